@@ -0,0 +1,201 @@
+//----------------------------------------------------------------------------------------------------
+// BakedMeshBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Game/Subsystem/Resource/BakedMesh.hpp"
+#include "Game/Subsystem/Resource/MappedFile.hpp"
+#include "Game/Subsystem/Resource/ObjMeshParser.hpp"
+#include "Game/Subsystem/Resource/GameResourceLoader.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr LARGE_SPHERE_SLICES = 1024;
+static int constexpr LARGE_SPHERE_STACKS = 512;        // 1024 x 512 quads: 1,048,576 triangles
+
+static char constexpr SMALL_BAKED_PATH[]   = "BakedMeshBenchmark_small.bmesh";
+static char constexpr CORRUPT_BAKED_PATH[] = "BakedMeshBenchmark_corrupt.bmesh";
+static char constexpr LARGE_OBJ_PATH[]     = "BakedMeshBenchmark_large.obj";
+static char constexpr LARGE_BAKED_PATH[]   = "BakedMeshBenchmark_large.bmesh";
+
+//----------------------------------------------------------------------------------------------------
+static bool IsBakedMeshEqual(BakedMesh const& baked, sMeshData const& mesh)
+{
+    size_t const vertexBytes = mesh.m_vertexes.size() * sizeof(Vertex_PCU);
+    size_t const indexBytes  = mesh.m_indexes.size() * sizeof(unsigned int);
+
+    bool isEqual = baked.GetVertexFormat() == eBakedVertexFormat::PCU;
+    isEqual      = isEqual && baked.GetVertexCount() == static_cast<int>(mesh.m_vertexes.size()) && baked.GetIndexCount() == static_cast<int>(mesh.m_indexes.size());
+    isEqual      = isEqual && memcmp(baked.GetVertexesPCU(), mesh.m_vertexes.data(), vertexBytes) == 0 && memcmp(baked.GetIndexes(), mesh.m_indexes.data(), indexBytes) == 0;
+    isEqual      = isEqual && baked.GetSubmeshCount() == static_cast<int>(mesh.m_submeshes.size()) && baked.GetMaterialCount() == static_cast<int>(mesh.m_materialNames.size());
+
+    for (int submeshIndex = 0; isEqual && submeshIndex < baked.GetSubmeshCount(); ++submeshIndex)
+    {
+        sSubmesh const& bakedSubmesh = baked.GetSubmeshes()[submeshIndex];
+        sSubmesh const& submesh      = mesh.m_submeshes[submeshIndex];
+
+        isEqual = bakedSubmesh.m_firstIndex == submesh.m_firstIndex && bakedSubmesh.m_indexCount == submesh.m_indexCount && bakedSubmesh.m_materialIndex == submesh.m_materialIndex;
+    }
+
+    for (int materialIndex = 0; isEqual && materialIndex < baked.GetMaterialCount(); ++materialIndex)
+    {
+        isEqual = mesh.m_materialNames[materialIndex] == baked.GetMaterialName(materialIndex);
+    }
+
+    sBoundingSphere const sphere = baked.GetLocalBoundingSphere();
+    return isEqual && sphere.m_center.x == mesh.m_localBoundingSphere.m_center.x && sphere.m_radius == mesh.m_localBoundingSphere.m_radius;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Submesh ranges from usemtl, a bake round trip that must give back the exact mesh, files the
+// loader must reject, and a baked model through the GameResourceLoader.
+//
+static void ValidateBakedMesh()
+{
+    char constexpr text[] =
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+        "f 1 2 3\n"
+        "usemtl stone\nf 1 3 4\n"
+        "usemtl wood \nf 1 2 3 4\n"
+        "usemtl stone\nf 2 3 4\n";
+
+    unsigned int const expectedSubmeshes[][3] = { { 0, 3, static_cast<unsigned int>(-1) }, { 3, 3, 0 }, { 6, 6, 1 }, { 12, 3, 0 } };
+
+    sMeshData mesh;
+    bool      isParsed = ParseObjMesh(text, sizeof(text) - 1, mesh) && mesh.m_submeshes.size() == 4;
+    isParsed           = isParsed && mesh.m_materialNames.size() == 2 && mesh.m_materialNames[0] == "stone" && mesh.m_materialNames[1] == "wood";
+
+    for (int submeshIndex = 0; isParsed && submeshIndex < 4; ++submeshIndex)
+    {
+        sSubmesh const& submesh = mesh.m_submeshes[submeshIndex];
+        isParsed                = submesh.m_firstIndex == expectedSubmeshes[submeshIndex][0] && submesh.m_indexCount == expectedSubmeshes[submeshIndex][1] && static_cast<unsigned int>(submesh.m_materialIndex) == expectedSubmeshes[submeshIndex][2];
+    }
+
+    GUARANTEE_OR_DIE(isParsed, "ParseObjMesh built the wrong submeshes from usemtl records")
+
+    BakedMesh baked;
+    String    error;
+
+    GUARANTEE_OR_DIE(WriteBakedMesh(SMALL_BAKED_PATH, mesh, &error), Stringf("WriteBakedMesh failed: %s", error.c_str()))
+    GUARANTEE_OR_DIE(baked.Load(SMALL_BAKED_PATH, &error), Stringf("BakedMesh could not load its own file: %s", error.c_str()))
+    GUARANTEE_OR_DIE(IsBakedMeshEqual(baked, mesh), "A baked mesh did not load back as the mesh it was baked from")
+
+    MappedFile bakedFile;
+    GUARANTEE_OR_DIE(bakedFile.Open(SMALL_BAKED_PATH), "MappedFile could not map a baked mesh")
+    String const bakedBytes(reinterpret_cast<char const*>(bakedFile.GetData()), bakedFile.GetSize());
+    bakedFile.Close();
+
+    String badMagicBytes = bakedBytes;
+    badMagicBytes[0]     = 'X';
+
+    sBakedMeshHeader header;
+    memcpy(&header, bakedBytes.data(), sizeof(header));
+
+    // The first submesh's index count, now past the end of the mesh
+    String badSubmeshBytes = bakedBytes;
+    badSubmeshBytes[static_cast<size_t>(header.m_submeshOffset) + 4] = 100;
+
+    String const corruptFiles[] = { bakedBytes.substr(0, bakedBytes.size() - 4), badMagicBytes, badSubmeshBytes };
+
+    for (String const& corruptFile : corruptFiles)
+    {
+        GUARANTEE_OR_DIE(WriteBenchmarkTextFile(CORRUPT_BAKED_PATH, corruptFile), "Could not write a corrupt baked mesh")
+        GUARANTEE_OR_DIE(!baked.Load(CORRUPT_BAKED_PATH, &error) && !baked.IsLoaded(), "BakedMesh accepted a corrupt file")
+    }
+
+    {
+        GameResourceLoader resourceLoader;
+        resourceLoader.Startup();
+
+        ModelHandle const handle = resourceLoader.RequestModel(SMALL_BAKED_PATH);
+
+        resourceLoader.WaitForLoads();
+        resourceLoader.PublishFinishedModels();
+
+        GUARANTEE_OR_DIE(resourceLoader.GetModelState(handle) == eModelState::READY && resourceLoader.GetModelLocalBoundingSphere(handle).m_radius == mesh.m_localBoundingSphere.m_radius, "GameResourceLoader did not load a baked model")
+        resourceLoader.Shutdown();
+    }
+
+    remove(SMALL_BAKED_PATH);
+    remove(CORRUPT_BAKED_PATH);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Touches every vertex and index, as an upload would, so the timing includes paging the file in.
+//
+static float ReadWholeMesh(BakedMesh const& baked)
+{
+    Vertex_PCU const*   vertexes = baked.GetVertexesPCU();
+    unsigned int const* indexes  = baked.GetIndexes();
+    float               sum      = 0.f;
+    unsigned int        indexSum = 0;
+
+    for (int vertexIndex = 0; vertexIndex < baked.GetVertexCount(); ++vertexIndex)
+    {
+        sum += vertexes[vertexIndex].m_position.x + vertexes[vertexIndex].m_uvTexCoords.y;
+    }
+
+    for (int index = 0; index < baked.GetIndexCount(); ++index)
+    {
+        indexSum += indexes[index];
+    }
+
+    return sum + static_cast<float>(indexSum);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Checks the format, then loads a model of over a million triangles from OBJ text and from its
+// baked file. Both files are in the OS file cache by the time they are timed, as they would be
+// after the first run.
+//
+void RunBakedMeshBenchmarks()
+{
+    ValidateBakedMesh();
+
+    String    objText      = MakeBenchmarkSphereObjText(LARGE_SPHERE_SLICES, LARGE_SPHERE_STACKS);
+    int const objMegabytes = static_cast<int>(objText.size() >> 20);
+
+    GUARANTEE_OR_DIE(WriteBenchmarkTextFile(LARGE_OBJ_PATH, objText), "Could not write the benchmark's OBJ file")
+    String().swap(objText);
+
+    String error;
+    GUARANTEE_OR_DIE(ConvertObjToBakedMesh(LARGE_OBJ_PATH, LARGE_BAKED_PATH, &error), Stringf("ConvertObjToBakedMesh failed: %s", error.c_str()))
+
+    sMeshData parsedMesh;
+    BakedMesh bakedMesh;
+    float     checksum  = 0.f;
+    int const triangles = LARGE_SPHERE_SLICES * LARGE_SPHERE_STACKS * 2;
+
+    sBenchmarkResult const objResult = RunBenchmark(Stringf("OBJ load, %d triangles (%d MB: map + parse)", triangles, objMegabytes), 2, 1, [&parsedMesh]()
+    {
+        MappedFile objFile;
+        objFile.Open(LARGE_OBJ_PATH);
+        ParseObjMesh(reinterpret_cast<char const*>(objFile.GetData()), objFile.GetSize(), parsedMesh);
+    });
+
+    RunBenchmark(Stringf("bmesh load, %d triangles (map + validate)", triangles), 100, 1, [&bakedMesh]()
+    {
+        bakedMesh.Load(LARGE_BAKED_PATH);
+    });
+
+    sBenchmarkResult const bakedResult = RunBenchmark(Stringf("bmesh load, %d triangles, reading every vertex and index", triangles), 20, 1, [&bakedMesh, &checksum]()
+    {
+        bakedMesh.Load(LARGE_BAKED_PATH);
+        checksum += ReadWholeMesh(bakedMesh);
+    });
+
+    printf("bmesh load is %.0fx faster than OBJ, reading the whole mesh (checksum %g)\n", objResult.m_secondsPerIteration / bakedResult.m_secondsPerIteration, checksum);
+
+    GUARANTEE_OR_DIE(bakedMesh.GetIndexCount() / 3 == triangles && IsBakedMeshEqual(bakedMesh, parsedMesh), "The baked large mesh is not the mesh its OBJ parses to")
+    GUARANTEE_OR_DIE(bakedResult.m_secondsPerIteration * 10.0 < objResult.m_secondsPerIteration, "Loading a baked mesh was not at least 10x faster than parsing its OBJ")
+
+    bakedMesh.Unload();
+    remove(LARGE_OBJ_PATH);
+    remove(LARGE_BAKED_PATH);
+}
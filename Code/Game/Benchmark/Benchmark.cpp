@@ -0,0 +1,362 @@
+//----------------------------------------------------------------------------------------------------
+// Benchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Game/Math/SIMD.hpp"
+
+//----------------------------------------------------------------------------------------------------
+struct sBenchmarkSuite
+{
+    char const* m_name;
+    void        (*m_function)();
+};
+
+//----------------------------------------------------------------------------------------------------
+static sBenchmarkSuite const s_benchmarkSuites[] =
+{
+    { "bakedmesh", RunBakedMeshBenchmarks },
+    { "culling", RunCullingBenchmarks },
+    { "entities", RunEntityStoreBenchmarks },
+    { "frametimes", RunFrameTimeBenchmarks },
+    { "hotpaths", RunHotPathBenchmarks },
+    { "jobs", RunJobSystemBenchmarks },
+    { "lightpool", RunLightPoolBenchmarks },
+    { "lights", RunLightClusterBenchmarks },
+    { "lightselect", RunLightSelectorBenchmarks },
+    { "meshes", RunMeshBenchmarks },
+    { "modelstreaming", RunModelStreamingBenchmarks },
+    { "objparser", RunObjParserBenchmarks },
+    { "pipeline", RunPipelineStateBenchmarks },
+    { "profiler", RunProfilerBenchmarks },
+    { "raster", RunSoftwareRasterBenchmarks },
+    { "renderpipeline", RunRenderPipelineBenchmarks },
+    { "renderqueue", RunRenderQueueBenchmarks },
+    { "shadercache", RunShaderCacheBenchmarks },
+    { "spatial", RunSpatialIndexBenchmarks },
+    { "texturecache", RunTextureCacheBenchmarks },
+    { "timestep", RunTimestepBenchmarks },
+    { "transforms", RunTransformBenchmarks },
+};
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr MAX_BENCHMARK_SAMPLES = 5;
+
+static std::vector<sBenchmarkResult> s_benchmarkResults;
+static char const*                   s_currentSuiteName = "";
+
+//----------------------------------------------------------------------------------------------------
+sBenchmarkResult RunBenchmark(String const& name, int const iterations, int const itemsPerIteration, std::function<void()> const& function)
+{
+    sBenchmarkResult result;
+    result.m_suiteName         = s_currentSuiteName;
+    result.m_name              = name;
+    result.m_iterations        = iterations;
+    result.m_itemsPerIteration = itemsPerIteration;
+    result.m_warmupIterations  = iterations / 10 > 1 ? iterations / 10 : 1;
+    result.m_sampleCount       = iterations < MAX_BENCHMARK_SAMPLES ? iterations : MAX_BENCHMARK_SAMPLES;
+
+    for (int iteration = 0; iteration < result.m_warmupIterations; ++iteration)
+    {
+        function();
+    }
+
+    double sampleSecondsPerIteration[MAX_BENCHMARK_SAMPLES];
+
+    for (int sample = 0; sample < result.m_sampleCount; ++sample)
+    {
+        // The last sample takes the remainder, so every requested iteration is timed
+        int const    sampleIterations = sample < result.m_sampleCount - 1 ? iterations / result.m_sampleCount : iterations - (iterations / result.m_sampleCount) * sample;
+        double const startSeconds     = GetCurrentTimeSeconds();
+
+        for (int iteration = 0; iteration < sampleIterations; ++iteration)
+        {
+            function();
+        }
+
+        double const sampleSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+        result.m_totalSeconds             += sampleSeconds;
+        sampleSecondsPerIteration[sample]  = sampleSeconds / static_cast<double>(sampleIterations);
+    }
+
+    if (result.m_sampleCount > 0)
+    {
+        std::sort(sampleSecondsPerIteration, sampleSecondsPerIteration + result.m_sampleCount);
+
+        double varianceSum = 0.0;
+        result.m_meanSecondsPerIteration = result.m_totalSeconds / static_cast<double>(iterations);
+
+        for (int sample = 0; sample < result.m_sampleCount; ++sample)
+        {
+            double const deviation  = sampleSecondsPerIteration[sample] - result.m_meanSecondsPerIteration;
+            varianceSum            += deviation * deviation;
+        }
+
+        result.m_secondsPerIteration       = sampleSecondsPerIteration[result.m_sampleCount / 2];
+        result.m_minSecondsPerIteration    = sampleSecondsPerIteration[0];
+        result.m_stddevSecondsPerIteration = result.m_sampleCount > 1 ? sqrt(varianceSum / static_cast<double>(result.m_sampleCount - 1)) : 0.0;
+    }
+
+    double const nanosecondsPerItem = result.m_secondsPerIteration * 1000000000.0 / static_cast<double>(itemsPerIteration);
+    double const relativeDeviation  = result.m_secondsPerIteration > 0.0 ? 100.0 * result.m_stddevSecondsPerIteration / result.m_secondsPerIteration : 0.0;
+    String const line               = Stringf("%-52s %10.3f us/iter %10.3f ns/item  (min %.3f us, +-%.1f%%)\n", name.c_str(), result.m_secondsPerIteration * 1000000.0, nanosecondsPerItem, result.m_minSecondsPerIteration * 1000000.0, relativeDeviation);
+
+    DebuggerPrintf("%s", line.c_str());
+    printf("%s", line.c_str());
+
+    s_benchmarkResults.push_back(result);
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool RunBenchmarkSuites(String const& suiteName)
+{
+    bool didRunSuite = false;
+
+    for (sBenchmarkSuite const& suite : s_benchmarkSuites)
+    {
+        if (suiteName == "all" || suiteName == suite.m_name)
+        {
+            s_currentSuiteName = suite.m_name;
+            suite.m_function();
+            s_currentSuiteName = "";
+            didRunSuite        = true;
+        }
+    }
+
+    return didRunSuite;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Quotes, backslashes and every control character are escaped, so names holding a tab, a newline or
+// a stray byte below 0x20 still make valid JSON.
+//
+static void WriteJsonString(FILE* file, char const* text)
+{
+    fputc('"', file);
+
+    for (char const* character = text; *character != '\0'; ++character)
+    {
+        unsigned char const code = static_cast<unsigned char>(*character);
+
+        if (code == '"' || code == '\\')
+        {
+            fputc('\\', file);
+            fputc(code, file);
+        }
+        else if (code == '\n')
+        {
+            fputs("\\n", file);
+        }
+        else if (code == '\t')
+        {
+            fputs("\\t", file);
+        }
+        else if (code < 0x20)
+        {
+            fprintf(file, "\\u%04x", code);
+        }
+        else
+        {
+            fputc(code, file);
+        }
+    }
+
+    fputc('"', file);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Times are in nanoseconds per iteration. The build block is what makes two files comparable: a
+// Debug result next to a Release one, SSE next to scalar, or markers compiled in next to compiled
+// out, is not a regression.
+//
+bool WriteBenchmarkResultsJson(String const& filePath)
+{
+    FILE* file = nullptr;
+
+#if defined(_WIN32)
+    if (fopen_s(&file, filePath.c_str(), "wb") != 0)
+    {
+        file = nullptr;
+    }
+#else
+    file = fopen(filePath.c_str(), "wb");
+#endif
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+#if defined(_DEBUG) || !defined(NDEBUG)
+    char const* configuration = "Debug";
+#else
+    char const* configuration = "Release";
+#endif
+
+#if defined(_MSC_VER)
+    String const compiler = Stringf("MSVC %d", _MSC_VER);
+#elif defined(__clang__)
+    String const compiler = Stringf("Clang %d.%d", __clang_major__, __clang_minor__);
+#elif defined(__GNUC__)
+    String const compiler = Stringf("GCC %d.%d", __GNUC__, __GNUC_MINOR__);
+#else
+    String const compiler = "Unknown";
+#endif
+
+#if defined(GAME_SIMD_SSE)
+    char const* simd = "SSE";
+#else
+    char const* simd = "None";
+#endif
+
+#if defined(GAME_DISABLE_PROFILER)
+    char const* profilerMarkers = "false";
+#else
+    char const* profilerMarkers = "true";
+#endif
+
+    fputs("{\"build\":{\"configuration\":", file);
+    WriteJsonString(file, configuration);
+    fputs(",\"compiler\":", file);
+    WriteJsonString(file, compiler.c_str());
+    fputs(",\"simd\":", file);
+    WriteJsonString(file, simd);
+    fprintf(file, ",\"profilerMarkers\":%s},\n\"results\":[", profilerMarkers);
+
+    for (size_t resultIndex = 0; resultIndex < s_benchmarkResults.size(); ++resultIndex)
+    {
+        sBenchmarkResult const& result = s_benchmarkResults[resultIndex];
+
+        fputs(resultIndex == 0 ? "\n{\"suite\":" : ",\n{\"suite\":", file);
+        WriteJsonString(file, result.m_suiteName.c_str());
+        fputs(",\"name\":", file);
+        WriteJsonString(file, result.m_name.c_str());
+        fprintf(file, ",\"iterations\":%d,\"warmupIterations\":%d,\"samples\":%d,\"itemsPerIteration\":%d", result.m_iterations, result.m_warmupIterations, result.m_sampleCount, result.m_itemsPerIteration);
+        fprintf(file, ",\"medianNs\":%.3f,\"minNs\":%.3f,\"meanNs\":%.3f,\"stddevNs\":%.3f,\"nsPerItem\":%.3f}",
+                result.m_secondsPerIteration * 1000000000.0,
+                result.m_minSecondsPerIteration * 1000000000.0,
+                result.m_meanSecondsPerIteration * 1000000000.0,
+                result.m_stddevSecondsPerIteration * 1000000000.0,
+                result.m_secondsPerIteration * 1000000000.0 / static_cast<double>(result.m_itemsPerIteration));
+    }
+
+    fputs("\n]}\n", file);
+
+    bool const isWritten = ferror(file) == 0;
+    fclose(file);
+
+    return isWritten;
+}
+
+//----------------------------------------------------------------------------------------------------
+// A camera at the origin looking down +X (Y left, Z up), with the same 60 degree, 2:1, 0.1 to 100
+// perspective as the player camera, so tests need no Camera or Renderer.
+//
+void MakeBenchmarkCameraTransforms(Mat44& out_worldToRender, Mat44& out_renderToClip)
+{
+    float constexpr fovDegrees = 60.f;
+    float constexpr aspect     = 2.f;
+    float constexpr zNear      = 0.1f;
+    float constexpr zFar       = 100.f;
+
+    float const scaleY = CosDegrees(fovDegrees * 0.5f) / SinDegrees(fovDegrees * 0.5f);
+    float const scaleX = scaleY / aspect;
+
+    for (int index = 0; index < 16; ++index)
+    {
+        out_worldToRender.m_values[index] = 0.f;
+        out_renderToClip.m_values[index]  = 0.f;
+    }
+
+    out_worldToRender.m_values[Mat44::Jx] = -1.f;                           // Render x is world -Y
+    out_worldToRender.m_values[Mat44::Ky] = 1.f;                            // Render y is world Z
+    out_worldToRender.m_values[Mat44::Iz] = 1.f;                            // Render z is world X
+    out_worldToRender.m_values[Mat44::Tw] = 1.f;
+
+    out_renderToClip.m_values[Mat44::Ix] = scaleX;
+    out_renderToClip.m_values[Mat44::Jy] = scaleY;
+    out_renderToClip.m_values[Mat44::Kz] = zFar / (zFar - zNear);
+    out_renderToClip.m_values[Mat44::Tz] = -zNear * zFar / (zFar - zNear);
+    out_renderToClip.m_values[Mat44::Kw] = 1.f;
+}
+
+//----------------------------------------------------------------------------------------------------
+Mat44 MakeBenchmarkWorldToClip()
+{
+    Mat44 worldToRender;
+    Mat44 worldToClip;
+    MakeBenchmarkCameraTransforms(worldToRender, worldToClip);
+
+    worldToClip.Append(worldToRender);
+
+    return worldToClip;
+}
+
+//----------------------------------------------------------------------------------------------------
+String MakeBenchmarkSphereObjText(int const slices, int const stacks)
+{
+    String text = "# Benchmark sphere\n";
+
+    for (int stack = 0; stack <= stacks; ++stack)
+    {
+        float const pitchRadians = 3.14159265f * (static_cast<float>(stack) / static_cast<float>(stacks) - 0.5f);
+
+        for (int slice = 0; slice <= slices; ++slice)
+        {
+            float const yawRadians = 6.28318531f * static_cast<float>(slice) / static_cast<float>(slices);
+            text += Stringf("v %.6f %.6f %.6f\n", cosf(pitchRadians) * cosf(yawRadians), cosf(pitchRadians) * sinf(yawRadians), sinf(pitchRadians));
+            text += Stringf("vt %.6f %.6f\n", static_cast<float>(slice) / static_cast<float>(slices), static_cast<float>(stack) / static_cast<float>(stacks));
+        }
+    }
+
+    for (int stack = 0; stack < stacks; ++stack)
+    {
+        for (int slice = 0; slice < slices; ++slice)
+        {
+            int const bottomLeft = 1 + stack * (slices + 1) + slice;
+            int const topLeft    = bottomLeft + slices + 1;
+            text += Stringf("f %d/%d %d/%d %d/%d %d/%d\n", bottomLeft, bottomLeft, bottomLeft + 1, bottomLeft + 1, topLeft + 1, topLeft + 1, topLeft, topLeft);
+        }
+    }
+
+    return text;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool WriteBenchmarkTextFile(String const& filePath, String const& text)
+{
+    FILE* file = nullptr;
+
+#if defined(_WIN32)
+    if (fopen_s(&file, filePath.c_str(), "wb") != 0)
+    {
+        file = nullptr;
+    }
+#else
+    file = fopen(filePath.c_str(), "wb");
+#endif
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    bool const isWritten = fwrite(text.data(), 1, text.size(), file) == text.size();
+    fclose(file);
+
+    return isWritten;
+}
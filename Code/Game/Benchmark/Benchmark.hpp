@@ -0,0 +1,91 @@
+//----------------------------------------------------------------------------------------------------
+// Benchmark.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <functional>
+
+#include "Engine/Core/StringUtils.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+struct Mat44;
+
+//----------------------------------------------------------------------------------------------------
+// Per-iteration times are over samples, each a run of consecutive iterations; the median is the
+// headline number, and min and standard deviation show how noisy the run was.
+//
+struct sBenchmarkResult
+{
+    String m_suiteName;
+    String m_name;
+    int    m_iterations                = 0;
+    int    m_itemsPerIteration         = 1;
+    int    m_warmupIterations          = 0;
+    int    m_sampleCount               = 0;
+    double m_totalSeconds              = 0.0;       // Timed samples only
+    double m_secondsPerIteration       = 0.0;       // Median sample
+    double m_minSecondsPerIteration    = 0.0;
+    double m_meanSecondsPerIteration   = 0.0;
+    double m_stddevSecondsPerIteration = 0.0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Runs `function` untimed for a tenth of `iterations` (at least once) to warm caches and
+// allocators, then times `iterations` calls split into up to five samples, prints the result and
+// adds it to the run's results. `itemsPerIteration` is only used to report a per-item cost (e.g.
+// per entity).
+//
+sBenchmarkResult RunBenchmark(String const& name, int iterations, int itemsPerIteration, std::function<void()> const& function);
+
+//----------------------------------------------------------------------------------------------------
+// Runs every benchmark suite whose name matches `suiteName` ("all" runs every suite).
+// Returns false if no suite has that name.
+//
+bool RunBenchmarkSuites(String const& suiteName);
+
+//----------------------------------------------------------------------------------------------------
+// Writes every result since startup as JSON, with the build configuration, so runs from different
+// commits can be diffed by a script. Returns false if the file could not be written.
+//
+bool WriteBenchmarkResultsJson(String const& filePath);
+
+//----------------------------------------------------------------------------------------------------
+// Transforms for a camera at the origin looking down +X, with the player camera's perspective.
+//
+void  MakeBenchmarkCameraTransforms(Mat44& out_worldToRender, Mat44& out_renderToClip);
+Mat44 MakeBenchmarkWorldToClip();
+
+//----------------------------------------------------------------------------------------------------
+// A UV sphere of unit radius as OBJ text: a (slices + 1) x (stacks + 1) grid of v and vt records,
+// so every grid point is one distinct vertex, and one quad face per cell, 2 x slices x stacks
+// triangles in all.
+//
+String MakeBenchmarkSphereObjText(int slices, int stacks);
+bool   WriteBenchmarkTextFile(String const& filePath, String const& text);
+
+//----------------------------------------------------------------------------------------------------
+// Suites, one per Benchmark/*Benchmark.cpp file
+//
+void RunBakedMeshBenchmarks();
+void RunCullingBenchmarks();
+void RunEntityStoreBenchmarks();
+void RunFrameTimeBenchmarks();
+void RunHotPathBenchmarks();
+void RunJobSystemBenchmarks();
+void RunLightClusterBenchmarks();
+void RunLightPoolBenchmarks();
+void RunLightSelectorBenchmarks();
+void RunMeshBenchmarks();
+void RunModelStreamingBenchmarks();
+void RunObjParserBenchmarks();
+void RunPipelineStateBenchmarks();
+void RunProfilerBenchmarks();
+void RunRenderPipelineBenchmarks();
+void RunRenderQueueBenchmarks();
+void RunShaderCacheBenchmarks();
+void RunSoftwareRasterBenchmarks();
+void RunSpatialIndexBenchmarks();
+void RunTextureCacheBenchmarks();
+void RunTimestepBenchmarks();
+void RunTransformBenchmarks();
@@ -0,0 +1,52 @@
+//----------------------------------------------------------------------------------------------------
+// CullingBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <cstdio>
+#include <vector>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Game/Math/FrustumCulling.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Checks the SSE cull against the scalar one on random spheres around the camera, then times both.
+//
+void RunCullingBenchmarks()
+{
+    int constexpr sphereCount = 10000;
+
+    RandomNumberGenerator        rng;
+    std::vector<sBoundingSphere> spheres(sphereCount);
+    std::vector<uint8_t>         batchVisible(sphereCount);
+    std::vector<uint8_t>         scalarVisible(sphereCount);
+
+    for (sBoundingSphere& sphere : spheres)
+    {
+        sphere.m_center = Vec3(rng.RollRandomFloatInRange(-100.f, 100.f), rng.RollRandomFloatInRange(-100.f, 100.f), rng.RollRandomFloatInRange(-20.f, 20.f));
+        sphere.m_radius = rng.RollRandomFloatInRange(0.1f, 3.f);
+    }
+
+    sFrustum const frustum = sFrustum::MakeFromWorldToClip(MakeBenchmarkWorldToClip());
+
+    int const batchVisibleCount  = CullSpheres(frustum, spheres.data(), sphereCount, batchVisible.data());
+    int const scalarVisibleCount = CullSpheresScalar(frustum, spheres.data(), sphereCount, scalarVisible.data());
+
+    printf("CullSpheres: %d of %d spheres visible\n", batchVisibleCount, sphereCount);
+    GUARANTEE_OR_DIE(batchVisibleCount == scalarVisibleCount && batchVisible == scalarVisible, "CullSpheres does not match CullSpheresScalar")
+    GUARANTEE_OR_DIE(batchVisibleCount > 0 && batchVisibleCount < sphereCount, "Culling test scene should have both visible and culled spheres")
+
+    RunBenchmark(Stringf("CullSpheres scalar x%d", sphereCount), 1000, sphereCount, [&]()
+    {
+        CullSpheresScalar(frustum, spheres.data(), sphereCount, scalarVisible.data());
+    });
+
+    RunBenchmark(Stringf("CullSpheres SSE x%d", sphereCount), 1000, sphereCount, [&]()
+    {
+        CullSpheres(frustum, spheres.data(), sphereCount, batchVisible.data());
+    });
+}
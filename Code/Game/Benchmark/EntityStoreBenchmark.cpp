@@ -0,0 +1,63 @@
+//----------------------------------------------------------------------------------------------------
+// EntityStoreBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <vector>
+
+#include "Game/EntityStore.hpp"
+#include "Game/Prop.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Compares the per-object path (one heap Prop per entity, virtual Update) with the EntityStore
+// sweep at 1k, 10k and 100k entities.
+//
+void RunEntityStoreBenchmarks()
+{
+    float constexpr deltaSeconds   = 1.f / 60.f;
+    int const       entityCounts[] = { 1000, 10000, 100000 };
+
+    for (int const entityCount : entityCounts)
+    {
+        int const iterations = 10000000 / entityCount;
+
+        std::vector<Entity*> entities;
+        entities.reserve(static_cast<size_t>(entityCount));
+
+        EntityStore entityStore;
+        entityStore.Reserve(entityCount);
+
+        for (int entityIndex = 0; entityIndex < entityCount; ++entityIndex)
+        {
+            Vec3 const        position(static_cast<float>(entityIndex), 0.f, 0.f);
+            EulerAngles const angularVelocity(45.f, 30.f, 30.f);
+
+            Prop* prop              = new Prop(nullptr);
+            prop->m_position        = position;
+            prop->m_angularVelocity = angularVelocity;
+            entities.push_back(prop);
+
+            entityStore.CreateEntity(0, position, EulerAngles::ZERO, angularVelocity);
+        }
+
+        RunBenchmark(Stringf("Entity::Update (per-object) x%d", entityCount), iterations, entityCount, [&entities]()
+        {
+            for (Entity* entity : entities)
+            {
+                entity->Update(deltaSeconds);
+            }
+        });
+
+        RunBenchmark(Stringf("EntityStore::UpdateOrientations x%d", entityCount), iterations, entityCount, [&entityStore]()
+        {
+            entityStore.UpdateOrientations(deltaSeconds);
+        });
+
+        for (Entity* entity : entities)
+        {
+            delete entity;
+        }
+    }
+}
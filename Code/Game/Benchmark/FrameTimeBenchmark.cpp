@@ -0,0 +1,101 @@
+//----------------------------------------------------------------------------------------------------
+// FrameTimeBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <utility>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Game/Subsystem/Profile/FrameTimeStatistics.hpp"
+#include "Game/Subsystem/Profile/Profiler.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr WINDOW_SIZE = 240;
+
+//----------------------------------------------------------------------------------------------------
+// 1 to 100 ms in shuffled order has known nearest-rank percentiles. Pushing another full window
+// of 5 ms frames must evict every one of them.
+//
+static void ValidateFrameTimeStatistics()
+{
+    FrameTimeStatistics   statistics(100);
+    RandomNumberGenerator rng;
+    float                 frameMilliseconds[100];
+
+    for (int frame = 0; frame < 100; ++frame)
+    {
+        frameMilliseconds[frame] = static_cast<float>(frame + 1);
+    }
+
+    for (int frame = 99; frame > 0; --frame)
+    {
+        int const other = rng.RollRandomIntInRange(0, frame);
+        std::swap(frameMilliseconds[frame], frameMilliseconds[other]);
+    }
+
+    for (float const milliseconds : frameMilliseconds)
+    {
+        statistics.AddFrame(milliseconds / 1000.f);
+    }
+
+    sFrameTimeSummary const& summary = statistics.GetSummary();
+
+    auto const isNear = [](float const value, float const expected)
+    {
+        return value > expected - 0.001f && value < expected + 0.001f;
+    };
+
+    GUARANTEE_OR_DIE(summary.m_frameCount == 100, "FrameTimeStatistics frame count is wrong");
+    GUARANTEE_OR_DIE(isNear(summary.m_minMilliseconds, 1.f) && isNear(summary.m_maxMilliseconds, 100.f), "FrameTimeStatistics min or max is wrong");
+    GUARANTEE_OR_DIE(isNear(summary.m_averageMilliseconds, 50.5f), "FrameTimeStatistics average is wrong");
+    GUARANTEE_OR_DIE(isNear(summary.m_p50Milliseconds, 50.f) && isNear(summary.m_p95Milliseconds, 95.f) && isNear(summary.m_p99Milliseconds, 99.f), "FrameTimeStatistics percentiles are wrong");
+    GUARANTEE_OR_DIE(isNear(statistics.GetFrameMilliseconds(0), frameMilliseconds[99]), "FrameTimeStatistics newest frame is wrong");
+
+    for (int frame = 0; frame < 100; ++frame)
+    {
+        statistics.AddFrame(0.005f);
+    }
+
+    GUARANTEE_OR_DIE(isNear(summary.m_maxMilliseconds, 5.f) && isNear(summary.m_p99Milliseconds, 5.f), "FrameTimeStatistics kept frames older than its window");
+}
+
+//----------------------------------------------------------------------------------------------------
+// The per-frame cost of the HUD's statistics and of the profiler's frame summary, which together
+// are what showing the HUD adds to a frame besides drawing it.
+//
+void RunFrameTimeBenchmarks()
+{
+    ValidateFrameTimeStatistics();
+
+    FrameTimeStatistics   statistics(WINDOW_SIZE);
+    RandomNumberGenerator rng;
+
+    RunBenchmark("FrameTimeStatistics::AddFrame 240-frame window", 10000, 1, [&statistics, &rng]()
+    {
+        statistics.AddFrame(rng.RollRandomFloatInRange(0.010f, 0.020f));
+    });
+
+    SetProfilerFrameSummaryEnabled(true);
+
+    RunBenchmark("Profiler frame summary, 200 scopes", 1000, 200, []()
+    {
+        ProfilerBeginFrame();
+
+        for (int scope = 0; scope < 200; ++scope)
+        {
+            PROFILE_SCOPE("FrameTimeBenchmark::Scope");
+        }
+
+        ProfilerEndFrame();
+    });
+
+#if !defined(GAME_DISABLE_PROFILER)
+    sProfilerFrameSummary const& summary = GetProfilerFrameSummary();
+    GUARANTEE_OR_DIE(summary.m_scopeCount == 2 && summary.m_scopes[1].m_callCount == 200, "Profiler frame summary miscounted the last frame's scopes");
+#endif
+
+    SetProfilerFrameSummaryEnabled(false);
+}
@@ -0,0 +1,328 @@
+//----------------------------------------------------------------------------------------------------
+// HotPathBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Renderer/Light.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Prop.hpp"
+#include "Game/Subsystem/Light/LightSubsystem.hpp"
+#include "Game/Subsystem/Render/GlyphFont.hpp"
+#include "Game/Subsystem/Render/NullRenderBackend.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr HOT_PATH_ENTITY_COUNT     = 10000;
+static int constexpr DEBUG_DRAWS_PER_ITERATION = 100;
+static int constexpr LIVE_LIGHT_COUNT          = 1000;
+static int constexpr LIGHTS_CHURNED_PER_FRAME  = 100;
+static int constexpr LIT_DRAWS_PER_FRAME       = 256;
+static int constexpr TEXT_LINES_PER_ITERATION  = 16;
+
+//----------------------------------------------------------------------------------------------------
+static bool IsNear(Vec3 const& a, Vec3 const& b, float const tolerance)
+{
+    return fabsf(a.x - b.x) <= tolerance && fabsf(a.y - b.y) <= tolerance && fabsf(a.z - b.z) <= tolerance;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Through the Entity base, the way Game and EntityStore call it, so the virtual call is included.
+//
+static void RunEntityTransformBenchmarks()
+{
+    RandomNumberGenerator rng;
+    std::vector<Prop*>    props;
+    std::vector<Mat44>    transforms(HOT_PATH_ENTITY_COUNT);
+
+    for (int entityIndex = 0; entityIndex < HOT_PATH_ENTITY_COUNT; ++entityIndex)
+    {
+        Prop* prop          = new Prop(nullptr);
+        prop->m_position    = Vec3(rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(0.f, 10.f));
+        prop->m_orientation = EulerAngles(rng.RollRandomFloatInRange(-720.f, 720.f), rng.RollRandomFloatInRange(-90.f, 90.f), rng.RollRandomFloatInRange(-180.f, 180.f));
+        props.push_back(prop);
+    }
+
+    for (int entityIndex = 0; entityIndex < HOT_PATH_ENTITY_COUNT; ++entityIndex)
+    {
+        Entity const* entity   = props[entityIndex];
+        Mat44 const   expected = Entity::MakeModelToWorldTransform(entity->m_position, entity->m_orientation);
+        Mat44 const   actual   = entity->GetModelToWorldTransform();
+
+        for (int valueIndex = 0; valueIndex < 16; ++valueIndex)
+        {
+            GUARANTEE_OR_DIE(actual.m_values[valueIndex] == expected.m_values[valueIndex], "Entity::GetModelToWorldTransform does not match MakeModelToWorldTransform")
+        }
+    }
+
+    RunBenchmark(Stringf("Entity::GetModelToWorldTransform x%d", HOT_PATH_ENTITY_COUNT), 500, HOT_PATH_ENTITY_COUNT, [&]()
+    {
+        for (int entityIndex = 0; entityIndex < HOT_PATH_ENTITY_COUNT; ++entityIndex)
+        {
+            Entity const* entity     = props[entityIndex];
+            transforms[entityIndex] = entity->GetModelToWorldTransform();
+        }
+    });
+
+    for (Prop*& prop : props)
+    {
+        delete prop;
+        prop = nullptr;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// The generators append to the Prop's lists, so each iteration builds a fresh Prop, as spawning one
+// in Game does. The bounds check catches a generator that stops producing the mesh it should.
+//
+static void RunPropGeneratorBenchmark(char const* name, int const iterations, void (Prop::*generator)(), Vec3 const& expectedMins, Vec3 const& expectedMaxs)
+{
+    {
+        Prop prop(nullptr);
+        (prop.*generator)();
+        prop.ComputeLocalBounds();
+
+        GUARANTEE_OR_DIE(IsNear(prop.m_localBounds.m_mins, expectedMins, 0.05f) && IsNear(prop.m_localBounds.m_maxs, expectedMaxs, 0.05f), Stringf("%s built a mesh with unexpected bounds", name))
+    }
+
+    RunBenchmark(name, iterations, 1, [&]()
+    {
+        Prop prop(nullptr);
+        (prop.*generator)();
+        prop.ComputeLocalBounds();
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+static void RunPropBenchmarks()
+{
+    RunPropGeneratorBenchmark("Prop::InitializeLocalVertsForCube", 20000, &Prop::InitializeLocalVertsForCube, Vec3(-0.5f, -0.5f, -0.5f), Vec3(0.5f, 0.5f, 0.5f));
+    RunPropGeneratorBenchmark("Prop::InitializeLocalVertsForSphere", 2000, &Prop::InitializeLocalVertsForSphere, Vec3(-0.5f, -0.5f, -0.5f), Vec3(0.5f, 0.5f, 0.5f));
+    RunPropGeneratorBenchmark("Prop::InitializeLocalVertsForGrid", 500, &Prop::InitializeLocalVertsForGrid, Vec3(-50.025f, -50.025f, -0.15f), Vec3(50.f, 50.f, 0.15f));
+
+    {
+        Prop arrows(nullptr);
+        arrows.InitializeLocalVertsForWorldCoordinateArrows();
+        arrows.ComputeLocalBounds();
+
+        GUARANTEE_OR_DIE(arrows.m_localBounds.m_maxs.x >= 2.f - 0.01f && arrows.m_localBounds.m_maxs.y >= 2.f - 0.01f && arrows.m_localBounds.m_maxs.z >= 2.f - 0.01f, "World coordinate arrows do not reach 2 m along each axis")
+
+        RunBenchmark("Prop::InitializeLocalVertsForWorldCoordinateArrows", 5000, 1, []()
+        {
+            Prop prop(nullptr);
+            prop.InitializeLocalVertsForWorldCoordinateArrows();
+            prop.ComputeLocalBounds();
+        });
+    }
+
+    {
+        // Headless runs load no font; the layout reads none of its texels
+        GlyphFont        headlessFont(nullptr);
+        GlyphFont* const loadedFont = g_theGlyphFont;
+        g_theGlyphFont              = loadedFont != nullptr ? loadedFont : &headlessFont;
+
+        Prop text(nullptr);
+        text.InitializeLocalVertsForText2D();
+        text.ComputeLocalBounds();
+
+        AABB3 const& bounds = text.m_localBounds;
+        GUARANTEE_OR_DIE(bounds.m_mins.x == 0.f && bounds.m_maxs.x == 0.f, "Prop text is not in the X = 0 plane")
+        GUARANTEE_OR_DIE(bounds.m_mins.y == -6.f && bounds.m_maxs.y == 6.f && bounds.m_mins.z == -0.5f && bounds.m_maxs.z == 0.5f, "Prop text is not centered on its origin")
+
+        // 'A' is glyph 65: column 1, row 4 down from the top
+        VertexList_PCU glyphVerts;
+        g_theGlyphFont->AddVertsForText2D(glyphVerts, Vec2(), 1.f, "A");
+
+        for (Vertex_PCU const& vert : glyphVerts)
+        {
+            Vec2 const& uv = vert.m_uvTexCoords;
+            GUARANTEE_OR_DIE(glyphVerts.size() == 6 && uv.x >= 1.f / 16.f && uv.x <= 2.f / 16.f && uv.y >= 11.f / 16.f && uv.y <= 12.f / 16.f, "GlyphFont does not sample a glyph's own cell")
+        }
+
+        RunBenchmark("Prop::InitializeLocalVertsForText2D", 5000, 1, []()
+        {
+            Prop prop(nullptr);
+            prop.InitializeLocalVertsForText2D();
+            prop.ComputeLocalBounds();
+        });
+
+        g_theGlyphFont = loadedFont;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Each builder fills a stack array and submits it in one draw; the vertex counts pin down that it
+// still does.
+//
+static void RunDebugDrawBenchmark(char const* name, int const expectedVertexes, std::function<void(int)> const& draw)
+{
+    g_theRenderBackend->BeginFrame();
+    draw(0);
+
+    sRenderStatistics const& statistics = g_theRenderBackend->GetFrameStatistics();
+    GUARANTEE_OR_DIE(statistics.m_drawCalls == 1 && statistics.m_verticesSubmitted == expectedVertexes, Stringf("%s submitted %d vertexes in %d draws, expected %d in 1", name, statistics.m_verticesSubmitted, statistics.m_drawCalls, expectedVertexes))
+
+    RunBenchmark(Stringf("%s x%d", name, DEBUG_DRAWS_PER_ITERATION), 2000, DEBUG_DRAWS_PER_ITERATION, [&]()
+    {
+        g_theRenderBackend->BeginFrame();
+
+        for (int drawIndex = 0; drawIndex < DEBUG_DRAWS_PER_ITERATION; ++drawIndex)
+        {
+            draw(drawIndex);
+        }
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+static void RunDebugDrawBenchmarks()
+{
+    auto const getCenter = [](int const drawIndex)
+    {
+        return Vec2(static_cast<float>(drawIndex % 10) * 80.f, static_cast<float>(drawIndex / 10) * 80.f);
+    };
+
+    RunDebugDrawBenchmark("DebugDrawRing", 192, [&](int const drawIndex) { DebugDrawRing(getCenter(drawIndex), 20.f, 2.f, Rgba8::WHITE); });
+    RunDebugDrawBenchmark("DebugDrawLine", 6, [&](int const drawIndex) { DebugDrawLine(getCenter(drawIndex), getCenter(drawIndex) + Vec2(30.f, 10.f), 2.f, Rgba8::WHITE); });
+    RunDebugDrawBenchmark("DebugDrawGlowCircle", 96, [&](int const drawIndex) { DebugDrawGlowCircle(getCenter(drawIndex), 20.f, Rgba8::YELLOW, 0.5f); });
+    RunDebugDrawBenchmark("DebugDrawGlowBox", 6, [&](int const drawIndex) { DebugDrawGlowBox(getCenter(drawIndex), Vec2(30.f, 20.f), Rgba8::CYAN, 0.5f); });
+    RunDebugDrawBenchmark("DebugDrawBoxRing", 24, [&](int const drawIndex) { DebugDrawBoxRing(getCenter(drawIndex), 20.f, 2.f, Rgba8::MAGENTA); });
+}
+
+//----------------------------------------------------------------------------------------------------
+// A frame of the LightSubsystem at LIVE_LIGHT_COUNT lights: the oldest lights expire and as many
+// spawn, BeginFrame uploads the default set, and each lit draw selects and packs its own.
+//
+static void RunLightSubsystemBenchmarks()
+{
+    RandomNumberGenerator rng;
+    LightSubsystem        lightSubsystem(sLightConfig{ LIVE_LIGHT_COUNT + 64 });
+    lightSubsystem.StartUp();
+
+    int const                startupLightCount = lightSubsystem.GetLightCount();
+    std::vector<LightHandle> liveHandles;
+    int                      oldestHandleIndex = 0;
+
+    auto const makeLight = [&rng]()
+    {
+        Light light;
+        light.SetType(eLightType::POINT)
+             .SetWorldPosition(Vec3(rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(0.f, 10.f)))
+             .SetRadius(0.5f, rng.RollRandomFloatInRange(2.f, 8.f))
+             .SetColorWithIntensity(Vec4(1.f, 0.8f, 0.6f, 4.f));
+
+        return light;
+    };
+
+    for (int lightIndex = 0; lightIndex < LIVE_LIGHT_COUNT; ++lightIndex)
+    {
+        liveHandles.push_back(lightSubsystem.AddLight(makeLight()));
+    }
+
+    auto const churnLights = [&]()
+    {
+        for (int churnIndex = 0; churnIndex < LIGHTS_CHURNED_PER_FRAME; ++churnIndex)
+        {
+            lightSubsystem.RemoveLight(liveHandles[oldestHandleIndex]);
+            liveHandles[oldestHandleIndex] = lightSubsystem.AddLight(makeLight());
+            oldestHandleIndex              = (oldestHandleIndex + 1) % LIVE_LIGHT_COUNT;
+        }
+    };
+
+    std::vector<sBoundingSphere> drawBounds(LIT_DRAWS_PER_FRAME);
+
+    for (sBoundingSphere& bounds : drawBounds)
+    {
+        bounds.m_center = Vec3(rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(0.f, 5.f));
+        bounds.m_radius = rng.RollRandomFloatInRange(0.5f, 3.f);
+    }
+
+    auto const runFrame = [&]()
+    {
+        churnLights();
+        lightSubsystem.BeginFrame();
+
+        for (sBoundingSphere const& bounds : drawBounds)
+        {
+            lightSubsystem.BindLightsForBounds(bounds);
+        }
+    };
+
+    runFrame();
+
+    sLightStatistics const& statistics = lightSubsystem.GetFrameStatistics();
+    GUARANTEE_OR_DIE(lightSubsystem.GetLightCount() == startupLightCount + LIVE_LIGHT_COUNT, "Light churn changed the live light count")
+    GUARANTEE_OR_DIE(statistics.m_lightSetUploads + statistics.m_lightSetUploadsSkipped == LIT_DRAWS_PER_FRAME + 1, "Every light set must be either uploaded or skipped")
+    GUARANTEE_OR_DIE(statistics.m_lightSetUploads >= 1, "A frame with new lights must upload the default set")
+
+    RunBenchmark(Stringf("LightSubsystem add+remove x%d", LIGHTS_CHURNED_PER_FRAME), 2000, LIGHTS_CHURNED_PER_FRAME, churnLights);
+    RunBenchmark(Stringf("LightSubsystem frame (churn, BeginFrame, %d draws)", LIT_DRAWS_PER_FRAME), 500, LIT_DRAWS_PER_FRAME, runFrame);
+
+    lightSubsystem.ShutDown();
+}
+
+//----------------------------------------------------------------------------------------------------
+// The per-frame debug text Game and App build, with Stringf (a heap String per line) and with
+// snprintf into a stack buffer, which is what the perf HUD does.
+//
+static void RunDebugTextBenchmarks()
+{
+    float const totalSeconds = 123.456f;
+    float const timeScale    = 1.f;
+    Vec3 const  position     = Vec3(12.345f, -6.789f, 1.5f);
+    size_t      totalLength  = 0;
+
+    String const stringfText = Stringf("Player Position: (%.2f, %.2f, %.2f)", position.x, position.y, position.z);
+    char         bufferText[128];
+    snprintf(bufferText, sizeof(bufferText), "Player Position: (%.2f, %.2f, %.2f)", position.x, position.y, position.z);
+    GUARANTEE_OR_DIE(stringfText == bufferText, "Stringf and snprintf format the debug text differently")
+
+    RunBenchmark(Stringf("Debug text Stringf x%d", TEXT_LINES_PER_ITERATION), 20000, TEXT_LINES_PER_ITERATION, [&]()
+    {
+        for (int lineIndex = 0; lineIndex < TEXT_LINES_PER_ITERATION; lineIndex += 2)
+        {
+            String const timeText     = Stringf("Time: %.2f\nScale: %.1f", totalSeconds, timeScale);
+            String const positionText = Stringf("Player Position: (%.2f, %.2f, %.2f)", position.x, position.y, position.z);
+            totalLength               += timeText.size() + positionText.size();
+        }
+    });
+
+    RunBenchmark(Stringf("Debug text snprintf x%d", TEXT_LINES_PER_ITERATION), 20000, TEXT_LINES_PER_ITERATION, [&]()
+    {
+        char line[128];
+
+        for (int lineIndex = 0; lineIndex < TEXT_LINES_PER_ITERATION; lineIndex += 2)
+        {
+            totalLength += static_cast<size_t>(snprintf(line, sizeof(line), "Time: %.2f\nScale: %.1f", totalSeconds, timeScale));
+            totalLength += static_cast<size_t>(snprintf(line, sizeof(line), "Player Position: (%.2f, %.2f, %.2f)", position.x, position.y, position.z));
+        }
+    });
+
+    GUARANTEE_OR_DIE(totalLength > 0, "Debug text benchmarks formatted nothing")
+}
+
+//----------------------------------------------------------------------------------------------------
+// The game-side CPU paths a frame runs that the other suites don't cover. Everything draws into a
+// NullRenderBackend of its own, so the numbers are the same headless or windowed, and the
+// backend's statistics double as the check on what was submitted.
+//
+void RunHotPathBenchmarks()
+{
+    RenderBackend*    previousRenderBackend = g_theRenderBackend;
+    NullRenderBackend nullRenderBackend;
+    g_theRenderBackend = &nullRenderBackend;
+
+    RunEntityTransformBenchmarks();
+    RunPropBenchmarks();
+    RunDebugDrawBenchmarks();
+    RunLightSubsystemBenchmarks();
+    RunDebugTextBenchmarks();
+
+    g_theRenderBackend = previousRenderBackend;
+}
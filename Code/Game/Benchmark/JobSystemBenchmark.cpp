@@ -0,0 +1,298 @@
+//----------------------------------------------------------------------------------------------------
+// JobSystemBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Game/EntityStore.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Subsystem/Job/JobSystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr   VALIDATION_WORKER_COUNT = 3;         // More threads than a small machine has cores, on purpose
+static int constexpr   SCALING_ENTITY_COUNT    = 100000;
+static float constexpr DELTA_SECONDS           = 1.f / 60.f;
+
+//----------------------------------------------------------------------------------------------------
+// Every index of [0, count) must be handed out exactly once, for grains that do and do not divide
+// the count, and a slot must never run two ranges at the same time.
+//
+static void ValidateParallelFor(JobSystem& jobSystem)
+{
+    int const counts[]     = { 0, 1, 7, 1000, 100003 };
+    int const grainSizes[] = { 1, 64, 4096 };
+
+    for (int const count : counts)
+    {
+        for (int const grainSize : grainSizes)
+        {
+            std::vector<int> visits(static_cast<size_t>(count), 0);
+
+            jobSystem.ParallelFor(count, grainSize, [&visits](int const begin, int const end)
+            {
+                for (int index = begin; index < end; ++index)
+                {
+                    ++visits[index];
+                }
+            });
+
+            for (int const visitCount : visits)
+            {
+                GUARANTEE_OR_DIE(visitCount == 1, "JobSystem::ParallelFor did not visit every index exactly once")
+            }
+        }
+    }
+
+    int constexpr     maxSlotCount            = 2;
+    std::atomic<int>  busySlots[maxSlotCount] = {};
+    std::atomic<int>  rangeCount(0);
+    std::atomic<bool> isSlotShared(false);
+    std::atomic<bool> isSlotOutOfRange(false);
+
+    jobSystem.ParallelForSlots(10000, 16, maxSlotCount, [&](int const begin, int const end, int const slot)
+    {
+        UNUSED(begin)
+        UNUSED(end)
+
+        if (slot < 0 || slot >= maxSlotCount)
+        {
+            isSlotOutOfRange = true;
+            return;
+        }
+
+        if (busySlots[slot].fetch_add(1) != 0)
+        {
+            isSlotShared = true;
+        }
+
+        std::this_thread::yield();
+        busySlots[slot].fetch_sub(1);
+        ++rangeCount;
+    });
+
+    GUARANTEE_OR_DIE(!isSlotOutOfRange, "JobSystem::ParallelForSlots handed out a slot past maxSlotCount")
+    GUARANTEE_OR_DIE(!isSlotShared, "JobSystem::ParallelForSlots ran two ranges on one slot at once")
+    GUARANTEE_OR_DIE(rangeCount == (10000 + 15) / 16, "JobSystem::ParallelForSlots dropped ranges")
+}
+
+//----------------------------------------------------------------------------------------------------
+// A job that depends on a counter must not start before every job of that counter has finished,
+// including along a chain of dependencies.
+//
+static void ValidateDependencies(JobSystem& jobSystem)
+{
+    int constexpr    fanOutCount = 64;
+    std::atomic<int> finishedCount(0);
+    std::atomic<int> finishedWhenDependentRan(-1);
+
+    JobCounter fanOut;
+    JobCounter dependent;
+
+    for (int jobIndex = 0; jobIndex < fanOutCount; ++jobIndex)
+    {
+        jobSystem.Run([&finishedCount]()
+        {
+            std::this_thread::yield();
+            ++finishedCount;
+        }, &fanOut);
+    }
+
+    jobSystem.Run([&finishedCount, &finishedWhenDependentRan]() { finishedWhenDependentRan = finishedCount.load(); }, &dependent, &fanOut);
+    jobSystem.Wait(dependent);
+
+    GUARANTEE_OR_DIE(fanOut.IsDone() && finishedWhenDependentRan == fanOutCount, "JobSystem ran a job before its dependency finished")
+
+    int constexpr           chainLength = 100;
+    std::vector<JobCounter> chain(chainLength);
+    std::vector<int>        order;
+    order.reserve(chainLength);
+
+    for (int link = 0; link < chainLength; ++link)
+    {
+        jobSystem.Run([&order, link]() { order.push_back(link); }, &chain[link], link > 0 ? &chain[link - 1] : nullptr);
+    }
+
+    jobSystem.Wait(chain[chainLength - 1]);
+
+    bool isInOrder = static_cast<int>(order.size()) == chainLength;
+
+    for (int link = 0; isInOrder && link < chainLength; ++link)
+    {
+        isInOrder = order[link] == link;
+    }
+
+    GUARANTEE_OR_DIE(isInOrder, "JobSystem ran a dependency chain out of order")
+}
+
+//----------------------------------------------------------------------------------------------------
+// ParallelFor from inside jobs, and from a thread that is not a worker while the main thread runs
+// its own loop: waiting runs other jobs, so neither may deadlock or lose work.
+//
+static void ValidateNestingAndExternalThreads(JobSystem& jobSystem)
+{
+    std::atomic<int> nestedCount(0);
+
+    jobSystem.ParallelFor(16, 1, [&jobSystem, &nestedCount](int const begin, int const end)
+    {
+        for (int outer = begin; outer < end; ++outer)
+        {
+            jobSystem.ParallelFor(1000, 10, [&nestedCount](int const innerBegin, int const innerEnd) { nestedCount += innerEnd - innerBegin; });
+        }
+    });
+
+    GUARANTEE_OR_DIE(nestedCount == 16 * 1000, "JobSystem lost work in a nested ParallelFor")
+
+    std::atomic<int> externalCount(0);
+    std::atomic<int> mainCount(0);
+
+    std::thread externalThread([&jobSystem, &externalCount]()
+    {
+        for (int loop = 0; loop < 100; ++loop)
+        {
+            jobSystem.ParallelFor(1000, 50, [&externalCount](int const begin, int const end) { externalCount += end - begin; });
+        }
+    });
+
+    for (int loop = 0; loop < 100; ++loop)
+    {
+        jobSystem.ParallelFor(1000, 50, [&mainCount](int const begin, int const end) { mainCount += end - begin; });
+    }
+
+    externalThread.join();
+
+    GUARANTEE_OR_DIE(externalCount == 100 * 1000 && mainCount == 100 * 1000, "JobSystem lost work submitted from two threads at once")
+}
+
+//----------------------------------------------------------------------------------------------------
+static void FillEntityStore(EntityStore& out_entityStore, int const entityCount)
+{
+    RandomNumberGenerator rng;
+    out_entityStore.Reserve(entityCount);
+
+    for (int entityIndex = 0; entityIndex < entityCount; ++entityIndex)
+    {
+        Vec3 const        position(rng.RollRandomFloatInRange(-50.f, 200.f), rng.RollRandomFloatInRange(-100.f, 100.f), rng.RollRandomFloatInRange(-50.f, 50.f));
+        EulerAngles const orientation(rng.RollRandomFloatInRange(0.f, 360.f), rng.RollRandomFloatInRange(-90.f, 90.f), 0.f);
+        EulerAngles const angularVelocity(rng.RollRandomFloatInRange(-90.f, 90.f), rng.RollRandomFloatInRange(-90.f, 90.f), rng.RollRandomFloatInRange(-90.f, 90.f));
+
+        out_entityStore.CreateEntity(0, position, orientation, angularVelocity);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// The sweeps one simulation step and one frame run over every entity, on g_theJobSystem.
+//
+static int UpdateEntities(EntityStore& entityStore, std::vector<sBoundingSphere> const& localSpheres, sFrustum const& frustum)
+{
+    entityStore.UpdateOrientations(DELTA_SECONDS);
+    entityStore.UpdateModelToWorldTransforms();
+    entityStore.UpdateWorldBoundingSpheres(localSpheres);
+
+    return entityStore.CullAgainstFrustum(frustum);
+}
+
+//----------------------------------------------------------------------------------------------------
+// The parallel sweeps must produce exactly what the caller alone does, bit for bit.
+//
+static void ValidateEntityUpdates(JobSystem& jobSystem, std::vector<sBoundingSphere> const& localSpheres, sFrustum const& frustum)
+{
+    EntityStore serialStore;
+    FillEntityStore(serialStore, SCALING_ENTITY_COUNT);
+
+    EntityStore parallelStore = serialStore;
+
+    JobSystem* const previousJobSystem = g_theJobSystem;
+
+    g_theJobSystem               = nullptr;
+    int const serialVisibleCount = UpdateEntities(serialStore, localSpheres, frustum);
+
+    g_theJobSystem                 = &jobSystem;
+    int const parallelVisibleCount = UpdateEntities(parallelStore, localSpheres, frustum);
+
+    g_theJobSystem = previousJobSystem;
+
+    size_t const count        = static_cast<size_t>(SCALING_ENTITY_COUNT);
+    bool         isSameResult = serialVisibleCount == parallelVisibleCount;
+    isSameResult              = isSameResult && memcmp(serialStore.m_orientations.data(), parallelStore.m_orientations.data(), count * sizeof(EulerAngles)) == 0;
+    isSameResult              = isSameResult && memcmp(serialStore.m_modelToWorldTransforms.data(), parallelStore.m_modelToWorldTransforms.data(), count * sizeof(Mat44)) == 0;
+    isSameResult              = isSameResult && memcmp(serialStore.m_worldBoundingSpheres.data(), parallelStore.m_worldBoundingSpheres.data(), count * sizeof(sBoundingSphere)) == 0;
+    isSameResult              = isSameResult && memcmp(serialStore.m_isVisible.data(), parallelStore.m_isVisible.data(), count * sizeof(uint8_t)) == 0;
+
+    printf("JobSystem: %d of %d entities visible, serial and parallel sweeps match\n", parallelVisibleCount, SCALING_ENTITY_COUNT);
+    GUARANTEE_OR_DIE(isSameResult, "EntityStore sweeps on the JobSystem differ from the serial sweeps")
+}
+
+//----------------------------------------------------------------------------------------------------
+// Checks the scheduler, then times the per-frame entity sweeps over 100k entities with one thread
+// and then twice as many each round, up to the hardware's thread count.
+//
+void RunJobSystemBenchmarks()
+{
+    std::vector<sBoundingSphere> localSpheres(1);
+    localSpheres[0].m_radius = 1.f;
+
+    sFrustum const frustum = sFrustum::MakeFromWorldToClip(MakeBenchmarkWorldToClip());
+
+    {
+        sJobSystemConfig config;
+        config.m_workerCount = VALIDATION_WORKER_COUNT;
+
+        JobSystem jobSystem(config);
+
+        ValidateParallelFor(jobSystem);
+        ValidateDependencies(jobSystem);
+        ValidateNestingAndExternalThreads(jobSystem);
+        ValidateEntityUpdates(jobSystem, localSpheres, frustum);
+
+        sJobSystemStatistics const statistics = jobSystem.GetStatistics();
+        printf("JobSystem: validation ran %llu jobs, %llu of them stolen\n", static_cast<unsigned long long>(statistics.m_jobsRun), static_cast<unsigned long long>(statistics.m_jobsStolen));
+    }
+
+    EntityStore entityStore;
+    FillEntityStore(entityStore, SCALING_ENTITY_COUNT);
+
+    int const        hardwareThreadCount = static_cast<int>(std::thread::hardware_concurrency());
+    JobSystem* const previousJobSystem   = g_theJobSystem;
+    double           oneThreadSeconds    = 0.0;
+    double           twoThreadSeconds    = 0.0;
+
+    for (int threadCount = 1; threadCount == 1 || threadCount <= hardwareThreadCount; threadCount *= 2)
+    {
+        sJobSystemConfig config;
+        config.m_workerCount = threadCount - 1;
+
+        JobSystem jobSystem(config);
+        g_theJobSystem = &jobSystem;
+
+        sBenchmarkResult const result = RunBenchmark(Stringf("Entity sweeps x%d, %d thread(s)", SCALING_ENTITY_COUNT, threadCount), 100, SCALING_ENTITY_COUNT, [&entityStore, &localSpheres, &frustum]()
+        {
+            UpdateEntities(entityStore, localSpheres, frustum);
+        });
+
+        oneThreadSeconds = threadCount == 1 ? result.m_secondsPerIteration : oneThreadSeconds;
+        twoThreadSeconds = threadCount == 2 ? result.m_secondsPerIteration : twoThreadSeconds;
+
+        if (threadCount > 1 && result.m_secondsPerIteration > 0.0)
+        {
+            printf("JobSystem: %d threads %.2fx as fast as one\n", threadCount, oneThreadSeconds / result.m_secondsPerIteration);
+        }
+    }
+
+    g_theJobSystem = previousJobSystem;
+
+    // One core has nothing to spread the sweeps over
+    if (hardwareThreadCount >= 2)
+    {
+        GUARANTEE_OR_DIE(twoThreadSeconds < oneThreadSeconds * 0.85, "Entity sweeps did not scale to a second thread")
+    }
+}
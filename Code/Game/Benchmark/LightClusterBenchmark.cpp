@@ -0,0 +1,188 @@
+//----------------------------------------------------------------------------------------------------
+// LightClusterBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Game/Subsystem/Light/LightClusterGrid.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static float constexpr LIGHT_VIEWPORT_WIDTH  = 1600.f;
+static float constexpr LIGHT_VIEWPORT_HEIGHT = 800.f;
+
+//----------------------------------------------------------------------------------------------------
+// Point and spot lights scattered in and around the benchmark camera's view, one in four a spot.
+//
+static void MakeRandomLights(int const lightCount, std::vector<Light>& out_lights)
+{
+    RandomNumberGenerator rng;
+
+    out_lights.resize(static_cast<size_t>(lightCount));
+
+    for (Light& light : out_lights)
+    {
+        light.SetWorldPosition(Vec3(rng.RollRandomFloatInRange(-10.f, 110.f), rng.RollRandomFloatInRange(-60.f, 60.f), rng.RollRandomFloatInRange(-15.f, 15.f)))
+             .SetRadius(0.5f, rng.RollRandomFloatInRange(1.f, 8.f))
+             .SetColorWithIntensity(Vec4(1.f, 1.f, 1.f, 1.f));
+
+        if (rng.RollRandomIntInRange(0, 3) == 0)
+        {
+            Vec3 const direction = Vec3(rng.RollRandomFloatInRange(-1.f, 1.f), rng.RollRandomFloatInRange(-1.f, 1.f), rng.RollRandomFloatInRange(-1.f, -0.1f));
+
+            light.SetType(eLightType::SPOT)
+                 .SetDirection(direction.GetNormalized())
+                 .SetConeAngles(CosDegrees(10.f), CosDegrees(rng.RollRandomFloatInRange(15.f, 60.f)));
+        }
+        else
+        {
+            light.SetType(eLightType::POINT);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool IsSphereTouchingBox(Vec3 const& center, float const radius, Vec3 const& mins, Vec3 const& maxs)
+{
+    float const dx = fmaxf(fmaxf(mins.x - center.x, center.x - maxs.x), 0.f);
+    float const dy = fmaxf(fmaxf(mins.y - center.y, center.y - maxs.y), 0.f);
+    float const dz = fmaxf(fmaxf(mins.z - center.z, center.z - maxs.z), 0.f);
+
+    return dx * dx + dy * dy + dz * dz <= radius * radius;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Checks the binned lists against brute force:
+//   - every listed light touches its cluster's box, and lists are in ascending light order
+//   - for random points in view, every light whose sphere contains the point is in that point's cluster
+//
+static void ValidateLightClusters(LightClusterGrid const& grid)
+{
+    std::vector<sLightClusterRecord> const& records = grid.GetClusterRecords();
+    std::vector<uint32_t> const&            indexes = grid.GetLightIndexes();
+    std::vector<Vec3> const&                centers = grid.GetLightRenderCenters();
+    std::vector<float> const&               radii   = grid.GetLightRenderRadii();
+
+    for (int clusterIndex = 0; clusterIndex < grid.GetClusterCount(); ++clusterIndex)
+    {
+        Vec3 mins;
+        Vec3 maxs;
+        grid.GetClusterBounds(clusterIndex, mins, maxs);
+
+        sLightClusterRecord const& record = records[clusterIndex];
+        GUARANTEE_OR_DIE(record.m_firstIndex + record.m_lightCount <= indexes.size(), "Cluster record runs past the light index list")
+
+        for (uint32_t entry = record.m_firstIndex; entry < record.m_firstIndex + record.m_lightCount; ++entry)
+        {
+            uint32_t const lightIndex = indexes[entry];
+
+            GUARANTEE_OR_DIE(lightIndex < centers.size(), "Cluster lists a light that is not in the light buffer")
+            GUARANTEE_OR_DIE(entry == record.m_firstIndex || indexes[entry - 1] < lightIndex, "Cluster light list is not in ascending order")
+            GUARANTEE_OR_DIE(IsSphereTouchingBox(centers[lightIndex], radii[lightIndex], mins, maxs), "Cluster lists a light that does not touch it")
+        }
+    }
+
+    RandomNumberGenerator rng;
+    int                   sampleCount  = 0;
+    int                   checkedCount = 0;
+
+    while (sampleCount < 20000)
+    {
+        Vec3 const  point        = Vec3(rng.RollRandomFloatInRange(-60.f, 60.f), rng.RollRandomFloatInRange(-35.f, 35.f), rng.RollRandomFloatInRange(0.1f, 100.f));
+        int const   clusterIndex = grid.GetClusterIndexForRenderPosition(point);
+
+        if (clusterIndex < 0)
+        {
+            continue;
+        }
+
+        ++sampleCount;
+
+        sLightClusterRecord const& record = records[clusterIndex];
+
+        for (uint32_t lightIndex = 0; lightIndex < centers.size(); ++lightIndex)
+        {
+            Vec3 const offset = point - centers[lightIndex];
+
+            if (offset.x * offset.x + offset.y * offset.y + offset.z * offset.z > radii[lightIndex] * radii[lightIndex])
+            {
+                continue;
+            }
+
+            bool isListed = false;
+
+            for (uint32_t entry = record.m_firstIndex; entry < record.m_firstIndex + record.m_lightCount && !isListed; ++entry)
+            {
+                isListed = indexes[entry] == lightIndex;
+            }
+
+            GUARANTEE_OR_DIE(isListed, "A light reaching a point is missing from that point's cluster")
+            ++checkedCount;
+        }
+    }
+
+    GUARANTEE_OR_DIE(checkedCount > 0, "Light cluster test scene should have lit sample points")
+}
+
+//----------------------------------------------------------------------------------------------------
+// Validates one and several binning workers against brute force and each other, then times
+// LightClusterGrid::Update for each scene size.
+//
+void RunLightClusterBenchmarks()
+{
+    Mat44 worldToRender;
+    Mat44 renderToClip;
+    MakeBenchmarkCameraTransforms(worldToRender, renderToClip);
+
+    sLightClusterGridConfig singleWorkerConfig;
+    singleWorkerConfig.m_workerCount = 1;
+
+    LightClusterGrid singleWorkerGrid(singleWorkerConfig);
+    LightClusterGrid multiWorkerGrid;
+
+    int const lightCounts[] = { 256, 1024, 4096 };
+
+    for (int const lightCount : lightCounts)
+    {
+        std::vector<Light> lights;
+        MakeRandomLights(lightCount, lights);
+
+        singleWorkerGrid.Update(worldToRender, renderToClip, LIGHT_VIEWPORT_WIDTH, LIGHT_VIEWPORT_HEIGHT, lights.data(), lightCount);
+        multiWorkerGrid.Update(worldToRender, renderToClip, LIGHT_VIEWPORT_WIDTH, LIGHT_VIEWPORT_HEIGHT, lights.data(), lightCount);
+
+        ValidateLightClusters(singleWorkerGrid);
+
+        std::vector<sLightClusterRecord> const& singleRecords = singleWorkerGrid.GetClusterRecords();
+        std::vector<sLightClusterRecord> const& multiRecords  = multiWorkerGrid.GetClusterRecords();
+
+        for (size_t clusterIndex = 0; clusterIndex < singleRecords.size(); ++clusterIndex)
+        {
+            GUARANTEE_OR_DIE(singleRecords[clusterIndex].m_firstIndex == multiRecords[clusterIndex].m_firstIndex &&
+                             singleRecords[clusterIndex].m_lightCount == multiRecords[clusterIndex].m_lightCount, "Parallel light binning does not match single-threaded binning")
+        }
+
+        GUARANTEE_OR_DIE(singleWorkerGrid.GetLightIndexes() == multiWorkerGrid.GetLightIndexes(), "Parallel light binning does not match single-threaded binning")
+
+        int const   inViewCount       = static_cast<int>(singleWorkerGrid.GetLightBuffer().size());
+        float const lightsPerCluster  = static_cast<float>(singleWorkerGrid.GetTotalLightAssignments()) / static_cast<float>(singleWorkerGrid.GetClusterCount());
+
+        printf("LightClusterGrid: %d of %d lights in view, %d assignments, %.2f lights per cluster\n", inViewCount, lightCount, singleWorkerGrid.GetTotalLightAssignments(), static_cast<double>(lightsPerCluster));
+
+        RunBenchmark(Stringf("LightClusterGrid::Update 1 worker x%d lights", lightCount), 100, lightCount, [&]()
+        {
+            singleWorkerGrid.Update(worldToRender, renderToClip, LIGHT_VIEWPORT_WIDTH, LIGHT_VIEWPORT_HEIGHT, lights.data(), lightCount);
+        });
+
+        RunBenchmark(Stringf("LightClusterGrid::Update %d workers x%d lights", sLightClusterGridConfig().m_workerCount, lightCount), 100, lightCount, [&]()
+        {
+            multiWorkerGrid.Update(worldToRender, renderToClip, LIGHT_VIEWPORT_WIDTH, LIGHT_VIEWPORT_HEIGHT, lights.data(), lightCount);
+        });
+    }
+}
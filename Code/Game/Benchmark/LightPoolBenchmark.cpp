@@ -0,0 +1,174 @@
+//----------------------------------------------------------------------------------------------------
+// LightPoolBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Game/Subsystem/Light/LightPool.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr LIVE_LIGHT_COUNT         = 1000;
+static int constexpr LIGHTS_SPAWNED_PER_FRAME = 100;
+
+//----------------------------------------------------------------------------------------------------
+static Light MakeTaggedLight(float const tag)
+{
+    Light light;
+    light.SetType(eLightType::POINT)
+         .SetWorldPosition(Vec3(tag, 0.f, 0.f))
+         .SetRadius(0.5f, 4.f);
+
+    return light;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Random adds and removes against a list of what should be alive: every live handle must resolve
+// to its own light, every removed handle to nothing, and the packed range must hold exactly the
+// live lights.
+//
+static void ValidateLightPool()
+{
+    RandomNumberGenerator    rng;
+    LightPool                pool;
+    std::vector<LightHandle> liveHandles;
+    std::vector<float>       liveTags;
+    std::vector<LightHandle> removedHandles;
+
+    for (int step = 0; step < 20000; ++step)
+    {
+        if (liveHandles.empty() || rng.RollRandomIntInRange(0, 2) != 0)
+        {
+            float const tag = static_cast<float>(step);
+            liveHandles.push_back(pool.AddLight(MakeTaggedLight(tag)));
+            liveTags.push_back(tag);
+        }
+        else
+        {
+            int const victim = rng.RollRandomIntInRange(0, static_cast<int>(liveHandles.size()) - 1);
+
+            pool.RemoveLight(liveHandles[victim]);
+            removedHandles.push_back(liveHandles[victim]);
+
+            liveHandles[victim] = liveHandles.back();
+            liveTags[victim]    = liveTags.back();
+            liveHandles.pop_back();
+            liveTags.pop_back();
+        }
+
+        if (step % 1000 == 999)
+        {
+            if (!removedHandles.empty())
+            {
+                pool.RemoveLight(removedHandles.back());    // Removing twice must be a no-op
+            }
+
+            pool.Clear();
+            removedHandles.insert(removedHandles.end(), liveHandles.begin(), liveHandles.end());
+            liveHandles.clear();
+            liveTags.clear();
+        }
+    }
+
+    GUARANTEE_OR_DIE(pool.GetCount() == static_cast<int>(liveHandles.size()), "LightPool count does not match the live lights")
+
+    std::vector<float> packedTags;
+
+    for (int lightIndex = 0; lightIndex < pool.GetCount(); ++lightIndex)
+    {
+        packedTags.push_back(pool.GetLights()[lightIndex].m_worldPosition.x);
+    }
+
+    for (size_t liveIndex = 0; liveIndex < liveHandles.size(); ++liveIndex)
+    {
+        Light const* light = pool.GetLight(liveHandles[liveIndex]);
+        GUARANTEE_OR_DIE(light != nullptr && light->m_worldPosition.x == liveTags[liveIndex], "A live LightHandle does not resolve to its light")
+    }
+
+    for (LightHandle const& handle : removedHandles)
+    {
+        GUARANTEE_OR_DIE(!pool.IsAlive(handle) && pool.GetLight(handle) == nullptr, "A removed LightHandle still resolves")
+    }
+
+    std::sort(packedTags.begin(), packedTags.end());
+    std::sort(liveTags.begin(), liveTags.end());
+    GUARANTEE_OR_DIE(packedTags == liveTags, "LightPool packed range does not hold exactly the live lights")
+}
+
+//----------------------------------------------------------------------------------------------------
+// Short-lived light churn at a steady LIVE_LIGHT_COUNT: each frame retires the oldest
+// LIGHTS_SPAWNED_PER_FRAME lights, spawns as many, and gathers the lights for upload.
+// Compares heap lights in a std::vector<Light*> (find, erase, delete) with the LightPool.
+//
+void RunLightPoolBenchmarks()
+{
+    ValidateLightPool();
+
+    std::vector<Light> uploadBuffer(LIVE_LIGHT_COUNT);
+
+    {
+        std::vector<Light*> lights;
+        std::vector<Light*> spawnOrder;
+        int                 spawnCount = 0;
+
+        for (; spawnCount < LIVE_LIGHT_COUNT; ++spawnCount)
+        {
+            lights.push_back(new Light(MakeTaggedLight(static_cast<float>(spawnCount))));
+            spawnOrder.push_back(lights.back());
+        }
+
+        RunBenchmark(Stringf("std::vector<Light*> churn %d of %d lights", LIGHTS_SPAWNED_PER_FRAME, LIVE_LIGHT_COUNT), 1000, LIGHTS_SPAWNED_PER_FRAME, [&]()
+        {
+            for (int spawnIndex = 0; spawnIndex < LIGHTS_SPAWNED_PER_FRAME; ++spawnIndex, ++spawnCount)
+            {
+                Light* const expired = spawnOrder[spawnCount % LIVE_LIGHT_COUNT];
+
+                lights.erase(std::find(lights.begin(), lights.end(), expired));
+                delete expired;
+
+                lights.push_back(new Light(MakeTaggedLight(static_cast<float>(spawnCount))));
+                spawnOrder[spawnCount % LIVE_LIGHT_COUNT] = lights.back();
+            }
+
+            for (size_t lightIndex = 0; lightIndex < lights.size(); ++lightIndex)
+            {
+                uploadBuffer[lightIndex] = *lights[lightIndex];
+            }
+        });
+
+        for (Light* light : lights)
+        {
+            delete light;
+        }
+    }
+
+    {
+        LightPool                pool;
+        std::vector<LightHandle> spawnOrder;
+        int                      spawnCount = 0;
+
+        pool.Reserve(LIVE_LIGHT_COUNT);
+
+        for (; spawnCount < LIVE_LIGHT_COUNT; ++spawnCount)
+        {
+            spawnOrder.push_back(pool.AddLight(MakeTaggedLight(static_cast<float>(spawnCount))));
+        }
+
+        RunBenchmark(Stringf("LightPool churn %d of %d lights", LIGHTS_SPAWNED_PER_FRAME, LIVE_LIGHT_COUNT), 1000, LIGHTS_SPAWNED_PER_FRAME, [&]()
+        {
+            for (int spawnIndex = 0; spawnIndex < LIGHTS_SPAWNED_PER_FRAME; ++spawnIndex, ++spawnCount)
+            {
+                pool.RemoveLight(spawnOrder[spawnCount % LIVE_LIGHT_COUNT]);
+                spawnOrder[spawnCount % LIVE_LIGHT_COUNT] = pool.AddLight(MakeTaggedLight(static_cast<float>(spawnCount)));
+            }
+
+            // The packed range is the upload; there is nothing to gather
+            GUARANTEE_OR_DIE(pool.GetCount() == LIVE_LIGHT_COUNT, "LightPool churn changed the live light count")
+        });
+    }
+}
@@ -0,0 +1,200 @@
+//----------------------------------------------------------------------------------------------------
+// LightSelectorBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <cstdio>
+#include <vector>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Game/Subsystem/Light/LightBounds.hpp"
+#include "Game/Subsystem/Light/LightSubsystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr SELECTOR_LIGHT_COUNT  = 2000;
+static int constexpr SELECTOR_OBJECT_COUNT = 5000;
+
+//----------------------------------------------------------------------------------------------------
+// One sun plus point and spot lights over a 200 x 200 m area, one in four a spot.
+//
+static void MakeSelectorLights(std::vector<Light>& out_lights)
+{
+    RandomNumberGenerator rng;
+
+    Light sun;
+    sun.SetType(eLightType::DIRECTIONAL)
+       .SetColorWithIntensity(Vec4(1.f, 1.f, 1.f, 0.5f))
+       .SetDirection(Vec3(2.f, 1.f, -1.f).GetNormalized());
+    out_lights.push_back(sun);
+
+    for (int lightIndex = 1; lightIndex < SELECTOR_LIGHT_COUNT; ++lightIndex)
+    {
+        Light light;
+        light.SetWorldPosition(Vec3(rng.RollRandomFloatInRange(-100.f, 100.f), rng.RollRandomFloatInRange(-100.f, 100.f), rng.RollRandomFloatInRange(0.f, 10.f)))
+             .SetRadius(0.5f, rng.RollRandomFloatInRange(2.f, 12.f))
+             .SetColorWithIntensity(Vec4(1.f, 1.f, 1.f, rng.RollRandomFloatInRange(1.f, 8.f)));
+
+        if (rng.RollRandomIntInRange(0, 3) == 0)
+        {
+            light.SetType(eLightType::SPOT)
+                 .SetDirection(Vec3(rng.RollRandomFloatInRange(-1.f, 1.f), rng.RollRandomFloatInRange(-1.f, 1.f), -1.f).GetNormalized())
+                 .SetConeAngles(CosDegrees(10.f), CosDegrees(rng.RollRandomFloatInRange(15.f, 50.f)));
+        }
+        else
+        {
+            light.SetType(eLightType::POINT);
+        }
+
+        out_lights.push_back(light);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Object bounds laid out row by row, the way a spatially sorted draw list visits them.
+//
+static void MakeSelectorObjects(std::vector<sBoundingSphere>& out_objects)
+{
+    RandomNumberGenerator rng;
+    int constexpr         rowLength = 100;
+
+    for (int objectIndex = 0; objectIndex < SELECTOR_OBJECT_COUNT; ++objectIndex)
+    {
+        sBoundingSphere object;
+        object.m_center = Vec3(-100.f + 2.f * static_cast<float>(objectIndex % rowLength), -100.f + 4.f * static_cast<float>(objectIndex / rowLength), 0.f);
+        object.m_radius = rng.RollRandomFloatInRange(0.5f, 1.5f);
+        out_objects.push_back(object);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Brute force over every light, with the same order as LightSelector: influence descending, then
+// light index ascending.
+//
+static sLightSelection SelectLightsBruteForce(std::vector<Light> const& lights, sBoundingSphere const& bounds, int const maxLights)
+{
+    sLightSelection selection;
+    float           influences[MAX_LIGHTS];
+
+    for (int lightIndex = 0; lightIndex < static_cast<int>(lights.size()); ++lightIndex)
+    {
+        float const influence = GetLightInfluence(lights[lightIndex], bounds);
+
+        if (influence <= 0.f)
+        {
+            continue;
+        }
+
+        int slot = selection.m_lightCount < maxLights ? selection.m_lightCount++ : maxLights;
+
+        while (slot > 0 && influence > influences[slot - 1])
+        {
+            if (slot < maxLights)
+            {
+                influences[slot]               = influences[slot - 1];
+                selection.m_lightIndexes[slot] = selection.m_lightIndexes[slot - 1];
+            }
+
+            --slot;
+        }
+
+        if (slot < maxLights)
+        {
+            influences[slot]               = influence;
+            selection.m_lightIndexes[slot] = lightIndex;
+        }
+    }
+
+    return selection;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Checks LightSelector against brute force, times per-object selection against scoring every light
+// for every object, then counts the light constant uploads per-draw selection causes.
+//
+void RunLightSelectorBenchmarks()
+{
+    std::vector<Light>           lights;
+    std::vector<sBoundingSphere> objects;
+    MakeSelectorLights(lights);
+    MakeSelectorObjects(objects);
+
+    LightSelector selector;
+    selector.Build(lights.data(), SELECTOR_LIGHT_COUNT);
+
+    int selectedTotal  = 0;
+    int evaluatedTotal = 0;
+
+    for (sBoundingSphere const& object : objects)
+    {
+        sLightSelection selection;
+        evaluatedTotal += selector.SelectLights(object, MAX_LIGHTS, selection);
+        selectedTotal  += selection.m_lightCount;
+
+        GUARANTEE_OR_DIE(selection == SelectLightsBruteForce(lights, object, MAX_LIGHTS), "LightSelector does not match brute-force light selection")
+    }
+
+    printf("LightSelector: %d lights, %.1f scored and %.1f selected per object (of at most %d)\n", SELECTOR_LIGHT_COUNT,
+           static_cast<double>(evaluatedTotal) / SELECTOR_OBJECT_COUNT, static_cast<double>(selectedTotal) / SELECTOR_OBJECT_COUNT, MAX_LIGHTS);
+
+    float influenceSum = 0.f;
+
+    RunBenchmark(Stringf("Score every light per object x%d objects", SELECTOR_OBJECT_COUNT), 10, SELECTOR_OBJECT_COUNT, [&]()
+    {
+        for (sBoundingSphere const& object : objects)
+        {
+            for (Light const& light : lights)
+            {
+                influenceSum += GetLightInfluence(light, object);
+            }
+        }
+    });
+
+    RunBenchmark(Stringf("LightSelector::SelectLights x%d objects", SELECTOR_OBJECT_COUNT), 100, SELECTOR_OBJECT_COUNT, [&]()
+    {
+        sLightSelection selection;
+
+        for (sBoundingSphere const& object : objects)
+        {
+            selector.SelectLights(object, MAX_LIGHTS, selection);
+            influenceSum += static_cast<float>(selection.m_lightCount);
+        }
+    });
+
+    GUARANTEE_OR_DIE(influenceSum > 0.f, "Light selection test scene should light something")
+
+    // Through the LightSubsystem, so uploads go to g_theRenderBackend and are dirty-tracked
+    LightSubsystem lightSubsystem;
+    lightSubsystem.StartUp();
+    lightSubsystem.ClearLights();
+
+    for (Light const& light : lights)
+    {
+        lightSubsystem.AddLight(light);
+    }
+
+    for (int frameIndex = 0; frameIndex < 2; ++frameIndex)
+    {
+        lightSubsystem.BeginFrame();
+
+        for (sBoundingSphere const& object : objects)
+        {
+            lightSubsystem.BindLightsForBounds(object);
+        }
+
+        sLightStatistics const& statistics = lightSubsystem.GetFrameStatistics();
+        size_t const            naiveBytes = sizeof(Light) * MAX_LIGHTS * (SELECTOR_OBJECT_COUNT + 1);
+
+        printf("LightSubsystem frame %d: %d lights evaluated, %d uploads, %d skipped, %u bytes uploaded (%u if every draw uploaded)\n", frameIndex,
+               statistics.m_lightsEvaluated, statistics.m_lightSetUploads, statistics.m_lightSetUploadsSkipped,
+               static_cast<unsigned int>(statistics.m_lightBytesUploaded), static_cast<unsigned int>(naiveBytes));
+
+        GUARANTEE_OR_DIE(statistics.m_lightSetUploads + statistics.m_lightSetUploadsSkipped == SELECTOR_OBJECT_COUNT + 1, "Every bind should either upload or be skipped")
+        GUARANTEE_OR_DIE(statistics.m_lightSetUploadsSkipped > 0, "Neighboring objects should share light sets")
+    }
+
+    lightSubsystem.ShutDown();
+}
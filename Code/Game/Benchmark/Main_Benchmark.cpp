@@ -0,0 +1,47 @@
+//----------------------------------------------------------------------------------------------------
+// Main_Benchmark.cpp
+//
+// Entry point of the benchmark build for non-Windows platforms. The first argument names the suite
+// to run ("all" when none is given), e.g. "Protogame3D_Benchmark hotpaths benchmarkjson=Hot.json";
+// any "name=value" tokens are passed through to the App unchanged. Run it from Run/, like the game.
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#if !defined(_WIN32)
+#include <cstring>
+#include <string>
+
+#include "Game/Framework/App.hpp"
+#include "Game/Framework/GameCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+int main(int const argc, char* argv[])
+{
+    std::string commandLine = "headless";
+    std::string suiteName   = "all";
+
+    for (int argIndex = 1; argIndex < argc; ++argIndex)
+    {
+        if (argIndex == 1 && std::strchr(argv[argIndex], '=') == nullptr)
+        {
+            suiteName = argv[argIndex];
+            continue;
+        }
+
+        commandLine += " ";
+        commandLine += argv[argIndex];
+    }
+
+    commandLine += " benchmark=" + suiteName;
+
+    g_theApp = new App();
+    g_theApp->Startup(commandLine.c_str());
+    g_theApp->RunMainLoop();
+    g_theApp->Shutdown();
+
+    delete g_theApp;
+    g_theApp = nullptr;
+
+    return 0;
+}
+#endif
@@ -0,0 +1,100 @@
+//----------------------------------------------------------------------------------------------------
+// MeshBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <cstdio>
+#include <vector>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Game/Math/IndexedMeshUtils.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Prints vertex count and bytes for the flat list, the indexed generator, and the welded flat list.
+// Memory counts vertex bytes plus 32-bit index bytes, which is what Prop uploads.
+//
+static void PrintMeshReduction(char const* primitiveName, std::vector<Vertex_PCU> const& flatVerts, std::vector<Vertex_PCU> const& indexedVerts, std::vector<unsigned int> const& indexedIndexes)
+{
+    std::vector<Vertex_PCU>   weldedVerts;
+    std::vector<unsigned int> weldedIndexes;
+    WeldVertexes(flatVerts, weldedVerts, weldedIndexes);
+
+    GUARANTEE_OR_DIE(indexedIndexes.size() == flatVerts.size(), "Indexed generator emits a different triangle count than the flat one")
+    GUARANTEE_OR_DIE(weldedIndexes.size() == flatVerts.size(), "WeldVertexes changed the triangle count")
+
+    size_t const flatBytes    = flatVerts.size() * sizeof(Vertex_PCU);
+    size_t const indexedBytes = indexedVerts.size() * sizeof(Vertex_PCU) + indexedIndexes.size() * sizeof(unsigned int);
+    size_t const weldedBytes  = weldedVerts.size() * sizeof(Vertex_PCU) + weldedIndexes.size() * sizeof(unsigned int);
+
+    String const line = Stringf("%-10s flat %6d verts %8d B | indexed %6d verts %8d B (%5.1f%%) | welded %6d verts %8d B (%5.1f%%)\n",
+                                primitiveName,
+                                static_cast<int>(flatVerts.size()), static_cast<int>(flatBytes),
+                                static_cast<int>(indexedVerts.size()), static_cast<int>(indexedBytes), 100.0 * static_cast<double>(indexedBytes) / static_cast<double>(flatBytes),
+                                static_cast<int>(weldedVerts.size()), static_cast<int>(weldedBytes), 100.0 * static_cast<double>(weldedBytes) / static_cast<double>(flatBytes));
+
+    DebuggerPrintf("%s", line.c_str());
+    printf("%s", line.c_str());
+}
+
+//----------------------------------------------------------------------------------------------------
+// Compares the flat VertexUtils generators to the indexed ones for each primitive Prop builds,
+// then times building the indexed sphere and welding the flat one.
+//
+void RunMeshBenchmarks()
+{
+    Vec3 const  bottomLeft(0.f, -0.5f, -0.5f);
+    Vec3 const  bottomRight(0.f, 0.5f, -0.5f);
+    Vec3 const  topLeft(0.f, -0.5f, 0.5f);
+    Vec3 const  topRight(0.f, 0.5f, 0.5f);
+    AABB3 const box(Vec3(-0.5f, -0.5f, -0.5f), Vec3(0.5f, 0.5f, 0.5f));
+    Vec3 const  sphereCenter(0.f, 0.f, 0.f);
+
+    {
+        std::vector<Vertex_PCU>   flatVerts;
+        std::vector<Vertex_PCU>   indexedVerts;
+        std::vector<unsigned int> indexedIndexes;
+        AddVertsForQuad3D(flatVerts, bottomLeft, bottomRight, topLeft, topRight);
+        AddVertsForIndexedQuad3D(indexedVerts, indexedIndexes, bottomLeft, bottomRight, topLeft, topRight);
+        PrintMeshReduction("Quad3D", flatVerts, indexedVerts, indexedIndexes);
+    }
+
+    {
+        std::vector<Vertex_PCU>   flatVerts;
+        std::vector<Vertex_PCU>   indexedVerts;
+        std::vector<unsigned int> indexedIndexes;
+        AddVertsForAABB3D(flatVerts, box);
+        AddVertsForIndexedAABB3D(indexedVerts, indexedIndexes, box);
+        PrintMeshReduction("AABB3D", flatVerts, indexedVerts, indexedIndexes);
+    }
+
+    std::vector<Vertex_PCU> flatSphereVerts;
+    AddVertsForSphere3D(flatSphereVerts, sphereCenter, 0.5f, Rgba8::WHITE, AABB2::ZERO_TO_ONE, 32, 16);
+
+    {
+        std::vector<Vertex_PCU>   indexedVerts;
+        std::vector<unsigned int> indexedIndexes;
+        AddVertsForIndexedSphere3D(indexedVerts, indexedIndexes, sphereCenter, 0.5f, Rgba8::WHITE, AABB2::ZERO_TO_ONE, 32, 16);
+        PrintMeshReduction("Sphere3D", flatSphereVerts, indexedVerts, indexedIndexes);
+    }
+
+    std::vector<Vertex_PCU>     indexedVerts;
+    std::vector<unsigned short> indexedIndexes;
+
+    RunBenchmark("AddVertsForIndexedSphere3D 32x16 (uint16)", 10000, 1, [&]()
+    {
+        indexedVerts.clear();
+        indexedIndexes.clear();
+        AddVertsForIndexedSphere3D(indexedVerts, indexedIndexes, sphereCenter, 0.5f, Rgba8::WHITE, AABB2::ZERO_TO_ONE, 32, 16);
+    });
+
+    RunBenchmark("WeldVertexes flat sphere 32x16 (uint16)", 1000, static_cast<int>(flatSphereVerts.size()), [&]()
+    {
+        indexedVerts.clear();
+        indexedIndexes.clear();
+        WeldVertexes(flatSphereVerts, indexedVerts, indexedIndexes);
+    });
+}
@@ -0,0 +1,227 @@
+//----------------------------------------------------------------------------------------------------
+// ModelStreamingBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Subsystem/Resource/ObjMeshParser.hpp"
+#include "Game/Subsystem/Resource/GameResourceLoader.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr    STREAMED_MODEL_COUNT = 200;
+static int constexpr    SPHERE_SLICES        = 48;
+static int constexpr    SPHERE_STACKS        = 24;
+static double constexpr FRAME_BUDGET_SECONDS = 1.0 / 60.0;
+static double constexpr MAX_STREAM_SECONDS   = 60.0;       // Gives up on a load that never finishes
+
+//----------------------------------------------------------------------------------------------------
+static String GetStreamedModelPath(int const modelIndex)
+{
+    return Stringf("ModelStreamingBenchmark_%03d.obj", modelIndex);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Every corner form and negative indexes, with the exact vertexes and triangles they must give,
+// then records the parser must reject.
+//
+static void ValidateObjMeshParser()
+{
+    char constexpr text[] =
+        "# quad, then a relative-index triangle, then a triangle with normals but no uvs\n"
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+        "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+        "vn 0 0 1\n"
+        "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+        "f -4/-4 -2/-2 -1/-1\n"
+        "f 1//1 2//1 3//1\r\n"
+        "g ignored\n";
+
+    unsigned int const expectedIndexes[] = { 0, 1, 2, 0, 2, 3, 0, 2, 3, 4, 5, 6 };
+
+    sMeshData mesh;
+    String    error;
+    bool      isParsed = ParseObjMesh(text, sizeof(text) - 1, mesh, &error);
+
+    isParsed = isParsed && mesh.m_vertexes.size() == 7 && mesh.m_indexes.size() == 12;
+
+    for (int index = 0; isParsed && index < 12; ++index)
+    {
+        isParsed = mesh.m_indexes[index] == expectedIndexes[index];
+    }
+
+    isParsed = isParsed && mesh.m_vertexes[2].m_uvTexCoords.x == 1.f && mesh.m_vertexes[2].m_uvTexCoords.y == 1.f;
+    isParsed = isParsed && mesh.m_vertexes[4].m_uvTexCoords.x == 0.f && mesh.m_vertexes[6].m_position.y == 1.f;
+
+    GUARANTEE_OR_DIE(isParsed, "ParseObjMesh built the wrong mesh from a known OBJ")
+
+    char const* const malformedTexts[] = { "v 0 0 0\nv 1 0 0\nf 1 2\n", "v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 4\n", "v 0 x 0\n", "v 0 0 0\nf 0 1 1\n", "v 0 0 0\nvt 0 0\nf 1/2 1/1 1/1\n" };
+
+    for (char const* malformedText : malformedTexts)
+    {
+        GUARANTEE_OR_DIE(!ParseObjMesh(malformedText, strlen(malformedText), mesh, &error), "ParseObjMesh accepted a malformed OBJ")
+    }
+
+    // A length that stops mid-file must not read past it
+    char constexpr cutText[] = "v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 3\nf 1 2 3 4\n";
+    GUARANTEE_OR_DIE(ParseObjMesh(cutText, 32, mesh, &error) && mesh.m_indexes.size() == 3, "ParseObjMesh read past the given length")
+}
+
+//----------------------------------------------------------------------------------------------------
+// Requests every model in one frame, then runs frames that publish what has finished and sleep for
+// the rest of the frame, until every model is in. Returns the longest main-thread stall of a frame.
+//
+static double StreamModels(GameResourceLoader& resourceLoader, int& out_frameCount, int& out_readyCount)
+{
+    std::vector<ModelHandle> handles(STREAMED_MODEL_COUNT);
+    out_readyCount = 0;
+
+    double const startSeconds = GetCurrentTimeSeconds();
+    int          failedCount  = 0;
+    auto const   onReady      = [&out_readyCount, &failedCount](ModelHandle handle, eModelState const state)
+    {
+        UNUSED(handle)
+        out_readyCount += state == eModelState::READY ? 1 : 0;
+        failedCount    += state == eModelState::FAILED ? 1 : 0;
+    };
+
+    for (int modelIndex = 0; modelIndex < STREAMED_MODEL_COUNT; ++modelIndex)
+    {
+        handles[modelIndex] = resourceLoader.RequestModel(GetStreamedModelPath(modelIndex), onReady);
+    }
+
+    double const requestSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+    // Whatever is still loading draws the shared placeholder
+    int const placeholderStaticMeshId = resourceLoader.GetPlaceholderStaticMeshId();
+
+    for (ModelHandle const handle : handles)
+    {
+        GUARANTEE_OR_DIE(resourceLoader.GetModelState(handle) != eModelState::LOADING || resourceLoader.GetModelStaticMeshId(handle) == placeholderStaticMeshId, "A loading model did not resolve to the placeholder")
+    }
+
+    double maxFrameSeconds = requestSeconds;
+    out_frameCount         = 0;
+
+    while (resourceLoader.GetLoadingModelCount() > 0)
+    {
+        GUARANTEE_OR_DIE(GetCurrentTimeSeconds() - startSeconds < MAX_STREAM_SECONDS, "ModelStreamer never finished loading")
+
+        double const frameStartSeconds = GetCurrentTimeSeconds();
+        resourceLoader.PublishFinishedModels();
+        double const frameSeconds = GetCurrentTimeSeconds() - frameStartSeconds;
+
+        maxFrameSeconds = frameSeconds > maxFrameSeconds ? frameSeconds : maxFrameSeconds;
+        ++out_frameCount;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));      // The rest of the frame
+    }
+
+    GUARANTEE_OR_DIE(failedCount == 0, "ModelStreamer failed to load a model")
+
+    for (ModelHandle const handle : handles)
+    {
+        sBoundingSphere const& sphere = resourceLoader.GetModelLocalBoundingSphere(handle);
+
+        GUARANTEE_OR_DIE(resourceLoader.GetModelState(handle) == eModelState::READY && resourceLoader.GetModelStaticMeshId(handle) != placeholderStaticMeshId, "A published model still draws the placeholder")
+        GUARANTEE_OR_DIE(fabsf(sphere.m_radius - 1.f) < 0.001f, "A streamed model has the wrong bounds")
+    }
+
+    return maxFrameSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Checks the OBJ parser, then loads a batch of sphere models: once the way a blocking load would,
+// all on the main thread in one frame, and once streamed, where no frame's main-thread share may
+// go over the 16 ms frame budget.
+//
+void RunModelStreamingBenchmarks()
+{
+    ValidateObjMeshParser();
+
+    String const sphereText = MakeBenchmarkSphereObjText(SPHERE_SLICES, SPHERE_STACKS);
+
+    for (int modelIndex = 0; modelIndex < STREAMED_MODEL_COUNT; ++modelIndex)
+    {
+        GUARANTEE_OR_DIE(WriteBenchmarkTextFile(GetStreamedModelPath(modelIndex), sphereText), "Could not write the benchmark's OBJ files")
+    }
+
+    sMeshData sphereMesh;
+
+    RunBenchmark(Stringf("ParseObjMesh sphere %dx%d (%d KB)", SPHERE_SLICES, SPHERE_STACKS, static_cast<int>(sphereText.size() / 1024)), 50, 1, [&sphereText, &sphereMesh]()
+    {
+        ParseObjMesh(sphereText.data(), sphereText.size(), sphereMesh);
+    });
+
+    GUARANTEE_OR_DIE(sphereMesh.m_indexes.size() == static_cast<size_t>(SPHERE_SLICES * SPHERE_STACKS * 6), "ParseObjMesh lost faces of the sphere")
+
+    // With no job system the GameResourceLoader runs each decode inside RequestModel, and with no
+    // budget it publishes everything at once: a blocking load
+    JobSystem* const jobSystem       = g_theJobSystem;
+    double           blockingSeconds = 0.0;
+    g_theJobSystem                   = nullptr;
+
+    {
+        sGameResourceLoaderConfig blockingConfig;
+        blockingConfig.m_modelStreamerConfig.m_publishBudgetSeconds = 1000.0;
+
+        GameResourceLoader blockingResourceLoader(blockingConfig);
+        blockingResourceLoader.Startup();
+        double const startSeconds = GetCurrentTimeSeconds();
+
+        for (int modelIndex = 0; modelIndex < STREAMED_MODEL_COUNT; ++modelIndex)
+        {
+            blockingResourceLoader.RequestModel(GetStreamedModelPath(modelIndex));
+        }
+
+        blockingResourceLoader.PublishFinishedModels();
+        blockingSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+        GUARANTEE_OR_DIE(blockingResourceLoader.GetLoadingModelCount() == 0, "A blocking load left models loading")
+        blockingResourceLoader.Shutdown();
+    }
+
+    g_theJobSystem = jobSystem;
+
+    if (jobSystem != nullptr)
+    {
+        sGameResourceLoaderConfig const resourceLoaderConfig;
+        GameResourceLoader              resourceLoader(resourceLoaderConfig);
+        resourceLoader.Startup();
+
+        int          frameCount      = 0;
+        int          readyCount      = 0;
+        double const streamedSeconds = StreamModels(resourceLoader, frameCount, readyCount);
+
+        sModelStreamerStatistics const      statistics     = resourceLoader.GetModelStreamerStatistics();
+        sGameResourceLoaderStatistics const loadStatistics = resourceLoader.GetStatistics();
+        printf("ModelStreamer: %d models over %d frames, worst frame %.3f ms on the main thread (%.3f ms publishing), blocking load %.3f ms\n", readyCount, frameCount, streamedSeconds * 1000.0, statistics.m_maxPublishSeconds * 1000.0, blockingSeconds * 1000.0);
+        printf("GameResourceLoader: %d loads queued, at most %d loader jobs at once\n", loadStatistics.m_queuedCount, loadStatistics.m_maxInFlightCount);
+
+        GUARANTEE_OR_DIE(readyCount == STREAMED_MODEL_COUNT, "ModelStreamer did not call back for every model")
+        GUARANTEE_OR_DIE(loadStatistics.m_queuedCount == STREAMED_MODEL_COUNT, "A model decode did not go through the GameResourceLoader")
+        GUARANTEE_OR_DIE(loadStatistics.m_maxInFlightCount >= 1 && loadStatistics.m_maxInFlightCount <= resourceLoaderConfig.m_maxLoadsInFlight, "The GameResourceLoader ran more loader jobs than its limit")
+
+        // On one core the decoding workers preempt the main thread, and a time slice is about a frame
+        if (std::thread::hardware_concurrency() >= 2)
+        {
+            GUARANTEE_OR_DIE(streamedSeconds < FRAME_BUDGET_SECONDS, "Streaming models stalled a frame past its budget")
+        }
+    }
+
+    for (int modelIndex = 0; modelIndex < STREAMED_MODEL_COUNT; ++modelIndex)
+    {
+        remove(GetStreamedModelPath(modelIndex).c_str());
+    }
+}
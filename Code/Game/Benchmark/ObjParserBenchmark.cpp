@@ -0,0 +1,164 @@
+//----------------------------------------------------------------------------------------------------
+// ObjParserBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Subsystem/Job/JobSystem.hpp"
+#include "Game/Subsystem/Resource/ObjMeshParser.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr LARGE_SPHERE_SLICES = 1024;
+static int constexpr LARGE_SPHERE_STACKS = 512;        // 1024 x 512 quads: 1,048,576 triangles
+static int constexpr MIXED_FACE_COUNT    = 200000;     // Enough lines to span several parser chunks
+
+//----------------------------------------------------------------------------------------------------
+static bool IsMeshEqual(sMeshData const& a, sMeshData const& b)
+{
+    bool isEqual = a.m_vertexes.size() == b.m_vertexes.size() && a.m_indexes.size() == b.m_indexes.size();
+    isEqual      = isEqual && memcmp(a.m_vertexes.data(), b.m_vertexes.data(), a.m_vertexes.size() * sizeof(Vertex_PCU)) == 0;
+    isEqual      = isEqual && memcmp(a.m_indexes.data(), b.m_indexes.data(), a.m_indexes.size() * sizeof(unsigned int)) == 0;
+    isEqual      = isEqual && a.m_submeshes.size() == b.m_submeshes.size() && a.m_materialNames == b.m_materialNames;
+
+    for (size_t submeshIndex = 0; isEqual && submeshIndex < a.m_submeshes.size(); ++submeshIndex)
+    {
+        sSubmesh const& submeshA = a.m_submeshes[submeshIndex];
+        sSubmesh const& submeshB = b.m_submeshes[submeshIndex];
+
+        isEqual = submeshA.m_firstIndex == submeshB.m_firstIndex && submeshA.m_indexCount == submeshB.m_indexCount && submeshA.m_materialIndex == submeshB.m_materialIndex;
+    }
+
+    sBoundingSphere const& sphereA = a.m_localBoundingSphere;
+    sBoundingSphere const& sphereB = b.m_localBoundingSphere;
+
+    return isEqual && memcmp(&sphereA.m_center, &sphereB.m_center, sizeof(sphereA.m_center)) == 0 && memcmp(&sphereA.m_radius, &sphereB.m_radius, sizeof(sphereA.m_radius)) == 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Every record shape the parser takes, spread over enough lines to cross chunk boundaries: CRLF
+// and LF endings, usemtl switches back and forth, negative indexes, v//vn corners, quads, comments,
+// floats that miss the fast path, and positions shared between far-apart faces.
+//
+static String MakeMixedObjText()
+{
+    String text = "# mixed\r\nmtllib mixed.mtl\r\n";
+    text.reserve(static_cast<size_t>(MIXED_FACE_COUNT) * 96);
+
+    char const* const materials[] = { "stone", "wood", "stone", "metal" };
+
+    for (int faceIndex = 0; faceIndex < MIXED_FACE_COUNT; ++faceIndex)
+    {
+        char const* const lineEnd = (faceIndex % 3 == 0) ? "\r\n" : "\n";
+
+        text += Stringf("v %d.%03d %.7g -%d.5%s", faceIndex % 977, faceIndex % 1000, 1.f / static_cast<float>(faceIndex + 3), faceIndex % 13, lineEnd);
+        text += Stringf("vt 0.%d %de-3%s", faceIndex % 10, faceIndex % 1000, lineEnd);
+        text += Stringf("vn 0 0 1%s", lineEnd);
+
+        if (faceIndex % 5000 == 0)
+        {
+            text += Stringf("usemtl %s%s", materials[(faceIndex / 5000) % 4], lineEnd);
+        }
+
+        if (faceIndex < 2)
+        {
+            continue;
+        }
+
+        switch (faceIndex % 4)
+        {
+        case 0:  text += Stringf("f -1/-1 -2/-2 -3/-3%s", lineEnd); break;
+        case 1:  text += Stringf("f %d//1 %d//1 %d//1%s", faceIndex + 1, faceIndex, faceIndex / 2, lineEnd); break;
+        case 2:  text += Stringf("f %d/%d/1 %d/%d/1 %d/%d/1 %d/%d/1%s", faceIndex + 1, faceIndex + 1, faceIndex, faceIndex, faceIndex - 1, faceIndex - 1, 1, 1, lineEnd); break;
+        default: text += Stringf("# face %d\nf %d %d/%d\t-2%s", faceIndex, faceIndex + 1, faceIndex, faceIndex, lineEnd); break;
+        }
+    }
+
+    return text;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Parses `text` both ways and checks the results match exactly, success or failure.
+//
+static void ValidateSameParse(String const& text, char const* description, bool shouldSucceed)
+{
+    sMeshData serialMesh;
+    sMeshData parallelMesh;
+    String    serialError;
+    String    parallelError;
+
+    bool const isSerialParsed   = ParseObjMesh(text.data(), text.size(), serialMesh, &serialError);
+    bool const isParallelParsed = ParseObjMeshParallel(g_theJobSystem, text.data(), text.size(), parallelMesh, &parallelError);
+
+    GUARANTEE_OR_DIE(isSerialParsed == shouldSucceed, Stringf("ParseObjMesh gave the wrong result for %s: %s", description, serialError.c_str()))
+    GUARANTEE_OR_DIE(isParallelParsed == isSerialParsed && parallelError == serialError, Stringf("ParseObjMeshParallel disagreed with ParseObjMesh on %s: \"%s\" vs \"%s\"", description, parallelError.c_str(), serialError.c_str()))
+    GUARANTEE_OR_DIE(!shouldSucceed || IsMeshEqual(serialMesh, parallelMesh), Stringf("ParseObjMeshParallel built a different mesh for %s", description))
+}
+
+//----------------------------------------------------------------------------------------------------
+static void ValidateObjParser(String const& sphereText)
+{
+    String const mixedText = MakeMixedObjText();
+
+    ValidateSameParse(sphereText, "a large sphere", true);
+    ValidateSameParse(mixedText, "mixed records", true);
+    ValidateSameParse(mixedText.substr(0, mixedText.size() / 2 + 17), "text cut mid-record", true);
+    ValidateSameParse("v 1 2 3\nf 1 1 1", "a single chunk", true);
+    ValidateSameParse("", "empty text", true);
+
+    // Errors late in the file: the first failing line must win even when an earlier chunk's range
+    // error and a later chunk's syntax error are found by different threads.
+    ValidateSameParse(mixedText + "f 1 2 bad\n", "a late syntax error", false);
+    ValidateSameParse(mixedText + "f 1 2 999999999\n", "a late index out of range", false);
+    ValidateSameParse("f 1 2 3\n" + mixedText + "f 1 x 3\n", "an early range error before a late syntax error", false);
+    ValidateSameParse(mixedText + "f 1 2/-999999999 3\n" + mixedText, "a uv index out of range mid-file", false);
+    ValidateSameParse(mixedText + "v 1 2\n", "a short vertex record", false);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Checks the parallel parser against the serial one, then times both on a model of over a million
+// triangles held in memory, so only parsing is measured.
+//
+void RunObjParserBenchmarks()
+{
+    String const sphereText = MakeBenchmarkSphereObjText(LARGE_SPHERE_SLICES, LARGE_SPHERE_STACKS);
+    double const megabytes  = static_cast<double>(sphereText.size()) / (1024.0 * 1024.0);
+    int const    triangles  = LARGE_SPHERE_SLICES * LARGE_SPHERE_STACKS * 2;
+
+    ValidateObjParser(sphereText);
+
+    sMeshData mesh;
+
+    sBenchmarkResult const serialResult = RunBenchmark(Stringf("ParseObjMesh, %d triangles (%.0f MB)", triangles, megabytes), 2, 1, [&sphereText, &mesh]()
+    {
+        ParseObjMesh(sphereText.data(), sphereText.size(), mesh);
+    });
+
+    sBenchmarkResult const chunkedResult = RunBenchmark(Stringf("ParseObjMeshParallel, %d triangles, caller only", triangles), 2, 1, [&sphereText, &mesh]()
+    {
+        ParseObjMeshParallel(nullptr, sphereText.data(), sphereText.size(), mesh);
+    });
+
+    sBenchmarkResult const parallelResult = RunBenchmark(Stringf("ParseObjMeshParallel, %d triangles, %d job workers", triangles, g_theJobSystem->GetWorkerCount()), 2, 1, [&sphereText, &mesh]()
+    {
+        ParseObjMeshParallel(g_theJobSystem, sphereText.data(), sphereText.size(), mesh);
+    });
+
+    printf("OBJ parse throughput: serial %.0f MB/s, chunked on one thread %.0f MB/s, parallel %.0f MB/s (%.1fx serial)\n",
+           megabytes / serialResult.m_secondsPerIteration, megabytes / chunkedResult.m_secondsPerIteration, megabytes / parallelResult.m_secondsPerIteration,
+           serialResult.m_secondsPerIteration / parallelResult.m_secondsPerIteration);
+
+    GUARANTEE_OR_DIE(static_cast<int>(mesh.m_indexes.size()) / 3 == triangles, "ParseObjMeshParallel lost triangles from the large sphere")
+
+    // Speedup is only meaningful when the workers have cores of their own
+    if (std::thread::hardware_concurrency() >= 2)
+    {
+        GUARANTEE_OR_DIE(parallelResult.m_secondsPerIteration < serialResult.m_secondsPerIteration, "ParseObjMeshParallel was slower than ParseObjMesh with cores to spare")
+    }
+}
@@ -0,0 +1,106 @@
+//----------------------------------------------------------------------------------------------------
+// PipelineStateBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Game/Subsystem/Render/NullRenderBackend.hpp"
+#include "Game/Subsystem/Render/PipelineState.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr PIPELINE_DRAW_COUNT = 10000;
+
+//----------------------------------------------------------------------------------------------------
+// A NullRenderBackend whose shader lookup searches loaded shaders by name, the way the Renderer's
+// shader cache does, so the per-draw cost of looking a shader up by path shows in the timings.
+//
+class ShaderCacheRenderBackend : public NullRenderBackend
+{
+public:
+    ShaderCacheRenderBackend()
+    {
+        char const* const shaderNames[] = { "Data/Shaders/Default", "Data/Shaders/Diffuse", "Data/Shaders/BlinnPhong", "Data/Shaders/Bloom" };
+
+        for (char const* shaderName : shaderNames)
+        {
+            m_shaders.push_back({ shaderName, reinterpret_cast<Shader*>(static_cast<uintptr_t>(0x1000 * (m_shaders.size() + 1))) });
+        }
+    }
+
+    Shader* CreateOrGetShaderFromFile(char const* shaderName, eRenderVertexType const vertexType) override
+    {
+        UNUSED(vertexType)
+
+        for (sLoadedShader const& loadedShader : m_shaders)
+        {
+            if (loadedShader.m_name == shaderName)
+            {
+                return loadedShader.m_shader;
+            }
+        }
+
+        return nullptr;
+    }
+
+private:
+    struct sLoadedShader
+    {
+        String  m_name;
+        Shader* m_shader = nullptr;
+    };
+
+    std::vector<sLoadedShader> m_shaders;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Times Prop's per-draw submission with the shader looked up by path and four modes set one by one,
+// against binding a PipelineState resolved once at load.
+//
+void RunPipelineStateBenchmarks()
+{
+    ShaderCacheRenderBackend backend;
+    Mat44 const              modelToWorldTransform;
+    int const                staticMeshId = backend.CreateStaticMesh(std::vector<Vertex_PCU>(36), {});
+
+    sPipelineStateDesc desc;
+    desc.m_shaderName                  = "Data/Shaders/Bloom";
+    PipelineState const* pipelineState = backend.CreateOrGetPipelineState(desc);
+
+    GUARANTEE_OR_DIE(pipelineState == backend.CreateOrGetPipelineState(desc), "Equal descs must share one PipelineState")
+    GUARANTEE_OR_DIE(pipelineState->GetShader() == backend.CreateOrGetShaderFromFile("Data/Shaders/Bloom", eRenderVertexType::VERTEX_PCU), "PipelineState resolved the wrong shader")
+
+    backend.BeginFrame();
+
+    RunBenchmark(Stringf("Per-draw shader lookup by path x%d", PIPELINE_DRAW_COUNT), 200, PIPELINE_DRAW_COUNT, [&]()
+    {
+        for (int drawIndex = 0; drawIndex < PIPELINE_DRAW_COUNT; ++drawIndex)
+        {
+            backend.SetModelConstants(modelToWorldTransform, Rgba8::WHITE);
+            backend.SetBlendMode(eRenderBlendMode::OPAQUE);
+            backend.SetRasterizerMode(eRenderRasterizerMode::SOLID_CULL_BACK);
+            backend.SetSamplerMode(eRenderSamplerMode::POINT_CLAMP);
+            backend.SetDepthMode(eRenderDepthMode::READ_WRITE_LESS_EQUAL);
+            backend.BindTexture(nullptr);
+            backend.BindShader(backend.CreateOrGetShaderFromFile("Data/Shaders/Bloom", eRenderVertexType::VERTEX_PCU));
+            backend.DrawStaticMesh(staticMeshId);
+        }
+    });
+
+    RunBenchmark(Stringf("Per-draw PipelineState bind x%d", PIPELINE_DRAW_COUNT), 200, PIPELINE_DRAW_COUNT, [&]()
+    {
+        for (int drawIndex = 0; drawIndex < PIPELINE_DRAW_COUNT; ++drawIndex)
+        {
+            backend.SetModelConstants(modelToWorldTransform, Rgba8::WHITE);
+            backend.BindPipelineState(pipelineState);
+            backend.BindTexture(nullptr);
+            backend.DrawStaticMesh(staticMeshId);
+        }
+    });
+}
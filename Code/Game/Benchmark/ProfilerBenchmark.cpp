@@ -0,0 +1,212 @@
+//----------------------------------------------------------------------------------------------------
+// ProfilerBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Game/Subsystem/Profile/Profiler.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr  SCOPES_PER_ITERATION   = 10000;
+static int constexpr  CAPTURE_FRAME_COUNT    = 3;
+static int constexpr  WORKERS_PER_FRAME      = 3;
+static int constexpr  SCOPES_PER_WORKER      = 500;
+static int constexpr  SUMMARY_FRAME_COUNT    = 200;
+static char constexpr BENCHMARK_TRACE_PATH[] = "ProfilerBenchmark.json";
+
+#if defined(GAME_DISABLE_PROFILER)
+static bool constexpr ARE_SCOPES_COMPILED = false;
+#else
+static bool constexpr ARE_SCOPES_COMPILED = true;
+#endif
+
+//----------------------------------------------------------------------------------------------------
+static void RecordScopes(int const scopeCount)
+{
+    for (int scope = 0; scope < scopeCount; ++scope)
+    {
+        PROFILE_SCOPE("ProfilerBenchmark::Scope");
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+static int CountOccurrences(FILE* file, char const* pattern)
+{
+    int          count         = 0;
+    size_t       matched       = 0;
+    size_t const patternLength = strlen(pattern);
+
+    for (int character = fgetc(file); character != EOF; character = fgetc(file))
+    {
+        matched = character == pattern[matched] ? matched + 1 : (character == pattern[0] ? 1 : 0);
+
+        if (matched == patternLength)
+        {
+            ++count;
+            matched = 0;
+        }
+    }
+
+    return count;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Records a few frames with nested scopes on this thread and on workers spawned per frame, the
+// way LightClusterGrid and the software rasterizer spawn theirs. Every scope must reach the file,
+// and the workers must share lanes across frames instead of adding one each (fewer still when they
+// happen to run one after another).
+//
+static void ValidateCapture()
+{
+    ProfilerRequestCapture(CAPTURE_FRAME_COUNT, BENCHMARK_TRACE_PATH);
+
+    for (int frame = 0; frame < CAPTURE_FRAME_COUNT; ++frame)
+    {
+        ProfilerBeginFrame();
+
+        {
+            PROFILE_SCOPE("ProfilerBenchmark::Frame");
+
+            std::vector<std::thread> workers;
+
+            for (int workerIndex = 0; workerIndex < WORKERS_PER_FRAME; ++workerIndex)
+            {
+                workers.emplace_back([]()
+                {
+                    SetProfilerThreadName("Profiler benchmark worker");
+                    RecordScopes(SCOPES_PER_WORKER);
+                });
+            }
+
+            RecordScopes(SCOPES_PER_WORKER);
+
+            for (std::thread& worker : workers)
+            {
+                worker.join();
+            }
+        }
+
+        ProfilerEndFrame();
+    }
+
+    int const scopesPerFrame = ARE_SCOPES_COMPILED ? 1 + SCOPES_PER_WORKER * (1 + WORKERS_PER_FRAME) : 0;
+    int const expectedScopes = CAPTURE_FRAME_COUNT * (1 + scopesPerFrame);       // Plus the profiler's own frame scope
+
+    sProfilerCaptureStatistics const& statistics = GetProfilerCaptureStatistics();
+
+    GUARANTEE_OR_DIE(!IsProfilerCapturing(), "Profiler capture did not finish after its frame count");
+    GUARANTEE_OR_DIE(statistics.m_isWritten, "Profiler capture was not written");
+    GUARANTEE_OR_DIE(statistics.m_frameCount == CAPTURE_FRAME_COUNT, "Profiler capture recorded the wrong frame count");
+    GUARANTEE_OR_DIE(statistics.m_eventCount == expectedScopes, "Profiler capture lost or duplicated scopes");
+    GUARANTEE_OR_DIE(statistics.m_droppedCount == 0, "Profiler capture dropped scopes below ring capacity");
+    GUARANTEE_OR_DIE(!ARE_SCOPES_COMPILED || statistics.m_threadCount <= 1 + WORKERS_PER_FRAME, "Per-frame workers did not reuse their profiler lanes");
+
+    FILE* file = nullptr;
+
+#if defined(_WIN32)
+    if (fopen_s(&file, BENCHMARK_TRACE_PATH, "rb") != 0)
+    {
+        file = nullptr;
+    }
+#else
+    file = fopen(BENCHMARK_TRACE_PATH, "rb");
+#endif
+
+    GUARANTEE_OR_DIE(file != nullptr, "Profiler capture file is missing");
+
+    int const completeEvents = CountOccurrences(file, "\"ph\":\"X\"");
+    fclose(file);
+    remove(BENCHMARK_TRACE_PATH);
+
+    GUARANTEE_OR_DIE(completeEvents == expectedScopes, "Profiler capture file does not hold every scope");
+}
+
+//----------------------------------------------------------------------------------------------------
+// The frame summary reads a worker's ring while the worker keeps wrapping around it. Every scope it
+// totals must be one that was actually recorded: a torn read would show a stray name, or a
+// duration made of one scope's begin and another's end.
+//
+static void ValidateSummaryWhileWrapping()
+{
+    if (!ARE_SCOPES_COMPILED)
+    {
+        return;
+    }
+
+    std::atomic<bool> isWorkerRunning(true);
+    std::atomic<int>  workerIterationCount(0);
+
+    SetProfilerFrameSummaryEnabled(true);
+
+    std::thread worker([&isWorkerRunning, &workerIterationCount]()
+    {
+        while (isWorkerRunning.load(std::memory_order_relaxed))
+        {
+            RecordScopes(SCOPES_PER_ITERATION);
+            workerIterationCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    sProfilerConfig constexpr defaultConfig;
+    int const                 wrappingIterationCount = 4 * defaultConfig.m_eventsPerThread / SCOPES_PER_ITERATION;
+    int                       workerScopeCount       = 0;
+
+    for (int frame = 0; frame < SUMMARY_FRAME_COUNT || workerIterationCount.load(std::memory_order_relaxed) < wrappingIterationCount; ++frame)
+    {
+        ProfilerBeginFrame();
+        ProfilerEndFrame();
+
+        sProfilerFrameSummary const& summary = GetProfilerFrameSummary();
+
+        for (int scopeIndex = 0; scopeIndex < summary.m_scopeCount; ++scopeIndex)
+        {
+            sProfilerScopeTotal const& scope = summary.m_scopes[scopeIndex];
+            bool const isWorkerScope         = strcmp(scope.m_name, "ProfilerBenchmark::Scope") == 0;
+            GUARANTEE_OR_DIE(isWorkerScope || strcmp(scope.m_name, "Frame") == 0, "Profiler summary read a scope that was never recorded")
+            GUARANTEE_OR_DIE(scope.m_milliseconds >= 0.f && scope.m_milliseconds < 60000.f, "Profiler summary read a torn scope")
+
+            workerScopeCount += isWorkerScope ? scope.m_callCount : 0;
+        }
+    }
+
+    isWorkerRunning.store(false, std::memory_order_relaxed);
+    worker.join();
+    SetProfilerFrameSummaryEnabled(false);
+
+    printf("Profiler summary: %d of %d worker scopes totaled while the worker wrapped its ring\n", workerScopeCount, workerIterationCount.load() * SCOPES_PER_ITERATION);
+    GUARANTEE_OR_DIE(workerScopeCount > 0, "Profiler summary never saw the worker's scopes")
+}
+
+//----------------------------------------------------------------------------------------------------
+// Marker cost outside a capture, and while recording. The recording run overflows the ring on
+// purpose; only the cost per marker matters there.
+//
+void RunProfilerBenchmarks()
+{
+    ValidateCapture();
+    ValidateSummaryWhileWrapping();
+
+    RunBenchmark("PROFILE_SCOPE not capturing", 100, SCOPES_PER_ITERATION, []()
+    {
+        RecordScopes(SCOPES_PER_ITERATION);
+    });
+
+    ProfilerRequestCapture(1, BENCHMARK_TRACE_PATH);
+    ProfilerBeginFrame();
+
+    RunBenchmark("PROFILE_SCOPE recording", 100, SCOPES_PER_ITERATION, []()
+    {
+        RecordScopes(SCOPES_PER_ITERATION);
+    });
+
+    ProfilerEndFrame();
+    remove(BENCHMARK_TRACE_PATH);
+}
@@ -0,0 +1,147 @@
+//----------------------------------------------------------------------------------------------------
+// RenderPipelineBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <cstdio>
+#include <thread>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Game/Framework/RenderPipeline.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr    VALIDATION_FRAME_COUNT = 2000;
+static int constexpr    FRAMES_PER_ITERATION   = 20;
+static double constexpr UPDATE_SECONDS         = 0.001;
+static double constexpr RENDER_SECONDS         = 0.0015;
+
+//----------------------------------------------------------------------------------------------------
+// Stands in for update or render work: busy, so it costs the same on any scheduler.
+//
+static void SpinForSeconds(double const seconds)
+{
+    double const endSeconds = GetCurrentTimeSeconds() + seconds;
+
+    while (GetCurrentTimeSeconds() < endSeconds)
+    {
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Fills a snapshot whose every field is derived from the frame number, so the render side can tell
+// a snapshot that was overwritten while it was being drawn from an intact one.
+//
+static void FillNumberedSnapshot(sRenderSnapshot& out_snapshot, int const frame)
+{
+    out_snapshot.m_isAttractMode    = (frame & 1) != 0;
+    out_snapshot.m_lightChangeCount = static_cast<uint32_t>(frame);
+    out_snapshot.m_draws.resize(static_cast<size_t>(1 + frame % 64));
+
+    for (sSnapshotDraw& draw : out_snapshot.m_draws)
+    {
+        draw.m_meshIndex = frame;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Two thousand frames with jittered update and render times on both sides of each other: every
+// snapshot must be drawn exactly once, in order, and never change while it is drawn.
+//
+static void ValidateRenderPipeline()
+{
+    RandomNumberGenerator rng;
+    int                   expectedFrame = 0;
+    int                   tornCount     = 0;
+
+    auto const renderFunction = [&expectedFrame, &tornCount](sRenderSnapshot const& snapshot)
+    {
+        int const frame = static_cast<int>(snapshot.m_frameIndex);
+        GUARANTEE_OR_DIE(frame == expectedFrame, "RenderPipeline drew a snapshot out of order")
+
+        // Long enough that the game thread fills the next slots meanwhile
+        SpinForSeconds((frame % 3) * 0.00002);
+
+        bool isIntact = static_cast<int>(snapshot.m_lightChangeCount) == frame && snapshot.m_isAttractMode == ((frame & 1) != 0);
+        isIntact      = isIntact && snapshot.m_draws.size() == static_cast<size_t>(1 + frame % 64);
+
+        for (sSnapshotDraw const& draw : snapshot.m_draws)
+        {
+            isIntact = isIntact && draw.m_meshIndex == frame;
+        }
+
+        tornCount += isIntact ? 0 : 1;
+        ++expectedFrame;
+    };
+
+    sRenderPipelineConfig config;
+    RenderPipeline        pipeline(config, renderFunction);
+
+    for (int frame = 0; frame < VALIDATION_FRAME_COUNT; ++frame)
+    {
+        FillNumberedSnapshot(pipeline.BeginSnapshot(), frame);
+        pipeline.SubmitSnapshot();
+
+        SpinForSeconds(rng.RollRandomIntInRange(0, 2) * 0.00002);
+    }
+
+    pipeline.WaitForIdle();
+
+    sRenderPipelineStatistics const statistics = pipeline.GetStatistics();
+
+    printf("RenderPipeline: %d frames drawn, game thread waited %.3f ms in all, render thread %.3f ms\n", expectedFrame, statistics.m_submitWaitSeconds * 1000.0, statistics.m_renderWaitSeconds * 1000.0);
+    GUARANTEE_OR_DIE(expectedFrame == VALIDATION_FRAME_COUNT && statistics.m_framesRendered == VALIDATION_FRAME_COUNT, "RenderPipeline dropped snapshots")
+    GUARANTEE_OR_DIE(tornCount == 0, "RenderPipeline handed out a snapshot that was still being drawn")
+}
+
+//----------------------------------------------------------------------------------------------------
+// Frames of UPDATE_SECONDS of simulation and RENDER_SECONDS of drawing: serial frames cost the sum,
+// pipelined ones should cost about the longer of the two.
+//
+static sBenchmarkResult MeasureFrames(bool const isThreaded)
+{
+    sRenderPipelineConfig config;
+    config.m_isThreaded = isThreaded;
+
+    RenderPipeline pipeline(config, [](sRenderSnapshot const& snapshot)
+    {
+        UNUSED(snapshot)
+        SpinForSeconds(RENDER_SECONDS);
+    });
+
+    String const name = Stringf("%s frames, %.1f ms update + %.1f ms render", isThreaded ? "Pipelined" : "Serial", UPDATE_SECONDS * 1000.0, RENDER_SECONDS * 1000.0);
+
+    return RunBenchmark(name, 10, FRAMES_PER_ITERATION, [&pipeline]()
+    {
+        for (int frame = 0; frame < FRAMES_PER_ITERATION; ++frame)
+        {
+            SpinForSeconds(UPDATE_SECONDS);
+            FillNumberedSnapshot(pipeline.BeginSnapshot(), frame);
+            pipeline.SubmitSnapshot();
+        }
+
+        pipeline.WaitForIdle();
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+void RunRenderPipelineBenchmarks()
+{
+    ValidateRenderPipeline();
+
+    sBenchmarkResult const serial    = MeasureFrames(false);
+    sBenchmarkResult const pipelined = MeasureFrames(true);
+
+    double const speedup = pipelined.m_secondsPerIteration > 0.0 ? serial.m_secondsPerIteration / pipelined.m_secondsPerIteration : 0.0;
+    printf("RenderPipeline: pipelined frames %.2fx as fast as serial\n", speedup);
+
+    // One core cannot overlap the stages; with two, the slack is the render thread's last frame
+    if (std::thread::hardware_concurrency() >= 2)
+    {
+        GUARANTEE_OR_DIE(pipelined.m_secondsPerIteration < serial.m_secondsPerIteration * 0.8, "Pipelined frames did not overlap update and render")
+    }
+}
@@ -0,0 +1,363 @@
+//----------------------------------------------------------------------------------------------------
+// RenderQueueBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Game/Subsystem/Render/NullRenderBackend.hpp"
+#include "Game/Subsystem/Render/PipelineState.hpp"
+#include "Game/Subsystem/Render/RenderQueue.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr RENDER_QUEUE_DRAW_COUNT    = 10000;
+static int constexpr RENDER_QUEUE_SHADER_COUNT  = 4;
+static int constexpr RENDER_QUEUE_TEXTURE_COUNT = 16;
+static int constexpr RENDER_QUEUE_MESH_COUNT    = 8;
+
+//----------------------------------------------------------------------------------------------------
+// A NullRenderBackend that also tracks what is bound, and records the state each draw or instance
+// saw. Items are identified by the index the benchmark packs into the model color.
+//
+class RecordingRenderBackend : public NullRenderBackend
+{
+public:
+    struct sRecordedDraw
+    {
+        sRenderState m_state;
+        int          m_staticMeshId = -1;
+        int          m_drawSequence = -1;       // Order the draw was issued in, -1 until it is
+    };
+
+    explicit RecordingRenderBackend(int const itemCount)
+        : m_draws(static_cast<size_t>(itemCount))
+    {
+    }
+
+    void SetModelConstants(Mat44 const& modelToWorldTransform, Rgba8 const& modelColor) override
+    {
+        NullRenderBackend::SetModelConstants(modelToWorldTransform, modelColor);
+        m_currentItemIndex = GetItemIndex(modelColor);
+    }
+
+    void BindPipelineState(PipelineState const* pipelineState) override
+    {
+        NullRenderBackend::BindPipelineState(pipelineState);
+        m_boundState.m_pipelineState = pipelineState;
+    }
+
+    void BindTexture(Texture const* texture) override
+    {
+        NullRenderBackend::BindTexture(texture);
+        m_boundState.m_texture = texture;
+    }
+
+    void DrawStaticMesh(int const staticMeshId) override
+    {
+        NullRenderBackend::DrawStaticMesh(staticMeshId);
+        RecordItemDraw(m_currentItemIndex, staticMeshId);
+    }
+
+    void DrawStaticMeshInstanced(int const staticMeshId, sInstanceData const* instances, int const instanceCount) override
+    {
+        NullRenderBackend::DrawStaticMeshInstanced(staticMeshId, instances, instanceCount);
+
+        for (int instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex)
+        {
+            RecordItemDraw(GetItemIndex(instances[instanceIndex].m_color), staticMeshId);
+        }
+    }
+
+    int GetRecordedItemCount() const
+    {
+        return m_drawSequence;
+    }
+
+    static int GetItemIndex(Rgba8 const& color)
+    {
+        return color.r | color.g << 8 | color.b << 16;
+    }
+
+    std::vector<sRecordedDraw> m_draws;
+
+private:
+    void RecordItemDraw(int const itemIndex, int const staticMeshId)
+    {
+        sRecordedDraw& draw = m_draws[itemIndex];
+        draw.m_state        = m_boundState;
+        draw.m_staticMeshId = staticMeshId;
+        draw.m_drawSequence = m_drawSequence++;
+    }
+
+    sRenderState m_boundState;
+    int          m_currentItemIndex = 0;
+    int          m_drawSequence     = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sRenderQueueTestItem
+{
+    sRenderState    m_state;
+    int             m_staticMeshId = 0;
+    Mat44           m_modelToWorldTransform;
+    Rgba8           m_color;
+    sBoundingSphere m_worldBounds;              // A unit cube's, at the translation
+};
+
+//----------------------------------------------------------------------------------------------------
+// Draws in random order over a few shaders and textures, one in ten alpha blended. Textures are
+// fake pointers; no backend here dereferences them.
+//
+static std::vector<sRenderQueueTestItem> MakeRenderQueueTestItems(RandomNumberGenerator& rng, RenderBackend& pipelineStateOwner)
+{
+    PipelineState const* opaquePipelineStates[RENDER_QUEUE_SHADER_COUNT];
+    PipelineState const* blendedPipelineStates[RENDER_QUEUE_SHADER_COUNT];
+
+    for (int shaderIndex = 0; shaderIndex < RENDER_QUEUE_SHADER_COUNT; ++shaderIndex)
+    {
+        sPipelineStateDesc desc;
+        desc.m_shaderName                  = Stringf("Data/Shaders/Benchmark%d", shaderIndex);
+        opaquePipelineStates[shaderIndex]  = pipelineStateOwner.CreateOrGetPipelineState(desc);
+        desc.m_blendMode                   = eRenderBlendMode::ALPHA;
+        desc.m_depthMode                   = eRenderDepthMode::READ_ONLY_LESS_EQUAL;
+        blendedPipelineStates[shaderIndex] = pipelineStateOwner.CreateOrGetPipelineState(desc);
+    }
+
+    std::vector<sRenderQueueTestItem> items(RENDER_QUEUE_DRAW_COUNT);
+
+    for (int itemIndex = 0; itemIndex < RENDER_QUEUE_DRAW_COUNT; ++itemIndex)
+    {
+        sRenderQueueTestItem& item           = items[itemIndex];
+        int const             shaderIndex    = rng.RollRandomIntInRange(0, RENDER_QUEUE_SHADER_COUNT - 1);
+        uintptr_t const       textureAddress = 0x8000 + 0x100 * static_cast<uintptr_t>(rng.RollRandomIntInRange(0, RENDER_QUEUE_TEXTURE_COUNT - 1));
+
+        item.m_state.m_pipelineState = rng.RollRandomIntInRange(0, 9) == 0 ? blendedPipelineStates[shaderIndex] : opaquePipelineStates[shaderIndex];
+        item.m_state.m_texture       = reinterpret_cast<Texture const*>(textureAddress);
+
+        item.m_staticMeshId = rng.RollRandomIntInRange(0, RENDER_QUEUE_MESH_COUNT - 1);
+        item.m_modelToWorldTransform.SetTranslation3D(Vec3(rng.RollRandomFloatInRange(0.f, 70.f), rng.RollRandomFloatInRange(-50.f, 50.f), 0.f));
+        item.m_worldBounds.m_center = item.m_modelToWorldTransform.GetTranslation3D();
+        item.m_worldBounds.m_radius = 0.87f;
+        item.m_color = Rgba8(static_cast<unsigned char>(itemIndex & 0xFF), static_cast<unsigned char>((itemIndex >> 8) & 0xFF), static_cast<unsigned char>((itemIndex >> 16) & 0xFF));
+    }
+
+    return items;
+}
+
+//----------------------------------------------------------------------------------------------------
+// What Prop::RenderWithTransform does: every state is bound before every draw.
+//
+static void SubmitImmediate(RenderBackend& backend, std::vector<sRenderQueueTestItem> const& items)
+{
+    for (sRenderQueueTestItem const& item : items)
+    {
+        backend.SetModelConstants(item.m_modelToWorldTransform, item.m_color);
+        backend.BindPipelineState(item.m_state.m_pipelineState);
+        backend.BindTexture(item.m_state.m_texture);
+        backend.DrawStaticMesh(item.m_staticMeshId);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+static void SubmitQueued(RenderQueue& queue, RenderBackend& backend, std::vector<sRenderQueueTestItem> const& items)
+{
+    queue.Begin(Vec3::ZERO, 100.f);
+
+    for (sRenderQueueTestItem const& item : items)
+    {
+        queue.Submit(item.m_state, item.m_staticMeshId, item.m_modelToWorldTransform, item.m_color, item.m_worldBounds);
+    }
+
+    queue.Flush(backend);
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool AreRenderStatesEqual(sRenderState const& a, sRenderState const& b)
+{
+    return a.m_pipelineState == b.m_pipelineState && a.m_texture == b.m_texture;
+}
+
+//----------------------------------------------------------------------------------------------------
+// 10k copies of one mesh with one state must become a single instanced draw whose instance buffer
+// holds every item's transform and tint exactly once, and whose lights are bound once, for bounds
+// that hold every item.
+//
+static void ValidateInstancedBatching(RenderQueue& queue, std::vector<sRenderQueueTestItem> const& items, PipelineState const* pipelineState)
+{
+    NullRenderBackend nullBackend;
+    int const         cubeMeshId = nullBackend.CreateStaticMesh(std::vector<Vertex_PCU>(36), {});
+
+    queue.Begin(Vec3::ZERO, 100.f);
+
+    for (sRenderQueueTestItem const& item : items)
+    {
+        queue.Submit({ pipelineState, nullptr }, cubeMeshId, item.m_modelToWorldTransform, item.m_color, item.m_worldBounds);
+    }
+
+    queue.BuildBatches();
+
+    std::vector<sDrawBatch> const&    batches   = queue.GetBatches();
+    std::vector<sInstanceData> const& instances = queue.GetInstances();
+    GUARANTEE_OR_DIE(batches.size() == 1 && batches[0].m_instanceCount == RENDER_QUEUE_DRAW_COUNT, "RenderQueue did not merge identical draws into one batch")
+    GUARANTEE_OR_DIE(instances.size() == items.size(), "RenderQueue packed the wrong number of instances")
+
+    std::vector<uint8_t> isItemPacked(items.size());
+
+    for (sInstanceData const& instance : instances)
+    {
+        int const itemIndex = RecordingRenderBackend::GetItemIndex(instance.m_color);
+        GUARANTEE_OR_DIE(isItemPacked[itemIndex] == 0, "RenderQueue packed an item twice")
+        GUARANTEE_OR_DIE(instance.m_modelToWorldTransform.GetTranslation3D() == items[itemIndex].m_modelToWorldTransform.GetTranslation3D(), "RenderQueue packed the wrong transform")
+        isItemPacked[itemIndex] = 1;
+    }
+
+    sBoundingSphere const batchBounds = batches[0].m_worldBounds;
+
+    for (sRenderQueueTestItem const& item : items)
+    {
+        float const farthest = (item.m_worldBounds.m_center - batchBounds.m_center).GetLength() + item.m_worldBounds.m_radius;
+        GUARANTEE_OR_DIE(farthest <= batchBounds.m_radius * 1.0001f, "A batch's world bounds missed one of its items")
+    }
+
+    int lightBindCount = 0;
+
+    nullBackend.BeginFrame();
+    queue.Flush(nullBackend, [&lightBindCount](sBoundingSphere const&) { ++lightBindCount; });
+    printf("RenderQueue instancing: %d cubes in %d draw, %d light bind\n", RENDER_QUEUE_DRAW_COUNT, nullBackend.GetFrameStatistics().m_drawCalls, lightBindCount);
+    GUARANTEE_OR_DIE(nullBackend.GetFrameStatistics().m_drawCalls == 1, "Instanced cubes should cost one draw call")
+    GUARANTEE_OR_DIE(lightBindCount == 1, "Flush should bind lights once per batch")
+}
+
+//----------------------------------------------------------------------------------------------------
+// A destroyed static mesh id goes back on the free list: the next create reuses it, with the new
+// mesh's contents, and destroying it twice frees it only once.
+//
+static void ValidateStaticMeshIdReuse()
+{
+    NullRenderBackend nullBackend;
+    int const         firstMeshId  = nullBackend.CreateStaticMesh(std::vector<Vertex_PCU>(36), {});
+    int const         secondMeshId = nullBackend.CreateStaticMesh(std::vector<Vertex_PCU>(24), {});
+
+    nullBackend.DestroyStaticMesh(firstMeshId);
+    nullBackend.DestroyStaticMesh(firstMeshId);
+
+    int const reusedMeshId = nullBackend.CreateStaticMesh(std::vector<Vertex_PCU>(6), {});
+    int const newMeshId    = nullBackend.CreateStaticMesh(std::vector<Vertex_PCU>(6), {});
+    GUARANTEE_OR_DIE(reusedMeshId == firstMeshId, "CreateStaticMesh did not reuse a destroyed id")
+    GUARANTEE_OR_DIE(newMeshId != firstMeshId && newMeshId != secondMeshId, "A destroyed static mesh id was handed out twice")
+
+    nullBackend.BeginFrame();
+    nullBackend.DrawStaticMesh(reusedMeshId);
+    GUARANTEE_OR_DIE(nullBackend.GetFrameStatistics().m_verticesSubmitted == 6, "A reused static mesh id drew the destroyed mesh")
+}
+
+//----------------------------------------------------------------------------------------------------
+// Submits the same draws immediately and through the RenderQueue to recording backends, checks that
+// every draw or instance saw the same state both ways and that blended draws came last, back to
+// front, then checks instanced batching and static mesh id reuse and times both paths.
+//
+void RunRenderQueueBenchmarks()
+{
+    RandomNumberGenerator                   rng;
+    NullRenderBackend                       pipelineStateOwner;
+    std::vector<sRenderQueueTestItem> const items = MakeRenderQueueTestItems(rng, pipelineStateOwner);
+    std::vector<Vertex_PCU> const           meshVertexes(36);
+    RecordingRenderBackend                  immediateBackend(RENDER_QUEUE_DRAW_COUNT);
+    RecordingRenderBackend                  queuedBackend(RENDER_QUEUE_DRAW_COUNT);
+    RenderQueue                             queue;
+
+    for (int meshIndex = 0; meshIndex < RENDER_QUEUE_MESH_COUNT; ++meshIndex)
+    {
+        immediateBackend.CreateStaticMesh(meshVertexes, {});
+        queuedBackend.CreateStaticMesh(meshVertexes, {});
+    }
+
+    immediateBackend.BeginFrame();
+    SubmitImmediate(immediateBackend, items);
+    queuedBackend.BeginFrame();
+    SubmitQueued(queue, queuedBackend, items);
+
+    int const immediateStateChanges = immediateBackend.GetFrameStatistics().m_stateChanges;
+    int const queuedStateChanges    = queuedBackend.GetFrameStatistics().m_stateChanges;
+    printf("Immediate: %d draws, %d state changes\n", immediateBackend.GetFrameStatistics().m_drawCalls, immediateStateChanges);
+    printf("RenderQueue: %d draws, %d state changes (%.1f%%)\n", queuedBackend.GetFrameStatistics().m_drawCalls, queuedStateChanges, 100.0 * queuedStateChanges / immediateStateChanges);
+
+    GUARANTEE_OR_DIE(queuedBackend.GetRecordedItemCount() == RENDER_QUEUE_DRAW_COUNT, "RenderQueue dropped or repeated draws")
+
+    int   lastOpaqueSequence      = -1;
+    int   firstBlendedSequence    = RENDER_QUEUE_DRAW_COUNT;
+    float previousBlendedDistance = 1e30f;
+
+    for (int itemIndex = 0; itemIndex < RENDER_QUEUE_DRAW_COUNT; ++itemIndex)
+    {
+        RecordingRenderBackend::sRecordedDraw const& expected = immediateBackend.m_draws[itemIndex];
+        RecordingRenderBackend::sRecordedDraw const& actual   = queuedBackend.m_draws[itemIndex];
+        GUARANTEE_OR_DIE(actual.m_drawSequence >= 0 && actual.m_staticMeshId == expected.m_staticMeshId, "RenderQueue lost a draw")
+        GUARANTEE_OR_DIE(AreRenderStatesEqual(actual.m_state, expected.m_state), "RenderQueue drew with the wrong state bound")
+
+        if (actual.m_state.m_pipelineState->IsOpaque())
+        {
+            lastOpaqueSequence = actual.m_drawSequence > lastOpaqueSequence ? actual.m_drawSequence : lastOpaqueSequence;
+        }
+        else
+        {
+            firstBlendedSequence = actual.m_drawSequence < firstBlendedSequence ? actual.m_drawSequence : firstBlendedSequence;
+        }
+    }
+
+    GUARANTEE_OR_DIE(lastOpaqueSequence < firstBlendedSequence, "RenderQueue drew a blended item before an opaque one")
+
+    std::vector<int> itemIndexBySequence(RENDER_QUEUE_DRAW_COUNT);
+
+    for (int itemIndex = 0; itemIndex < RENDER_QUEUE_DRAW_COUNT; ++itemIndex)
+    {
+        itemIndexBySequence[queuedBackend.m_draws[itemIndex].m_drawSequence] = itemIndex;
+    }
+
+    for (int sequence = firstBlendedSequence; sequence < RENDER_QUEUE_DRAW_COUNT; ++sequence)
+    {
+        Vec3 const  translation = items[itemIndexBySequence[sequence]].m_modelToWorldTransform.GetTranslation3D();
+        float const distance    = translation.GetLength();
+        GUARANTEE_OR_DIE(distance <= previousBlendedDistance + 0.01f, "RenderQueue did not draw blended items back to front")
+        previousBlendedDistance = distance;
+    }
+
+    ValidateInstancedBatching(queue, items, pipelineStateOwner.CreateOrGetPipelineState(sPipelineStateDesc()));
+    ValidateStaticMeshIdReuse();
+
+    NullRenderBackend nullBackend;
+
+    for (int meshIndex = 0; meshIndex < RENDER_QUEUE_MESH_COUNT; ++meshIndex)
+    {
+        nullBackend.CreateStaticMesh(meshVertexes, {});
+    }
+
+    RunBenchmark(Stringf("Immediate submit x%d", RENDER_QUEUE_DRAW_COUNT), 200, RENDER_QUEUE_DRAW_COUNT, [&]()
+    {
+        SubmitImmediate(nullBackend, items);
+    });
+
+    RunBenchmark(Stringf("RenderQueue submit, sort, flush x%d", RENDER_QUEUE_DRAW_COUNT), 200, RENDER_QUEUE_DRAW_COUNT, [&]()
+    {
+        SubmitQueued(queue, nullBackend, items);
+    });
+
+    queue.Begin(Vec3::ZERO, 100.f);
+
+    for (sRenderQueueTestItem const& item : items)
+    {
+        queue.Submit(item.m_state, item.m_staticMeshId, item.m_modelToWorldTransform, item.m_color, item.m_worldBounds);
+    }
+
+    RunBenchmark(Stringf("RenderQueue radix sort x%d", RENDER_QUEUE_DRAW_COUNT), 200, RENDER_QUEUE_DRAW_COUNT, [&]()
+    {
+        queue.Sort();
+    });
+}
@@ -0,0 +1,302 @@
+//----------------------------------------------------------------------------------------------------
+// ShaderCacheBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+#include <thread>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Subsystem/Job/JobSystem.hpp"
+#include "Game/Subsystem/Render/ShaderCache.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static char constexpr CACHE_DIRECTORY[]  = "ShaderCacheBenchmark_cache";
+static char constexpr SOURCE_DIRECTORY[] = "ShaderCacheBenchmark_source";
+static int constexpr  STAND_IN_PASSES    = 200;       // Passes over the source per compile; about 6 ms for BlinnPhong
+
+//----------------------------------------------------------------------------------------------------
+// Compiles nothing: it hashes the source over and over, so a compile takes time in proportion to
+// the shader like a real one, and returns bytes that change with its options. Includes are not
+// read, as the cache hashes them itself; a shader file containing "#error" fails to compile.
+//
+class StandInShaderCompiler : public ShaderCompiler
+{
+public:
+    String GetIdentity() const override
+    {
+        return "StandInShaderCompiler 1";
+    }
+
+    bool Compile(sShaderPermutation const& permutation, String const& source, String const& sourcePath, std::vector<unsigned char>& out_bytecode, String* out_error) const override
+    {
+        ++m_compileCount;
+
+        if (source.find("#error") != String::npos)
+        {
+            if (out_error != nullptr)
+            {
+                *out_error = Stringf("%s: #error", sourcePath.c_str());
+            }
+
+            return false;
+        }
+
+        String options = Stringf("%s %d %d", permutation.m_entryPoint.c_str(), static_cast<int>(permutation.m_stage), static_cast<int>(permutation.m_vertexType));
+
+        for (sShaderDefine const& define : permutation.m_defines)
+        {
+            options += Stringf(" %s=%s", define.m_name.c_str(), define.m_value.c_str());
+        }
+
+        uint64_t hash = 14695981039346656037ull;
+
+        for (int pass = 0; pass < STAND_IN_PASSES; ++pass)
+        {
+            for (char const character : source)
+            {
+                hash = (hash ^ static_cast<unsigned char>(character)) * 1099511628211ull;
+            }
+        }
+
+        out_bytecode.assign(options.begin(), options.end());
+        out_bytecode.insert(out_bytecode.end(), reinterpret_cast<unsigned char const*>(&hash), reinterpret_cast<unsigned char const*>(&hash) + sizeof(hash));
+        return true;
+    }
+
+    int GetCompileCount() const
+    {
+        return m_compileCount.load();
+    }
+
+private:
+    mutable std::atomic<int> m_compileCount = { 0 };
+};
+
+//----------------------------------------------------------------------------------------------------
+static void WriteSource(char const* relativePath, String const& text)
+{
+    String const filePath = Stringf("%s/%s", SOURCE_DIRECTORY, relativePath);
+
+    std::error_code directoryError;
+    std::filesystem::create_directories(std::filesystem::path(filePath).parent_path(), directoryError);
+
+    GUARANTEE_OR_DIE(WriteBenchmarkTextFile(filePath, text), Stringf("Could not write \"%s\"", filePath.c_str()))
+}
+
+//----------------------------------------------------------------------------------------------------
+// Each call is one lookup; checks how it was served against the compile count.
+//
+static std::vector<unsigned char> ExpectBytecode(ShaderCache& cache, StandInShaderCompiler const& compiler, sShaderPermutation const& permutation, bool isCompileExpected, char const* description)
+{
+    int const                  compileCount = compiler.GetCompileCount();
+    std::vector<unsigned char> bytecode;
+    String                     error;
+
+    GUARANTEE_OR_DIE(cache.GetBytecode(permutation, bytecode, &error), Stringf("ShaderCache failed on %s: %s", description, error.c_str()))
+    GUARANTEE_OR_DIE((compiler.GetCompileCount() > compileCount) == isCompileExpected, Stringf("ShaderCache %s on %s", isCompileExpected ? "served a stale entry" : "recompiled", description))
+
+    return bytecode;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Hits, misses for every part of the key, include edits, errors, damaged entries and a restart,
+// on a small shader tree with nested and repeated includes.
+//
+static void ValidateShaderCache()
+{
+    std::error_code removeError;
+    std::filesystem::remove_all(CACHE_DIRECTORY, removeError);
+    std::filesystem::remove_all(SOURCE_DIRECTORY, removeError);
+
+    WriteSource("Common.hlsl", "float4 Tint() { return float4(1, 1, 1, 1); }\n");
+    WriteSource("Lighting/Light.hlsl", "  #  include \"../Common.hlsl\"\nfloat Light() { return 1; }\n");
+    WriteSource("Main.hlsl", "#include \"Common.hlsl\"\n#include <Lighting/Light.hlsl>\n// #include \"Missing.hlsl\"\nfloat4 VertexMain() : SV_Position { return Tint() * Light(); }\n");
+
+    sShaderCacheConfig cacheConfig;
+    cacheConfig.m_directory = CACHE_DIRECTORY;
+
+    StandInShaderCompiler compiler;
+    ShaderCache           cache(cacheConfig, compiler);
+
+    sShaderPermutation permutation;
+    permutation.m_shaderName = Stringf("%s/Main", SOURCE_DIRECTORY);
+    permutation.m_defines    = { { "A", "1" }, { "B", "2" } };
+
+    std::vector<unsigned char> const bytecode = ExpectBytecode(cache, compiler, permutation, true, "a first lookup");
+    GUARANTEE_OR_DIE(ExpectBytecode(cache, compiler, permutation, false, "a repeated lookup") == bytecode, "ShaderCache served different bytecode from what it compiled")
+
+    sShaderPermutation reordered = permutation;
+    reordered.m_defines          = { { "B", "2" }, { "A", "1" } };
+    ExpectBytecode(cache, compiler, reordered, false, "the same defines in another order");
+
+    sShaderPermutation changed = permutation;
+    changed.m_defines[1].m_value = "3";
+    ExpectBytecode(cache, compiler, changed, true, "another define value");
+
+    changed              = permutation;
+    changed.m_stage      = eShaderStage::PIXEL;
+    changed.m_entryPoint = "PixelMain";
+    ExpectBytecode(cache, compiler, changed, true, "another entry point and stage");
+
+    changed              = permutation;
+    changed.m_vertexType = eRenderVertexType::VERTEX_PCUTBN;
+    ExpectBytecode(cache, compiler, changed, true, "another vertex type");
+
+    // An edited include, two levels down, is a new key; editing it back finds the old entry again
+    WriteSource("Common.hlsl", "float4 Tint() { return float4(1, 0, 0, 1); }\n");
+    ExpectBytecode(cache, compiler, permutation, true, "an edited include");
+    WriteSource("Common.hlsl", "float4 Tint() { return float4(1, 1, 1, 1); }\n");
+    ExpectBytecode(cache, compiler, permutation, false, "an include edited back");
+
+    // A damaged entry is recompiled, not served
+    uint64_t key = 0;
+    GUARANTEE_OR_DIE(cache.ComputeKey(permutation, key), "ShaderCache could not key a readable shader")
+    GUARANTEE_OR_DIE(WriteBenchmarkTextFile(cache.GetCachedFilePath(key), "truncated"), "Could not damage a cached shader")
+    GUARANTEE_OR_DIE(ExpectBytecode(cache, compiler, permutation, true, "a damaged entry") == bytecode, "ShaderCache recompiled a damaged entry into different bytecode")
+
+    // A new cache over the same directory, as on the next launch, hits without compiling
+    {
+        ShaderCache restartedCache(cacheConfig, compiler);
+        ExpectBytecode(restartedCache, compiler, permutation, false, "a lookup after a restart");
+    }
+
+    std::vector<unsigned char> failedBytecode;
+    String                     error;
+    int const                  compileCount = compiler.GetCompileCount();
+
+    WriteSource("Lighting/Light.hlsl", "#include \"Shadow.hlsl\"\n");
+    GUARANTEE_OR_DIE(!cache.GetBytecode(permutation, failedBytecode, &error) && error.find("Shadow.hlsl") != String::npos && compiler.GetCompileCount() == compileCount, "ShaderCache compiled a shader with a missing include")
+
+    WriteSource("Lighting/Light.hlsl", "float Light() { return 0.5; }\n");
+    WriteSource("Main.hlsl", "#include \"Common.hlsl\"\n#error broken\n");
+    GUARANTEE_OR_DIE(!cache.GetBytecode(permutation, failedBytecode, &error) && error.find("#error") != String::npos, "ShaderCache did not report a compile error")
+    GUARANTEE_OR_DIE(!cache.ComputeKey(permutation, key) || !std::filesystem::exists(cache.GetCachedFilePath(key).c_str()), "ShaderCache stored a failed compile")
+
+    sShaderCacheStatistics const statistics = cache.GetStatistics();
+    GUARANTEE_OR_DIE(statistics.m_hitCount == 3 && statistics.m_compiledCount == 6 && statistics.m_failedCount == 2, "ShaderCache counted its lookups wrong")
+
+    // CompileMissing compiles each missing key once, on any thread, and stores what GetBytecode reads
+    WriteSource("Main.hlsl", "#include \"Common.hlsl\"\n#include <Lighting/Light.hlsl>\nfloat4 VertexMain() : SV_Position { return Tint() * Light(); }\n");
+
+    std::vector<sShaderPermutation> permutations;
+
+    for (int defineValue = 0; defineValue < 8; ++defineValue)
+    {
+        sShaderPermutation variant = permutation;
+        variant.m_defines.push_back({ "VARIANT", Stringf("%d", defineValue) });
+        permutations.push_back(variant);
+        permutations.push_back(variant);
+    }
+
+    int const compileCountBefore = compiler.GetCompileCount();
+    GUARANTEE_OR_DIE(cache.CompileMissing(permutations, g_theJobSystem) == 0 && compiler.GetCompileCount() - compileCountBefore == 8, "CompileMissing did not compile each missing permutation exactly once")
+    GUARANTEE_OR_DIE(cache.CompileMissing(permutations, g_theJobSystem) == 0 && compiler.GetCompileCount() - compileCountBefore == 8, "CompileMissing recompiled cached permutations")
+
+    for (sShaderPermutation const& variant : permutations)
+    {
+        ExpectBytecode(cache, compiler, variant, false, "a permutation CompileMissing built");
+    }
+
+    std::filesystem::remove_all(CACHE_DIRECTORY, removeError);
+    std::filesystem::remove_all(SOURCE_DIRECTORY, removeError);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Every vertex and pixel shader the game builds: Default and Bloom for Vertex_PCU, and BlinnPhong
+// for Vertex_PCUTBN with and without clustered lighting.
+//
+static std::vector<sShaderPermutation> MakeGameShaderPermutations()
+{
+    std::vector<sShaderPermutation> permutations;
+
+    auto const addStages = [&permutations](char const* shaderName, eRenderVertexType const vertexType, std::vector<sShaderDefine> const& defines)
+    {
+        sShaderPermutation permutation;
+        permutation.m_shaderName = shaderName;
+        permutation.m_vertexType = vertexType;
+        permutation.m_defines    = defines;
+        permutations.push_back(permutation);
+
+        permutation.m_entryPoint = "PixelMain";
+        permutation.m_stage      = eShaderStage::PIXEL;
+        permutations.push_back(permutation);
+    };
+
+    addStages("Data/Shaders/Default", eRenderVertexType::VERTEX_PCU, {});
+    addStages("Data/Shaders/Bloom", eRenderVertexType::VERTEX_PCU, {});
+    addStages("Data/Shaders/BlinnPhong", eRenderVertexType::VERTEX_PCUTBN, {});
+    addStages("Data/Shaders/BlinnPhong", eRenderVertexType::VERTEX_PCUTBN, { { "CLUSTERED_LIGHTING", "1" } });
+
+    return permutations;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Checks the cache, then times getting every game shader with a cold cache, compiled one at a time
+// or in parallel by CompileMissing, and with a warm one. Run from Run/, where Data/Shaders is.
+//
+void RunShaderCacheBenchmarks()
+{
+    ValidateShaderCache();
+
+    std::vector<sShaderPermutation> const permutations = MakeGameShaderPermutations();
+    int const                             count        = static_cast<int>(permutations.size());
+
+    sShaderCacheConfig cacheConfig;
+    cacheConfig.m_directory = CACHE_DIRECTORY;
+
+    StandInShaderCompiler compiler;
+    ShaderCache           cache(cacheConfig, compiler);
+    size_t                bytecodeSize = 0;
+
+    auto const getEveryShader = [&cache, &permutations, &bytecodeSize]()
+    {
+        std::vector<unsigned char> bytecode;
+
+        for (sShaderPermutation const& permutation : permutations)
+        {
+            GUARANTEE_OR_DIE(cache.GetBytecode(permutation, bytecode), Stringf("ShaderCache could not build %s", permutation.m_shaderName.c_str()))
+            bytecodeSize += bytecode.size();
+        }
+    };
+
+    sBenchmarkResult const serialResult = RunBenchmark(Stringf("Game shaders x%d, cold cache, compiled one at a time", count), 5, count, [&getEveryShader]()
+    {
+        std::error_code removeError;
+        std::filesystem::remove_all(CACHE_DIRECTORY, removeError);
+        getEveryShader();
+    });
+
+    sBenchmarkResult const parallelResult = RunBenchmark(Stringf("Game shaders x%d, cold cache, CompileMissing on %d job workers", count, g_theJobSystem->GetWorkerCount()), 5, count, [&cache, &permutations, &getEveryShader]()
+    {
+        std::error_code removeError;
+        std::filesystem::remove_all(CACHE_DIRECTORY, removeError);
+        cache.CompileMissing(permutations, g_theJobSystem);
+        getEveryShader();
+    });
+
+    int const              compileCount = compiler.GetCompileCount();
+    sBenchmarkResult const warmResult   = RunBenchmark(Stringf("Game shaders x%d, warm cache", count), 50, count, getEveryShader);
+
+    printf("Game shaders: cold %.2f ms one at a time, %.2f ms in parallel; warm %.2f ms, %.0fx faster than compiling (%zu bytecode bytes)\n",
+           serialResult.m_secondsPerIteration * 1000.0, parallelResult.m_secondsPerIteration * 1000.0, warmResult.m_secondsPerIteration * 1000.0,
+           serialResult.m_secondsPerIteration / warmResult.m_secondsPerIteration, bytecodeSize);
+
+    GUARANTEE_OR_DIE(compiler.GetCompileCount() == compileCount, "A warm ShaderCache compiled a shader")
+    GUARANTEE_OR_DIE(warmResult.m_secondsPerIteration < serialResult.m_secondsPerIteration, "A warm ShaderCache was not faster than compiling")
+
+    // Parallel compiles only win when the workers have cores of their own
+    if (std::thread::hardware_concurrency() >= 2)
+    {
+        GUARANTEE_OR_DIE(parallelResult.m_secondsPerIteration < serialResult.m_secondsPerIteration, "CompileMissing was not faster than compiling one at a time")
+    }
+
+    std::error_code removeError;
+    std::filesystem::remove_all(CACHE_DIRECTORY, removeError);
+}
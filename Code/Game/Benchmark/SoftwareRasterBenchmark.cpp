@@ -0,0 +1,253 @@
+//----------------------------------------------------------------------------------------------------
+// SoftwareRasterBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <cstdio>
+#include <vector>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Game/Subsystem/Render/SoftwareRenderBackend.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr RASTER_CUBE_COUNT = 2000;
+
+//----------------------------------------------------------------------------------------------------
+// A grid of quads over [-extent, extent] on the plane x = depth, with every inner vertex jittered
+// and one triangle in three wound the other way. Split into two triangles per cell, it covers
+// every point of the grid exactly once.
+//
+static void MakeJitteredGrid(float const depth, float const extent, int const cellCount, std::vector<Vertex_PCU>& out_vertexes)
+{
+    RandomNumberGenerator rng;
+    std::vector<Vec3>     corners;
+    float const           cellSize = 2.f * extent / static_cast<float>(cellCount);
+
+    for (int row = 0; row <= cellCount; ++row)
+    {
+        for (int column = 0; column <= cellCount; ++column)
+        {
+            bool const isBorder = row == 0 || column == 0 || row == cellCount || column == cellCount;
+            float      y        = -extent + cellSize * static_cast<float>(column);
+            float      z        = -extent + cellSize * static_cast<float>(row);
+
+            if (!isBorder)
+            {
+                y += rng.RollRandomFloatInRange(-0.3f, 0.3f) * cellSize;
+                z += rng.RollRandomFloatInRange(-0.3f, 0.3f) * cellSize;
+            }
+
+            corners.push_back(Vec3(depth, y, z));
+        }
+    }
+
+    Rgba8 const color(16, 16, 16, 255);
+
+    auto const addTriangle = [&](int const a, int const b, int const c)
+    {
+        bool const isFlipped = rng.RollRandomIntInRange(0, 2) == 0;
+
+        out_vertexes.push_back(Vertex_PCU(corners[a], color, Vec2::ZERO));
+        out_vertexes.push_back(Vertex_PCU(corners[isFlipped ? c : b], color, Vec2::ZERO));
+        out_vertexes.push_back(Vertex_PCU(corners[isFlipped ? b : c], color, Vec2::ZERO));
+    };
+
+    for (int row = 0; row < cellCount; ++row)
+    {
+        for (int column = 0; column < cellCount; ++column)
+        {
+            int const corner = row * (cellCount + 1) + column;
+
+            addTriangle(corner, corner + 1, corner + cellCount + 2);
+            addTriangle(corner, corner + cellCount + 2, corner + cellCount + 1);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Draws the grid additively with no culling or depth test: with the top-left fill rule every pixel
+// it covers gets exactly one 16, never 0 (a crack) or 32 (a double-drawn edge).
+//
+static void ValidateFillRule(Mat44 const& worldToRender, Mat44 const& renderToClip, float const depth, float const extent, int const width, int const height)
+{
+    sSoftwareRenderConfig config;
+    config.m_width       = width;
+    config.m_height      = height;
+    config.m_workerCount = 1;
+
+    SoftwareRenderBackend backend(config);
+
+    std::vector<Vertex_PCU> vertexes;
+    MakeJitteredGrid(depth, extent, 24, vertexes);
+
+    backend.ClearScreen(Rgba8(0, 0, 0, 0), Rgba8::BLACK);
+    backend.BeginCamera(worldToRender, renderToClip);
+    backend.SetBlendMode(eRenderBlendMode::ADDITIVE);
+    backend.SetRasterizerMode(eRenderRasterizerMode::SOLID_CULL_NONE);
+    backend.SetDepthMode(eRenderDepthMode::DISABLED);
+    backend.BindTexture(nullptr);
+    backend.SetModelConstants(Mat44(), Rgba8::WHITE);
+    backend.DrawVertexArray(vertexes);
+    backend.EndCamera();
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            GUARANTEE_OR_DIE(backend.GetPixel(x, y).r == 16, "Software rasterizer left a crack or drew a shared edge twice")
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// A near red triangle and a far green one over the same pixels, in both orders: red must win both times.
+//
+static void ValidateDepthTest()
+{
+    sSoftwareRenderConfig config;
+    config.m_width  = 256;
+    config.m_height = 128;
+
+    SoftwareRenderBackend backend(config);
+
+    Mat44 worldToRender;
+    Mat44 renderToClip;
+    MakeBenchmarkCameraTransforms(worldToRender, renderToClip);
+
+    // One triangle each, both covering the center of the view
+    std::vector<Vertex_PCU> nearTriangle;
+    std::vector<Vertex_PCU> farTriangle;
+    nearTriangle.push_back(Vertex_PCU(Vec3(5.f, 2.f, -1.f), Rgba8::RED, Vec2::ZERO));
+    nearTriangle.push_back(Vertex_PCU(Vec3(5.f, -2.f, -1.f), Rgba8::RED, Vec2::ZERO));
+    nearTriangle.push_back(Vertex_PCU(Vec3(5.f, 0.f, 2.f), Rgba8::RED, Vec2::ZERO));
+    farTriangle.push_back(Vertex_PCU(Vec3(6.f, 2.f, -1.f), Rgba8::GREEN, Vec2::ZERO));
+    farTriangle.push_back(Vertex_PCU(Vec3(6.f, -2.f, -1.f), Rgba8::GREEN, Vec2::ZERO));
+    farTriangle.push_back(Vertex_PCU(Vec3(6.f, 0.f, 2.f), Rgba8::GREEN, Vec2::ZERO));
+
+    for (int order = 0; order < 2; ++order)
+    {
+        backend.ClearScreen(Rgba8::BLACK, Rgba8::BLACK);
+        backend.BeginCamera(worldToRender, renderToClip);
+        backend.SetRasterizerMode(eRenderRasterizerMode::SOLID_CULL_NONE);
+        backend.SetModelConstants(Mat44(), Rgba8::WHITE);
+        backend.DrawVertexArray(order == 0 ? nearTriangle : farTriangle);
+        backend.DrawVertexArray(order == 0 ? farTriangle : nearTriangle);
+        backend.EndCamera();
+
+        GUARANTEE_OR_DIE(backend.GetPixel(128, 64) == Rgba8::RED, "Software rasterizer depth test let a farther triangle through")
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Random cubes in front of the benchmark camera, half of them textured.
+//
+static void RenderCubeScene(SoftwareRenderBackend& backend, int const cubeMeshId, Texture const* texture, std::vector<Mat44> const& transforms, std::vector<Rgba8> const& colors)
+{
+    Mat44 worldToRender;
+    Mat44 renderToClip;
+    MakeBenchmarkCameraTransforms(worldToRender, renderToClip);
+
+    backend.BeginFrame();
+    backend.ClearScreen(Rgba8::GREY, Rgba8::BLACK);
+    backend.BeginCamera(worldToRender, renderToClip);
+    backend.SetRasterizerMode(eRenderRasterizerMode::SOLID_CULL_BACK);
+    backend.SetSamplerMode(eRenderSamplerMode::BILINEAR_WRAP);
+
+    for (size_t cubeIndex = 0; cubeIndex < transforms.size(); ++cubeIndex)
+    {
+        backend.BindTexture(cubeIndex % 2 == 0 ? texture : nullptr);
+        backend.SetModelConstants(transforms[cubeIndex], colors[cubeIndex]);
+        backend.DrawStaticMesh(cubeMeshId);
+    }
+
+    backend.EndCamera();
+    backend.EndFrame();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Checks coverage and depth against exact expectations, checks that one and several workers produce
+// the same image, then times whole frames.
+//
+void RunSoftwareRasterBenchmarks()
+{
+    Mat44 worldToRender;
+    Mat44 renderToClip;
+    MakeBenchmarkCameraTransforms(worldToRender, renderToClip);
+
+    // Clip space directly, odd sizes so tiles and SSE rows end mid-chunk; then through a perspective
+    // camera with the grid well past every side of the view, so shared edges are clipped too
+    Mat44 clipSpace;
+    clipSpace.m_values[Mat44::Ix] = 0.f;
+    clipSpace.m_values[Mat44::Iz] = 1.f;
+    clipSpace.m_values[Mat44::Jx] = 1.f;
+    clipSpace.m_values[Mat44::Jy] = 0.f;
+    clipSpace.m_values[Mat44::Ky] = 1.f;
+    clipSpace.m_values[Mat44::Kz] = 0.f;
+
+    ValidateFillRule(clipSpace, Mat44(), 0.5f, 1.f, 333, 187);
+    ValidateFillRule(worldToRender, renderToClip, 10.f, 20.f, 400, 200);
+    ValidateDepthTest();
+
+    RandomNumberGenerator rng;
+    std::vector<Mat44>    transforms;
+    std::vector<Rgba8>    colors;
+
+    for (int cubeIndex = 0; cubeIndex < RASTER_CUBE_COUNT; ++cubeIndex)
+    {
+        Mat44 transform;
+        transform.AppendZRotation(rng.RollRandomFloatInRange(0.f, 360.f));
+        transform.AppendYRotation(rng.RollRandomFloatInRange(0.f, 360.f));
+        transform.SetTranslation3D(Vec3(rng.RollRandomFloatInRange(3.f, 60.f), rng.RollRandomFloatInRange(-30.f, 30.f), rng.RollRandomFloatInRange(-15.f, 15.f)));
+        transforms.push_back(transform);
+        colors.push_back(Rgba8(static_cast<unsigned char>(rng.RollRandomIntInRange(64, 255)), static_cast<unsigned char>(rng.RollRandomIntInRange(64, 255)), static_cast<unsigned char>(rng.RollRandomIntInRange(64, 255))));
+    }
+
+    std::vector<Vertex_PCU> cubeVertexes;
+    AddVertsForAABB3D(cubeVertexes, AABB3(Vec3(-0.5f, -0.5f, -0.5f), Vec3(0.5f, 0.5f, 0.5f)));
+
+    sSoftwareRenderConfig singleWorkerConfig;
+    singleWorkerConfig.m_workerCount = 1;
+
+    SoftwareRenderBackend singleWorkerBackend(singleWorkerConfig);
+    SoftwareRenderBackend multiWorkerBackend;
+
+    int const      singleCubeMeshId = singleWorkerBackend.CreateStaticMesh(cubeVertexes, std::vector<unsigned int>());
+    int const      multiCubeMeshId  = multiWorkerBackend.CreateStaticMesh(cubeVertexes, std::vector<unsigned int>());
+    Texture const* singleTexture    = singleWorkerBackend.CreateOrGetTextureFromFile("Data/Images/TestUV.png");
+    Texture const* multiTexture     = multiWorkerBackend.CreateOrGetTextureFromFile("Data/Images/TestUV.png");
+
+    RenderCubeScene(singleWorkerBackend, singleCubeMeshId, singleTexture, transforms, colors);
+    RenderCubeScene(multiWorkerBackend, multiCubeMeshId, multiTexture, transforms, colors);
+
+    std::vector<Rgba8> singleWorkerImage;
+    std::vector<Rgba8> multiWorkerImage;
+    singleWorkerBackend.ReadColorBuffer(singleWorkerImage);
+    multiWorkerBackend.ReadColorBuffer(multiWorkerImage);
+
+    GUARANTEE_OR_DIE(singleWorkerImage == multiWorkerImage, "Software rasterizer image depends on the worker count")
+
+    uint64_t const firstHash = multiWorkerBackend.GetColorBufferHash();
+    RenderCubeScene(multiWorkerBackend, multiCubeMeshId, multiTexture, transforms, colors);
+    GUARANTEE_OR_DIE(multiWorkerBackend.GetColorBufferHash() == firstHash, "Software rasterizer is not deterministic from frame to frame")
+
+    sSoftwareRenderStatistics const& statistics = multiWorkerBackend.GetRasterStatistics();
+    printf("SoftwareRenderBackend: %d triangles, %d culled, %d binned, %d tile bin entries, %lld pixels written, image hash %016llx\n",
+           statistics.m_trianglesSubmitted, statistics.m_trianglesCulled, statistics.m_trianglesBinned, statistics.m_tileBinEntries,
+           static_cast<long long>(statistics.m_pixelsWritten), static_cast<unsigned long long>(firstHash));
+
+    RunBenchmark(Stringf("SoftwareRenderBackend frame 1 worker x%d cubes", RASTER_CUBE_COUNT), 20, RASTER_CUBE_COUNT, [&]()
+    {
+        RenderCubeScene(singleWorkerBackend, singleCubeMeshId, singleTexture, transforms, colors);
+    });
+
+    RunBenchmark(Stringf("SoftwareRenderBackend frame %d workers x%d cubes", sSoftwareRenderConfig().m_workerCount, RASTER_CUBE_COUNT), 20, RASTER_CUBE_COUNT, [&]()
+    {
+        RenderCubeScene(multiWorkerBackend, multiCubeMeshId, multiTexture, transforms, colors);
+    });
+}
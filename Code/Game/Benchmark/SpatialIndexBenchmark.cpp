@@ -0,0 +1,196 @@
+//----------------------------------------------------------------------------------------------------
+// SpatialIndexBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Game/EntityStore.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr SPATIAL_ENTITY_COUNT = 100000;
+static int constexpr SPATIAL_QUERY_COUNT  = 1000;
+
+//----------------------------------------------------------------------------------------------------
+// Props scattered over a 1 km square, using four meshes with bounding radii from 0.5 to 2 m.
+//
+static void PopulateSpatialTestStore(EntityStore& store, std::vector<sBoundingSphere> const& localSpheresByMesh, RandomNumberGenerator& rng)
+{
+    store.Reserve(SPATIAL_ENTITY_COUNT);
+
+    for (int entityIndex = 0; entityIndex < SPATIAL_ENTITY_COUNT; ++entityIndex)
+    {
+        Vec3 const position(rng.RollRandomFloatInRange(-500.f, 500.f), rng.RollRandomFloatInRange(-500.f, 500.f), rng.RollRandomFloatInRange(0.f, 20.f));
+        store.CreateEntity(entityIndex % static_cast<int>(localSpheresByMesh.size()), position);
+    }
+
+    store.UpdateModelToWorldTransforms();
+    store.UpdateWorldBoundingSpheres(localSpheresByMesh);
+    store.UpdateSpatialIndex();
+}
+
+//----------------------------------------------------------------------------------------------------
+static float GetBruteForceRaycastDistance(EntityStore const& store, Vec3 const& start, Vec3 const& forwardNormal, float const maxDistance)
+{
+    float closestDistance = maxDistance;
+
+    for (sBoundingSphere const& sphere : store.m_worldBoundingSpheres)
+    {
+        Vec3 const  toStart         = start - sphere.m_center;
+        float const projection      = toStart.x * forwardNormal.x + toStart.y * forwardNormal.y + toStart.z * forwardNormal.z;
+        float const startDistanceSq = toStart.x * toStart.x + toStart.y * toStart.y + toStart.z * toStart.z - sphere.m_radius * sphere.m_radius;
+        float const discriminant    = projection * projection - startDistanceSq;
+
+        if ((startDistanceSq > 0.f && projection > 0.f) || discriminant < 0.f)
+        {
+            continue;
+        }
+
+        float const distance = fmaxf(-projection - sqrtf(discriminant), 0.f);
+        closestDistance      = distance < closestDistance ? distance : closestDistance;
+    }
+
+    return closestDistance;
+}
+
+//----------------------------------------------------------------------------------------------------
+static int GetBruteForceOverlapCount(EntityStore const& store, Vec3 const& center, float const radius)
+{
+    int overlapCount = 0;
+
+    for (sBoundingSphere const& sphere : store.m_worldBoundingSpheres)
+    {
+        Vec3 const  displacement = sphere.m_center - center;
+        float const radiusSum    = sphere.m_radius + radius;
+
+        overlapCount += displacement.x * displacement.x + displacement.y * displacement.y + displacement.z * displacement.z <= radiusSum * radiusSum ? 1 : 0;
+    }
+
+    return overlapCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Compares the first 100 rays and spheres against brute-force sweeps over every entity.
+//
+static void ValidateSpatialQueries(EntityStore const& store, std::vector<Vec3> const& rayStarts, std::vector<Vec3> const& rayForwardNormals, float const rayLength, std::vector<Vec3> const& sphereCenters, float const sphereRadius)
+{
+    std::vector<EntityHandle> overlaps;
+
+    for (int queryIndex = 0; queryIndex < 100; ++queryIndex)
+    {
+        sEntityRaycastResult const result           = store.RaycastEntities(rayStarts[queryIndex], rayForwardNormals[queryIndex], rayLength);
+        float const                expectedDistance = GetBruteForceRaycastDistance(store, rayStarts[queryIndex], rayForwardNormals[queryIndex], rayLength);
+        float const                actualDistance   = result.m_didHit ? result.m_impactDistance : rayLength;
+        GUARANTEE_OR_DIE(fabsf(expectedDistance - actualDistance) < 1e-3f, "RaycastEntities does not match the brute-force raycast")
+
+        overlaps.clear();
+        int const overlapCount = store.OverlapSphere(sphereCenters[queryIndex], sphereRadius, overlaps);
+        GUARANTEE_OR_DIE(overlapCount == GetBruteForceOverlapCount(store, sphereCenters[queryIndex], sphereRadius), "OverlapSphere does not match the brute-force overlap")
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Times building the DynamicAABBTree over 100k props, refitting it after motion, and ray, sphere, and
+// frustum queries against it. Every query type is checked against a brute-force sweep first.
+//
+void RunSpatialIndexBenchmarks()
+{
+    std::vector<sBoundingSphere> localSpheresByMesh(4);
+
+    for (int meshIndex = 0; meshIndex < 4; ++meshIndex)
+    {
+        localSpheresByMesh[meshIndex].m_radius = 0.5f + 0.5f * static_cast<float>(meshIndex);
+    }
+
+    RandomNumberGenerator rng;
+    EntityStore           store;
+    PopulateSpatialTestStore(store, localSpheresByMesh, rng);
+
+    printf("DynamicAABBTree: %d proxies, height %d\n", store.GetSpatialIndex().GetProxyCount(), store.GetSpatialIndex().GetHeight());
+
+    std::vector<Vec3> rayStarts(SPATIAL_QUERY_COUNT);
+    std::vector<Vec3> rayForwardNormals(SPATIAL_QUERY_COUNT);
+    std::vector<Vec3> sphereCenters(SPATIAL_QUERY_COUNT);
+
+    for (int queryIndex = 0; queryIndex < SPATIAL_QUERY_COUNT; ++queryIndex)
+    {
+        rayStarts[queryIndex]         = Vec3(rng.RollRandomFloatInRange(-500.f, 500.f), rng.RollRandomFloatInRange(-500.f, 500.f), 10.f);
+        rayForwardNormals[queryIndex] = Vec3(rng.RollRandomFloatInRange(-1.f, 1.f), rng.RollRandomFloatInRange(-1.f, 1.f), rng.RollRandomFloatInRange(-0.2f, 0.2f)).GetNormalized();
+        sphereCenters[queryIndex]     = Vec3(rng.RollRandomFloatInRange(-500.f, 500.f), rng.RollRandomFloatInRange(-500.f, 500.f), 10.f);
+    }
+
+    std::vector<sEntityRaycastResult> rayResults(SPATIAL_QUERY_COUNT);
+    std::vector<EntityHandle>         queryResults;
+    float constexpr                   rayLength    = 100.f;
+    float constexpr                   sphereRadius = 10.f;
+
+    ValidateSpatialQueries(store, rayStarts, rayForwardNormals, rayLength, sphereCenters, sphereRadius);
+
+    sFrustum const frustum = sFrustum::MakeFromWorldToClip(MakeBenchmarkWorldToClip());
+    queryResults.clear();
+    int const frustumCount = store.QueryFrustum(frustum, queryResults);
+
+    std::vector<uint8_t> isVisible(SPATIAL_ENTITY_COUNT);
+    int const            culledVisibleCount = CullSpheres(frustum, store.m_worldBoundingSpheres.data(), SPATIAL_ENTITY_COUNT, isVisible.data());
+    printf("QueryFrustum: %d candidates for %d visible spheres\n", frustumCount, culledVisibleCount);
+    GUARANTEE_OR_DIE(frustumCount >= culledVisibleCount, "QueryFrustum missed entities that CullSpheres reports visible")
+
+    RunBenchmark(Stringf("Spatial build x%d", SPATIAL_ENTITY_COUNT), 5, SPATIAL_ENTITY_COUNT, [&]()
+    {
+        EntityStore buildStore;
+        PopulateSpatialTestStore(buildStore, localSpheresByMesh, rng);
+    });
+
+    // One percent of props teleport and the rest drift by less than the fat margin
+    RunBenchmark(Stringf("Spatial refit x%d", SPATIAL_ENTITY_COUNT), 20, SPATIAL_ENTITY_COUNT, [&]()
+    {
+        for (int entityIndex = 0; entityIndex < SPATIAL_ENTITY_COUNT; ++entityIndex)
+        {
+            Vec3& position = store.m_positions[entityIndex];
+
+            if (entityIndex % 100 == 0)
+            {
+                position = Vec3(rng.RollRandomFloatInRange(-500.f, 500.f), rng.RollRandomFloatInRange(-500.f, 500.f), rng.RollRandomFloatInRange(0.f, 20.f));
+            }
+            else
+            {
+                position.x += rng.RollRandomFloatInRange(-0.01f, 0.01f);
+            }
+        }
+
+        store.UpdateModelToWorldTransforms();
+        store.UpdateWorldBoundingSpheres(localSpheresByMesh);
+        store.UpdateSpatialIndex();
+    });
+
+    // The refits above went through incremental MoveProxy, not Rebuild
+    ValidateSpatialQueries(store, rayStarts, rayForwardNormals, rayLength, sphereCenters, sphereRadius);
+    printf("DynamicAABBTree after refits: height %d\n", store.GetSpatialIndex().GetHeight());
+
+    RunBenchmark(Stringf("Spatial raycast %.0fm x%d", static_cast<double>(rayLength), SPATIAL_QUERY_COUNT), 20, SPATIAL_QUERY_COUNT, [&]()
+    {
+        store.RaycastEntities(rayStarts.data(), rayForwardNormals.data(), rayLength, SPATIAL_QUERY_COUNT, rayResults.data());
+    });
+
+    RunBenchmark(Stringf("Spatial sphere overlap %.0fm x%d", static_cast<double>(sphereRadius), SPATIAL_QUERY_COUNT), 20, SPATIAL_QUERY_COUNT, [&]()
+    {
+        for (Vec3 const& center : sphereCenters)
+        {
+            queryResults.clear();
+            store.OverlapSphere(center, sphereRadius, queryResults);
+        }
+    });
+
+    RunBenchmark("Spatial frustum query", 100, 1, [&]()
+    {
+        queryResults.clear();
+        store.QueryFrustum(frustum, queryResults);
+    });
+}
@@ -0,0 +1,315 @@
+//----------------------------------------------------------------------------------------------------
+// TextureCacheBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <vector>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Game/Subsystem/Render/SoftwareRenderBackend.hpp"
+#include "Game/Subsystem/Resource/CookedTexture.hpp"
+#include "Game/Subsystem/Resource/MappedFile.hpp"
+#include "Game/Subsystem/Resource/TextureCache.hpp"
+#include "ThirdParty/stb/stb_image.h"
+
+//----------------------------------------------------------------------------------------------------
+static char constexpr CACHE_DIRECTORY[]  = "TextureCacheBenchmark_cache";
+static char constexpr SOURCE_COPY_PATH[] = "TextureCacheBenchmark_source.png";
+
+// Every image the game loads at startup
+static int constexpr     STARTUP_IMAGE_COUNT                      = 2;
+static char const* const STARTUP_IMAGE_PATHS[STARTUP_IMAGE_COUNT] = { "Data/Images/TestUV.png", "Data/Fonts/SquirrelFixedFont.png" };
+
+//----------------------------------------------------------------------------------------------------
+static String ReadWholeFile(char const* filePath)
+{
+    MappedFile file;
+    GUARANTEE_OR_DIE(file.Open(filePath), Stringf("Could not read \"%s\"", filePath))
+
+    return String(reinterpret_cast<char const*>(file.GetData()), file.GetSize());
+}
+
+//----------------------------------------------------------------------------------------------------
+// BuildTextureMip written the obvious way, one channel at a time.
+//
+static std::vector<Rgba8> MakeReferenceMip(Rgba8 const* source, int const sourceWidth, int const sourceHeight)
+{
+    int const          mipWidth  = GetTextureMipSize(sourceWidth, 1);
+    int const          mipHeight = GetTextureMipSize(sourceHeight, 1);
+    std::vector<Rgba8> mip;
+
+    for (int y = 0; y < mipHeight; ++y)
+    {
+        for (int x = 0; x < mipWidth; ++x)
+        {
+            int const     columns[2] = { 2 * x, 2 * x + 1 < sourceWidth ? 2 * x + 1 : 2 * x };
+            int const     rows[2]    = { 2 * y, 2 * y + 1 < sourceHeight ? 2 * y + 1 : 2 * y };
+            unsigned char channels[4];
+
+            for (int channel = 0; channel < 4; ++channel)
+            {
+                int sum = 2;
+
+                for (int row : rows)
+                {
+                    for (int column : columns)
+                    {
+                        sum += reinterpret_cast<unsigned char const*>(&source[row * sourceWidth + column])[channel];
+                    }
+                }
+
+                channels[channel] = static_cast<unsigned char>(sum / 4);
+            }
+
+            mip.push_back(Rgba8(channels[0], channels[1], channels[2], channels[3]));
+        }
+    }
+
+    return mip;
+}
+
+//----------------------------------------------------------------------------------------------------
+// One full-screen quad of the texture, so two backends can be compared by their images.
+//
+static void RenderTexturedQuad(SoftwareRenderBackend& backend, char const* imageFilePath, std::vector<Rgba8>& out_image)
+{
+    Mat44 worldToRender;
+    Mat44 renderToClip;
+    MakeBenchmarkCameraTransforms(worldToRender, renderToClip);
+
+    std::vector<Vertex_PCU> vertexes;
+    AddVertsForQuad3D(vertexes, Vec3(2.f, 2.f, -1.f), Vec3(2.f, -2.f, -1.f), Vec3(2.f, 2.f, 1.f), Vec3(2.f, -2.f, 1.f));
+
+    backend.ClearScreen(Rgba8::BLACK, Rgba8::BLACK);
+    backend.BeginCamera(worldToRender, renderToClip);
+    backend.SetRasterizerMode(eRenderRasterizerMode::SOLID_CULL_NONE);
+    backend.SetSamplerMode(eRenderSamplerMode::POINT_CLAMP);
+    backend.BindTexture(backend.CreateOrGetTextureFromFile(imageFilePath));
+    backend.SetModelConstants(Mat44(), Rgba8::WHITE);
+    backend.DrawVertexArray(vertexes);
+    backend.EndCamera();
+    backend.ReadColorBuffer(out_image);
+}
+
+//----------------------------------------------------------------------------------------------------
+// The SSE mip filter against a plain one, a cooked image against its decode, the cache's hit,
+// miss and recovery paths, and a software-rendered frame with and without the cache.
+//
+static void ValidateTextureCache()
+{
+    int const sizes[][2] = { { 64, 64 }, { 37, 19 }, { 18, 7 }, { 1, 9 }, { 9, 1 }, { 3, 3 }, { 2, 1 } };
+    uint32_t  seed       = 12345;
+
+    for (auto const& size : sizes)
+    {
+        std::vector<Rgba8> source;
+
+        for (int texelIndex = 0; texelIndex < size[0] * size[1]; ++texelIndex)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            source.push_back(Rgba8(static_cast<unsigned char>(seed >> 24), static_cast<unsigned char>(seed >> 16), static_cast<unsigned char>(seed >> 8), static_cast<unsigned char>(seed)));
+        }
+
+        std::vector<Rgba8> const reference = MakeReferenceMip(source.data(), size[0], size[1]);
+        std::vector<Rgba8>       mip(reference.size());
+        BuildTextureMip(source.data(), size[0], size[1], mip.data());
+
+        GUARANTEE_OR_DIE(memcmp(mip.data(), reference.data(), mip.size() * sizeof(Rgba8)) == 0, Stringf("BuildTextureMip is wrong for a %d x %d source", size[0], size[1]))
+    }
+
+    GUARANTEE_OR_DIE(GetTextureMipCount(512, 512) == 10 && GetTextureMipCount(37, 19) == 6 && GetTextureMipCount(1, 1) == 1, "GetTextureMipCount does not run down to 1 x 1")
+
+    std::error_code removeError;
+    std::filesystem::remove_all(CACHE_DIRECTORY, removeError);
+
+    sTextureCacheConfig cacheConfig;
+    cacheConfig.m_directory = CACHE_DIRECTORY;
+
+    TextureCache  cache(cacheConfig);
+    CookedTexture texture;
+    String        error;
+    char const*   imagePath = STARTUP_IMAGE_PATHS[0];
+
+    GUARANTEE_OR_DIE(cache.Load(imagePath, texture, &error), Stringf("TextureCache could not cook \"%s\": %s", imagePath, error.c_str()))
+    GUARANTEE_OR_DIE(cache.GetStatistics().m_cookedCount == 1 && cache.GetStatistics().m_hitCount == 0, "TextureCache hit an empty cache")
+
+    int            width        = 0;
+    int            height       = 0;
+    int            channelCount = 0;
+    unsigned char* pixels       = stbi_load(imagePath, &width, &height, &channelCount, 4);
+    bool           isTopMipSame = pixels != nullptr && texture.GetWidth() == width && texture.GetHeight() == height;
+
+    for (int row = 0; isTopMipSame && row < height; ++row)
+    {
+        isTopMipSame = memcmp(texture.GetMipTexels(0) + static_cast<size_t>(row) * width, pixels + static_cast<size_t>(height - 1 - row) * width * 4, static_cast<size_t>(width) * 4) == 0;
+    }
+
+    stbi_image_free(pixels);
+    GUARANTEE_OR_DIE(isTopMipSame, "A cooked texture's top mip is not its image, bottom row first")
+    GUARANTEE_OR_DIE(texture.GetMipCount() == GetTextureMipCount(width, height), "A cooked texture is missing mips")
+
+    for (int mipLevel = 1; mipLevel < texture.GetMipCount(); ++mipLevel)
+    {
+        std::vector<Rgba8> const reference = MakeReferenceMip(texture.GetMipTexels(mipLevel - 1), GetTextureMipSize(width, mipLevel - 1), GetTextureMipSize(height, mipLevel - 1));
+        GUARANTEE_OR_DIE(memcmp(texture.GetMipTexels(mipLevel), reference.data(), reference.size() * sizeof(Rgba8)) == 0, Stringf("Cooked mip %d is not the box filter of the one above it", mipLevel))
+    }
+
+    GUARANTEE_OR_DIE(cache.Load(imagePath, texture) && cache.GetStatistics().m_hitCount == 1, "TextureCache recooked an image it already had")
+    GUARANTEE_OR_DIE(cache.GetStatistics().m_cookedSeconds > cache.GetStatistics().m_hitSeconds && cache.GetStatistics().m_hitSeconds > 0.0, "TextureCache did not time its cook and its hit apart")
+
+    // The same bytes under another path share the cooked file; other bytes under that path do not
+    String const imageBytes = ReadWholeFile(imagePath);
+    GUARANTEE_OR_DIE(WriteBenchmarkTextFile(SOURCE_COPY_PATH, imageBytes), "Could not copy the benchmark image")
+    GUARANTEE_OR_DIE(cache.Load(SOURCE_COPY_PATH, texture) && cache.GetStatistics().m_hitCount == 2, "TextureCache did not key a copied image by its content")
+
+    GUARANTEE_OR_DIE(WriteBenchmarkTextFile(SOURCE_COPY_PATH, ReadWholeFile(STARTUP_IMAGE_PATHS[1])), "Could not overwrite the benchmark image")
+    GUARANTEE_OR_DIE(cache.Load(SOURCE_COPY_PATH, texture) && cache.GetStatistics().m_cookedCount == 2 && texture.GetWidth() != width, "TextureCache served a stale texture for an edited image")
+
+    // A truncated cooked file is recooked, not served
+    String const cookedFilePath = cache.GetCookedFilePath(HashTextureSource(reinterpret_cast<unsigned char const*>(imageBytes.data()), imageBytes.size()));
+    String const cookedBytes    = ReadWholeFile(cookedFilePath.c_str());
+    texture.Unload();
+    GUARANTEE_OR_DIE(WriteBenchmarkTextFile(cookedFilePath, cookedBytes.substr(0, cookedBytes.size() / 2)), "Could not truncate a cooked texture")
+    GUARANTEE_OR_DIE(cache.Load(imagePath, texture) && cache.GetStatistics().m_cookedCount == 3 && texture.GetWidth() == width, "TextureCache did not recook a truncated file")
+
+    GUARANTEE_OR_DIE(WriteBenchmarkTextFile(SOURCE_COPY_PATH, "not an image"), "Could not write the benchmark image")
+    GUARANTEE_OR_DIE(!cache.Load(SOURCE_COPY_PATH, texture, &error) && !texture.IsLoaded() && cache.GetStatistics().m_failedCount == 1, "TextureCache cooked a file that is not an image")
+
+    sSoftwareRenderConfig renderConfig;
+    renderConfig.m_width  = 256;
+    renderConfig.m_height = 128;
+
+    SoftwareRenderBackend decodingBackend(renderConfig);
+    renderConfig.m_textureCache = &cache;
+    SoftwareRenderBackend cachedBackend(renderConfig);
+
+    std::vector<Rgba8> decodedImage;
+    std::vector<Rgba8> cachedImage;
+    RenderTexturedQuad(decodingBackend, imagePath, decodedImage);
+    RenderTexturedQuad(cachedBackend, imagePath, cachedImage);
+
+    GUARANTEE_OR_DIE(decodedImage == cachedImage && cache.GetStatistics().m_hitCount == 3, "SoftwareRenderBackend drew a cached texture differently from a decoded one")
+
+    remove(SOURCE_COPY_PATH);
+}
+
+//----------------------------------------------------------------------------------------------------
+// What a launch without the cache pays for each image: decode it, then build the mips.
+//
+static size_t DecodeWithMips(char const* imageFilePath)
+{
+    int            width        = 0;
+    int            height       = 0;
+    int            channelCount = 0;
+    unsigned char* pixels       = stbi_load(imageFilePath, &width, &height, &channelCount, 4);
+
+    std::vector<Rgba8> mip(reinterpret_cast<Rgba8 const*>(pixels), reinterpret_cast<Rgba8 const*>(pixels) + static_cast<size_t>(width) * height);
+    size_t             texelCount = mip.size();
+    stbi_image_free(pixels);
+
+    for (int mipLevel = 1; mipLevel < GetTextureMipCount(width, height); ++mipLevel)
+    {
+        std::vector<Rgba8> nextMip(static_cast<size_t>(GetTextureMipSize(width, mipLevel)) * GetTextureMipSize(height, mipLevel));
+        BuildTextureMip(mip.data(), GetTextureMipSize(width, mipLevel - 1), GetTextureMipSize(height, mipLevel - 1), nextMip.data());
+
+        texelCount += nextMip.size();
+        mip.swap(nextMip);
+    }
+
+    return texelCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Reads every mip, as an upload would, so the timing includes paging the file in.
+//
+static uint32_t ReadEveryMip(CookedTexture const& texture)
+{
+    uint32_t sum = 0;
+
+    for (int mipLevel = 0; mipLevel < texture.GetMipCount(); ++mipLevel)
+    {
+        Rgba8 const* texels     = texture.GetMipTexels(mipLevel);
+        size_t const texelCount = static_cast<size_t>(GetTextureMipSize(texture.GetWidth(), mipLevel)) * GetTextureMipSize(texture.GetHeight(), mipLevel);
+
+        for (size_t texelIndex = 0; texelIndex < texelCount; ++texelIndex)
+        {
+            sum += texels[texelIndex].r + texels[texelIndex].a;
+        }
+    }
+
+    return sum;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Checks the cache, then times loading the startup textures without it, with a cold cache (every
+// image cooked) and with a warm one (every image mapped from its cooked file).
+//
+void RunTextureCacheBenchmarks()
+{
+    ValidateTextureCache();
+
+    sTextureCacheConfig cacheConfig;
+    cacheConfig.m_directory = CACHE_DIRECTORY;
+
+    TextureCache  cache(cacheConfig);
+    CookedTexture textures[STARTUP_IMAGE_COUNT];
+    size_t        texelCount = 0;
+    uint32_t      checksum   = 0;
+
+    sBenchmarkResult const uncachedResult = RunBenchmark(Stringf("Startup textures x%d, no cache (decode + mips)", STARTUP_IMAGE_COUNT), 20, STARTUP_IMAGE_COUNT, [&texelCount]()
+    {
+        for (char const* imagePath : STARTUP_IMAGE_PATHS)
+        {
+            texelCount += DecodeWithMips(imagePath);
+        }
+    });
+
+    sBenchmarkResult const coldResult = RunBenchmark(Stringf("Startup textures x%d, cold cache (decode + mips + write + map)", STARTUP_IMAGE_COUNT), 20, STARTUP_IMAGE_COUNT, [&cache, &textures]()
+    {
+        for (CookedTexture& texture : textures)
+        {
+            texture.Unload();
+        }
+
+        std::error_code removeError;
+        std::filesystem::remove_all(CACHE_DIRECTORY, removeError);
+
+        for (int imageIndex = 0; imageIndex < STARTUP_IMAGE_COUNT; ++imageIndex)
+        {
+            cache.Load(STARTUP_IMAGE_PATHS[imageIndex], textures[imageIndex]);
+        }
+    });
+
+    sBenchmarkResult const warmResult = RunBenchmark(Stringf("Startup textures x%d, warm cache (hash + map + read every mip)", STARTUP_IMAGE_COUNT), 200, STARTUP_IMAGE_COUNT, [&cache, &textures, &checksum]()
+    {
+        for (int imageIndex = 0; imageIndex < STARTUP_IMAGE_COUNT; ++imageIndex)
+        {
+            cache.Load(STARTUP_IMAGE_PATHS[imageIndex], textures[imageIndex]);
+            checksum += ReadEveryMip(textures[imageIndex]);
+        }
+    });
+
+    printf("Startup textures: no cache %.2f ms, cold cache %.2f ms, warm cache %.2f ms (%.0fx faster than no cache; checksum %zu/%u)\n",
+           uncachedResult.m_secondsPerIteration * 1000.0, coldResult.m_secondsPerIteration * 1000.0, warmResult.m_secondsPerIteration * 1000.0,
+           uncachedResult.m_secondsPerIteration / warmResult.m_secondsPerIteration, texelCount, checksum);
+
+    GUARANTEE_OR_DIE(cache.GetStatistics().m_failedCount == 0, "TextureCache failed to load a startup texture")
+    GUARANTEE_OR_DIE(warmResult.m_secondsPerIteration < uncachedResult.m_secondsPerIteration && warmResult.m_secondsPerIteration < coldResult.m_secondsPerIteration, "A warm texture cache was not faster than decoding")
+
+    for (CookedTexture& texture : textures)
+    {
+        texture.Unload();
+    }
+
+    std::error_code removeError;
+    std::filesystem::remove_all(CACHE_DIRECTORY, removeError);
+}
@@ -0,0 +1,225 @@
+//----------------------------------------------------------------------------------------------------
+// TimestepBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Game/Entity.hpp"
+#include "Game/EntityStore.hpp"
+#include "Game/Framework/FixedTimestep.hpp"
+#include "Game/Framework/FrameLimiter.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr    TIMESTEP_ENTITY_COUNT  = 10000;
+static int constexpr    DETERMINISM_STEP_COUNT = 600;
+static int constexpr    LIMITER_FRAME_COUNT    = 100;
+static double constexpr LIMITER_TARGET_FPS     = 200.0;
+
+//----------------------------------------------------------------------------------------------------
+static void FillTimestepStore(EntityStore& out_entityStore)
+{
+    RandomNumberGenerator rng;
+    out_entityStore.Reserve(TIMESTEP_ENTITY_COUNT);
+
+    for (int entityIndex = 0; entityIndex < TIMESTEP_ENTITY_COUNT; ++entityIndex)
+    {
+        Vec3 const        position(rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(0.f, 10.f));
+        EulerAngles const angularVelocity(rng.RollRandomFloatInRange(-90.f, 90.f), rng.RollRandomFloatInRange(-90.f, 90.f), rng.RollRandomFloatInRange(-90.f, 90.f));
+
+        out_entityStore.CreateEntity(0, position, EulerAngles::ZERO, angularVelocity);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Frame times around `framesPerSecond`, +-50% at random, the way a busy frame loop jitters.
+//
+static double GetJitteredFrameSeconds(RandomNumberGenerator& rng, double const framesPerSecond)
+{
+    return static_cast<double>(rng.RollRandomFloatInRange(0.5f, 1.5f)) / framesPerSecond;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Runs DETERMINISM_STEP_COUNT fixed steps, fed by frames at `framesPerSecond`.
+//
+static void SimulateFixedSteps(EntityStore& entityStore, double const framesPerSecond)
+{
+    RandomNumberGenerator rng;
+    FixedTimestep         timestep;
+    float const           stepSeconds = static_cast<float>(timestep.GetStepSeconds());
+    int                   stepsRun    = 0;
+
+    while (stepsRun < DETERMINISM_STEP_COUNT)
+    {
+        int const stepCount = timestep.Advance(GetJitteredFrameSeconds(rng, framesPerSecond));
+
+        for (int step = 0; step < stepCount && stepsRun < DETERMINISM_STEP_COUNT; ++step, ++stepsRun)
+        {
+            entityStore.BeginSimulationStep();
+            entityStore.UpdateOrientations(stepSeconds);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// The same simulated time, integrated once per frame with that frame's delta.
+//
+static void SimulateVariableSteps(EntityStore& entityStore, double const framesPerSecond)
+{
+    RandomNumberGenerator rng;
+    double const          totalSeconds     = static_cast<double>(DETERMINISM_STEP_COUNT) / 60.0;
+    double                simulatedSeconds = 0.0;
+
+    while (simulatedSeconds < totalSeconds)
+    {
+        double frameSeconds = GetJitteredFrameSeconds(rng, framesPerSecond);
+        frameSeconds        = simulatedSeconds + frameSeconds > totalSeconds ? totalSeconds - simulatedSeconds : frameSeconds;
+
+        entityStore.UpdateOrientations(static_cast<float>(frameSeconds));
+        simulatedSeconds += frameSeconds;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+static float GetMaxOrientationDifference(EntityStore const& a, EntityStore const& b)
+{
+    float maxDifference = 0.f;
+
+    for (int entityIndex = 0; entityIndex < a.GetCount(); ++entityIndex)
+    {
+        EulerAngles const& orientationA = a.m_orientations[entityIndex];
+        EulerAngles const& orientationB = b.m_orientations[entityIndex];
+
+        maxDifference = fmaxf(maxDifference, fabsf(orientationA.m_yawDegrees - orientationB.m_yawDegrees));
+        maxDifference = fmaxf(maxDifference, fabsf(orientationA.m_pitchDegrees - orientationB.m_pitchDegrees));
+        maxDifference = fmaxf(maxDifference, fabsf(orientationA.m_rollDegrees - orientationB.m_rollDegrees));
+    }
+
+    return maxDifference;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Step counts, carried time and dropped time against a hand count, then the same world simulated
+// at 144 and 30 frames per second: bit-identical with fixed steps, and visibly apart when each
+// frame integrates its own delta.
+//
+static void ValidateFixedTimestep()
+{
+    RandomNumberGenerator rng;
+    FixedTimestep         timestep;
+    double                totalSeconds = 0.0;
+
+    for (int frame = 0; frame < 10000; ++frame)
+    {
+        double const frameSeconds  = GetJitteredFrameSeconds(rng, 144.0);
+        totalSeconds              += frameSeconds;
+
+        timestep.Advance(frameSeconds);
+
+        float const alpha = timestep.GetInterpolationAlpha();
+        GUARANTEE_OR_DIE(alpha >= 0.f && alpha < 1.f, "FixedTimestep interpolation alpha left [0, 1)")
+    }
+
+    uint64_t const expectedSteps = static_cast<uint64_t>(totalSeconds / timestep.GetStepSeconds());
+    GUARANTEE_OR_DIE(timestep.GetStepCount() + 1 >= expectedSteps && timestep.GetStepCount() <= expectedSteps, "FixedTimestep lost or invented steps")
+    GUARANTEE_OR_DIE(timestep.GetDroppedSeconds() == 0.0, "FixedTimestep dropped time from frames shorter than its step limit")
+
+    // 60.5 steps at once: the limit of 5 run, 55 are dropped, and the half step is kept
+    FixedTimestep hitch;
+    GUARANTEE_OR_DIE(hitch.Advance(60.5 / 60.0) == sFixedTimestepConfig().m_maxStepsPerFrame, "A hitch must run exactly the step limit")
+    GUARANTEE_OR_DIE(fabs(hitch.GetDroppedSeconds() - 55.0 / 60.0) < 1e-9, "A hitch must drop its whole steps past the limit")
+    GUARANTEE_OR_DIE(hitch.Advance(0.0) == 0 && fabsf(hitch.GetInterpolationAlpha() - 0.5f) < 1e-4f, "A hitch must keep its partial step")
+
+    EntityStore fastFixed;
+    FillTimestepStore(fastFixed);
+
+    EntityStore slowFixed    = fastFixed;
+    EntityStore fastVariable = fastFixed;
+    EntityStore slowVariable = fastFixed;
+
+    SimulateFixedSteps(fastFixed, 144.0);
+    SimulateFixedSteps(slowFixed, 30.0);
+    SimulateVariableSteps(fastVariable, 144.0);
+    SimulateVariableSteps(slowVariable, 30.0);
+
+    float const fixedDifference    = GetMaxOrientationDifference(fastFixed, slowFixed);
+    float const variableDifference = GetMaxOrientationDifference(fastVariable, slowVariable);
+
+    printf("Orientation after %d steps, 144 vs 30 fps: fixed step max diff %g deg, per-frame delta max diff %g deg\n", DETERMINISM_STEP_COUNT, static_cast<double>(fixedDifference), static_cast<double>(variableDifference));
+    GUARANTEE_OR_DIE(fixedDifference == 0.f, "Fixed-step simulation depends on the frame rate")
+
+    // Alpha 0 draws the previous step and alpha 1 the latest
+    fastFixed.UpdateInterpolatedModelToWorldTransforms(0.f);
+    Mat44 const atPrevious = Entity::MakeModelToWorldTransform(fastFixed.m_previousPositions[0], fastFixed.m_previousOrientations[0]);
+    GUARANTEE_OR_DIE(fabsf(fastFixed.m_modelToWorldTransforms[0].m_values[Mat44::Ix] - atPrevious.m_values[Mat44::Ix]) < 1e-5f, "Interpolation at alpha 0 must draw the previous step")
+
+    fastFixed.UpdateInterpolatedModelToWorldTransforms(1.f);
+    Mat44 const atCurrent = Entity::MakeModelToWorldTransform(fastFixed.m_positions[0], fastFixed.m_orientations[0]);
+    GUARANTEE_OR_DIE(fabsf(fastFixed.m_modelToWorldTransforms[0].m_values[Mat44::Ix] - atCurrent.m_values[Mat44::Ix]) < 1e-5f, "Interpolation at alpha 1 must draw the latest step")
+}
+
+//----------------------------------------------------------------------------------------------------
+// Frames with no work, paced at LIMITER_TARGET_FPS: the limiter must never release a frame early
+// on average, and should spend most of the wait asleep.
+//
+static void MeasureFrameLimiter()
+{
+    FrameLimiter frameLimiter(LIMITER_TARGET_FPS);
+    frameLimiter.WaitForNextFrame();
+
+    double const periodSeconds = 1.0 / LIMITER_TARGET_FPS;
+    double const firstSeconds  = GetCurrentTimeSeconds();
+    double       lastSeconds   = firstSeconds;
+    double       worstSeconds  = 0.0;
+
+    for (int frame = 0; frame < LIMITER_FRAME_COUNT; ++frame)
+    {
+        frameLimiter.WaitForNextFrame();
+
+        double const nowSeconds = GetCurrentTimeSeconds();
+        worstSeconds            = fmax(worstSeconds, fabs(nowSeconds - lastSeconds - periodSeconds));
+        lastSeconds             = nowSeconds;
+    }
+
+    sFrameLimiterStatistics const& statistics   = frameLimiter.GetStatistics();
+    double const                   waitSeconds  = statistics.m_sleepSeconds + statistics.m_spinSeconds;
+    double const                   sleepPercent = waitSeconds > 0.0 ? 100.0 * statistics.m_sleepSeconds / waitSeconds : 0.0;
+    double const                   meanSeconds  = (lastSeconds - firstSeconds) / static_cast<double>(LIMITER_FRAME_COUNT);
+
+    printf("FrameLimiter at %.0f fps: mean frame %.3f ms, worst off by %.3f ms, %.1f%% of the wait asleep, %d missed deadlines\n", LIMITER_TARGET_FPS, meanSeconds * 1000.0, worstSeconds * 1000.0, sleepPercent, statistics.m_missedCount);
+    GUARANTEE_OR_DIE(meanSeconds >= periodSeconds * 0.99, "FrameLimiter released frames early")
+}
+
+//----------------------------------------------------------------------------------------------------
+void RunTimestepBenchmarks()
+{
+    ValidateFixedTimestep();
+    MeasureFrameLimiter();
+
+    EntityStore entityStore;
+    FillTimestepStore(entityStore);
+    entityStore.BeginSimulationStep();
+    entityStore.UpdateOrientations(1.f / 60.f);
+
+    RunBenchmark(Stringf("UpdateModelToWorldTransforms x%d", TIMESTEP_ENTITY_COUNT), 1000, TIMESTEP_ENTITY_COUNT, [&]()
+    {
+        entityStore.UpdateModelToWorldTransforms();
+    });
+
+    RunBenchmark(Stringf("UpdateInterpolatedModelToWorldTransforms x%d", TIMESTEP_ENTITY_COUNT), 1000, TIMESTEP_ENTITY_COUNT, [&]()
+    {
+        entityStore.UpdateInterpolatedModelToWorldTransforms(0.5f);
+    });
+
+    RunBenchmark(Stringf("BeginSimulationStep x%d", TIMESTEP_ENTITY_COUNT), 1000, TIMESTEP_ENTITY_COUNT, [&]()
+    {
+        entityStore.BeginSimulationStep();
+    });
+}
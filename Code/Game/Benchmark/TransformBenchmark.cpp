@@ -0,0 +1,63 @@
+//----------------------------------------------------------------------------------------------------
+// TransformBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Benchmark/Benchmark.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Game/Math/BatchTransforms.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Checks the SSE batch against the scalar Entity::MakeModelToWorldTransform, then times both.
+//
+void RunTransformBenchmarks()
+{
+    int constexpr entityCount = 10000;
+
+    RandomNumberGenerator    rng;
+    std::vector<Vec3>        positions(entityCount);
+    std::vector<EulerAngles> orientations(entityCount);
+    std::vector<Mat44>       batchTransforms(entityCount);
+    std::vector<Mat44>       scalarTransforms(entityCount);
+
+    for (int entityIndex = 0; entityIndex < entityCount; ++entityIndex)
+    {
+        positions[entityIndex]    = Vec3(rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(0.f, 10.f));
+        orientations[entityIndex] = EulerAngles(rng.RollRandomFloatInRange(-720.f, 720.f), rng.RollRandomFloatInRange(-90.f, 90.f), rng.RollRandomFloatInRange(-180.f, 180.f));
+    }
+
+    ComputeModelToWorldTransforms(positions.data(), orientations.data(), entityCount, batchTransforms.data());
+    ComputeModelToWorldTransformsScalar(positions.data(), orientations.data(), entityCount, scalarTransforms.data());
+
+    float maxError = 0.f;
+
+    for (int entityIndex = 0; entityIndex < entityCount; ++entityIndex)
+    {
+        for (int valueIndex = 0; valueIndex < 16; ++valueIndex)
+        {
+            float const error = fabsf(batchTransforms[entityIndex].m_values[valueIndex] - scalarTransforms[entityIndex].m_values[valueIndex]);
+            maxError          = error > maxError ? error : maxError;
+        }
+    }
+
+    printf("ComputeModelToWorldTransforms max abs error vs scalar: %g\n", static_cast<double>(maxError));
+    GUARANTEE_OR_DIE(maxError < 1e-4f, "ComputeModelToWorldTransforms does not match Entity::MakeModelToWorldTransform")
+
+    RunBenchmark(Stringf("ModelToWorld scalar x%d", entityCount), 1000, entityCount, [&]()
+    {
+        ComputeModelToWorldTransformsScalar(positions.data(), orientations.data(), entityCount, scalarTransforms.data());
+    });
+
+    RunBenchmark(Stringf("ModelToWorld SSE batch x%d", entityCount), 1000, entityCount, [&]()
+    {
+        ComputeModelToWorldTransforms(positions.data(), orientations.data(), entityCount, batchTransforms.data());
+    });
+}
@@ -0,0 +1,177 @@
+//----------------------------------------------------------------------------------------------------
+// DebugPrimitiveList.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/DebugPrimitiveList.hpp"
+
+//----------------------------------------------------------------------------------------------------
+#if defined(_WIN32)
+void DebugPrimitiveList::AddWorldBasis(Mat44 const& transform, float const duration)
+{
+    sDebugPrimitive primitive;
+    primitive.m_type      = eDebugPrimitiveType::WORLD_BASIS;
+    primitive.m_transform = transform;
+    primitive.m_duration  = duration;
+
+    m_primitives.push_back(primitive);
+}
+
+//----------------------------------------------------------------------------------------------------
+void DebugPrimitiveList::AddWorldText(String const& text, Mat44 const& transform, float const textHeight, Vec2 const& alignment, float const duration, Rgba8 const& color)
+{
+    sDebugPrimitive primitive;
+    primitive.m_type       = eDebugPrimitiveType::WORLD_TEXT;
+    primitive.m_text       = text;
+    primitive.m_transform  = transform;
+    primitive.m_size       = textHeight;
+    primitive.m_alignment  = alignment;
+    primitive.m_duration   = duration;
+    primitive.m_startColor = color;
+
+    m_primitives.push_back(primitive);
+}
+
+//----------------------------------------------------------------------------------------------------
+void DebugPrimitiveList::AddWorldLine(Vec3 const& start, Vec3 const& end, float const radius, float const duration, Rgba8 const& startColor, Rgba8 const& endColor, eDebugRenderMode const mode)
+{
+    sDebugPrimitive primitive;
+    primitive.m_type       = eDebugPrimitiveType::WORLD_LINE;
+    primitive.m_start      = start;
+    primitive.m_end        = end;
+    primitive.m_size       = radius;
+    primitive.m_duration   = duration;
+    primitive.m_startColor = startColor;
+    primitive.m_endColor   = endColor;
+    primitive.m_renderMode = static_cast<uint8_t>(mode);
+
+    m_primitives.push_back(primitive);
+}
+
+//----------------------------------------------------------------------------------------------------
+void DebugPrimitiveList::AddWorldPoint(Vec3 const& position, float const radius, float const duration, Rgba8 const& startColor, Rgba8 const& endColor)
+{
+    sDebugPrimitive primitive;
+    primitive.m_type       = eDebugPrimitiveType::WORLD_POINT;
+    primitive.m_start      = position;
+    primitive.m_size       = radius;
+    primitive.m_duration   = duration;
+    primitive.m_startColor = startColor;
+    primitive.m_endColor   = endColor;
+
+    m_primitives.push_back(primitive);
+}
+
+//----------------------------------------------------------------------------------------------------
+void DebugPrimitiveList::AddWorldWireSphere(Vec3 const& center, float const radius, float const duration, Rgba8 const& startColor, Rgba8 const& endColor)
+{
+    sDebugPrimitive primitive;
+    primitive.m_type       = eDebugPrimitiveType::WORLD_WIRE_SPHERE;
+    primitive.m_start      = center;
+    primitive.m_size       = radius;
+    primitive.m_duration   = duration;
+    primitive.m_startColor = startColor;
+    primitive.m_endColor   = endColor;
+
+    m_primitives.push_back(primitive);
+}
+
+//----------------------------------------------------------------------------------------------------
+void DebugPrimitiveList::AddWorldCylinder(Vec3 const& base, Vec3 const& top, float const radius, float const duration, bool const isWireframe, Rgba8 const& startColor, Rgba8 const& endColor)
+{
+    sDebugPrimitive primitive;
+    primitive.m_type        = eDebugPrimitiveType::WORLD_CYLINDER;
+    primitive.m_start       = base;
+    primitive.m_end         = top;
+    primitive.m_size        = radius;
+    primitive.m_duration    = duration;
+    primitive.m_isWireframe = isWireframe;
+    primitive.m_startColor  = startColor;
+    primitive.m_endColor    = endColor;
+
+    m_primitives.push_back(primitive);
+}
+
+//----------------------------------------------------------------------------------------------------
+void DebugPrimitiveList::AddBillboardText(String const& text, Vec3 const& origin, float const textHeight, Vec2 const& alignment, float const duration, Rgba8 const& startColor, Rgba8 const& endColor)
+{
+    sDebugPrimitive primitive;
+    primitive.m_type       = eDebugPrimitiveType::BILLBOARD_TEXT;
+    primitive.m_text       = text;
+    primitive.m_start      = origin;
+    primitive.m_size       = textHeight;
+    primitive.m_alignment  = alignment;
+    primitive.m_duration   = duration;
+    primitive.m_startColor = startColor;
+    primitive.m_endColor   = endColor;
+
+    m_primitives.push_back(primitive);
+}
+
+//----------------------------------------------------------------------------------------------------
+void DebugPrimitiveList::AddScreenText(String const& text, Vec2 const& position, float const size, Vec2 const& alignment, float const duration, Rgba8 const& startColor, Rgba8 const& endColor)
+{
+    sDebugPrimitive primitive;
+    primitive.m_type           = eDebugPrimitiveType::SCREEN_TEXT;
+    primitive.m_text           = text;
+    primitive.m_screenPosition = position;
+    primitive.m_size           = size;
+    primitive.m_alignment      = alignment;
+    primitive.m_duration       = duration;
+    primitive.m_startColor     = startColor;
+    primitive.m_endColor       = endColor;
+
+    m_primitives.push_back(primitive);
+}
+
+//----------------------------------------------------------------------------------------------------
+void DebugPrimitiveList::AddMessage(String const& text, float const duration)
+{
+    sDebugPrimitive primitive;
+    primitive.m_type     = eDebugPrimitiveType::MESSAGE;
+    primitive.m_text     = text;
+    primitive.m_duration = duration;
+
+    m_primitives.push_back(primitive);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Only DebugRender is touched here, so the caller must be the thread that draws DebugRender.
+//
+void DebugPrimitiveList::Replay() const
+{
+    for (sDebugPrimitive const& primitive : m_primitives)
+    {
+        switch (primitive.m_type)
+        {
+        case eDebugPrimitiveType::WORLD_BASIS:       DebugAddWorldBasis(primitive.m_transform, primitive.m_duration); break;
+        case eDebugPrimitiveType::WORLD_TEXT:        DebugAddWorldText(primitive.m_text, primitive.m_transform, primitive.m_size, primitive.m_alignment, primitive.m_duration, primitive.m_startColor); break;
+        case eDebugPrimitiveType::WORLD_LINE:        DebugAddWorldLine(primitive.m_start, primitive.m_end, primitive.m_size, primitive.m_duration, primitive.m_startColor, primitive.m_endColor, static_cast<eDebugRenderMode>(primitive.m_renderMode)); break;
+        case eDebugPrimitiveType::WORLD_POINT:       DebugAddWorldPoint(primitive.m_start, primitive.m_size, primitive.m_duration, primitive.m_startColor, primitive.m_endColor); break;
+        case eDebugPrimitiveType::WORLD_WIRE_SPHERE: DebugAddWorldWireSphere(primitive.m_start, primitive.m_size, primitive.m_duration, primitive.m_startColor, primitive.m_endColor); break;
+        case eDebugPrimitiveType::WORLD_CYLINDER:    DebugAddWorldCylinder(primitive.m_start, primitive.m_end, primitive.m_size, primitive.m_duration, primitive.m_isWireframe, primitive.m_startColor, primitive.m_endColor); break;
+        case eDebugPrimitiveType::BILLBOARD_TEXT:    DebugAddBillboardText(primitive.m_text, primitive.m_start, primitive.m_size, primitive.m_alignment, primitive.m_duration, primitive.m_startColor, primitive.m_endColor); break;
+        case eDebugPrimitiveType::SCREEN_TEXT:       DebugAddScreenText(primitive.m_text, primitive.m_screenPosition, primitive.m_size, primitive.m_alignment, primitive.m_duration, primitive.m_startColor, primitive.m_endColor); break;
+        case eDebugPrimitiveType::MESSAGE:           DebugAddMessage(primitive.m_text, primitive.m_duration); break;
+        }
+    }
+}
+#endif
+
+//----------------------------------------------------------------------------------------------------
+void DebugPrimitiveList::Clear()
+{
+    m_primitives.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+void DebugPrimitiveList::Swap(DebugPrimitiveList& other)
+{
+    m_primitives.swap(other.m_primitives);
+}
+
+//----------------------------------------------------------------------------------------------------
+int DebugPrimitiveList::GetCount() const
+{
+    return static_cast<int>(m_primitives.size());
+}
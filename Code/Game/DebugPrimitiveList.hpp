@@ -0,0 +1,87 @@
+//----------------------------------------------------------------------------------------------------
+// DebugPrimitiveList.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+#if defined(_WIN32)
+#include "Engine/Renderer/DebugRenderSystem.hpp"
+#endif
+
+//----------------------------------------------------------------------------------------------------
+enum class eDebugPrimitiveType : uint8_t
+{
+    WORLD_BASIS,
+    WORLD_TEXT,
+    WORLD_LINE,
+    WORLD_POINT,
+    WORLD_WIRE_SPHERE,
+    WORLD_CYLINDER,
+    BILLBOARD_TEXT,
+    SCREEN_TEXT,
+    MESSAGE
+};
+
+//----------------------------------------------------------------------------------------------------
+// The arguments of one DebugAdd* call. Each type uses only the fields its call takes.
+//
+struct sDebugPrimitive
+{
+    eDebugPrimitiveType m_type        = eDebugPrimitiveType::MESSAGE;
+    Mat44               m_transform;
+    Vec3                m_start;                    // Line and cylinder start, point, sphere center, billboard origin
+    Vec3                m_end;
+    Vec2                m_screenPosition;
+    Vec2                m_alignment;
+    float               m_size        = 0.f;        // Radius, or text height
+    float               m_duration    = 0.f;        // Seconds; -1 lasts forever, 0 a single frame
+    Rgba8               m_startColor  = Rgba8::WHITE;
+    Rgba8               m_endColor    = Rgba8::WHITE;
+    bool                m_isWireframe = false;
+    uint8_t             m_renderMode  = 0;          // An eDebugRenderMode; only the Windows build has the enum
+    String              m_text;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Debug primitives the Game adds during a frame, carried to the render side in its sRenderSnapshot.
+// The Engine's DebugRender keeps one global primitive list, so the Game records here instead of
+// calling DebugAdd* itself; Replay hands the frame's primitives to DebugRender on the thread that
+// draws them, right before DebugRenderWorld and DebugRenderScreen. DebugRender still owns their
+// lifetimes.
+//
+// The Add functions mirror the DebugAdd* calls of the same name and, like DebugRender, are Windows
+// only.
+//
+class DebugPrimitiveList
+{
+public:
+#if defined(_WIN32)
+    void AddWorldBasis(Mat44 const& transform, float duration);
+    void AddWorldText(String const& text, Mat44 const& transform, float textHeight, Vec2 const& alignment, float duration, Rgba8 const& color);
+    void AddWorldLine(Vec3 const& start, Vec3 const& end, float radius, float duration, Rgba8 const& startColor, Rgba8 const& endColor, eDebugRenderMode mode);
+    void AddWorldPoint(Vec3 const& position, float radius, float duration, Rgba8 const& startColor, Rgba8 const& endColor);
+    void AddWorldWireSphere(Vec3 const& center, float radius, float duration, Rgba8 const& startColor, Rgba8 const& endColor);
+    void AddWorldCylinder(Vec3 const& base, Vec3 const& top, float radius, float duration, bool isWireframe, Rgba8 const& startColor, Rgba8 const& endColor);
+    void AddBillboardText(String const& text, Vec3 const& origin, float textHeight, Vec2 const& alignment, float duration, Rgba8 const& startColor, Rgba8 const& endColor);
+    void AddScreenText(String const& text, Vec2 const& position, float size, Vec2 const& alignment, float duration, Rgba8 const& startColor = Rgba8::WHITE, Rgba8 const& endColor = Rgba8::WHITE);
+    void AddMessage(String const& text, float duration);
+
+    void Replay() const;
+#endif
+
+    void Clear();
+    void Swap(DebugPrimitiveList& other);       // Hands over this frame's primitives without copying them
+    int  GetCount() const;
+
+private:
+    std::vector<sDebugPrimitive> m_primitives;
+};
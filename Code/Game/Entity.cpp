@@ -5,6 +5,8 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Entity.hpp"
 
+#include "Engine/Core/EngineCommon.hpp"
+
 //----------------------------------------------------------------------------------------------------
 Entity::Entity(Game* owner)
     : m_game(owner)
@@ -18,14 +20,20 @@ Entity::~Entity()
 
 //----------------------------------------------------------------------------------------------------
 Mat44 Entity::GetModelToWorldTransform() const
+{
+    return MakeModelToWorldTransform(m_position, m_orientation);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC Mat44 Entity::MakeModelToWorldTransform(Vec3 const& position, EulerAngles const& orientation)
 {
     Mat44 m2w;
 
-    m2w.SetTranslation3D(m_position);
+    m2w.SetTranslation3D(position);
 
-    m2w.AppendZRotation(m_orientation.m_yawDegrees);
-    m2w.AppendYRotation(m_orientation.m_pitchDegrees);
-    m2w.AppendXRotation(m_orientation.m_rollDegrees);
+    m2w.AppendZRotation(orientation.m_yawDegrees);
+    m2w.AppendYRotation(orientation.m_pitchDegrees);
+    m2w.AppendXRotation(orientation.m_rollDegrees);
 
     // m2w.Append(m_orientation.GetAsMatrix_IFwd_JLeft_KUp());
 
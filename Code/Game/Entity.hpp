@@ -5,8 +5,10 @@
 //----------------------------------------------------------------------------------------------------
 #pragma once
 #include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/EulerAngles.hpp"
 #include "Engine/Math/Vec3.hpp"
+#include "Game/Math/FrustumCulling.hpp"
 
 //----------------------------------------------------------------------------------------------------
 class Game;
@@ -22,10 +24,16 @@ public:
     virtual void  Render() const = 0;
     virtual Mat44 GetModelToWorldTransform() const;
 
+    static Mat44 MakeModelToWorldTransform(Vec3 const& position, EulerAngles const& orientation);
+
     Game*       m_game            = nullptr;
     Vec3        m_position        = Vec3::ZERO;
     Vec3        m_velocity        = Vec3::ZERO;
     EulerAngles m_orientation     = EulerAngles::ZERO;
     EulerAngles m_angularVelocity = EulerAngles::ZERO;
     Rgba8       m_color           = Rgba8::WHITE;
+
+    // Model space, computed from the mesh (see Prop::ComputeLocalBounds)
+    AABB3           m_localBounds;
+    sBoundingSphere m_localBoundingSphere;
 };
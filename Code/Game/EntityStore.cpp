@@ -0,0 +1,451 @@
+//----------------------------------------------------------------------------------------------------
+// EntityStore.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/EntityStore.hpp"
+
+#include <atomic>
+#include <cmath>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Game/Entity.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Math/BatchTransforms.hpp"
+#include "Game/Math/SIMD.hpp"
+#include "Game/Subsystem/Job/JobSystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// The batched sweeps split into ranges of this many entities on g_theJobSystem; smaller stores run
+// on the caller alone. A multiple of four, so each range starts on the same four-wide SIMD group
+// as the serial sweep and the results do not depend on the thread count.
+//
+static int constexpr ENTITIES_PER_JOB = 4096;
+
+//----------------------------------------------------------------------------------------------------
+EntityHandle EntityStore::CreateEntity(int const meshIndex, Vec3 const& position, EulerAngles const& orientation, EulerAngles const& angularVelocity, Rgba8 const& color)
+{
+    m_positions.push_back(position);
+    m_orientations.push_back(orientation);
+    m_previousPositions.push_back(position);
+    m_previousOrientations.push_back(orientation);
+    m_angularVelocities.push_back(angularVelocity);
+    m_colors.push_back(color);
+    m_meshIndices.push_back(meshIndex);
+    m_modelToWorldTransforms.push_back(Entity::MakeModelToWorldTransform(position, orientation));
+    m_worldBoundingSpheres.push_back(sBoundingSphere());
+    m_isVisible.push_back(1);
+    m_spatialProxyIds.push_back(DynamicAABBTree::NULL_NODE);
+
+    return m_slots.Add();
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntityStore::DestroyEntity(EntityHandle const handle)
+{
+    uint32_t denseIndex = 0;
+
+    if (!m_slots.Remove(handle, denseIndex))
+    {
+        return;
+    }
+
+    uint32_t const lastIndex = static_cast<uint32_t>(m_positions.size()) - 1;
+
+    if (m_spatialProxyIds[denseIndex] != DynamicAABBTree::NULL_NODE)
+    {
+        m_spatialIndex.DestroyProxy(m_spatialProxyIds[denseIndex]);
+    }
+
+    // Mirror the slot map: the last entity moves into the hole
+    if (denseIndex != lastIndex)
+    {
+        m_positions[denseIndex]              = m_positions[lastIndex];
+        m_orientations[denseIndex]           = m_orientations[lastIndex];
+        m_previousPositions[denseIndex]      = m_previousPositions[lastIndex];
+        m_previousOrientations[denseIndex]   = m_previousOrientations[lastIndex];
+        m_angularVelocities[denseIndex]      = m_angularVelocities[lastIndex];
+        m_colors[denseIndex]                 = m_colors[lastIndex];
+        m_meshIndices[denseIndex]            = m_meshIndices[lastIndex];
+        m_modelToWorldTransforms[denseIndex] = m_modelToWorldTransforms[lastIndex];
+        m_worldBoundingSpheres[denseIndex]   = m_worldBoundingSpheres[lastIndex];
+        m_isVisible[denseIndex]              = m_isVisible[lastIndex];
+        m_spatialProxyIds[denseIndex]        = m_spatialProxyIds[lastIndex];
+    }
+
+    m_positions.pop_back();
+    m_orientations.pop_back();
+    m_previousPositions.pop_back();
+    m_previousOrientations.pop_back();
+    m_angularVelocities.pop_back();
+    m_colors.pop_back();
+    m_meshIndices.pop_back();
+    m_modelToWorldTransforms.pop_back();
+    m_worldBoundingSpheres.pop_back();
+    m_isVisible.pop_back();
+    m_spatialProxyIds.pop_back();
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntityStore::Reserve(int const capacity)
+{
+    size_t const size = static_cast<size_t>(capacity);
+
+    m_positions.reserve(size);
+    m_orientations.reserve(size);
+    m_previousPositions.reserve(size);
+    m_previousOrientations.reserve(size);
+    m_interpolatedPositions.reserve(size);
+    m_interpolatedOrientations.reserve(size);
+    m_angularVelocities.reserve(size);
+    m_colors.reserve(size);
+    m_meshIndices.reserve(size);
+    m_modelToWorldTransforms.reserve(size);
+    m_worldBoundingSpheres.reserve(size);
+    m_isVisible.reserve(size);
+    m_spatialProxyIds.reserve(size);
+    m_slots.Reserve(capacity);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Also empties the spatial index, so no query can return a handle from before the clear.
+//
+void EntityStore::Clear()
+{
+    m_positions.clear();
+    m_orientations.clear();
+    m_previousPositions.clear();
+    m_previousOrientations.clear();
+    m_angularVelocities.clear();
+    m_colors.clear();
+    m_meshIndices.clear();
+    m_modelToWorldTransforms.clear();
+    m_worldBoundingSpheres.clear();
+    m_isVisible.clear();
+    m_spatialProxyIds.clear();
+    m_spatialIndex.Clear();
+    m_slots.Clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool EntityStore::IsAlive(EntityHandle const handle) const
+{
+    return m_slots.IsAlive(handle);
+}
+
+//----------------------------------------------------------------------------------------------------
+int EntityStore::GetDenseIndex(EntityHandle const handle) const
+{
+    return m_slots.GetDenseIndex(handle);
+}
+
+//----------------------------------------------------------------------------------------------------
+int EntityStore::GetCount() const
+{
+    return static_cast<int>(m_positions.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+Mat44 EntityStore::GetModelToWorldTransform(int const denseIndex) const
+{
+    return Entity::MakeModelToWorldTransform(m_positions[denseIndex], m_orientations[denseIndex]);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Called before each fixed simulation step, so the previous and current state bracket the step
+// the renderer interpolates across. Assigning into arrays of the same size never reallocates.
+//
+void EntityStore::BeginSimulationStep()
+{
+    m_previousPositions    = m_positions;
+    m_previousOrientations = m_orientations;
+}
+
+//----------------------------------------------------------------------------------------------------
+// EulerAngles is three packed floats, so both arrays are walked as flat float arrays, four floats
+// at a time.
+//
+void EntityStore::UpdateOrientations(float const deltaSeconds)
+{
+    static_assert(sizeof(EulerAngles) == sizeof(float) * 3, "EulerAngles must be three packed floats");
+
+    if (m_orientations.empty())
+    {
+        return;
+    }
+
+    float*       orientations      = &m_orientations[0].m_yawDegrees;
+    float const* angularVelocities = &m_angularVelocities[0].m_yawDegrees;
+
+    ParallelFor(g_theJobSystem, GetCount(), ENTITIES_PER_JOB, [=](int const firstEntity, int const endEntity)
+    {
+        size_t const endFloat   = static_cast<size_t>(endEntity) * 3;
+        size_t       floatIndex = static_cast<size_t>(firstEntity) * 3;
+
+#if defined(GAME_SIMD_SSE)
+        __m128 const deltaSeconds4 = _mm_set1_ps(deltaSeconds);
+
+        for (; floatIndex + 4 <= endFloat; floatIndex += 4)
+        {
+            __m128 const orientation     = _mm_loadu_ps(orientations + floatIndex);
+            __m128 const angularVelocity = _mm_loadu_ps(angularVelocities + floatIndex);
+            _mm_storeu_ps(orientations + floatIndex, _mm_add_ps(orientation, _mm_mul_ps(angularVelocity, deltaSeconds4)));
+        }
+#endif
+
+        for (; floatIndex < endFloat; ++floatIndex)
+        {
+            orientations[floatIndex] += angularVelocities[floatIndex] * deltaSeconds;
+        }
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntityStore::UpdateModelToWorldTransforms()
+{
+    if (m_positions.empty())
+    {
+        return;
+    }
+
+    Vec3 const*        positions    = m_positions.data();
+    EulerAngles const* orientations = m_orientations.data();
+    Mat44*             transforms   = m_modelToWorldTransforms.data();
+
+    ParallelFor(g_theJobSystem, GetCount(), ENTITIES_PER_JOB, [=](int const firstEntity, int const endEntity)
+    {
+        ComputeModelToWorldTransforms(positions + firstEntity, orientations + firstEntity, endEntity - firstEntity, transforms + firstEntity);
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+// Transforms for a moment between the last two simulation steps: 0 is the previous step, 1 the
+// latest. Orientations accumulate without wrapping, so blending the angles directly never takes
+// the long way round.
+//
+void EntityStore::UpdateInterpolatedModelToWorldTransforms(float const interpolationAlpha)
+{
+    static_assert(sizeof(Vec3) == sizeof(float) * 3, "Vec3 must be three packed floats");
+
+    if (m_positions.empty())
+    {
+        return;
+    }
+
+    m_interpolatedPositions.resize(m_positions.size());
+    m_interpolatedOrientations.resize(m_orientations.size());
+
+    float const* previousPositions    = &m_previousPositions[0].x;
+    float const* positions            = &m_positions[0].x;
+    Vec3*        blendedPositions     = m_interpolatedPositions.data();
+    float const* previousOrientations = &m_previousOrientations[0].m_yawDegrees;
+    float const* orientations         = &m_orientations[0].m_yawDegrees;
+    EulerAngles* blendedOrientations  = m_interpolatedOrientations.data();
+    Mat44*       transforms           = m_modelToWorldTransforms.data();
+
+    ParallelFor(g_theJobSystem, GetCount(), ENTITIES_PER_JOB, [=](int const firstEntity, int const endEntity)
+    {
+        float* const blendedPositionFloats    = &blendedPositions[0].x;
+        float* const blendedOrientationFloats = &blendedOrientations[0].m_yawDegrees;
+        size_t const endFloat                 = static_cast<size_t>(endEntity) * 3;
+
+        for (size_t floatIndex = static_cast<size_t>(firstEntity) * 3; floatIndex < endFloat; ++floatIndex)
+        {
+            blendedPositionFloats[floatIndex]    = previousPositions[floatIndex] + (positions[floatIndex] - previousPositions[floatIndex]) * interpolationAlpha;
+            blendedOrientationFloats[floatIndex] = previousOrientations[floatIndex] + (orientations[floatIndex] - previousOrientations[floatIndex]) * interpolationAlpha;
+        }
+
+        ComputeModelToWorldTransforms(blendedPositions + firstEntity, blendedOrientations + firstEntity, endEntity - firstEntity, transforms + firstEntity);
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+// Model-to-world transforms are rotation plus translation only, so the local radius carries over
+// unchanged and only the center needs transforming.
+//
+void EntityStore::UpdateWorldBoundingSpheres(std::vector<sBoundingSphere> const& localSpheresByMesh)
+{
+    ParallelFor(g_theJobSystem, GetCount(), ENTITIES_PER_JOB, [this, &localSpheresByMesh](int const firstEntity, int const endEntity)
+    {
+        for (int entityIndex = firstEntity; entityIndex < endEntity; ++entityIndex)
+        {
+            sBoundingSphere const& localSphere = localSpheresByMesh[m_meshIndices[entityIndex]];
+            float const*           m           = m_modelToWorldTransforms[entityIndex].m_values;
+            Vec3 const&            center      = localSphere.m_center;
+            sBoundingSphere&       worldSphere = m_worldBoundingSpheres[entityIndex];
+
+            worldSphere.m_center.x = m[Mat44::Ix] * center.x + m[Mat44::Jx] * center.y + m[Mat44::Kx] * center.z + m[Mat44::Tx];
+            worldSphere.m_center.y = m[Mat44::Iy] * center.x + m[Mat44::Jy] * center.y + m[Mat44::Ky] * center.z + m[Mat44::Ty];
+            worldSphere.m_center.z = m[Mat44::Iz] * center.x + m[Mat44::Jz] * center.y + m[Mat44::Kz] * center.z + m[Mat44::Tz];
+            worldSphere.m_radius   = localSphere.m_radius;
+        }
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns the number of visible entities.
+//
+int EntityStore::CullAgainstFrustum(sFrustum const& frustum)
+{
+    std::atomic<int> visibleCount(0);
+
+    ParallelFor(g_theJobSystem, GetCount(), ENTITIES_PER_JOB, [this, &frustum, &visibleCount](int const firstEntity, int const endEntity)
+    {
+        int const rangeVisibleCount = CullSpheres(frustum, m_worldBoundingSpheres.data() + firstEntity, endEntity - firstEntity, m_isVisible.data() + firstEntity);
+        visibleCount.fetch_add(rangeVisibleCount, std::memory_order_relaxed);
+    });
+
+    return visibleCount.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+static AABB3 GetSphereBounds(sBoundingSphere const& sphere)
+{
+    Vec3 const extents(sphere.m_radius, sphere.m_radius, sphere.m_radius);
+
+    return AABB3(sphere.m_center - extents, sphere.m_center + extents);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Refits the spatial index to the current world bounding spheres. Entities that stay inside their
+// fat leaf box cost one containment test. New entities and ones that escaped their box are inserted
+// one at a time if there are few of them; if there are many (the first update after spawning, mass
+// teleports) the tree is rebuilt instead, which is both faster and gives a better tree.
+// Returns how many entities were inserted or moved.
+//
+int EntityStore::UpdateSpatialIndex()
+{
+    int const count        = GetCount();
+    int       changedCount = 0;
+
+    for (int entityIndex = 0; entityIndex < count; ++entityIndex)
+    {
+        int const proxyId = m_spatialProxyIds[entityIndex];
+        changedCount += proxyId == DynamicAABBTree::NULL_NODE || !m_spatialIndex.IsInsideFatBounds(proxyId, GetSphereBounds(m_worldBoundingSpheres[entityIndex])) ? 1 : 0;
+    }
+
+    bool const shouldRebuild = changedCount > 64 && changedCount * 4 > count;
+
+    for (int entityIndex = 0; entityIndex < count && changedCount > 0; ++entityIndex)
+    {
+        AABB3 const bounds  = GetSphereBounds(m_worldBoundingSpheres[entityIndex]);
+        int&        proxyId = m_spatialProxyIds[entityIndex];
+
+        if (proxyId == DynamicAABBTree::NULL_NODE)
+        {
+            proxyId = m_spatialIndex.CreateProxy(bounds, static_cast<int>(m_slots.GetSlot(entityIndex)), shouldRebuild);
+        }
+        else if (shouldRebuild)
+        {
+            m_spatialIndex.SetFatBounds(proxyId, bounds);
+        }
+        else
+        {
+            m_spatialIndex.MoveProxy(proxyId, bounds);
+        }
+    }
+
+    if (shouldRebuild)
+    {
+        m_spatialIndex.Rebuild();
+    }
+
+    return changedCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Closest hit along the ray against the entities' world bounding spheres. A ray that starts inside
+// a sphere hits it at distance 0.
+//
+sEntityRaycastResult EntityStore::RaycastEntities(Vec3 const& start, Vec3 const& forwardNormal, float const maxDistance) const
+{
+    sEntityRaycastResult result;
+
+    m_spatialIndex.Raycast(start, forwardNormal, maxDistance, [&](int const proxyId, float const currentMaxDistance)
+    {
+        uint32_t const         slot            = static_cast<uint32_t>(m_spatialIndex.GetUserData(proxyId));
+        sBoundingSphere const& sphere          = m_worldBoundingSpheres[m_slots.GetDenseIndexForSlot(slot)];
+        Vec3 const             toStart         = start - sphere.m_center;
+        float const            projection      = toStart.x * forwardNormal.x + toStart.y * forwardNormal.y + toStart.z * forwardNormal.z;
+        float const            startDistanceSq = toStart.x * toStart.x + toStart.y * toStart.y + toStart.z * toStart.z - sphere.m_radius * sphere.m_radius;
+        float const            discriminant    = projection * projection - startDistanceSq;
+
+        if ((startDistanceSq > 0.f && projection > 0.f) || discriminant < 0.f)
+        {
+            return currentMaxDistance;
+        }
+
+        float impactDistance = -projection - sqrtf(discriminant);
+        impactDistance       = impactDistance < 0.f ? 0.f : impactDistance;
+
+        if (impactDistance >= currentMaxDistance)
+        {
+            return currentMaxDistance;
+        }
+
+        result.m_didHit         = true;
+        result.m_hitEntity      = m_slots.GetHandleForSlot(slot);
+        result.m_impactDistance = impactDistance;
+        result.m_impactPosition = start + forwardNormal * impactDistance;
+
+        return impactDistance;
+    });
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntityStore::RaycastEntities(Vec3 const* starts, Vec3 const* forwardNormals, float const maxDistance, int const rayCount, sEntityRaycastResult* out_results) const
+{
+    for (int rayIndex = 0; rayIndex < rayCount; ++rayIndex)
+    {
+        out_results[rayIndex] = RaycastEntities(starts[rayIndex], forwardNormals[rayIndex], maxDistance);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Appends every entity whose world bounding sphere touches the query sphere. Returns the count added.
+//
+int EntityStore::OverlapSphere(Vec3 const& center, float const radius, std::vector<EntityHandle>& out_entities) const
+{
+    size_t const startSize = out_entities.size();
+
+    m_spatialIndex.QuerySphere(center, radius, [&](int const proxyId)
+    {
+        uint32_t const         slot         = static_cast<uint32_t>(m_spatialIndex.GetUserData(proxyId));
+        sBoundingSphere const& sphere       = m_worldBoundingSpheres[m_slots.GetDenseIndexForSlot(slot)];
+        Vec3 const             displacement = sphere.m_center - center;
+        float const            radiusSum    = sphere.m_radius + radius;
+
+        if (displacement.x * displacement.x + displacement.y * displacement.y + displacement.z * displacement.z <= radiusSum * radiusSum)
+        {
+            out_entities.push_back(m_slots.GetHandleForSlot(slot));
+        }
+
+        return true;
+    });
+
+    return static_cast<int>(out_entities.size() - startSize);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Appends every entity whose fat leaf box touches the frustum. Returns the count added.
+//
+int EntityStore::QueryFrustum(sFrustum const& frustum, std::vector<EntityHandle>& out_entities) const
+{
+    size_t const startSize = out_entities.size();
+
+    m_spatialIndex.QueryFrustum(frustum, [&](int const proxyId)
+    {
+        out_entities.push_back(m_slots.GetHandleForSlot(static_cast<uint32_t>(m_spatialIndex.GetUserData(proxyId))));
+        return true;
+    });
+
+    return static_cast<int>(out_entities.size() - startSize);
+}
+
+//----------------------------------------------------------------------------------------------------
+DynamicAABBTree const& EntityStore::GetSpatialIndex() const
+{
+    return m_spatialIndex;
+}
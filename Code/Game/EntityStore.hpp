@@ -0,0 +1,90 @@
+//----------------------------------------------------------------------------------------------------
+// EntityStore.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Game/Framework/GenerationalSlotMap.hpp"
+#include "Game/Math/DynamicAABBTree.hpp"
+#include "Game/Math/FrustumCulling.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Names one prop for as long as it lives, e.g. the prop a raycast hit or the one the player holds.
+// The spatial index stores slots, not dense indices, so its leaves survive other props being
+// destroyed; queries turn them back into handles.
+//
+struct sEntityHandleTag;
+using EntityHandle = GenerationalHandle<sEntityHandleTag>;
+
+//----------------------------------------------------------------------------------------------------
+struct sEntityRaycastResult
+{
+    bool         m_didHit         = false;
+    EntityHandle m_hitEntity      = EntityHandle::INVALID;
+    float        m_impactDistance = 0.f;
+    Vec3         m_impactPosition = Vec3::ZERO;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Structure-of-arrays storage for props.
+// Every attribute lives in its own contiguous array indexed by a dense index in [0, GetCount()).
+// Destroying an entity moves the last entity into its place, so the arrays never have holes and
+// the batched systems below are plain linear sweeps with no virtual calls or pointer chasing.
+// Dense indices change on destroy; hold an EntityHandle to refer to an entity across frames.
+//
+class EntityStore
+{
+public:
+    EntityHandle CreateEntity(int meshIndex, Vec3 const& position, EulerAngles const& orientation = EulerAngles::ZERO, EulerAngles const& angularVelocity = EulerAngles::ZERO, Rgba8 const& color = Rgba8::WHITE);
+    void         DestroyEntity(EntityHandle handle);
+    void         Reserve(int capacity);
+    void         Clear();
+
+    bool IsAlive(EntityHandle handle) const;
+    int  GetDenseIndex(EntityHandle handle) const;
+    int  GetCount() const;
+
+    Mat44 GetModelToWorldTransform(int denseIndex) const;
+
+    // Batched systems
+    void BeginSimulationStep();
+    void UpdateOrientations(float deltaSeconds);
+    void UpdateModelToWorldTransforms();
+    void UpdateInterpolatedModelToWorldTransforms(float interpolationAlpha);
+    void UpdateWorldBoundingSpheres(std::vector<sBoundingSphere> const& localSpheresByMesh);
+    int  CullAgainstFrustum(sFrustum const& frustum);
+    int  UpdateSpatialIndex();
+
+    // Spatial queries against the world bounding spheres, accelerated by the DynamicAABBTree.
+    // They see the bounds as of the last UpdateSpatialIndex.
+    sEntityRaycastResult   RaycastEntities(Vec3 const& start, Vec3 const& forwardNormal, float maxDistance) const;
+    void                   RaycastEntities(Vec3 const* starts, Vec3 const* forwardNormals, float maxDistance, int rayCount, sEntityRaycastResult* out_results) const;
+    int                    OverlapSphere(Vec3 const& center, float radius, std::vector<EntityHandle>& out_entities) const;
+    int                    QueryFrustum(sFrustum const& frustum, std::vector<EntityHandle>& out_entities) const;
+    DynamicAABBTree const& GetSpatialIndex() const;
+
+    std::vector<Vec3>            m_positions;
+    std::vector<EulerAngles>     m_orientations;
+    std::vector<Vec3>            m_previousPositions;        // As of the last BeginSimulationStep
+    std::vector<EulerAngles>     m_previousOrientations;     // As of the last BeginSimulationStep
+    std::vector<EulerAngles>     m_angularVelocities;
+    std::vector<Rgba8>           m_colors;
+    std::vector<int>             m_meshIndices;
+    std::vector<Mat44>           m_modelToWorldTransforms;   // Written by UpdateModelToWorldTransforms
+    std::vector<sBoundingSphere> m_worldBoundingSpheres;     // Written by UpdateWorldBoundingSpheres
+    std::vector<uint8_t>         m_isVisible;                // Written by CullAgainstFrustum
+    std::vector<int>             m_spatialProxyIds;          // Leaf of each entity in m_spatialIndex, NULL_NODE until first indexed
+
+private:
+    DynamicAABBTree          m_spatialIndex;                 // Leaf user data is the entity slot
+    std::vector<Vec3>        m_interpolatedPositions;        // Scratch for UpdateInterpolatedModelToWorldTransforms
+    std::vector<EulerAngles> m_interpolatedOrientations;
+    GenerationalSlotMap<EntityHandle> m_slots;              // Dense order matches every array above
+};
@@ -5,44 +5,163 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Framework/App.hpp"
 
-#include "Engine/Audio/AudioSystem.hpp"
+#include <cstdio>
+#include <cstdlib>
+
 #include "Engine/Core/Clock.hpp"
-#include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/EngineCommon.hpp"
-#include "Engine/Input/InputSystem.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Game/Game.hpp"
+#include "Game/Benchmark/Benchmark.hpp"
+#include "Game/Framework/FrameLimiter.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/RenderPipeline.hpp"
+#include "Game/Subsystem/Job/JobSystem.hpp"
+#include "Game/Subsystem/Profile/Profiler.hpp"
+#include "Game/Subsystem/Light/LightSubsystem.hpp"
+#include "Game/Subsystem/Render/GlyphFont.hpp"
+#include "Game/Subsystem/Render/NullRenderBackend.hpp"
+#include "Game/Subsystem/Render/SoftwareRenderBackend.hpp"
+#include "Game/Subsystem/Resource/BakedMesh.hpp"
+#include "Game/Subsystem/Resource/GameResourceLoader.hpp"
+#include "Game/Subsystem/Resource/TextureCache.hpp"
+
+// Windowed mode only; other platforms build the headless App (see Main_Headless.cpp)
+#if defined(_WIN32)
+#include "Engine/Audio/AudioSystem.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Input/InputSystem.hpp"
 #include "Engine/Platform/Window.hpp"
-#include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/DebugRenderSystem.hpp"
 #include "Engine/Renderer/Renderer.hpp"
-#include "Engine/Resource/ResourceSubsystem.hpp"
 #include "Engine/Scripting/V8Subsystem.hpp"
-#include "Game/Game.hpp"
-#include "Game/Framework/GameCommon.hpp"
-#include "Game/Subsystem/Light/LightSubsystem.hpp"
+#include "Game/Subsystem/Profile/PerfHUD.hpp"
+#include "Game/Subsystem/Render/EngineRenderBackend.hpp"
+#endif
 
 //----------------------------------------------------------------------------------------------------
-App*                   g_theApp               = nullptr;       // Created and owned by Main_Windows.cpp
-AudioSystem*           g_theAudio             = nullptr;       // Created and owned by the App
-BitmapFont*            g_theBitmapFont        = nullptr;       // Created and owned by the App
-Game*                  g_theGame              = nullptr;       // Created and owned by the App
-Renderer*              g_theRenderer          = nullptr;       // Created and owned by the App
-RandomNumberGenerator* g_theRNG               = nullptr;       // Created and owned by the App
-Window*                g_theWindow            = nullptr;       // Created and owned by the App
-LightSubsystem*        g_theLightSubsystem    = nullptr;       // Created and owned by the App
-ResourceSubsystem*     g_theResourceSubsystem = nullptr;       // Created and owned by the App
+App*                   g_theApp                = nullptr;      // Created and owned by Main_Windows.cpp
+AudioSystem*           g_theAudio              = nullptr;      // Created and owned by the App
+Game*                  g_theGame               = nullptr;      // Created and owned by the App
+GameResourceLoader*    g_theGameResourceLoader = nullptr;      // Created and owned by the App
+GlyphFont*             g_theGlyphFont          = nullptr;      // Created and owned by the App; windowed only
+JobSystem*             g_theJobSystem          = nullptr;      // Created and owned by the App
+Renderer*              g_theRenderer           = nullptr;      // Created and owned by the App
+RandomNumberGenerator* g_theRNG                = nullptr;      // Created and owned by the App
+LightSubsystem*        g_theLightSubsystem     = nullptr;      // Created and owned by the App
+RenderBackend*         g_theRenderBackend      = nullptr;      // Created and owned by the App
+#if defined(_WIN32)
+Window*                g_theWindow             = nullptr;      // Created and owned by the App
+
+// The Engine's own resource subsystem is not created; the game loads through g_theGameResourceLoader.
+// Still defined, as before, for the Engine code that declares it, none of which the game calls.
+class ResourceSubsystem;
+ResourceSubsystem*     g_theResourceSubsystem  = nullptr;
+#endif
 
 //----------------------------------------------------------------------------------------------------
 STATIC bool App::m_isQuitting = false;
 
 //----------------------------------------------------------------------------------------------------
-void App::Startup()
+// Command line is a whitespace-separated list of "name" or "name=value" tokens.
+//
+static sAppConfig ParseCommandLine(char const* commandLine)
+{
+    sAppConfig config;
+
+    if (commandLine == nullptr)
+    {
+        return config;
+    }
+
+    String const line = commandLine;
+    size_t       start = line.find_first_not_of(" \t");
+
+    while (start != String::npos)
+    {
+        size_t const end    = line.find_first_of(" \t", start);
+        String const token  = line.substr(start, end == String::npos ? String::npos : end - start);
+        size_t const equals = token.find('=');
+        String const name   = token.substr(0, equals);
+        String const value  = equals == String::npos ? String() : token.substr(equals + 1);
+
+        if (name == "headless") config.m_isHeadless = true;
+        if (name == "ticks") config.m_headlessMaxTicks = atoi(value.c_str());
+        if (name == "seconds") config.m_headlessMaxSeconds = atof(value.c_str());
+        if (name == "renderer") config.m_isSoftwareRendering = value == "software";
+        if (name == "capture") config.m_captureFilePath = value;
+        if (name == "benchmark") config.m_benchmarkSuiteName = value.empty() ? "all" : value;
+        if (name == "benchmarkjson") config.m_benchmarkJsonFilePath = value;
+        if (name == "bake") config.m_bakeObjFilePath = value;
+        if (name == "profile") config.m_profileFrameCount = value.empty() ? 120 : atoi(value.c_str());
+        if (name == "trace") config.m_profileFilePath = value;
+        if (name == "simhz") config.m_simulationStepsPerSecond = atof(value.c_str());
+        if (name == "fps") config.m_frameRateLimit = atof(value.c_str());
+        if (name == "pipelined") config.m_isRenderPipelined = true;
+
+        start = line.find_first_not_of(" \t", end);
+    }
+
+    // The simulation has to step at some rate; "simhz=0" or garbage keeps the default
+    if (config.m_simulationStepsPerSecond <= 0.0)
+    {
+        config.m_simulationStepsPerSecond = 60.0;
+    }
+
+    // A headless run with no budget would never end; default to a fixed number of ticks.
+    if (config.m_isHeadless && config.m_headlessMaxTicks <= 0 && config.m_headlessMaxSeconds <= 0.0)
+    {
+        config.m_headlessMaxTicks = 10000;
+    }
+
+    return config;
+}
+
+//----------------------------------------------------------------------------------------------------
+void App::Startup(char const* commandLine)
+{
+    m_config = ParseCommandLine(commandLine);
+
+    SetProfilerThreadName("Main");
+
+    if (m_config.m_profileFrameCount > 0)
+    {
+        ProfilerRequestCapture(m_config.m_profileFrameCount, m_config.m_profileFilePath.empty() ? nullptr : m_config.m_profileFilePath.c_str());
+    }
+
+    // First up and last down, since any subsystem may hand it work
+    sJobSystemConfig constexpr jobSystemConfig;
+    g_theJobSystem = new JobSystem(jobSystemConfig);
+
+    double const startupStartSeconds = GetCurrentTimeSeconds();
+
+    if (m_config.m_isHeadless)
+    {
+        StartupHeadless();
+    }
+    else
+    {
+#if defined(_WIN32)
+        StartupWindowed();
+#endif
+    }
+
+    ReportStartup(GetCurrentTimeSeconds() - startupStartSeconds);
+}
+
+//----------------------------------------------------------------------------------------------------
+#if defined(_WIN32)
+void App::StartupWindowed()
 {
     // Create All Engine Subsystems
     sEventSystemConfig eventSystemConfig;
     g_theEventSystem = new EventSystem(eventSystemConfig);
     g_theEventSystem->SubscribeEventCallbackFunction("OnCloseButtonClicked", OnCloseButtonClicked);
     g_theEventSystem->SubscribeEventCallbackFunction("quit", OnCloseButtonClicked);
+    g_theEventSystem->SubscribeEventCallbackFunction("PerfHUD", OnTogglePerfHUD);
+    g_theEventSystem->SubscribeEventCallbackFunction("LoadModel", OnLoadModel);
 
     sInputSystemConfig inputConfig;
     g_theInput = new InputSystem(inputConfig);
@@ -57,6 +176,7 @@ void App::Startup()
     sRendererConfig rendererConfig;
     rendererConfig.m_window = g_theWindow;
     g_theRenderer           = new Renderer(rendererConfig);
+    g_theRenderBackend      = new EngineRenderBackend(g_theRenderer);
 
     sDebugRenderConfig debugConfig;
     debugConfig.m_renderer = g_theRenderer;
@@ -86,6 +206,7 @@ void App::Startup()
     g_theDevConsole->AddLine(DevConsole::INFO_MINOR, "(5)     Spawn Billboard Text");
     g_theDevConsole->AddLine(DevConsole::INFO_MINOR, "(6)     Spawn Wireframe Cylinder");
     g_theDevConsole->AddLine(DevConsole::INFO_MINOR, "(7)     Add Message");
+    g_theDevConsole->AddLine(DevConsole::INFO_MINOR, "(F1)    Toggle Perf HUD");
     g_theDevConsole->AddLine(DevConsole::INFO_MINOR, "(~)     Toggle Dev Console");
     g_theDevConsole->AddLine(DevConsole::INFO_MINOR, "(ESC)   Exit Game");
     g_theDevConsole->AddLine(DevConsole::INFO_MINOR, "(SPACE) Start Game");
@@ -98,14 +219,14 @@ void App::Startup()
 
     //-End-of-NetworkSubsystem------------------------------------------------------------------------
     //------------------------------------------------------------------------------------------------
-    //-Start-of-ResourceSubsystem---------------------------------------------------------------------
+    //-Start-of-GameResourceLoader--------------------------------------------------------------------
 
-    sResourceSubsystemConfig resourceSubsystemConfig;
-    resourceSubsystemConfig.m_threadCount = 4;
+    // No threads of its own: loads run as background jobs on g_theJobSystem
+    sGameResourceLoaderConfig constexpr resourceLoaderConfig;
 
-    g_theResourceSubsystem = new ResourceSubsystem(resourceSubsystemConfig);
+    g_theGameResourceLoader = new GameResourceLoader(resourceLoaderConfig);
 
-    //-End-of-ResourceSubsystem-----------------------------------------------------------------------
+    //-End-of-GameResourceLoader----------------------------------------------------------------------
     //------------------------------------------------------------------------------------------------
     //-Start-of-V8Subsystem--------------------------------------------------------------------------
 
@@ -119,7 +240,10 @@ void App::Startup()
     //-End-of-V8Subsystem----------------------------------------------------------------------------
 
 
+    sProfilerConfig constexpr profilerConfig;
+
     g_theEventSystem->Startup();
+    ProfilerStartup(profilerConfig);
     g_theWindow->Startup();
     g_theRenderer->Startup();
     DebugRenderSystemStartup(debugConfig);
@@ -127,12 +251,77 @@ void App::Startup()
     g_theInput->Startup();
     g_theAudio->Startup();
     g_theLightSubsystem->StartUp();
-    g_theResourceSubsystem->Startup();
+    g_theLightSubsystem->SetBackendUploadsEnabled(false);     // The snapshot carries the lights
+    g_theGameResourceLoader->Startup();
     g_theV8Subsystem->Startup();  // V8 ?????
 
-    g_theBitmapFont = g_theRenderer->CreateOrGetBitmapFontFromFile("Data/Fonts/SquirrelFixedFont"); // DO NOT SPECIFY FILE .EXTENSION!!  (Important later on.)
-    g_theRNG        = new RandomNumberGenerator();
-    g_theGame       = new Game();
+    g_theGlyphFont = new GlyphFont(g_theRenderBackend->CreateOrGetTextureFromFile("Data/Fonts/SquirrelFixedFont.png"));
+    g_theRNG       = new RandomNumberGenerator();
+    g_theGame      = new Game();
+
+    sPerfHUDConfig constexpr perfHUDConfig;
+    m_perfHUD      = new PerfHUD(perfHUDConfig);
+    m_frameLimiter = new FrameLimiter(m_config.m_frameRateLimit);
+
+    // Windowed frames draw their snapshot on the main thread: the Renderer, DebugRender and
+    // DevConsole all belong to it
+    m_snapshotLightBinder = new LightBinder();
+
+    sRenderPipelineConfig renderPipelineConfig;
+    renderPipelineConfig.m_isThreaded = false;
+
+    m_renderPipeline = new RenderPipeline(renderPipelineConfig, [this](sRenderSnapshot const& snapshot) { RenderSnapshot(snapshot); });
+}
+#endif
+
+//----------------------------------------------------------------------------------------------------
+// Headless runs only need what Game::Update touches. No InputSystem is created; the Game and the
+// Player read no input while headless.
+//
+void App::StartupHeadless()
+{
+    sEventSystemConfig eventSystemConfig;
+    g_theEventSystem = new EventSystem(eventSystemConfig);
+    g_theEventSystem->SubscribeEventCallbackFunction("quit", OnCloseButtonClicked);
+
+    if (m_config.m_isSoftwareRendering)
+    {
+        sTextureCacheConfig textureCacheConfig;
+        m_textureCache = new TextureCache(textureCacheConfig);
+
+        sSoftwareRenderConfig softwareRenderConfig;
+        softwareRenderConfig.m_textureCache = m_textureCache;
+        m_softwareRenderBackend             = new SoftwareRenderBackend(softwareRenderConfig);
+        g_theRenderBackend                  = m_softwareRenderBackend;
+    }
+    else
+    {
+        g_theRenderBackend = new NullRenderBackend();
+    }
+
+    sLightConfig constexpr lightConfig;
+    g_theLightSubsystem = new LightSubsystem(lightConfig);
+
+    sGameResourceLoaderConfig constexpr resourceLoaderConfig;
+    g_theGameResourceLoader = new GameResourceLoader(resourceLoaderConfig);
+
+    sProfilerConfig constexpr profilerConfig;
+
+    g_theEventSystem->Startup();
+    ProfilerStartup(profilerConfig);
+    g_theLightSubsystem->StartUp();
+    g_theLightSubsystem->SetBackendUploadsEnabled(false);     // The snapshot carries the lights
+    g_theGameResourceLoader->Startup();
+
+    g_theRNG  = new RandomNumberGenerator();
+    g_theGame = new Game();
+
+    m_snapshotLightBinder = new LightBinder();
+
+    sRenderPipelineConfig renderPipelineConfig;
+    renderPipelineConfig.m_isThreaded = m_config.m_isRenderPipelined;
+
+    m_renderPipeline = new RenderPipeline(renderPipelineConfig, [this](sRenderSnapshot const& snapshot) { RenderSnapshot(snapshot); });
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -140,15 +329,57 @@ void App::Startup()
 //
 void App::Shutdown()
 {
+    // Draws what is still queued, so it goes before the Game and the backend it draws with
+    delete m_renderPipeline;
+    m_renderPipeline = nullptr;
+
+    delete m_snapshotLightBinder;
+    m_snapshotLightBinder = nullptr;
+
     // Destroy all Engine Subsystem
+    ProfilerShutdown();
+
+    delete m_frameLimiter;
+    m_frameLimiter = nullptr;
+
+#if defined(_WIN32)
+    delete m_perfHUD;
+    m_perfHUD = nullptr;
+#endif
+
     delete g_theGame;
     g_theGame = nullptr;
 
     delete g_theRNG;
     g_theRNG = nullptr;
 
-    delete g_theBitmapFont;
-    g_theBitmapFont = nullptr;
+    // After the Game, whose props draw its models, and before the job system its loads run on
+    g_theGameResourceLoader->Shutdown();
+
+    delete g_theGameResourceLoader;
+    g_theGameResourceLoader = nullptr;
+
+    // Nothing that submits jobs is left running
+    delete g_theJobSystem;
+    g_theJobSystem = nullptr;
+
+    if (m_config.m_isHeadless)
+    {
+        ShutdownHeadless();
+        return;
+    }
+
+#if defined(_WIN32)
+    ShutdownWindowed();
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------
+#if defined(_WIN32)
+void App::ShutdownWindowed()
+{
+    delete g_theGlyphFont;
+    g_theGlyphFont = nullptr;
 
     g_theV8Subsystem->Shutdown();  // V8 ????
     g_theLightSubsystem->ShutDown();
@@ -159,6 +390,10 @@ void App::Shutdown()
     delete m_devConsoleCamera;
     m_devConsoleCamera = nullptr;
 
+    // Its static mesh buffers are Renderer resources, so it goes while the device is still up
+    delete g_theRenderBackend;
+    g_theRenderBackend = nullptr;
+
     DebugRenderSystemShutdown();
     g_theRenderer->Shutdown();
     g_theWindow->Shutdown();
@@ -179,29 +414,106 @@ void App::Shutdown()
     delete g_theInput;
     g_theInput = nullptr;
 }
+#endif
+
+//----------------------------------------------------------------------------------------------------
+void App::ShutdownHeadless()
+{
+    g_theLightSubsystem->ShutDown();
+    g_theEventSystem->Shutdown();
+
+    delete g_theLightSubsystem;
+    g_theLightSubsystem = nullptr;
+
+    delete g_theRenderBackend;
+    g_theRenderBackend      = nullptr;
+    m_softwareRenderBackend = nullptr;
+
+    delete m_textureCache;
+    m_textureCache = nullptr;
+
+    delete g_theEventSystem;
+    g_theEventSystem = nullptr;
+}
 
 //----------------------------------------------------------------------------------------------------
 // One "frame" of the game.  Generally: Input, Update, Render.  We call this 60+ times per second.
 //
 void App::RunFrame()
 {
+    ProfilerBeginFrame();   // Starts a requested capture on a frame boundary
+
     BeginFrame();   // Engine pre-frame stuff
     Update();       // Game updates / moves / spawns / hurts / kills stuff
     Render();       // Game draws current state of things
     EndFrame();     // Engine post-frame stuff
+
+    if (m_frameLimiter != nullptr)
+    {
+        m_frameLimiter->WaitForNextFrame();     // Inside the profiled frame, so traces show the idle time
+    }
+
+    ProfilerEndFrame();     // Writes the capture once its last frame is recorded
 }
 
 //----------------------------------------------------------------------------------------------------
 void App::RunMainLoop()
 {
+    if (!m_config.m_bakeObjFilePath.empty())
+    {
+        String const& objFilePath    = m_config.m_bakeObjFilePath;
+        size_t const  extensionStart = objFilePath.find_last_of("./\\");
+        bool const    hasExtension   = extensionStart != String::npos && objFilePath[extensionStart] == '.';
+        String const  bakedFilePath  = objFilePath.substr(0, hasExtension ? extensionStart : String::npos) + BAKED_MESH_EXTENSION;
+        String        error;
+
+        if (!ConvertObjToBakedMesh(objFilePath.c_str(), bakedFilePath.c_str(), &error))
+        {
+            DebuggerPrintf("Could not bake \"%s\": %s\n", objFilePath.c_str(), error.c_str());
+        }
+
+        return;
+    }
+
+    if (!m_config.m_benchmarkSuiteName.empty())
+    {
+        if (!RunBenchmarkSuites(m_config.m_benchmarkSuiteName))
+        {
+            DebuggerPrintf("Unknown benchmark suite \"%s\"\n", m_config.m_benchmarkSuiteName.c_str());
+        }
+        else if (!m_config.m_benchmarkJsonFilePath.empty() && !WriteBenchmarkResultsJson(m_config.m_benchmarkJsonFilePath))
+        {
+            DebuggerPrintf("Could not write benchmark results to \"%s\"\n", m_config.m_benchmarkJsonFilePath.c_str());
+        }
+
+        return;
+    }
+
+    if (m_config.m_isHeadless)
+    {
+        RunHeadlessLoop();
+        return;
+    }
+
     // Program main loop; keep running frames until it's time to quit
     while (!m_isQuitting)
     {
-        // Sleep(16); // Temporary code to "slow down" our app to ~60Hz until we have proper frame timing in
-        RunFrame();
+        RunFrame();     // Paced by m_frameLimiter
     }
 }
 
+//----------------------------------------------------------------------------------------------------
+bool App::IsHeadless() const
+{
+    return m_config.m_isHeadless;
+}
+
+//----------------------------------------------------------------------------------------------------
+sAppConfig const& App::GetConfig() const
+{
+    return m_config;
+}
+
 //----------------------------------------------------------------------------------------------------
 STATIC bool App::OnCloseButtonClicked(EventArgs& args)
 {
@@ -212,6 +524,44 @@ STATIC bool App::OnCloseButtonClicked(EventArgs& args)
     return true;
 }
 
+//----------------------------------------------------------------------------------------------------
+STATIC bool App::OnTogglePerfHUD(EventArgs& args)
+{
+    UNUSED(args)
+
+#if defined(_WIN32)
+    if (g_theApp->m_perfHUD != nullptr)
+    {
+        g_theApp->m_perfHUD->ToggleVisible();
+    }
+#endif
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// DevConsole: LoadModel file=Data/Models/Example.obj
+//
+STATIC bool App::OnLoadModel(EventArgs& args)
+{
+    String const filePath = args.GetValue("file", String());
+
+    if (filePath.empty() || g_theGame == nullptr)
+    {
+        return false;
+    }
+
+    // The new Prop grows the Game's meshes, which a pipelined render thread may be drawing
+    if (g_theApp->m_renderPipeline != nullptr)
+    {
+        g_theApp->m_renderPipeline->WaitForIdle();
+    }
+
+    g_theGame->SpawnStreamedModel(filePath);
+
+    return true;
+}
+
 //----------------------------------------------------------------------------------------------------
 STATIC void App::RequestQuit()
 {
@@ -221,24 +571,51 @@ STATIC void App::RequestQuit()
 //----------------------------------------------------------------------------------------------------
 void App::BeginFrame() const
 {
-    g_theEventSystem->BeginFrame();
-    g_theWindow->BeginFrame();
-    g_theRenderer->BeginFrame();
-    DebugRenderBeginFrame();
-    g_theDevConsole->BeginFrame();
-    g_theInput->BeginFrame();
-    g_theAudio->BeginFrame();
+    PROFILE_SCOPE("App::BeginFrame");
+
+    // Headless frames begin and end the RenderBackend in RenderSnapshot, on the render side
+    if (m_config.m_isHeadless)
+    {
+        PROFILE_STATEMENT("EventSystem::BeginFrame", g_theEventSystem->BeginFrame());
+        g_theLightSubsystem->BeginFrame();
+        return;
+    }
+
+#if defined(_WIN32)
+    PROFILE_STATEMENT("EventSystem::BeginFrame", g_theEventSystem->BeginFrame());
+    PROFILE_STATEMENT("Window::BeginFrame", g_theWindow->BeginFrame());
+    PROFILE_STATEMENT("RenderBackend::BeginFrame", g_theRenderBackend->BeginFrame());
+    PROFILE_STATEMENT("DebugRender::BeginFrame", DebugRenderBeginFrame());
+    PROFILE_STATEMENT("DevConsole::BeginFrame", g_theDevConsole->BeginFrame());
+    PROFILE_STATEMENT("InputSystem::BeginFrame", g_theInput->BeginFrame());
+    PROFILE_STATEMENT("AudioSystem::BeginFrame", g_theAudio->BeginFrame());
     g_theLightSubsystem->BeginFrame();
+#endif
 }
 
 //----------------------------------------------------------------------------------------------------
 void App::Update()
 {
+    PROFILE_SCOPE("App::Update");
+
     Clock::TickSystemClock();
-	float deltaSeconds = Clock::GetSystemClock().GetDeltaSeconds();
     UpdateCursorMode();
+    PublishStreamedModels();
     g_theGame->Update();
-   
+
+#if defined(_WIN32)
+    if (m_perfHUD == nullptr)
+    {
+        return;
+    }
+
+    if (g_theInput->WasKeyJustPressed(KEYCODE_F1))
+    {
+        m_perfHUD->ToggleVisible();
+    }
+
+    m_perfHUD->Update(static_cast<float>(Clock::GetSystemClock().GetDeltaSeconds()));
+#endif
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -250,32 +627,113 @@ void App::Update()
 //
 void App::Render() const
 {
-    Rgba8 const clearColor = Rgba8::GREY;
+    PROFILE_SCOPE("App::Render");
+
+    g_theGame->BuildRenderSnapshot(m_renderPipeline->BeginSnapshot());
+    m_renderPipeline->SubmitSnapshot();
 
-    g_theRenderer->ClearScreen(clearColor, Rgba8::BLACK);
-    g_theGame->Render();
+    if (m_config.m_isHeadless)
+    {
+        return;
+    }
+
+#if defined(_WIN32)
+    // Drawn from the main thread's own state, over the frame SubmitSnapshot just drew
+    m_perfHUD->Render();
 
     AABB2 const box = AABB2(Vec2::ZERO, Vec2(1600.f, 30.f));
 
     g_theDevConsole->Render(box);
+#endif
 }
 
 //----------------------------------------------------------------------------------------------------
 void App::EndFrame() const
 {
-    g_theEventSystem->EndFrame();
-    g_theWindow->EndFrame();
-    g_theRenderer->EndFrame();
-    DebugRenderEndFrame();
-    g_theDevConsole->EndFrame();
-    g_theInput->EndFrame();
-    g_theAudio->EndFrame();
+    PROFILE_SCOPE("App::EndFrame");
+
+    if (m_config.m_isHeadless)
+    {
+        PROFILE_STATEMENT("EventSystem::EndFrame", g_theEventSystem->EndFrame());
+        g_theLightSubsystem->EndFrame();
+        return;
+    }
+
+#if defined(_WIN32)
+    PROFILE_STATEMENT("EventSystem::EndFrame", g_theEventSystem->EndFrame());
+    PROFILE_STATEMENT("Window::EndFrame", g_theWindow->EndFrame());
+    PROFILE_STATEMENT("RenderBackend::EndFrame", g_theRenderBackend->EndFrame());
+    PROFILE_STATEMENT("DebugRender::EndFrame", DebugRenderEndFrame());
+    PROFILE_STATEMENT("DevConsole::EndFrame", g_theDevConsole->EndFrame());
+    PROFILE_STATEMENT("InputSystem::EndFrame", g_theInput->EndFrame());
+    PROFILE_STATEMENT("AudioSystem::EndFrame", g_theAudio->EndFrame());
     g_theLightSubsystem->EndFrame();
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------
+// Uploads models that finished decoding and swaps them into the Game's props, at the start of the
+// frame so this Update sees them. A pipelined render thread must finish its frames first, since it
+// draws with the same backend and the same props; frames with nothing to publish never wait.
+//
+void App::PublishStreamedModels()
+{
+    if (!g_theGameResourceLoader->HasFinishedModels())
+    {
+        return;
+    }
+
+    if (m_renderPipeline != nullptr)
+    {
+        m_renderPipeline->WaitForIdle();
+    }
+
+    g_theGameResourceLoader->PublishFinishedModels();
+    g_theGame->UpdateStreamedModels();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Draws one snapshot: on the render thread when pipelined, otherwise on the main thread inside
+// SubmitSnapshot. The snapshot's lights are bound the way LightSubsystem would bind them: the
+// default set first, then per batch, each upload skipped when nothing changed.
+//
+// A headless tick's whole backend frame happens here. Windowed frames are begun and ended by
+// BeginFrame and EndFrame, around the Window and DebugRender frames.
+//
+void App::RenderSnapshot(sRenderSnapshot const& snapshot)
+{
+    if (m_config.m_isHeadless)
+    {
+        g_theRenderBackend->BeginFrame();
+    }
+
+    m_snapshotLightBinder->ResetStatistics();
+    m_snapshotLightBinder->SetLights(snapshot.m_lights.data(), static_cast<int>(snapshot.m_lights.size()), snapshot.m_lightChangeCount);
+    m_snapshotLightBinder->BindDefaultLights();
+
+    g_theRenderBackend->ClearScreen(Rgba8::GREY, Rgba8::BLACK);
+    g_theGame->RenderSnapshot(snapshot, *m_snapshotLightBinder);
+
+    if (!m_config.m_isHeadless)
+    {
+        return;
+    }
+
+    g_theRenderBackend->EndFrame();
+
+    size_t const vertexBytes = g_theRenderBackend->GetFrameStatistics().m_vertexBytesUploaded;
+    m_maxVertexBytesUploaded = vertexBytes > m_maxVertexBytesUploaded ? vertexBytes : m_maxVertexBytesUploaded;
 }
 
 //----------------------------------------------------------------------------------------------------
 void App::UpdateCursorMode()
 {
+    if (m_config.m_isHeadless)
+    {
+        return;
+    }
+
+#if defined(_WIN32)
     bool const doesWindowHasFocus   = GetActiveWindow() == g_theWindow->GetWindowHandle();
     bool const shouldUsePointerMode = !doesWindowHasFocus || g_theDevConsole->IsOpen() || g_theGame->IsAttractMode();
 
@@ -287,6 +745,7 @@ void App::UpdateCursorMode()
     {
         g_theInput->SetCursorMode(eCursorMode::FPS);
     }
+#endif
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -297,3 +756,93 @@ void App::DeleteAndCreateNewGame()
 
     g_theGame = new Game();
 }
+
+//----------------------------------------------------------------------------------------------------
+// Runs frames back to back until the tick or time budget is spent, then reports the throughput.
+// The run ends once the last frame has been drawn, so a pipelined run is timed the same way.
+//
+void App::RunHeadlessLoop()
+{
+    double const startSeconds   = GetCurrentTimeSeconds();
+    double       elapsedSeconds = 0.0;
+    int          tickCount      = 0;
+
+    while (!m_isQuitting)
+    {
+        RunFrame();
+        ++tickCount;
+
+        elapsedSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+        if (m_config.m_headlessMaxTicks > 0 && tickCount >= m_config.m_headlessMaxTicks) break;
+        if (m_config.m_headlessMaxSeconds > 0.0 && elapsedSeconds >= m_config.m_headlessMaxSeconds) break;
+    }
+
+    m_renderPipeline->WaitForIdle();
+    elapsedSeconds = GetCurrentTimeSeconds() - startSeconds;
+
+    size_t const maxVertexBytes = m_maxVertexBytesUploaded;     // Static geometry is uploaded at load, so this should stay 0
+
+    double const ticksPerSecond      = elapsedSeconds > 0.0 ? static_cast<double>(tickCount) / elapsedSeconds : 0.0;
+    double const microsecondsPerTick = tickCount > 0 ? elapsedSeconds * 1000000.0 / static_cast<double>(tickCount) : 0.0;
+    String const report              = Stringf("Headless: %d ticks in %.3f s (%.1f ticks/s, %.3f us/tick)\n", tickCount, elapsedSeconds, ticksPerSecond, microsecondsPerTick);
+
+    sRenderStatistics const& statistics = g_theRenderBackend->GetFrameStatistics();
+    String const renderReport = Stringf("Headless: %d draws/frame, %d state changes/frame, max %u vertex bytes uploaded in one frame\n", statistics.m_drawCalls, statistics.m_stateChanges, static_cast<unsigned int>(maxVertexBytes));
+
+    sCullingStatistics const& culling    = g_theGame->GetCullingStatistics();
+    String const              cullReport = Stringf("Headless: %d entities visible, %d culled\n", culling.m_visibleCount, culling.m_culledCount);
+
+    sLightStatistics const& lights      = m_snapshotLightBinder->GetStatistics();
+    String const            lightReport = Stringf("Headless: %d lights evaluated/frame, %d light uploads (%d skipped), %u light bytes uploaded/frame\n", lights.m_lightsEvaluated, lights.m_lightSetUploads, lights.m_lightSetUploadsSkipped, static_cast<unsigned int>(lights.m_lightBytesUploaded));
+
+    DebuggerPrintf("%s%s%s%s", report.c_str(), renderReport.c_str(), cullReport.c_str(), lightReport.c_str());
+    printf("%s%s%s%s", report.c_str(), renderReport.c_str(), cullReport.c_str(), lightReport.c_str());
+
+    if (m_renderPipeline->IsThreaded())
+    {
+        sRenderPipelineStatistics const pipeline       = m_renderPipeline->GetStatistics();
+        double const                    frameCount     = pipeline.m_framesRendered > 0 ? static_cast<double>(pipeline.m_framesRendered) : 1.0;
+        String const                    pipelineReport = Stringf("Headless: pipelined, game thread waited %.3f us/frame for a free snapshot, render thread waited %.3f us/frame for the next one\n", pipeline.m_submitWaitSeconds * 1000000.0 / frameCount, pipeline.m_renderWaitSeconds * 1000000.0 / frameCount);
+
+        DebuggerPrintf("%s", pipelineReport.c_str());
+        printf("%s", pipelineReport.c_str());
+    }
+
+    if (m_softwareRenderBackend == nullptr)
+    {
+        return;
+    }
+
+    sSoftwareRenderStatistics const& raster       = m_softwareRenderBackend->GetRasterStatistics();
+    String                           rasterReport = Stringf("Headless: %d triangles binned/frame (%d culled), %lld pixels written/frame, image hash %016llx\n", raster.m_trianglesBinned, raster.m_trianglesCulled, static_cast<long long>(raster.m_pixelsWritten), static_cast<unsigned long long>(m_softwareRenderBackend->GetColorBufferHash()));
+
+    if (!m_config.m_captureFilePath.empty())
+    {
+        bool const isWritten = m_softwareRenderBackend->WriteColorBufferToTGA(m_config.m_captureFilePath.c_str());
+        rasterReport        += Stringf("Headless: %s \"%s\"\n", isWritten ? "captured frame to" : "could not write capture", m_config.m_captureFilePath.c_str());
+    }
+
+    DebuggerPrintf("%s", rasterReport.c_str());
+    printf("%s", rasterReport.c_str());
+}
+
+//----------------------------------------------------------------------------------------------------
+// A launch whose textures all hit the cache is a warm start; any cook makes it a cold one, and the
+// report splits the texture time both ways so the two can be compared across launches.
+//
+void App::ReportStartup(double const startupSeconds) const
+{
+    if (m_textureCache == nullptr)
+    {
+        return;
+    }
+
+    sTextureCacheStatistics const& statistics = m_textureCache->GetStatistics();
+    String const                   report     = Stringf("Startup: %.2f ms, %s texture cache: %d textures mapped in %.2f ms, %d cooked in %.2f ms, %d failed\n",
+                                                        startupSeconds * 1000.0, statistics.m_cookedCount > 0 ? "cold" : "warm",
+                                                        statistics.m_hitCount, statistics.m_hitSeconds * 1000.0, statistics.m_cookedCount, statistics.m_cookedSeconds * 1000.0, statistics.m_failedCount);
+
+    DebuggerPrintf("%s", report.c_str());
+    printf("%s", report.c_str());
+}
@@ -4,10 +4,51 @@
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
+#include <cstddef>
+#include <cstdint>
+
 #include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/StringUtils.hpp"
 
 //-Forward-Declaration--------------------------------------------------------------------------------
 class Camera;
+class FrameLimiter;
+class LightBinder;
+class PerfHUD;
+class RenderPipeline;
+class SoftwareRenderBackend;
+class TextureCache;
+struct sRenderSnapshot;
+
+//----------------------------------------------------------------------------------------------------
+// Parsed from the command line, e.g. "headless ticks=10000", "headless seconds=5",
+// "headless benchmark=all benchmarkjson=Results.json" or
+// "headless renderer=software ticks=1 capture=frame.tga".
+// "headless pipelined" draws each headless frame on a render thread while the next one simulates.
+// "profile=120 trace=Trace.json" writes a profiler capture of the first 120 frames, headless or not.
+// "simhz=120" sets the fixed simulation rate, and "fps=144" the windowed frame limit ("fps=0" runs
+// unlimited).
+// In headless mode no Window, Renderer, DevConsole, DebugRender or Audio is created; the game
+// submits its frames to a NullRenderBackend, or with "renderer=software" draws them on the CPU, and
+// the main loop stops after the tick or time budget. Each headless tick is one simulation step and
+// is never frame limited.
+//
+struct sAppConfig
+{
+    bool   m_isHeadless               = false;
+    int    m_headlessMaxTicks         = 0;          // 0 means no tick limit
+    double m_headlessMaxSeconds       = 0.0;        // 0 means no time limit
+    bool   m_isSoftwareRendering      = false;      // Headless frames go to a SoftwareRenderBackend
+    String m_captureFilePath;                       // Last software-rendered frame is written here as a TGA
+    String m_benchmarkSuiteName;                    // Runs Benchmark/ suites instead of the game loop when set
+    String m_benchmarkJsonFilePath;                 // The benchmark results are also written here as JSON
+    String m_bakeObjFilePath;                       // Converts this OBJ to a .bmesh beside it instead of running the game
+    int    m_profileFrameCount        = 0;          // Frames to capture from startup; 0 means no capture
+    String m_profileFilePath;                       // Chrome trace JSON; the profiler's default when empty
+    double m_simulationStepsPerSecond = 60.0;       // Fixed rate the Game simulation steps at
+    double m_frameRateLimit           = 60.0;       // Windowed only; 0 means no limit
+    bool   m_isRenderPipelined        = false;      // Headless only; see RenderPipeline
+};
 
 //----------------------------------------------------------------------------------------------------
 class App
@@ -15,13 +56,18 @@ class App
 public:
     App()  = default;
     ~App() = default;
-    void Startup();
+    void Startup(char const* commandLine);
     void Shutdown();
     void RunFrame();
 
     void RunMainLoop();
+    bool IsHeadless() const;
+
+    sAppConfig const& GetConfig() const;
 
     static bool OnCloseButtonClicked(EventArgs& args);
+    static bool OnTogglePerfHUD(EventArgs& args);
+    static bool OnLoadModel(EventArgs& args);
     static void RequestQuit();
     static bool m_isQuitting;
 
@@ -30,9 +76,27 @@ private:
     void Update();
     void Render() const;
     void EndFrame() const;
+    void RenderSnapshot(sRenderSnapshot const& snapshot);
+    void PublishStreamedModels();
 
+    void StartupWindowed();     // Windows only
+    void StartupHeadless();
+    void ShutdownWindowed();    // Windows only
+    void ShutdownHeadless();
     void UpdateCursorMode();
     void DeleteAndCreateNewGame();
+    void RunHeadlessLoop();
+    void ReportStartup(double startupSeconds) const;
+
+    sAppConfig             m_config;
+    Camera*                m_devConsoleCamera      = nullptr;
+    FrameLimiter*          m_frameLimiter          = nullptr;     // Windowed only
+    PerfHUD*               m_perfHUD               = nullptr;     // Windowed only; F1 or "PerfHUD" toggles it
+    SoftwareRenderBackend* m_softwareRenderBackend = nullptr;     // g_theRenderBackend, when software rendering
+    TextureCache*          m_textureCache          = nullptr;     // Software rendering only; its textures load cooked
+    RenderPipeline*        m_renderPipeline        = nullptr;     // Draws every frame; threaded only when headless pipelined
 
-    Camera* m_devConsoleCamera = nullptr;
+    // Render side of each frame, touched only by RenderSnapshot
+    LightBinder*           m_snapshotLightBinder    = nullptr;    // Binds each snapshot's lights, per batch
+    size_t                 m_maxVertexBytesUploaded = 0;          // Most in any one frame; should stay 0
 };
@@ -0,0 +1,78 @@
+//----------------------------------------------------------------------------------------------------
+// FixedTimestep.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/FixedTimestep.hpp"
+
+#include <cmath>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+//----------------------------------------------------------------------------------------------------
+FixedTimestep::FixedTimestep(sFixedTimestepConfig const& config)
+    : m_config(config)
+{
+    GUARANTEE_OR_DIE(config.m_stepsPerSecond > 0.0, "FixedTimestep needs a positive step rate")
+    GUARANTEE_OR_DIE(config.m_maxStepsPerFrame > 0, "FixedTimestep needs at least one step per frame")
+
+    m_stepSeconds = 1.0 / config.m_stepsPerSecond;
+}
+
+//----------------------------------------------------------------------------------------------------
+int FixedTimestep::Advance(double const deltaSeconds)
+{
+    m_accumulatedSeconds += deltaSeconds > 0.0 ? deltaSeconds : 0.0;
+
+    int stepCount = 0;
+
+    while (m_accumulatedSeconds >= m_stepSeconds && stepCount < m_config.m_maxStepsPerFrame)
+    {
+        m_accumulatedSeconds -= m_stepSeconds;
+        ++stepCount;
+    }
+
+    // Whole steps past the limit are dropped; the partial step stays for interpolation
+    if (m_accumulatedSeconds >= m_stepSeconds)
+    {
+        double const remainderSeconds  = fmod(m_accumulatedSeconds, m_stepSeconds);
+        m_droppedSeconds              += m_accumulatedSeconds - remainderSeconds;
+        m_accumulatedSeconds           = remainderSeconds;
+    }
+
+    m_stepCount += static_cast<uint64_t>(stepCount);
+
+    return stepCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void FixedTimestep::Reset()
+{
+    m_accumulatedSeconds = 0.0;
+    m_droppedSeconds     = 0.0;
+    m_stepCount          = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+double FixedTimestep::GetStepSeconds() const
+{
+    return m_stepSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+float FixedTimestep::GetInterpolationAlpha() const
+{
+    return static_cast<float>(m_accumulatedSeconds / m_stepSeconds);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t FixedTimestep::GetStepCount() const
+{
+    return m_stepCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+double FixedTimestep::GetDroppedSeconds() const
+{
+    return m_droppedSeconds;
+}
@@ -0,0 +1,44 @@
+//----------------------------------------------------------------------------------------------------
+// FixedTimestep.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+struct sFixedTimestepConfig
+{
+    double m_stepsPerSecond   = 60.0;
+    int    m_maxStepsPerFrame = 5;      // A frame that falls further behind drops the rest of its time
+};
+
+//----------------------------------------------------------------------------------------------------
+// Turns variable frame times into a whole number of fixed simulation steps. Time that does not make
+// a full step carries over to the next frame, and what is left is the interpolation alpha: how far
+// the frame being drawn lies between the last two steps.
+//
+// The simulation only ever sees the one step length, so a run gives the same result at any frame
+// rate. After a long hitch it runs at most m_maxStepsPerFrame steps and lets the game slow down,
+// rather than spending ever longer catching up.
+//
+class FixedTimestep
+{
+public:
+    explicit FixedTimestep(sFixedTimestepConfig const& config = sFixedTimestepConfig());
+
+    int  Advance(double deltaSeconds);      // Steps to run this frame
+    void Reset();
+
+    double   GetStepSeconds() const;
+    float    GetInterpolationAlpha() const; // In [0, 1), as of the last Advance
+    uint64_t GetStepCount() const;          // Every step handed out since the last Reset
+    double   GetDroppedSeconds() const;     // Time discarded because a frame hit m_maxStepsPerFrame
+
+private:
+    sFixedTimestepConfig m_config;
+    double               m_stepSeconds        = 0.0;
+    double               m_accumulatedSeconds = 0.0;
+    double               m_droppedSeconds     = 0.0;
+    uint64_t             m_stepCount          = 0;
+};
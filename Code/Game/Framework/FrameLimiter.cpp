@@ -0,0 +1,118 @@
+//----------------------------------------------------------------------------------------------------
+// FrameLimiter.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/FrameLimiter.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "Engine/Core/Time.hpp"
+#include "Game/Math/SIMD.hpp"
+#include "Game/Subsystem/Profile/Profiler.hpp"
+
+#if defined(_WIN32)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <timeapi.h>
+#pragma comment(lib, "winmm.lib")
+#endif
+
+//----------------------------------------------------------------------------------------------------
+static double constexpr SLEEP_SLICE_SECONDS = 0.001;
+static double constexpr SLICE_WEIGHT        = 1.0 / 32.0;  // Of each new slice in the running estimate
+
+//----------------------------------------------------------------------------------------------------
+FrameLimiter::FrameLimiter(double const targetFramesPerSecond)
+{
+    SetTargetFramesPerSecond(targetFramesPerSecond);
+
+#if defined(_WIN32)
+    timeBeginPeriod(1);
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------
+FrameLimiter::~FrameLimiter()
+{
+#if defined(_WIN32)
+    timeEndPeriod(1);
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------
+void FrameLimiter::WaitForNextFrame()
+{
+    if (m_periodSeconds <= 0.0)
+    {
+        return;
+    }
+
+    PROFILE_SCOPE("FrameLimiter::WaitForNextFrame");
+
+    double const startSeconds = GetCurrentTimeSeconds();
+    ++m_statistics.m_frameCount;
+
+    if (m_nextDeadlineSeconds != 0.0 && startSeconds > m_nextDeadlineSeconds)
+    {
+        ++m_statistics.m_missedCount;
+    }
+
+    if (m_nextDeadlineSeconds == 0.0 || startSeconds > m_nextDeadlineSeconds + m_periodSeconds)
+    {
+        m_nextDeadlineSeconds = startSeconds + m_periodSeconds;
+    }
+
+    double const deadlineSeconds = m_nextDeadlineSeconds;
+    double       nowSeconds      = startSeconds;
+
+    // Sleep while even a slow slice (mean plus one deviation) would end before the deadline
+    while (deadlineSeconds - nowSeconds > m_sliceMeanSeconds + sqrt(m_sliceVariance))
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<long long>(SLEEP_SLICE_SECONDS * 1000000.0)));
+
+        double const wokeSeconds = GetCurrentTimeSeconds();
+        double const deviation   = (wokeSeconds - nowSeconds) - m_sliceMeanSeconds;
+
+        m_sliceMeanSeconds += deviation * SLICE_WEIGHT;
+        m_sliceVariance     = (1.0 - SLICE_WEIGHT) * (m_sliceVariance + deviation * deviation * SLICE_WEIGHT);
+        nowSeconds          = wokeSeconds;
+    }
+
+    double const spinStartSeconds = nowSeconds;
+
+    while (nowSeconds < deadlineSeconds)
+    {
+#if defined(GAME_SIMD_SSE)
+        _mm_pause();
+#endif
+        nowSeconds = GetCurrentTimeSeconds();
+    }
+
+    m_statistics.m_sleepSeconds += spinStartSeconds - startSeconds;
+    m_statistics.m_spinSeconds  += nowSeconds - spinStartSeconds;
+    m_nextDeadlineSeconds        = deadlineSeconds + m_periodSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+void FrameLimiter::SetTargetFramesPerSecond(double const targetFramesPerSecond)
+{
+    m_periodSeconds       = targetFramesPerSecond > 0.0 ? 1.0 / targetFramesPerSecond : 0.0;
+    m_nextDeadlineSeconds = 0.0;
+}
+
+//----------------------------------------------------------------------------------------------------
+double FrameLimiter::GetTargetFramesPerSecond() const
+{
+    return m_periodSeconds > 0.0 ? 1.0 / m_periodSeconds : 0.0;
+}
+
+//----------------------------------------------------------------------------------------------------
+sFrameLimiterStatistics const& FrameLimiter::GetStatistics() const
+{
+    return m_statistics;
+}
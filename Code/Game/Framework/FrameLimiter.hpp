@@ -0,0 +1,52 @@
+//----------------------------------------------------------------------------------------------------
+// FrameLimiter.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+
+//----------------------------------------------------------------------------------------------------
+struct sFrameLimiterStatistics
+{
+    int    m_frameCount   = 0;
+    int    m_missedCount  = 0;      // Frames that were already past their deadline
+    double m_sleepSeconds = 0.0;
+    double m_spinSeconds  = 0.0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Holds the main loop to a target frame rate. Each wait sleeps in 1 ms slices, then spins for the
+// last stretch, so the thread is idle for most of the frame and still wakes within microseconds of
+// its deadline. How long a slice really takes is tracked as a running mean and variance, and
+// sleeping stops once a slice one deviation slower than the mean could overrun the deadline; a
+// scheduler that oversleeps only shifts more of the wait into the spin.
+//
+// Deadlines are a fixed period apart rather than a period after each wait returns, so frames do
+// not drift. A frame that misses its deadline by more than a period starts a new schedule instead
+// of rushing to catch up.
+//
+// On Windows the system timer is raised to 1 ms while a limiter exists; the default 15.6 ms tick
+// would make every sleep too coarse to be useful.
+//
+class FrameLimiter
+{
+public:
+    explicit FrameLimiter(double targetFramesPerSecond);    // 0 or less never waits
+    ~FrameLimiter();
+
+    FrameLimiter(FrameLimiter const&)            = delete;
+    FrameLimiter& operator=(FrameLimiter const&) = delete;
+
+    void WaitForNextFrame();        // Call once per frame, after it has been presented
+    void SetTargetFramesPerSecond(double targetFramesPerSecond);
+
+    double                         GetTargetFramesPerSecond() const;
+    sFrameLimiterStatistics const& GetStatistics() const;       // Since construction
+
+private:
+    double                  m_periodSeconds        = 0.0;
+    double                  m_nextDeadlineSeconds  = 0.0;   // 0 until the first wait
+    double                  m_sliceMeanSeconds     = 0.002; // Measured length of a 1 ms sleep
+    double                  m_sliceVariance        = 0.0;
+    sFrameLimiterStatistics m_statistics;
+};
@@ -7,7 +7,7 @@
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/Vertex_PCU.hpp"
 #include "Engine/Math/MathUtils.hpp"
-#include "Engine/Renderer/Renderer.hpp"
+#include "Game/Subsystem/Render/RenderBackend.hpp"
 
 //-----------------------------------------------------------------------------------------------
 // DebugRender color-related
@@ -74,8 +74,8 @@ void DebugDrawRing(Vec2 const& center, float radius, float thickness, Rgba8 cons
         verts[vertIndexF].m_color    = color;
     }
 
-    g_theRenderer->BindTexture(nullptr);
-    g_theRenderer->DrawVertexArray(NUM_VERTS, &verts[0]);
+    g_theRenderBackend->BindTexture(nullptr);
+    g_theRenderBackend->DrawVertexArray(NUM_VERTS, &verts[0]);
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -107,8 +107,8 @@ void DebugDrawLine(Vec2 const& start, Vec2 const& end, float thickness, Rgba8 co
     verts[4].m_color    = color;
     verts[5].m_color    = color;
 
-    g_theRenderer->BindTexture(nullptr);
-    g_theRenderer->DrawVertexArray(6, &verts[0]);
+    g_theRenderBackend->BindTexture(nullptr);
+    g_theRenderBackend->DrawVertexArray(6, &verts[0]);
 }
 
 //------------------------------------------------------------------------------------------------
@@ -157,7 +157,7 @@ void DebugDrawGlowCircle(Vec2 const& center, float radius, Rgba8 const& color, f
         verts[vertIndexC].m_color = glowColor;
     }
 
-    g_theRenderer->DrawVertexArray(NUM_VERTS, &verts[0]);
+    g_theRenderBackend->DrawVertexArray(NUM_VERTS, &verts[0]);
 }
 
 void DebugDrawGlowBox(Vec2 const& center, Vec2 const& dimensions, Rgba8 const& color, float glowIntensity)
@@ -204,7 +204,7 @@ void DebugDrawGlowBox(Vec2 const& center, Vec2 const& dimensions, Rgba8 const& c
     }
 
     // Draw the vertex array
-    g_theRenderer->DrawVertexArray(NUM_VERTS, &verts[0]);
+    g_theRenderBackend->DrawVertexArray(NUM_VERTS, &verts[0]);
 }
 
 
@@ -270,5 +270,5 @@ void DebugDrawBoxRing(Vec2 const& center, float radius, float thickness, Rgba8 c
         verts[i].m_color = color;
     }
 
-    g_theRenderer->DrawVertexArray(24, &verts[0]);
+    g_theRenderBackend->DrawVertexArray(24, &verts[0]);
 }
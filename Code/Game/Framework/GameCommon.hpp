@@ -10,22 +10,26 @@ struct Rgba8;
 struct Vec2;
 class App;
 class AudioSystem;
-class BitmapFont;
 class Game;
+class GameResourceLoader;
+class GlyphFont;
+class JobSystem;
 class LightSubsystem;
 class Renderer;
+class RenderBackend;
 class RandomNumberGenerator;
-class ResourceSubsystem;
 
 // one-time declaration
 extern App*                   g_theApp;
 extern AudioSystem*           g_theAudio;
-extern BitmapFont*            g_theBitmapFont;
 extern Game*                  g_theGame;
+extern GameResourceLoader*    g_theGameResourceLoader;
+extern GlyphFont*             g_theGlyphFont;
+extern JobSystem*             g_theJobSystem;
 extern Renderer*              g_theRenderer;
+extern RenderBackend*         g_theRenderBackend;
 extern RandomNumberGenerator* g_theRNG;
 extern LightSubsystem*        g_theLightSubsystem;
-extern ResourceSubsystem*     g_theResourceSubsystem;
 
 //-----------------------------------------------------------------------------------------------
 // DebugRender-related
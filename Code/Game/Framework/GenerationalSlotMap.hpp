@@ -0,0 +1,194 @@
+//----------------------------------------------------------------------------------------------------
+// GenerationalSlotMap.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// A slot and the generation that slot had when the handle was made. `Tag` only keeps the handles of
+// different containers apart, so an EntityHandle cannot be passed where a LightHandle is expected.
+//
+template <typename Tag>
+struct GenerationalHandle
+{
+    uint32_t m_slot       = UINT32_MAX;
+    uint32_t m_generation = 0;
+
+    bool operator==(GenerationalHandle const& other) const { return m_slot == other.m_slot && m_generation == other.m_generation; }
+    bool operator!=(GenerationalHandle const& other) const { return !(*this == other); }
+
+    static GenerationalHandle const INVALID;
+};
+
+template <typename Tag>
+GenerationalHandle<Tag> const GenerationalHandle<Tag>::INVALID = GenerationalHandle<Tag>();
+
+//----------------------------------------------------------------------------------------------------
+// The handle bookkeeping behind a packed container: maps stable slots to dense indices in
+// [0, GetCount()) and back. The container keeps its own data arrays in dense order and mirrors the
+// two moves this makes, appending on Add and moving the last element into the hole on Remove.
+//
+// A removed slot goes on a free list and its generation is bumped, so a stale handle never matches
+// the slot's next occupant. Clear bumps every live slot the same way rather than resetting the
+// generations.
+//
+template <typename HandleType>
+class GenerationalSlotMap
+{
+public:
+    HandleType Add();                                                // The new element's dense index is GetCount() - 1
+    bool       Remove(HandleType handle, uint32_t& out_denseIndex);  // False if not alive; else move the last element to out_denseIndex and pop
+    void       Reserve(int capacity);
+    void       Clear();
+
+    bool       IsAlive(HandleType handle) const;
+    int        GetDenseIndex(HandleType handle) const;               // -1 if not alive
+    int        GetCount() const;
+    uint32_t   GetSlot(int denseIndex) const;
+    uint32_t   GetDenseIndexForSlot(uint32_t slot) const;            // Only meaningful for a live slot
+    HandleType GetHandleForSlot(uint32_t slot) const;
+
+private:
+    std::vector<uint32_t> m_denseToSlot;
+    std::vector<uint32_t> m_slotToDense;
+    std::vector<uint32_t> m_slotGenerations;
+    std::vector<uint32_t> m_freeSlots;
+};
+
+//----------------------------------------------------------------------------------------------------
+template <typename HandleType>
+HandleType GenerationalSlotMap<HandleType>::Add()
+{
+    uint32_t slot;
+
+    if (m_freeSlots.empty())
+    {
+        slot = static_cast<uint32_t>(m_slotGenerations.size());
+        m_slotGenerations.push_back(0);
+        m_slotToDense.push_back(0);
+    }
+    else
+    {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+
+    m_slotToDense[slot] = static_cast<uint32_t>(m_denseToSlot.size());
+    m_denseToSlot.push_back(slot);
+
+    return GetHandleForSlot(slot);
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename HandleType>
+bool GenerationalSlotMap<HandleType>::Remove(HandleType const handle, uint32_t& out_denseIndex)
+{
+    if (!IsAlive(handle))
+    {
+        return false;
+    }
+
+    uint32_t const denseIndex = m_slotToDense[handle.m_slot];
+    uint32_t const lastIndex  = static_cast<uint32_t>(m_denseToSlot.size()) - 1;
+
+    if (denseIndex != lastIndex)
+    {
+        uint32_t const movedSlot  = m_denseToSlot[lastIndex];
+        m_denseToSlot[denseIndex] = movedSlot;
+        m_slotToDense[movedSlot]  = denseIndex;
+    }
+
+    m_denseToSlot.pop_back();
+
+    ++m_slotGenerations[handle.m_slot];
+    m_freeSlots.push_back(handle.m_slot);
+
+    out_denseIndex = denseIndex;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename HandleType>
+void GenerationalSlotMap<HandleType>::Reserve(int const capacity)
+{
+    size_t const size = static_cast<size_t>(capacity);
+
+    m_denseToSlot.reserve(size);
+    m_slotToDense.reserve(size);
+    m_slotGenerations.reserve(size);
+    m_freeSlots.reserve(size);
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename HandleType>
+void GenerationalSlotMap<HandleType>::Clear()
+{
+    for (uint32_t const slot : m_denseToSlot)
+    {
+        ++m_slotGenerations[slot];
+        m_freeSlots.push_back(slot);
+    }
+
+    m_denseToSlot.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+// The generation check alone is not enough for a handle made up by hand, so the slot's dense index
+// must also point back at it.
+//
+template <typename HandleType>
+bool GenerationalSlotMap<HandleType>::IsAlive(HandleType const handle) const
+{
+    if (handle.m_slot >= m_slotGenerations.size() || m_slotGenerations[handle.m_slot] != handle.m_generation)
+    {
+        return false;
+    }
+
+    uint32_t const denseIndex = m_slotToDense[handle.m_slot];
+
+    return denseIndex < m_denseToSlot.size() && m_denseToSlot[denseIndex] == handle.m_slot;
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename HandleType>
+int GenerationalSlotMap<HandleType>::GetDenseIndex(HandleType const handle) const
+{
+    return IsAlive(handle) ? static_cast<int>(m_slotToDense[handle.m_slot]) : -1;
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename HandleType>
+int GenerationalSlotMap<HandleType>::GetCount() const
+{
+    return static_cast<int>(m_denseToSlot.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename HandleType>
+uint32_t GenerationalSlotMap<HandleType>::GetSlot(int const denseIndex) const
+{
+    return m_denseToSlot[denseIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename HandleType>
+uint32_t GenerationalSlotMap<HandleType>::GetDenseIndexForSlot(uint32_t const slot) const
+{
+    return m_slotToDense[slot];
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename HandleType>
+HandleType GenerationalSlotMap<HandleType>::GetHandleForSlot(uint32_t const slot) const
+{
+    HandleType handle;
+    handle.m_slot       = slot;
+    handle.m_generation = m_slotGenerations[slot];
+
+    return handle;
+}
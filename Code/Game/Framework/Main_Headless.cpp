@@ -0,0 +1,36 @@
+//----------------------------------------------------------------------------------------------------
+// Main_Headless.cpp
+//
+// Entry point for non-Windows builds. These builds have no Window or D3D11 Renderer, so the App
+// always runs headless; any other tokens (ticks=, seconds=) are passed through unchanged.
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#if !defined(_WIN32)
+#include <string>
+
+#include "Game/Framework/App.hpp"
+#include "Game/Framework/GameCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+int main(int const argc, char* argv[])
+{
+    std::string commandLine = "headless";
+
+    for (int argIndex = 1; argIndex < argc; ++argIndex)
+    {
+        commandLine += " ";
+        commandLine += argv[argIndex];
+    }
+
+    g_theApp = new App();
+    g_theApp->Startup(commandLine.c_str());
+    g_theApp->RunMainLoop();
+    g_theApp->Shutdown();
+
+    delete g_theApp;
+    g_theApp = nullptr;
+
+    return 0;
+}
+#endif
@@ -10,10 +10,9 @@
 int WINAPI WinMain(HINSTANCE const applicationInstanceHandle, HINSTANCE, LPSTR const commandLineString, int)
 {
     UNUSED(applicationInstanceHandle)
-    UNUSED(commandLineString)
 
     g_theApp = new App();
-    g_theApp->Startup();
+    g_theApp->Startup(commandLineString);
     g_theApp->RunMainLoop();
     g_theApp->Shutdown();
 
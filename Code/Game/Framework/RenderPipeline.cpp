@@ -0,0 +1,144 @@
+//----------------------------------------------------------------------------------------------------
+// RenderPipeline.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/RenderPipeline.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Game/Subsystem/Profile/Profiler.hpp"
+
+//----------------------------------------------------------------------------------------------------
+RenderPipeline::RenderPipeline(sRenderPipelineConfig const& config, RenderFunction renderFunction)
+    : m_config(config),
+      m_renderFunction(std::move(renderFunction))
+{
+    GUARANTEE_OR_DIE(m_renderFunction != nullptr, "RenderPipeline needs a render function")
+
+    if (m_config.m_isThreaded)
+    {
+        m_renderThread = std::thread(&RenderPipeline::RunRenderThread, this);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+RenderPipeline::~RenderPipeline()
+{
+    if (!m_renderThread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        m_isQuitting = true;
+    }
+
+    m_snapshotSubmitted.notify_one();
+    m_renderThread.join();
+}
+
+//----------------------------------------------------------------------------------------------------
+// The slot after the queued ones is free whenever fewer than SNAPSHOT_COUNT are queued; only the
+// game thread ever writes it, and the render thread does not read it until it is submitted.
+//
+sRenderSnapshot& RenderPipeline::BeginSnapshot()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (m_queuedCount == SNAPSHOT_COUNT)
+    {
+        PROFILE_SCOPE("RenderPipeline::WaitForFreeSnapshot");
+
+        double const waitStartSeconds = GetCurrentTimeSeconds();
+        m_snapshotRendered.wait(lock, [this]() { return m_queuedCount < SNAPSHOT_COUNT; });
+        m_statistics.m_submitWaitSeconds += GetCurrentTimeSeconds() - waitStartSeconds;
+    }
+
+    return m_snapshots[(m_firstQueuedIndex + m_queuedCount) % SNAPSHOT_COUNT];
+}
+
+//----------------------------------------------------------------------------------------------------
+void RenderPipeline::SubmitSnapshot()
+{
+    if (!m_config.m_isThreaded)
+    {
+        sRenderSnapshot& snapshot = m_snapshots[m_firstQueuedIndex];
+        snapshot.m_frameIndex     = m_statistics.m_framesSubmitted++;
+
+        m_renderFunction(snapshot);
+        ++m_statistics.m_framesRendered;
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+
+        sRenderSnapshot& snapshot = m_snapshots[(m_firstQueuedIndex + m_queuedCount) % SNAPSHOT_COUNT];
+        snapshot.m_frameIndex     = m_statistics.m_framesSubmitted++;
+        ++m_queuedCount;
+    }
+
+    m_snapshotSubmitted.notify_one();
+}
+
+//----------------------------------------------------------------------------------------------------
+void RenderPipeline::WaitForIdle()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_snapshotRendered.wait(lock, [this]() { return m_queuedCount == 0; });
+}
+
+//----------------------------------------------------------------------------------------------------
+bool RenderPipeline::IsThreaded() const
+{
+    return m_config.m_isThreaded;
+}
+
+//----------------------------------------------------------------------------------------------------
+sRenderPipelineStatistics RenderPipeline::GetStatistics() const
+{
+    std::lock_guard<std::mutex> const lock(m_mutex);
+    return m_statistics;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The snapshot stays queued while it is drawn, so BeginSnapshot cannot hand its slot out again
+// until the render function has returned.
+//
+void RenderPipeline::RunRenderThread()
+{
+    SetProfilerThreadName("Render");
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    for (;;)
+    {
+        if (m_queuedCount == 0 && !m_isQuitting)
+        {
+            double const waitStartSeconds = GetCurrentTimeSeconds();
+            m_snapshotSubmitted.wait(lock, [this]() { return m_queuedCount > 0 || m_isQuitting; });
+            m_statistics.m_renderWaitSeconds += GetCurrentTimeSeconds() - waitStartSeconds;
+        }
+
+        if (m_queuedCount == 0)
+        {
+            return;     // Quitting, and everything submitted has been drawn
+        }
+
+        sRenderSnapshot const& snapshot = m_snapshots[m_firstQueuedIndex];
+        lock.unlock();
+
+        {
+            PROFILE_SCOPE("RenderPipeline::RenderSnapshot");
+            m_renderFunction(snapshot);
+        }
+
+        lock.lock();
+        m_firstQueuedIndex = (m_firstQueuedIndex + 1) % SNAPSHOT_COUNT;
+        --m_queuedCount;
+        ++m_statistics.m_framesRendered;
+        m_snapshotRendered.notify_all();
+    }
+}
@@ -0,0 +1,77 @@
+//----------------------------------------------------------------------------------------------------
+// RenderPipeline.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "Game/RenderSnapshot.hpp"
+
+//----------------------------------------------------------------------------------------------------
+struct sRenderPipelineConfig
+{
+    bool m_isThreaded = true;       // false renders each snapshot on the caller, inside SubmitSnapshot
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sRenderPipelineStatistics
+{
+    uint64_t m_framesSubmitted   = 0;
+    uint64_t m_framesRendered    = 0;
+    double   m_submitWaitSeconds = 0.0;     // Game thread waiting in BeginSnapshot for a free slot
+    double   m_renderWaitSeconds = 0.0;     // Render thread waiting for the next submitted snapshot
+};
+
+//----------------------------------------------------------------------------------------------------
+// Two-stage frame pipeline: the game thread fills a sRenderSnapshot and submits it, and a render
+// thread draws it with the render function while the game simulates the next frame. A frame then
+// costs about the longer of update and render instead of their sum.
+//
+// Snapshots live in SNAPSHOT_COUNT slots, reused in order, so nothing is allocated once their
+// vectors have grown. With three slots one can be drawn, one queued and one filled at the same time;
+// the game thread only waits when the render thread is two whole frames behind, and the render
+// thread only waits when it has drawn everything submitted. Every snapshot is drawn, in submission
+// order, so a run renders the same frames threaded or not.
+//
+// The render function owns the RenderBackend while the pipeline is threaded: nothing else may call
+// g_theRenderBackend until WaitForIdle returns.
+//
+class RenderPipeline
+{
+public:
+    using RenderFunction = std::function<void(sRenderSnapshot const&)>;
+
+    RenderPipeline(sRenderPipelineConfig const& config, RenderFunction renderFunction);
+    ~RenderPipeline();      // Draws whatever is still queued, then joins the render thread
+
+    RenderPipeline(RenderPipeline const&)            = delete;
+    RenderPipeline& operator=(RenderPipeline const&) = delete;
+
+    sRenderSnapshot& BeginSnapshot();       // The slot to fill for the next frame
+    void             SubmitSnapshot();
+    void             WaitForIdle();         // Returns once every submitted snapshot has been drawn
+
+    bool                      IsThreaded() const;
+    sRenderPipelineStatistics GetStatistics() const;
+
+    static int constexpr SNAPSHOT_COUNT = 3;
+
+private:
+    void RunRenderThread();
+
+    sRenderPipelineConfig     m_config;
+    RenderFunction            m_renderFunction;
+    sRenderSnapshot           m_snapshots[SNAPSHOT_COUNT];
+    int                       m_firstQueuedIndex = 0;       // Oldest snapshot not yet drawn
+    int                       m_queuedCount      = 0;       // Submitted and not yet drawn, including the one being drawn
+    bool                      m_isQuitting       = false;
+    sRenderPipelineStatistics m_statistics;
+    mutable std::mutex        m_mutex;                      // Guards everything above but the slots themselves
+    std::condition_variable   m_snapshotSubmitted;
+    std::condition_variable   m_snapshotRendered;
+    std::thread               m_renderThread;
+};
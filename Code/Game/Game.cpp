@@ -8,18 +8,39 @@
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
-#include "Engine/Input/InputSystem.hpp"
-#include "Engine/Platform/Window.hpp"
-#include "Engine/Renderer/BitmapFont.hpp"
-#include "Engine/Renderer/DebugRenderSystem.hpp"
-#include "Engine/Renderer/Renderer.hpp"
-#include "Engine/Resource/ResourceSubsystem.hpp"
-#include "Engine/Resource/Resource/ModelResource.hpp"
-#include "Engine/Resource/ResourceLoader/ObjModelLoader.hpp"
 #include "Game/Framework/App.hpp"
 #include "Game/Framework/GameCommon.hpp"
 #include "Game/Player.hpp"
 #include "Game/Prop.hpp"
+#include "Game/RenderSnapshot.hpp"
+#include "Game/Subsystem/Light/LightSubsystem.hpp"
+#include "Game/Subsystem/Profile/Profiler.hpp"
+#include "Game/Subsystem/Render/PipelineState.hpp"
+#include "Game/Subsystem/Render/RenderBackend.hpp"
+#include "Game/Subsystem/Render/RenderQueue.hpp"
+#include "Game/Subsystem/Resource/GameResourceLoader.hpp"
+
+// Input, the Window and debug draws are windowed only, and only the Windows build has them
+#if defined(_WIN32)
+#include "Engine/Input/InputSystem.hpp"
+#include "Engine/Platform/Window.hpp"
+#include "Engine/Renderer/DebugRenderSystem.hpp"
+#endif
+
+//----------------------------------------------------------------------------------------------------
+// Headless runs have no Window; they use the default GameConfig.xml screen size instead.
+//
+static Vec2 GetClientDimensions()
+{
+#if defined(_WIN32)
+    if (Window::s_mainWindow != nullptr)
+    {
+        return Window::s_mainWindow->GetClientDimensions();
+    }
+#endif
+
+    return Vec2(1600.f, 800.f);
+}
 
 //----------------------------------------------------------------------------------------------------
 Game::Game()
@@ -28,33 +49,50 @@ Game::Game()
     SpawnProp();
 
     m_screenCamera = new Camera();
+    m_renderQueue  = new RenderQueue();
+
+    sPipelineStateDesc attractPipelineDesc;
+    attractPipelineDesc.m_shaderName  = "Data/Shaders/Default";
+    attractPipelineDesc.m_samplerMode = eRenderSamplerMode::BILINEAR_CLAMP;
+    attractPipelineDesc.m_depthMode   = eRenderDepthMode::DISABLED;
+    m_attractPipeline                 = g_theRenderBackend->CreateOrGetPipelineState(attractPipelineDesc);
 
     Vec2 const bottomLeft = Vec2::ZERO;
     // Vec2 const screenTopRight = Vec2(SCREEN_SIZE_X, SCREEN_SIZE_Y);
-    Vec2 clientDimensions = Window::s_mainWindow->GetClientDimensions();
+    Vec2 clientDimensions = GetClientDimensions();
 
     m_screenCamera->SetOrthoGraphicView(bottomLeft, clientDimensions);
     m_screenCamera->SetNormalizedViewport(AABB2::ZERO_TO_ONE);
     m_gameClock = new Clock(Clock::GetSystemClock());
 
-    m_player->m_position     = Vec3(-2.f, 0.f, 1.f);
-    m_firstCube->m_position  = Vec3(2.f, 2.f, 0.f);
-    m_secondCube->m_position = Vec3(-2.f, -2.f, 0.f);
-    m_sphere->m_position     = Vec3(10, -5, 1);
-    m_grid->m_position       = Vec3::ZERO;
+    sFixedTimestepConfig simulationConfig;
+    simulationConfig.m_stepsPerSecond = g_theApp->GetConfig().m_simulationStepsPerSecond;
+    m_simulationTimestep              = FixedTimestep(simulationConfig);
 
-    DebugAddWorldBasis(Mat44(), -1.f);
+    m_player->m_position = Vec3(-2.f, 0.f, 1.f);
+
+    // Headless runs skip input and debug draws, and go straight to the game state so the full
+    // simulation and render submission are exercised every tick.
+    if (g_theApp->IsHeadless())
+    {
+        m_gameState = eGameState::GAME;
+        return;
+    }
+
+#if defined(_WIN32)
+    m_debugPrimitives.AddWorldBasis(Mat44(), -1.f);
 
     Mat44 transform;
 
     transform.SetIJKT3D(-Vec3::Y_BASIS, Vec3::X_BASIS, Vec3::Z_BASIS, Vec3(0.25f, 0.f, 0.25f));
-    DebugAddWorldText("X-Forward", transform, 0.25f, Vec2::ONE, -1.f, Rgba8::RED);
+    m_debugPrimitives.AddWorldText("X-Forward", transform, 0.25f, Vec2::ONE, -1.f, Rgba8::RED);
 
     transform.SetIJKT3D(-Vec3::X_BASIS, -Vec3::Y_BASIS, Vec3::Z_BASIS, Vec3(0.f, 0.25f, 0.5f));
-    DebugAddWorldText("Y-Left", transform, 0.25f, Vec2::ZERO, -1.f, Rgba8::GREEN);
+    m_debugPrimitives.AddWorldText("Y-Left", transform, 0.25f, Vec2::ZERO, -1.f, Rgba8::GREEN);
 
     transform.SetIJKT3D(-Vec3::X_BASIS, Vec3::Z_BASIS, Vec3::Y_BASIS, Vec3(0.f, -0.25f, 0.25f));
-    DebugAddWorldText("Z-Up", transform, 0.25f, Vec2(1.f, 0.f), -1.f, Rgba8::BLUE);
+    m_debugPrimitives.AddWorldText("Z-Up", transform, 0.25f, Vec2(1.f, 0.f), -1.f, Rgba8::BLUE);
+#endif
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -63,17 +101,18 @@ Game::~Game()
     delete m_gameClock;
     m_gameClock = nullptr;
 
-    delete m_grid;
-    m_grid = nullptr;
+    for (Prop*& propMesh : m_propMeshes)
+    {
+        GAME_SAFE_RELEASE(propMesh);
+    }
 
-    delete m_sphere;
-    m_sphere = nullptr;
+    m_propMeshes.clear();
 
-    delete m_secondCube;
-    m_secondCube = nullptr;
+    delete m_renderQueue;
+    m_renderQueue = nullptr;
 
-    delete m_firstCube;
-    m_firstCube = nullptr;
+    delete m_entityStore;
+    m_entityStore = nullptr;
 
     delete m_player;
     m_player = nullptr;
@@ -85,64 +124,165 @@ Game::~Game()
 //----------------------------------------------------------------------------------------------------
 void Game::Update()
 {
-    float const gameDeltaSeconds   = static_cast<float>(m_gameClock->GetDeltaSeconds());
-    float const systemDeltaSeconds = static_cast<float>(Clock::GetSystemClock().GetDeltaSeconds());
+    PROFILE_SCOPE("Game::Update");
+
+    // Headless ticks are one step each, so a given tick count always simulates the same world
+    double const gameDeltaSeconds   = g_theApp->IsHeadless() ? m_simulationTimestep.GetStepSeconds() : m_gameClock->GetDeltaSeconds();
+    float const  systemDeltaSeconds = static_cast<float>(Clock::GetSystemClock().GetDeltaSeconds());
 
     // #TODO: Select keyboard or controller
-    UpdateEntities(gameDeltaSeconds, systemDeltaSeconds);
+    UpdateSimulation(gameDeltaSeconds);
+    UpdateEntities(systemDeltaSeconds);
+    UpdateEntityBounds();
+    CullEntities();
+
+    if (g_theApp->IsHeadless())
+    {
+        return;
+    }
 
+#if defined(_WIN32)
     UpdateFromKeyBoard();
     UpdateFromController();
-}
-
-//----------------------------------------------------------------------------------------------------
-void Game::Render() const
-{
-    //-Start-of-Game-Camera---------------------------------------------------------------------------
-
-    g_theRenderer->BeginCamera(*m_player->GetCamera());
 
     if (m_gameState == eGameState::GAME)
     {
-        RenderEntities();
         Vec2 screenDimensions = Window::s_mainWindow->GetScreenDimensions();
         Vec2 windowDimensions = Window::s_mainWindow->GetWindowDimensions();
         Vec2 clientDimensions = Window::s_mainWindow->GetClientDimensions();
         Vec2 windowPosition   = Window::s_mainWindow->GetWindowPosition();
         Vec2 clientPosition   = Window::s_mainWindow->GetClientPosition();
-        DebugAddScreenText(Stringf("ScreenDimensions=(%.1f,%.1f)",screenDimensions.x, screenDimensions.y ), Vec2(0,0),20.f,Vec2::ZERO, 0.f);
-        DebugAddScreenText(Stringf("WindowDimensions=(%.1f,%.1f)",windowDimensions.x, windowDimensions.y ), Vec2(0,20),20.f,Vec2::ZERO, 0.f);
-        DebugAddScreenText(Stringf("ClientDimensions=(%.1f,%.1f)",clientDimensions.x, clientDimensions.y ), Vec2(0,40),20.f,Vec2::ZERO, 0.f);
-        DebugAddScreenText(Stringf("WindowPosition=(%.1f,%.1f)",windowPosition.x, windowPosition.y ), Vec2(0,60),20.f,Vec2::ZERO, 0.f);
-        DebugAddScreenText(Stringf("ClientPosition=(%.1f,%.1f)",clientPosition.x, clientPosition.y ), Vec2(0,80),20.f,Vec2::ZERO, 0.f);
-        g_theRenderer->RenderEmissive();
+        m_debugPrimitives.AddScreenText(Stringf("ScreenDimensions=(%.1f,%.1f)",screenDimensions.x, screenDimensions.y ), Vec2(0,0),20.f,Vec2::ZERO, 0.f);
+        m_debugPrimitives.AddScreenText(Stringf("WindowDimensions=(%.1f,%.1f)",windowDimensions.x, windowDimensions.y ), Vec2(0,20),20.f,Vec2::ZERO, 0.f);
+        m_debugPrimitives.AddScreenText(Stringf("ClientDimensions=(%.1f,%.1f)",clientDimensions.x, clientDimensions.y ), Vec2(0,40),20.f,Vec2::ZERO, 0.f);
+        m_debugPrimitives.AddScreenText(Stringf("WindowPosition=(%.1f,%.1f)",windowPosition.x, windowPosition.y ), Vec2(0,60),20.f,Vec2::ZERO, 0.f);
+        m_debugPrimitives.AddScreenText(Stringf("ClientPosition=(%.1f,%.1f)",clientPosition.x, clientPosition.y ), Vec2(0,80),20.f,Vec2::ZERO, 0.f);
+    }
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------
+// Copies what RenderSnapshot draws, after Update has interpolated, culled and lit this frame. The
+// snapshot's vectors keep their capacity between frames, so this only allocates while they grow.
+// The debug primitives added since the last snapshot move into this one.
+//
+void Game::BuildRenderSnapshot(sRenderSnapshot& out_snapshot)
+{
+    PROFILE_SCOPE("Game::BuildRenderSnapshot");
+
+    out_snapshot.m_isAttractMode   = m_gameState == eGameState::ATTRACT;
+    out_snapshot.m_worldCamera     = *m_player->GetCamera();
+    out_snapshot.m_screenCamera    = *m_screenCamera;
+    out_snapshot.m_viewPosition    = m_player->m_position;
+    out_snapshot.m_playerTransform = m_player->GetModelToWorldTransform();
+
+    out_snapshot.m_draws.clear();
+
+    for (int entityIndex = 0; entityIndex < m_entityStore->GetCount(); ++entityIndex)
+    {
+        if (!m_entityStore->m_isVisible[entityIndex])
+        {
+            continue;
+        }
+
+        sSnapshotDraw draw;
+        draw.m_modelToWorldTransform = m_entityStore->m_modelToWorldTransforms[entityIndex];
+        draw.m_color                 = m_entityStore->m_colors[entityIndex];
+        draw.m_worldBounds           = m_entityStore->m_worldBoundingSpheres[entityIndex];
+        draw.m_meshIndex             = m_entityStore->m_meshIndices[entityIndex];
+
+        out_snapshot.m_draws.push_back(draw);
+    }
+
+    Light const* lights = g_theLightSubsystem->GetLights();
+
+    out_snapshot.m_lights.assign(lights, lights + g_theLightSubsystem->GetLightCount());
+    out_snapshot.m_lightChangeCount = g_theLightSubsystem->GetChangeCount();
+
+    out_snapshot.m_debugPrimitives.Clear();
+    out_snapshot.m_debugPrimitives.Swap(m_debugPrimitives);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Reads only the snapshot, the attract pipeline, the Prop meshes and the RenderQueue. Update never
+// touches the last three; streamed models change the Prop meshes only while App holds the
+// RenderPipeline idle. That is what lets it run on the render thread while Update runs. Lights are
+// bound per batch through `lightBinder`, which must already hold the snapshot's lights, never the
+// LightSubsystem.
+//
+// Windowed frames also hand the snapshot's debug primitives to DebugRender and draw them over the
+// world and screen cameras.
+//
+void Game::RenderSnapshot(sRenderSnapshot const& snapshot, LightBinder& lightBinder) const
+{
+    PROFILE_SCOPE("Game::RenderSnapshot");
+
+    bool const isWindowed = !g_theApp->IsHeadless();
+
+#if defined(_WIN32)
+    if (isWindowed)
+    {
+        snapshot.m_debugPrimitives.Replay();
+    }
+#endif
+
+    //-Start-of-Game-Camera---------------------------------------------------------------------------
+
+    g_theRenderBackend->BeginCamera(snapshot.m_worldCamera);
+
+    if (!snapshot.m_isAttractMode)
+    {
+        m_renderQueue->Begin(snapshot.m_viewPosition, 100.f);    // The player camera's far plane
+
+        for (sSnapshotDraw const& draw : snapshot.m_draws)
+        {
+            m_propMeshes[draw.m_meshIndex]->SubmitWithTransform(*m_renderQueue, draw.m_modelToWorldTransform, draw.m_color, draw.m_worldBounds);
+        }
+
+        m_renderQueue->Flush(*g_theRenderBackend, [&lightBinder](sBoundingSphere const& bounds) { lightBinder.BindLightsForBounds(bounds); });
+
+        g_theRenderBackend->SetModelConstants(snapshot.m_playerTransform);
+        m_player->Render();
+
+        if (isWindowed)
+        {
+            g_theRenderBackend->RenderEmissive();
+        }
     }
 
-    g_theRenderer->EndCamera(*m_player->GetCamera());
+    g_theRenderBackend->EndCamera(snapshot.m_worldCamera);
 
     //-End-of-Game-Camera-----------------------------------------------------------------------------
-    //------------------------------------------------------------------------------------------------
-    if (m_gameState == eGameState::GAME)
+#if defined(_WIN32)
+    if (isWindowed && !snapshot.m_isAttractMode)
     {
-        DebugRenderWorld(*m_player->GetCamera());
+        DebugRenderWorld(snapshot.m_worldCamera);
     }
-    //------------------------------------------------------------------------------------------------
+#endif
     //-Start-of-Screen-Camera-------------------------------------------------------------------------
 
-    g_theRenderer->BeginCamera(*m_screenCamera);
+    g_theRenderBackend->BeginCamera(snapshot.m_screenCamera);
 
-    if (m_gameState == eGameState::ATTRACT)
+    if (snapshot.m_isAttractMode)
     {
         RenderAttractMode();
     }
 
-    g_theRenderer->EndCamera(*m_screenCamera);
+    g_theRenderBackend->EndCamera(snapshot.m_screenCamera);
 
     //-End-of-Screen-Camera---------------------------------------------------------------------------
-    if (m_gameState == eGameState::GAME)
+#if defined(_WIN32)
+    if (isWindowed && !snapshot.m_isAttractMode)
     {
-        DebugRenderScreen(*m_screenCamera);
+        DebugRenderScreen(snapshot.m_screenCamera);
     }
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------
+sCullingStatistics const& Game::GetCullingStatistics() const
+{
+    return m_cullingStatistics;
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -152,6 +292,7 @@ bool Game::IsAttractMode() const
 }
 
 //----------------------------------------------------------------------------------------------------
+#if defined(_WIN32)
 void Game::UpdateFromKeyBoard()
 {
     if (m_gameState == eGameState::ATTRACT)
@@ -201,12 +342,23 @@ void Game::UpdateFromKeyBoard()
             Vec3 up;
             m_player->m_orientation.GetAsVectors_IFwd_JLeft_KUp(forward, right, up);
 
-            DebugAddWorldLine(m_player->m_position, m_player->m_position + forward * 20.f, 0.01f, 10.f, Rgba8(255, 255, 0), Rgba8(255, 255, 0), eDebugRenderMode::X_RAY);
+            sEntityRaycastResult const result = m_entityStore->RaycastEntities(m_player->m_position, forward, 20.f);
+
+            if (result.m_didHit)
+            {
+                m_debugPrimitives.AddWorldLine(m_player->m_position, result.m_impactPosition, 0.01f, 10.f, Rgba8(255, 255, 0), Rgba8(255, 255, 0), eDebugRenderMode::X_RAY);
+                m_debugPrimitives.AddWorldPoint(result.m_impactPosition, 0.06f, 10.f, Rgba8::RED, Rgba8::RED);
+                m_debugPrimitives.AddMessage(Stringf("Raycast hit entity in slot %u at %.2f m", result.m_hitEntity.m_slot, result.m_impactDistance), 5.f);
+            }
+            else
+            {
+                m_debugPrimitives.AddWorldLine(m_player->m_position, m_player->m_position + forward * 20.f, 0.01f, 10.f, Rgba8(255, 255, 0), Rgba8(255, 255, 0), eDebugRenderMode::X_RAY);
+            }
         }
 
         if (g_theInput->IsKeyDown(NUMCODE_2))
         {
-            DebugAddWorldPoint(Vec3(m_player->m_position.x, m_player->m_position.y, 0.f), 0.25f, 60.f, Rgba8(150, 75, 0), Rgba8(150, 75, 0));
+            m_debugPrimitives.AddWorldPoint(Vec3(m_player->m_position.x, m_player->m_position.y, 0.f), 0.25f, 60.f, Rgba8(150, 75, 0), Rgba8(150, 75, 0));
         }
 
         if (g_theInput->WasKeyJustPressed(NUMCODE_3))
@@ -216,12 +368,12 @@ void Game::UpdateFromKeyBoard()
             Vec3 up;
             m_player->m_orientation.GetAsVectors_IFwd_JLeft_KUp(forward, right, up);
 
-            DebugAddWorldWireSphere(m_player->m_position + forward * 2.f, 1.f, 5.f, Rgba8::GREEN, Rgba8::RED);
+            m_debugPrimitives.AddWorldWireSphere(m_player->m_position + forward * 2.f, 1.f, 5.f, Rgba8::GREEN, Rgba8::RED);
         }
 
         if (g_theInput->WasKeyJustPressed(NUMCODE_4))
         {
-            DebugAddWorldBasis(m_player->GetModelToWorldTransform(), 20.f);
+            m_debugPrimitives.AddWorldBasis(m_player->GetModelToWorldTransform(), 20.f);
         }
 
         if (g_theInput->WasKeyJustReleased(NUMCODE_5))
@@ -239,12 +391,12 @@ void Game::UpdateFromKeyBoard()
             Vec3 up;
             m_player->m_orientation.GetAsVectors_IFwd_JLeft_KUp(forward, right, up);
 
-            DebugAddBillboardText(text, m_player->m_position + forward, 0.1f, Vec2::HALF, 10.f, Rgba8::WHITE, Rgba8::RED);
+            m_debugPrimitives.AddBillboardText(text, m_player->m_position + forward, 0.1f, Vec2::HALF, 10.f, Rgba8::WHITE, Rgba8::RED);
         }
 
         if (g_theInput->WasKeyJustPressed(NUMCODE_6))
         {
-            DebugAddWorldCylinder(m_player->m_position, m_player->m_position + Vec3::Z_BASIS * 2, 1.f, 10.f, true, Rgba8::WHITE, Rgba8::RED);
+            m_debugPrimitives.AddWorldCylinder(m_player->m_position, m_player->m_position + Vec3::Z_BASIS * 2, 1.f, 10.f, true, Rgba8::WHITE, Rgba8::RED);
         }
 
 
@@ -254,10 +406,10 @@ void Game::UpdateFromKeyBoard()
             float const orientationY = m_player->GetCamera()->GetOrientation().m_pitchDegrees;
             float const orientationZ = m_player->GetCamera()->GetOrientation().m_rollDegrees;
 
-            DebugAddMessage(Stringf("Camera Orientation: (%.2f, %.2f, %.2f)", orientationX, orientationY, orientationZ), 5.f);
+            m_debugPrimitives.AddMessage(Stringf("Camera Orientation: (%.2f, %.2f, %.2f)", orientationX, orientationY, orientationZ), 5.f);
         }
 
-        DebugAddMessage(Stringf("Player Position: (%.2f, %.2f, %.2f)", m_player->m_position.x, m_player->m_position.y, m_player->m_position.z), 0.f);
+        m_debugPrimitives.AddMessage(Stringf("Player Position: (%.2f, %.2f, %.2f)", m_player->m_position.x, m_player->m_position.y, m_player->m_position.z), 0.f);
     }
 }
 
@@ -307,58 +459,142 @@ void Game::UpdateFromController()
         }
     }
 }
+#endif
 
 //----------------------------------------------------------------------------------------------------
-void Game::UpdateEntities(float const gameDeltaSeconds, float const systemDeltaSeconds) const
+// Everything that changes the world runs here, in fixed steps on the game clock (scaled and
+// pausable); the color pulse follows simulation time for the same reason.
+//
+void Game::UpdateSimulation(double const gameDeltaSeconds)
 {
-    m_player->Update(systemDeltaSeconds);
-    m_firstCube->Update(gameDeltaSeconds);
-    m_secondCube->Update(gameDeltaSeconds);
-    m_sphere->Update(gameDeltaSeconds);
-    m_grid->Update(gameDeltaSeconds);
+    PROFILE_SCOPE("Game::UpdateSimulation");
 
-    m_firstCube->m_orientation.m_pitchDegrees += 30.f * gameDeltaSeconds;
-    m_firstCube->m_orientation.m_rollDegrees += 30.f * gameDeltaSeconds;
+    int const   stepCount   = m_simulationTimestep.Advance(gameDeltaSeconds);
+    float const stepSeconds = static_cast<float>(m_simulationTimestep.GetStepSeconds());
 
-    float const time       = static_cast<float>(m_gameClock->GetTotalSeconds());
+    for (int step = 0; step < stepCount; ++step)
+    {
+        m_entityStore->BeginSimulationStep();
+        m_entityStore->UpdateOrientations(stepSeconds);
+    }
+
+    float const time       = static_cast<float>(static_cast<double>(m_simulationTimestep.GetStepCount()) * m_simulationTimestep.GetStepSeconds());
     float const colorValue = (sinf(time) + 1.0f) * 0.5f * 255.0f;
 
-    m_secondCube->m_color.r = static_cast<unsigned char>(colorValue);
-    m_secondCube->m_color.g = static_cast<unsigned char>(colorValue);
-    m_secondCube->m_color.b = static_cast<unsigned char>(colorValue);
+    Rgba8& secondCubeColor = m_entityStore->m_colors[m_entityStore->GetDenseIndex(m_secondCube)];
+
+    secondCubeColor.r = static_cast<unsigned char>(colorValue);
+    secondCubeColor.g = static_cast<unsigned char>(colorValue);
+    secondCubeColor.b = static_cast<unsigned char>(colorValue);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Runs every frame. The player stays on the system clock so the camera answers input at the frame
+// rate, and the props are drawn between their last two simulation steps.
+//
+void Game::UpdateEntities(float const systemDeltaSeconds)
+{
+    PROFILE_SCOPE("Game::UpdateEntities");
 
-    m_sphere->m_orientation.m_yawDegrees += 45.f * gameDeltaSeconds;
+    m_player->Update(systemDeltaSeconds);
+    m_entityStore->UpdateInterpolatedModelToWorldTransforms(m_simulationTimestep.GetInterpolationAlpha());
 
-    DebugAddScreenText(Stringf("Time: %.2f\nFPS: %.2f\nScale: %.1f", m_gameClock->GetTotalSeconds(), 1.f / m_gameClock->GetDeltaSeconds(), m_gameClock->GetTimeScale()), m_screenCamera->GetOrthographicTopRight() - Vec2(250.f, 60.f), 20.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
+    if (g_theApp->IsHeadless())
+    {
+        return;
+    }
+
+#if defined(_WIN32)
+    // Frame rate lives in the PerfHUD (F1), which times frames on the system clock
+    m_debugPrimitives.AddScreenText(Stringf("Time: %.2f\nScale: %.1f", m_gameClock->GetTotalSeconds(), m_gameClock->GetTimeScale()), m_screenCamera->GetOrthographicTopRight() - Vec2(250.f, 40.f), 20.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------
+// Runs after UpdateEntities so the world bounds, and the spatial index refit from them, follow this
+// frame's model-to-world transforms.
+//
+void Game::UpdateEntityBounds()
+{
+    PROFILE_SCOPE("Game::UpdateEntityBounds");
+
+    m_entityStore->UpdateWorldBoundingSpheres(m_propMeshBoundingSpheres);
+    m_entityStore->UpdateSpatialIndex();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Runs after UpdateEntityBounds, with the player camera already updated for this frame.
+//
+void Game::CullEntities()
+{
+    PROFILE_SCOPE("Game::CullEntities");
+
+    sFrustum const frustum = sFrustum::MakeFromCamera(*m_player->GetCamera());
+
+    m_cullingStatistics.m_visibleCount = m_entityStore->CullAgainstFrustum(frustum);
+    m_cullingStatistics.m_culledCount  = m_entityStore->GetCount() - m_cullingStatistics.m_visibleCount;
 }
 
 //----------------------------------------------------------------------------------------------------
 void Game::RenderAttractMode() const
 {
-    Vec2 clientDimensions = Window::s_mainWindow->GetClientDimensions();
+    Vec2 clientDimensions = GetClientDimensions();
 
     VertexList_PCU verts;
     AddVertsForDisc2D(verts, Vec2(clientDimensions.x * 0.5f, clientDimensions.y * 0.5f), 300.f, 10.f, Rgba8::YELLOW);
-    g_theRenderer->SetModelConstants();
-    g_theRenderer->SetBlendMode(eBlendMode::OPAQUE);
-    g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
-    g_theRenderer->SetSamplerMode(eSamplerMode::BILINEAR_CLAMP);
-    g_theRenderer->SetDepthMode(eDepthMode::DISABLED);
-    g_theRenderer->BindTexture(nullptr);
-    g_theRenderer->BindShader(g_theRenderer->CreateOrGetShaderFromFile("Data/Shaders/Default"));
-    g_theRenderer->DrawVertexArray(verts);
+    g_theRenderBackend->SetModelConstants();
+    g_theRenderBackend->BindPipelineState(m_attractPipeline);
+    g_theRenderBackend->BindTexture(nullptr);
+    g_theRenderBackend->DrawVertexArray(verts);
+}
+
+//----------------------------------------------------------------------------------------------------
+void Game::SpawnStreamedModel(String const& filePath)
+{
+    ModelHandle const model     = g_theGameResourceLoader->RequestModel(filePath);
+    Prop* const       modelMesh = new Prop(this);
+    int const         meshIndex = static_cast<int>(m_propMeshes.size());
+
+    modelMesh->UseSharedStaticMesh(g_theGameResourceLoader->GetModelStaticMeshId(model), g_theGameResourceLoader->GetModelLocalBoundingSphere(model));
+    m_propMeshes.push_back(modelMesh);
+    m_propMeshBoundingSpheres.push_back(modelMesh->m_localBoundingSphere);
+
+    Vec3 const position = m_player->m_position + m_player->GetModelToWorldTransform().GetIBasis3D() * 5.f;
+    m_entityStore->CreateEntity(meshIndex, position);
+
+    if (g_theGameResourceLoader->GetModelState(model) == eModelState::LOADING)
+    {
+        sLoadingModel loadingModel;
+        loadingModel.m_model     = model;
+        loadingModel.m_meshIndex = meshIndex;
+        m_loadingModels.push_back(loadingModel);
+    }
 }
 
 //----------------------------------------------------------------------------------------------------
-void Game::RenderEntities() const
+// Swaps published models in for their placeholders. A model that failed keeps the placeholder.
+// Model states only change in PublishFinishedModels, so App calls this right after it, while no
+// RenderPipeline thread is drawing.
+//
+void Game::UpdateStreamedModels()
 {
-    m_firstCube->Render();
-    m_secondCube->Render();
-    m_sphere->Render();
-    m_grid->Render();
+    for (size_t loadingIndex = 0; loadingIndex < m_loadingModels.size();)
+    {
+        sLoadingModel const& loadingModel = m_loadingModels[loadingIndex];
+
+        if (g_theGameResourceLoader->GetModelState(loadingModel.m_model) == eModelState::LOADING)
+        {
+            ++loadingIndex;
+            continue;
+        }
+
+        Prop* const modelMesh = m_propMeshes[loadingModel.m_meshIndex];
+        modelMesh->UseSharedStaticMesh(g_theGameResourceLoader->GetModelStaticMeshId(loadingModel.m_model), g_theGameResourceLoader->GetModelLocalBoundingSphere(loadingModel.m_model));
+        m_propMeshBoundingSpheres[loadingModel.m_meshIndex] = modelMesh->m_localBoundingSphere;
 
-    g_theRenderer->SetModelConstants(m_player->GetModelToWorldTransform());
-    m_player->Render();
+        m_loadingModels[loadingIndex] = m_loadingModels.back();
+        m_loadingModels.pop_back();
+    }
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -370,15 +606,37 @@ void Game::SpawnPlayer()
 //----------------------------------------------------------------------------------------------------
 void Game::SpawnProp()
 {
-    Texture const* texture = g_theRenderer->CreateOrGetTextureFromFile("Data/Images/TestUV.png");
+    Texture const* texture = g_theRenderBackend->CreateOrGetTextureFromFile("Data/Images/TestUV.png");
+
+    Prop* cubeMesh   = new Prop(this);
+    Prop* sphereMesh = new Prop(this, texture);
+    Prop* gridMesh   = new Prop(this);
+
+    cubeMesh->InitializeLocalVertsForCube();
+    sphereMesh->InitializeLocalVertsForSphere();
+    gridMesh->InitializeLocalVertsForGrid();
+
+    cubeMesh->CreateStaticMesh();
+    sphereMesh->CreateStaticMesh();
+    gridMesh->CreateStaticMesh();
+
+    int const cubeMeshIndex   = static_cast<int>(m_propMeshes.size());
+    int const sphereMeshIndex = cubeMeshIndex + 1;
+    int const gridMeshIndex   = cubeMeshIndex + 2;
+
+    m_propMeshes.push_back(cubeMesh);
+    m_propMeshes.push_back(sphereMesh);
+    m_propMeshes.push_back(gridMesh);
+
+    for (Prop const* propMesh : m_propMeshes)
+    {
+        m_propMeshBoundingSpheres.push_back(propMesh->m_localBoundingSphere);
+    }
 
-    m_firstCube  = new Prop(this);
-    m_secondCube = new Prop(this);
-    m_sphere     = new Prop(this, texture);
-    m_grid       = new Prop(this);
+    m_entityStore = new EntityStore();
 
-    m_firstCube->InitializeLocalVertsForCube();
-    m_secondCube->InitializeLocalVertsForCube();
-    m_sphere->InitializeLocalVertsForSphere();
-    m_grid->InitializeLocalVertsForGrid();
+    m_firstCube  = m_entityStore->CreateEntity(cubeMeshIndex, Vec3(2.f, 2.f, 0.f), EulerAngles::ZERO, EulerAngles(0.f, 30.f, 30.f));
+    m_secondCube = m_entityStore->CreateEntity(cubeMeshIndex, Vec3(-2.f, -2.f, 0.f));
+    m_sphere     = m_entityStore->CreateEntity(sphereMeshIndex, Vec3(10.f, -5.f, 1.f), EulerAngles::ZERO, EulerAngles(45.f, 0.f, 0.f));
+    m_grid       = m_entityStore->CreateEntity(gridMeshIndex, Vec3::ZERO);
 }
@@ -6,15 +6,21 @@
 #pragma once
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Core/Vertex_PCUTBN.hpp"
-#include "Engine/Resource/ResourceHandle.hpp"
+#include "Game/DebugPrimitiveList.hpp"
+#include "Game/EntityStore.hpp"
+#include "Game/Framework/FixedTimestep.hpp"
+#include "Game/Subsystem/Resource/GameResourceLoader.hpp"
 
 struct Vertex_PCUTBN;
-class ModelResource;
 //----------------------------------------------------------------------------------------------------
 class Camera;
 class Clock;
+class LightBinder;
+class PipelineState;
 class Player;
 class Prop;
+class RenderQueue;
+struct sRenderSnapshot;
 
 //----------------------------------------------------------------------------------------------------
 enum class eGameState : uint8_t
@@ -23,6 +29,25 @@ enum class eGameState : uint8_t
     GAME
 };
 
+//----------------------------------------------------------------------------------------------------
+// Result of the last frustum cull of the EntityStore against the player camera.
+//
+struct sCullingStatistics
+{
+    int m_visibleCount = 0;
+    int m_culledCount  = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// A streamed prop whose model was not ready yet. Game polls these rather than taking the
+// RequestModel callback, which could outlive a Game replaced by App::DeleteAndCreateNewGame.
+//
+struct sLoadingModel
+{
+    ModelHandle m_model;
+    int         m_meshIndex = -1;       // Into Game::m_propMeshes
+};
+
 //----------------------------------------------------------------------------------------------------
 class Game
 {
@@ -31,25 +56,49 @@ public:
     ~Game();
 
     void Update();
-    void Render() const;
     bool IsAttractMode() const;
 
+    // Frames render in two halves: the snapshot is built on the game thread after Update, and
+    // RenderSnapshot draws it on whichever thread owns the RenderBackend (see RenderPipeline)
+    void BuildRenderSnapshot(sRenderSnapshot& out_snapshot);
+    void RenderSnapshot(sRenderSnapshot const& snapshot, LightBinder& lightBinder) const;
+
+    sCullingStatistics const& GetCullingStatistics() const;
+
+    // Both change m_propMeshes or a Prop's mesh, which RenderSnapshot reads, so App only calls them
+    // while no RenderPipeline thread is drawing. SpawnStreamedModel spawns a prop in front of the
+    // player at once; it draws g_theGameResourceLoader's placeholder until UpdateStreamedModels swaps
+    // the published model in.
+    void SpawnStreamedModel(String const& filePath);
+    void UpdateStreamedModels();
+
 private:
     void UpdateFromKeyBoard();
     void UpdateFromController();
-    void UpdateEntities(float gameDeltaSeconds, float systemDeltaSeconds) const;
+    void UpdateSimulation(double gameDeltaSeconds);
+    void UpdateEntities(float systemDeltaSeconds);
+    void UpdateEntityBounds();
+    void CullEntities();
     void RenderAttractMode() const;
-    void RenderEntities() const;
 
     void SpawnPlayer();
     void SpawnProp();
 
-    Camera*    m_screenCamera = nullptr;
-    Player*    m_player       = nullptr;
-    Prop*      m_firstCube    = nullptr;
-    Prop*      m_secondCube   = nullptr;
-    Prop*      m_sphere       = nullptr;
-    Prop*      m_grid         = nullptr;
-    Clock*     m_gameClock    = nullptr;
-    eGameState m_gameState    = eGameState::ATTRACT;
+    Camera*                      m_screenCamera    = nullptr;
+    Player*                      m_player          = nullptr;
+    EntityStore*                 m_entityStore     = nullptr;
+    RenderQueue*                 m_renderQueue     = nullptr;
+    PipelineState const*         m_attractPipeline = nullptr;
+    std::vector<Prop*>           m_propMeshes;                 // One Prop per distinct mesh, indexed by EntityStore::m_meshIndices
+    std::vector<sBoundingSphere> m_propMeshBoundingSpheres;    // Local bounds of each m_propMeshes entry
+    sCullingStatistics           m_cullingStatistics;
+    EntityHandle                 m_firstCube;
+    EntityHandle                 m_secondCube;
+    EntityHandle                 m_sphere;
+    EntityHandle                 m_grid;
+    Clock*                       m_gameClock       = nullptr;
+    FixedTimestep                m_simulationTimestep;         // Steps UpdateSimulation at the App's simulation rate
+    std::vector<sLoadingModel>   m_loadingModels;              // Streamed props still drawing the placeholder
+    DebugPrimitiveList           m_debugPrimitives;            // Added this frame; moves into the next snapshot
+    eGameState                   m_gameState       = eGameState::ATTRACT;
 };
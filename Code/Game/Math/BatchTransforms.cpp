@@ -0,0 +1,167 @@
+//----------------------------------------------------------------------------------------------------
+// BatchTransforms.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Math/BatchTransforms.hpp"
+
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Game/Entity.hpp"
+#include "Game/Math/SIMD.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void ComputeModelToWorldTransformsScalar(Vec3 const* positions, EulerAngles const* orientations, int const count, Mat44* transforms)
+{
+    for (int index = 0; index < count; ++index)
+    {
+        transforms[index] = Entity::MakeModelToWorldTransform(positions[index], orientations[index]);
+    }
+}
+
+#if defined(GAME_SIMD_SSE)
+//----------------------------------------------------------------------------------------------------
+// sin and cos of four angles in degrees.
+// The angle is reduced in degrees (to the nearest multiple of 90) so the reduction is exact for any
+// angle the game accumulates, then both functions are evaluated with minimax polynomials on
+// [-45, 45] degrees and the results are swapped and negated by quadrant.
+//
+static void SinCosDegrees4(__m128 const degrees, __m128& out_sin, __m128& out_cos)
+{
+    __m128i const quadrant     = _mm_cvtps_epi32(_mm_mul_ps(degrees, _mm_set1_ps(1.f / 90.f)));
+    __m128 const  reduced      = _mm_sub_ps(degrees, _mm_mul_ps(_mm_cvtepi32_ps(quadrant), _mm_set1_ps(90.f)));
+    __m128 const  radians      = _mm_mul_ps(reduced, _mm_set1_ps(3.14159265358979f / 180.f));
+    __m128 const  radiansSq    = _mm_mul_ps(radians, radians);
+
+    __m128 sinPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), radiansSq), _mm_set1_ps(8.3321608736e-3f));
+    sinPoly        = _mm_add_ps(_mm_mul_ps(sinPoly, radiansSq), _mm_set1_ps(-1.6666654611e-1f));
+    sinPoly        = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinPoly, radiansSq), radians), radians);
+
+    __m128 cosPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), radiansSq), _mm_set1_ps(-1.388731625493765e-3f));
+    cosPoly        = _mm_add_ps(_mm_mul_ps(cosPoly, radiansSq), _mm_set1_ps(4.166664568298827e-2f));
+    cosPoly        = _mm_mul_ps(_mm_mul_ps(cosPoly, radiansSq), radiansSq);
+    cosPoly        = _mm_add_ps(_mm_sub_ps(cosPoly, _mm_mul_ps(radiansSq, _mm_set1_ps(0.5f))), _mm_set1_ps(1.f));
+
+    // Odd quadrants swap sin and cos; quadrants 2,3 negate sin; quadrants 1,2 negate cos
+    __m128 const swapMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+    __m128 const sinSign  = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+    __m128 const cosSign  = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+
+    __m128 const sinValue = _mm_or_ps(_mm_and_ps(swapMask, cosPoly), _mm_andnot_ps(swapMask, sinPoly));
+    __m128 const cosValue = _mm_or_ps(_mm_and_ps(swapMask, sinPoly), _mm_andnot_ps(swapMask, cosPoly));
+
+    out_sin = _mm_xor_ps(sinValue, sinSign);
+    out_cos = _mm_xor_ps(cosValue, cosSign);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Four transforms from lanes 0..3 of the inputs; writes only the first `laneCount` of them.
+//
+static void ComputeModelToWorldTransforms4(__m128 const yaw, __m128 const pitch, __m128 const roll, __m128 const tx, __m128 const ty, __m128 const tz, int const laneCount, Mat44* transforms)
+{
+    __m128 sy, cy, sp, cp, sr, cr;
+    SinCosDegrees4(yaw, sy, cy);
+    SinCosDegrees4(pitch, sp, cp);
+    SinCosDegrees4(roll, sr, cr);
+
+    // Z(yaw) * Y(pitch) * X(roll), i.e. EulerAngles::GetAsMatrix_IFwd_JLeft_KUp
+    __m128 const cySp = _mm_mul_ps(cy, sp);
+    __m128 const sySp = _mm_mul_ps(sy, sp);
+
+    __m128 ix = _mm_mul_ps(cy, cp);
+    __m128 iy = _mm_mul_ps(sy, cp);
+    __m128 iz = _mm_sub_ps(_mm_setzero_ps(), sp);
+    __m128 iw = _mm_setzero_ps();
+
+    __m128 jx = _mm_sub_ps(_mm_mul_ps(cySp, sr), _mm_mul_ps(sy, cr));
+    __m128 jy = _mm_add_ps(_mm_mul_ps(sySp, sr), _mm_mul_ps(cy, cr));
+    __m128 jz = _mm_mul_ps(cp, sr);
+    __m128 jw = _mm_setzero_ps();
+
+    __m128 kx = _mm_add_ps(_mm_mul_ps(cySp, cr), _mm_mul_ps(sy, sr));
+    __m128 ky = _mm_sub_ps(_mm_mul_ps(sySp, cr), _mm_mul_ps(cy, sr));
+    __m128 kz = _mm_mul_ps(cp, cr);
+    __m128 kw = _mm_setzero_ps();
+
+    __m128 px = tx;
+    __m128 py = ty;
+    __m128 pz = tz;
+    __m128 pw = _mm_set1_ps(1.f);
+
+    // Component-per-register to column-per-register
+    _MM_TRANSPOSE4_PS(ix, iy, iz, iw);
+    _MM_TRANSPOSE4_PS(jx, jy, jz, jw);
+    _MM_TRANSPOSE4_PS(kx, ky, kz, kw);
+    _MM_TRANSPOSE4_PS(px, py, pz, pw);
+
+    __m128 const columns[4][4] =
+    {
+        { ix, jx, kx, px },
+        { iy, jy, ky, py },
+        { iz, jz, kz, pz },
+        { iw, jw, kw, pw },
+    };
+
+    for (int lane = 0; lane < laneCount; ++lane)
+    {
+        float* values = transforms[lane].m_values;
+        _mm_storeu_ps(values + Mat44::Ix, columns[lane][0]);
+        _mm_storeu_ps(values + Mat44::Jx, columns[lane][1]);
+        _mm_storeu_ps(values + Mat44::Kx, columns[lane][2]);
+        _mm_storeu_ps(values + Mat44::Tx, columns[lane][3]);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void ComputeModelToWorldTransforms(Vec3 const* positions, EulerAngles const* orientations, int const count, Mat44* transforms)
+{
+    int index = 0;
+
+    for (; index + 4 <= count; index += 4)
+    {
+        EulerAngles const* o = orientations + index;
+        Vec3 const*        p = positions + index;
+
+        ComputeModelToWorldTransforms4(_mm_setr_ps(o[0].m_yawDegrees, o[1].m_yawDegrees, o[2].m_yawDegrees, o[3].m_yawDegrees),
+                                       _mm_setr_ps(o[0].m_pitchDegrees, o[1].m_pitchDegrees, o[2].m_pitchDegrees, o[3].m_pitchDegrees),
+                                       _mm_setr_ps(o[0].m_rollDegrees, o[1].m_rollDegrees, o[2].m_rollDegrees, o[3].m_rollDegrees),
+                                       _mm_setr_ps(p[0].x, p[1].x, p[2].x, p[3].x),
+                                       _mm_setr_ps(p[0].y, p[1].y, p[2].y, p[3].y),
+                                       _mm_setr_ps(p[0].z, p[1].z, p[2].z, p[3].z),
+                                       4, transforms + index);
+    }
+
+    // Tail: pad the remaining one to three entities with zeros
+    if (index < count)
+    {
+        float yaw[4]   = {};
+        float pitch[4] = {};
+        float roll[4]  = {};
+        float x[4]     = {};
+        float y[4]     = {};
+        float z[4]     = {};
+
+        int const laneCount = count - index;
+
+        for (int lane = 0; lane < laneCount; ++lane)
+        {
+            yaw[lane]   = orientations[index + lane].m_yawDegrees;
+            pitch[lane] = orientations[index + lane].m_pitchDegrees;
+            roll[lane]  = orientations[index + lane].m_rollDegrees;
+            x[lane]     = positions[index + lane].x;
+            y[lane]     = positions[index + lane].y;
+            z[lane]     = positions[index + lane].z;
+        }
+
+        ComputeModelToWorldTransforms4(_mm_loadu_ps(yaw), _mm_loadu_ps(pitch), _mm_loadu_ps(roll), _mm_loadu_ps(x), _mm_loadu_ps(y), _mm_loadu_ps(z), laneCount, transforms + index);
+    }
+}
+
+#else
+//----------------------------------------------------------------------------------------------------
+void ComputeModelToWorldTransforms(Vec3 const* positions, EulerAngles const* orientations, int const count, Mat44* transforms)
+{
+    ComputeModelToWorldTransformsScalar(positions, orientations, count, transforms);
+}
+#endif
@@ -0,0 +1,24 @@
+//----------------------------------------------------------------------------------------------------
+// BatchTransforms.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+struct EulerAngles;
+struct Mat44;
+struct Vec3;
+
+//----------------------------------------------------------------------------------------------------
+// Writes `count` model-to-world matrices, the same as Entity::MakeModelToWorldTransform for each
+// (position, orientation) pair.
+// Works on four entities at a time with SSE: one vectorized sincos for all twelve angles, and the
+// yaw/pitch/roll rotations composed directly into the basis vectors instead of three matrix appends.
+//
+void ComputeModelToWorldTransforms(Vec3 const* positions, EulerAngles const* orientations, int count, Mat44* transforms);
+
+//----------------------------------------------------------------------------------------------------
+// Reference path: one Entity::MakeModelToWorldTransform call per entity.
+//
+void ComputeModelToWorldTransformsScalar(Vec3 const* positions, EulerAngles const* orientations, int count, Mat44* transforms);
@@ -0,0 +1,472 @@
+//----------------------------------------------------------------------------------------------------
+// DynamicAABBTree.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Math/DynamicAABBTree.hpp"
+
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+static AABB3 GetUnion(AABB3 const& a, AABB3 const& b)
+{
+    Vec3 const mins(a.m_mins.x < b.m_mins.x ? a.m_mins.x : b.m_mins.x, a.m_mins.y < b.m_mins.y ? a.m_mins.y : b.m_mins.y, a.m_mins.z < b.m_mins.z ? a.m_mins.z : b.m_mins.z);
+    Vec3 const maxs(a.m_maxs.x > b.m_maxs.x ? a.m_maxs.x : b.m_maxs.x, a.m_maxs.y > b.m_maxs.y ? a.m_maxs.y : b.m_maxs.y, a.m_maxs.z > b.m_maxs.z ? a.m_maxs.z : b.m_maxs.z);
+
+    return AABB3(mins, maxs);
+}
+
+//----------------------------------------------------------------------------------------------------
+static float GetSurfaceArea(AABB3 const& bounds)
+{
+    Vec3 const size = bounds.m_maxs - bounds.m_mins;
+
+    return 2.f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool DoesAABB3Contain(AABB3 const& outer, AABB3 const& inner)
+{
+    return outer.m_mins.x <= inner.m_mins.x && outer.m_mins.y <= inner.m_mins.y && outer.m_mins.z <= inner.m_mins.z &&
+           outer.m_maxs.x >= inner.m_maxs.x && outer.m_maxs.y >= inner.m_maxs.y && outer.m_maxs.z >= inner.m_maxs.z;
+}
+
+//----------------------------------------------------------------------------------------------------
+// A deferred proxy is a leaf that is not linked into the hierarchy; queries miss it until Rebuild.
+//
+int DynamicAABBTree::CreateProxy(AABB3 const& bounds, int const userData, bool const deferInsertUntilRebuild)
+{
+    int const  proxyId = AllocateNode();
+    Vec3 const margin(m_fatMargin, m_fatMargin, m_fatMargin);
+    sNode&     node    = m_nodes[proxyId];
+
+    node.m_bounds   = AABB3(bounds.m_mins - margin, bounds.m_maxs + margin);
+    node.m_userData = userData;
+    node.m_height   = 0;
+
+    if (!deferInsertUntilRebuild)
+    {
+        InsertLeaf(proxyId);
+    }
+
+    ++m_proxyCount;
+
+    return proxyId;
+}
+
+//----------------------------------------------------------------------------------------------------
+void DynamicAABBTree::DestroyProxy(int const proxyId)
+{
+    GUARANTEE_OR_DIE(proxyId >= 0 && proxyId < static_cast<int>(m_nodes.size()) && m_nodes[proxyId].IsLeaf(), "DestroyProxy called with an invalid proxy id")
+
+    RemoveLeaf(proxyId);
+    FreeNode(proxyId);
+    --m_proxyCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns true if the proxy had to be reinserted, false if the new bounds still fit its fat box.
+//
+bool DynamicAABBTree::MoveProxy(int const proxyId, AABB3 const& bounds)
+{
+    if (DoesAABB3Contain(m_nodes[proxyId].m_bounds, bounds))
+    {
+        return false;
+    }
+
+    RemoveLeaf(proxyId);
+
+    Vec3 const margin(m_fatMargin, m_fatMargin, m_fatMargin);
+    m_nodes[proxyId].m_bounds = AABB3(bounds.m_mins - margin, bounds.m_maxs + margin);
+
+    InsertLeaf(proxyId);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool DynamicAABBTree::IsInsideFatBounds(int const proxyId, AABB3 const& bounds) const
+{
+    return DoesAABB3Contain(m_nodes[proxyId].m_bounds, bounds);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Grows `bounds` by the margin and stores it on the leaf without touching its ancestors. Queries are
+// wrong until the next Rebuild.
+//
+void DynamicAABBTree::SetFatBounds(int const proxyId, AABB3 const& bounds)
+{
+    Vec3 const margin(m_fatMargin, m_fatMargin, m_fatMargin);
+    m_nodes[proxyId].m_bounds = AABB3(bounds.m_mins - margin, bounds.m_maxs + margin);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Throws away every internal node and builds a new hierarchy over the current leaves, splitting at
+// the median along the widest axis of the leaf centers. Leaf (proxy) ids are unchanged. Internal
+// nodes are reallocated from the lowest free index up, parents before children, so a query walks
+// memory roughly front to back.
+//
+void DynamicAABBTree::Rebuild()
+{
+    m_rebuildLeafIndexes.clear();
+    m_freeList = NULL_NODE;
+
+    for (int nodeIndex = static_cast<int>(m_nodes.size()) - 1; nodeIndex >= 0; --nodeIndex)
+    {
+        if (m_nodes[nodeIndex].m_height == 0)
+        {
+            m_rebuildLeafIndexes.push_back(nodeIndex);
+        }
+        else
+        {
+            FreeNode(nodeIndex);
+        }
+    }
+
+    m_root = m_rebuildLeafIndexes.empty() ? NULL_NODE : BuildTopDown(m_rebuildLeafIndexes.data(), static_cast<int>(m_rebuildLeafIndexes.size()), NULL_NODE);
+}
+
+//----------------------------------------------------------------------------------------------------
+int DynamicAABBTree::BuildTopDown(int* leafIndexes, int const leafCount, int const parentIndex)
+{
+    if (leafCount == 1)
+    {
+        m_nodes[leafIndexes[0]].m_parentOrNext = parentIndex;
+        return leafIndexes[0];
+    }
+
+    int const nodeIndex = AllocateNode();
+
+    Vec3 centerMins = (m_nodes[leafIndexes[0]].m_bounds.m_mins + m_nodes[leafIndexes[0]].m_bounds.m_maxs) * 0.5f;
+    Vec3 centerMaxs = centerMins;
+
+    for (int leafOffset = 1; leafOffset < leafCount; ++leafOffset)
+    {
+        AABB3 const& bounds = m_nodes[leafIndexes[leafOffset]].m_bounds;
+        Vec3 const   center = (bounds.m_mins + bounds.m_maxs) * 0.5f;
+
+        centerMins = Vec3(center.x < centerMins.x ? center.x : centerMins.x, center.y < centerMins.y ? center.y : centerMins.y, center.z < centerMins.z ? center.z : centerMins.z);
+        centerMaxs = Vec3(center.x > centerMaxs.x ? center.x : centerMaxs.x, center.y > centerMaxs.y ? center.y : centerMaxs.y, center.z > centerMaxs.z ? center.z : centerMaxs.z);
+    }
+
+    Vec3 const spread = centerMaxs - centerMins;
+    int const  axis   = spread.x >= spread.y && spread.x >= spread.z ? 0 : (spread.y >= spread.z ? 1 : 2);
+    int const  half   = leafCount / 2;
+
+    std::nth_element(leafIndexes, leafIndexes + half, leafIndexes + leafCount, [this, axis](int const a, int const b)
+    {
+        AABB3 const& boundsA = m_nodes[a].m_bounds;
+        AABB3 const& boundsB = m_nodes[b].m_bounds;
+        float const  centerA = axis == 0 ? boundsA.m_mins.x + boundsA.m_maxs.x : (axis == 1 ? boundsA.m_mins.y + boundsA.m_maxs.y : boundsA.m_mins.z + boundsA.m_maxs.z);
+        float const  centerB = axis == 0 ? boundsB.m_mins.x + boundsB.m_maxs.x : (axis == 1 ? boundsB.m_mins.y + boundsB.m_maxs.y : boundsB.m_mins.z + boundsB.m_maxs.z);
+
+        return centerA < centerB;
+    });
+
+    int const child1 = BuildTopDown(leafIndexes, half, nodeIndex);
+    int const child2 = BuildTopDown(leafIndexes + half, leafCount - half, nodeIndex);
+    sNode&    node   = m_nodes[nodeIndex];
+
+    node.m_parentOrNext = parentIndex;
+    node.m_child1       = child1;
+    node.m_child2       = child2;
+    node.m_bounds       = GetUnion(m_nodes[child1].m_bounds, m_nodes[child2].m_bounds);
+    node.m_height       = 1 + (m_nodes[child1].m_height > m_nodes[child2].m_height ? m_nodes[child1].m_height : m_nodes[child2].m_height);
+
+    return nodeIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+void DynamicAABBTree::Clear()
+{
+    m_nodes.clear();
+    m_rebuildLeafIndexes.clear();
+    m_root       = NULL_NODE;
+    m_freeList   = NULL_NODE;
+    m_proxyCount = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+int DynamicAABBTree::GetUserData(int const proxyId) const
+{
+    return m_nodes[proxyId].m_userData;
+}
+
+//----------------------------------------------------------------------------------------------------
+AABB3 const& DynamicAABBTree::GetFatBounds(int const proxyId) const
+{
+    return m_nodes[proxyId].m_bounds;
+}
+
+//----------------------------------------------------------------------------------------------------
+int DynamicAABBTree::GetProxyCount() const
+{
+    return m_proxyCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int DynamicAABBTree::GetHeight() const
+{
+    return m_root == NULL_NODE ? 0 : m_nodes[m_root].m_height;
+}
+
+//----------------------------------------------------------------------------------------------------
+int DynamicAABBTree::AllocateNode()
+{
+    if (m_freeList == NULL_NODE)
+    {
+        m_nodes.emplace_back();
+        return static_cast<int>(m_nodes.size()) - 1;
+    }
+
+    int const nodeIndex = m_freeList;
+    m_freeList          = m_nodes[nodeIndex].m_parentOrNext;
+    m_nodes[nodeIndex]  = sNode();
+
+    return nodeIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+void DynamicAABBTree::FreeNode(int const nodeIndex)
+{
+    m_nodes[nodeIndex]                = sNode();
+    m_nodes[nodeIndex].m_parentOrNext = m_freeList;
+    m_freeList                        = nodeIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Walks down from the root toward the child whose box grows the least, stopping early when making a
+// new parent here is cheaper than descending, then rebalances on the way back up.
+//
+void DynamicAABBTree::InsertLeaf(int const leafIndex)
+{
+    if (m_root == NULL_NODE)
+    {
+        m_root                            = leafIndex;
+        m_nodes[leafIndex].m_parentOrNext = NULL_NODE;
+        return;
+    }
+
+    AABB3 const leafBounds = m_nodes[leafIndex].m_bounds;
+    int         index      = m_root;
+
+    while (!m_nodes[index].IsLeaf())
+    {
+        sNode const& node            = m_nodes[index];
+        float const  area            = GetSurfaceArea(node.m_bounds);
+        float const  combinedArea    = GetSurfaceArea(GetUnion(node.m_bounds, leafBounds));
+        float const  cost            = 2.f * combinedArea;
+        float const  inheritanceCost = 2.f * (combinedArea - area);
+
+        sNode const& child1 = m_nodes[node.m_child1];
+        sNode const& child2 = m_nodes[node.m_child2];
+        float        cost1  = GetSurfaceArea(GetUnion(leafBounds, child1.m_bounds)) + inheritanceCost;
+        float        cost2  = GetSurfaceArea(GetUnion(leafBounds, child2.m_bounds)) + inheritanceCost;
+
+        if (!child1.IsLeaf())
+        {
+            cost1 -= GetSurfaceArea(child1.m_bounds);
+        }
+
+        if (!child2.IsLeaf())
+        {
+            cost2 -= GetSurfaceArea(child2.m_bounds);
+        }
+
+        if (cost < cost1 && cost < cost2)
+        {
+            break;
+        }
+
+        index = cost1 < cost2 ? node.m_child1 : node.m_child2;
+    }
+
+    int const sibling   = index;
+    int const oldParent = m_nodes[sibling].m_parentOrNext;
+    int const newParent = AllocateNode();
+
+    m_nodes[newParent].m_parentOrNext = oldParent;
+    m_nodes[newParent].m_bounds       = GetUnion(leafBounds, m_nodes[sibling].m_bounds);
+    m_nodes[newParent].m_height       = m_nodes[sibling].m_height + 1;
+    m_nodes[newParent].m_child1       = sibling;
+    m_nodes[newParent].m_child2       = leafIndex;
+    m_nodes[sibling].m_parentOrNext   = newParent;
+    m_nodes[leafIndex].m_parentOrNext = newParent;
+
+    if (oldParent == NULL_NODE)
+    {
+        m_root = newParent;
+    }
+    else if (m_nodes[oldParent].m_child1 == sibling)
+    {
+        m_nodes[oldParent].m_child1 = newParent;
+    }
+    else
+    {
+        m_nodes[oldParent].m_child2 = newParent;
+    }
+
+    index = m_nodes[leafIndex].m_parentOrNext;
+
+    while (index != NULL_NODE)
+    {
+        index = Balance(index);
+
+        sNode&       node   = m_nodes[index];
+        sNode const& child1 = m_nodes[node.m_child1];
+        sNode const& child2 = m_nodes[node.m_child2];
+
+        node.m_height = 1 + (child1.m_height > child2.m_height ? child1.m_height : child2.m_height);
+        node.m_bounds = GetUnion(child1.m_bounds, child2.m_bounds);
+
+        index = node.m_parentOrNext;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Replaces the leaf's parent with the leaf's sibling, then refits and rebalances the ancestors.
+//
+void DynamicAABBTree::RemoveLeaf(int const leafIndex)
+{
+    if (leafIndex == m_root)
+    {
+        m_root = NULL_NODE;
+        return;
+    }
+
+    int const parent      = m_nodes[leafIndex].m_parentOrNext;
+    int const grandParent = m_nodes[parent].m_parentOrNext;
+    int const sibling     = m_nodes[parent].m_child1 == leafIndex ? m_nodes[parent].m_child2 : m_nodes[parent].m_child1;
+
+    FreeNode(parent);
+    m_nodes[sibling].m_parentOrNext = grandParent;
+
+    if (grandParent == NULL_NODE)
+    {
+        m_root = sibling;
+        return;
+    }
+
+    if (m_nodes[grandParent].m_child1 == parent)
+    {
+        m_nodes[grandParent].m_child1 = sibling;
+    }
+    else
+    {
+        m_nodes[grandParent].m_child2 = sibling;
+    }
+
+    int index = grandParent;
+
+    while (index != NULL_NODE)
+    {
+        index = Balance(index);
+
+        sNode&       node   = m_nodes[index];
+        sNode const& child1 = m_nodes[node.m_child1];
+        sNode const& child2 = m_nodes[node.m_child2];
+
+        node.m_height = 1 + (child1.m_height > child2.m_height ? child1.m_height : child2.m_height);
+        node.m_bounds = GetUnion(child1.m_bounds, child2.m_bounds);
+
+        index = node.m_parentOrNext;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// If one child of A is more than one level taller than the other, rotates that child up into A's
+// place and hands A the shorter of its grandchildren. Returns the index now at A's old position.
+//
+int DynamicAABBTree::Balance(int const indexA)
+{
+    sNode& a = m_nodes[indexA];
+
+    if (a.IsLeaf() || a.m_height < 2)
+    {
+        return indexA;
+    }
+
+    int const indexB  = a.m_child1;
+    int const indexC  = a.m_child2;
+    sNode&    b       = m_nodes[indexB];
+    sNode&    c       = m_nodes[indexC];
+    int const balance = c.m_height - b.m_height;
+
+    if (balance > 1)
+    {
+        int const indexF = c.m_child1;
+        int const indexG = c.m_child2;
+        sNode&    f      = m_nodes[indexF];
+        sNode&    g      = m_nodes[indexG];
+
+        c.m_child1       = indexA;
+        c.m_parentOrNext = a.m_parentOrNext;
+        a.m_parentOrNext = indexC;
+
+        if (c.m_parentOrNext == NULL_NODE)
+        {
+            m_root = indexC;
+        }
+        else if (m_nodes[c.m_parentOrNext].m_child1 == indexA)
+        {
+            m_nodes[c.m_parentOrNext].m_child1 = indexC;
+        }
+        else
+        {
+            m_nodes[c.m_parentOrNext].m_child2 = indexC;
+        }
+
+        sNode& taller  = f.m_height > g.m_height ? f : g;
+        sNode& shorter = f.m_height > g.m_height ? g : f;
+
+        c.m_child2             = f.m_height > g.m_height ? indexF : indexG;
+        a.m_child2             = f.m_height > g.m_height ? indexG : indexF;
+        shorter.m_parentOrNext = indexA;
+        a.m_bounds             = GetUnion(b.m_bounds, shorter.m_bounds);
+        c.m_bounds             = GetUnion(a.m_bounds, taller.m_bounds);
+        a.m_height             = 1 + (b.m_height > shorter.m_height ? b.m_height : shorter.m_height);
+        c.m_height             = 1 + (a.m_height > taller.m_height ? a.m_height : taller.m_height);
+
+        return indexC;
+    }
+
+    if (balance < -1)
+    {
+        int const indexD = b.m_child1;
+        int const indexE = b.m_child2;
+        sNode&    d      = m_nodes[indexD];
+        sNode&    e      = m_nodes[indexE];
+
+        b.m_child1       = indexA;
+        b.m_parentOrNext = a.m_parentOrNext;
+        a.m_parentOrNext = indexB;
+
+        if (b.m_parentOrNext == NULL_NODE)
+        {
+            m_root = indexB;
+        }
+        else if (m_nodes[b.m_parentOrNext].m_child1 == indexA)
+        {
+            m_nodes[b.m_parentOrNext].m_child1 = indexB;
+        }
+        else
+        {
+            m_nodes[b.m_parentOrNext].m_child2 = indexB;
+        }
+
+        sNode& taller  = d.m_height > e.m_height ? d : e;
+        sNode& shorter = d.m_height > e.m_height ? e : d;
+
+        b.m_child2             = d.m_height > e.m_height ? indexD : indexE;
+        a.m_child1             = d.m_height > e.m_height ? indexE : indexD;
+        shorter.m_parentOrNext = indexA;
+        a.m_bounds             = GetUnion(c.m_bounds, shorter.m_bounds);
+        b.m_bounds             = GetUnion(a.m_bounds, taller.m_bounds);
+        a.m_height             = 1 + (c.m_height > shorter.m_height ? c.m_height : shorter.m_height);
+        b.m_height             = 1 + (a.m_height > taller.m_height ? a.m_height : taller.m_height);
+
+        return indexB;
+    }
+
+    return indexA;
+}
@@ -0,0 +1,305 @@
+//----------------------------------------------------------------------------------------------------
+// DynamicAABBTree.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cmath>
+#include <vector>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Game/Math/FrustumCulling.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Bounding volume hierarchy over AABBs that supports insert, remove, and move without a rebuild.
+//
+// Leaves store a "fat" box: the real bounds grown by a margin. MoveProxy only touches the tree when
+// the new bounds leave the fat box, so small per-frame motion costs one containment test. Inserts
+// pick the sibling that adds the least surface area, and AVL-style rotations keep the height near
+// log2(N), so queries stay logarithmic as entities come and go.
+// Incremental inserts in random order leave wide boxes near the root, so bulk changes (spawning a
+// level, teleporting many proxies) should defer the inserts or use SetFatBounds, then Rebuild once.
+//
+// Queries are templates so the per-leaf callback inlines:
+//   QueryAABB / QuerySphere / QueryFrustum: bool callback(int proxyId), return false to stop.
+//   Raycast: float callback(int proxyId, float maxDistance), return the new max distance (the hit
+//            distance to keep only closer hits, maxDistance to ignore the leaf, 0 to stop).
+//
+class DynamicAABBTree
+{
+public:
+    static int constexpr NULL_NODE = -1;
+
+    int  CreateProxy(AABB3 const& bounds, int userData, bool deferInsertUntilRebuild = false);
+    void DestroyProxy(int proxyId);
+    bool MoveProxy(int proxyId, AABB3 const& bounds);
+    bool IsInsideFatBounds(int proxyId, AABB3 const& bounds) const;
+    void SetFatBounds(int proxyId, AABB3 const& bounds);
+    void Rebuild();
+    void Clear();
+
+    int          GetUserData(int proxyId) const;
+    AABB3 const& GetFatBounds(int proxyId) const;
+    int          GetProxyCount() const;
+    int          GetHeight() const;
+
+    template <typename Callback> void QueryAABB(AABB3 const& bounds, Callback&& callback) const;
+    template <typename Callback> void QuerySphere(Vec3 const& center, float radius, Callback&& callback) const;
+    template <typename Callback> void QueryFrustum(sFrustum const& frustum, Callback&& callback) const;
+    template <typename Callback> void Raycast(Vec3 const& start, Vec3 const& forwardNormal, float maxDistance, Callback&& callback) const;
+
+    float m_fatMargin = 0.1f;
+
+private:
+    struct sNode
+    {
+        AABB3 m_bounds;
+        int   m_parentOrNext = NULL_NODE;   // Parent while in the tree, next free node while on the free list
+        int   m_child1       = NULL_NODE;
+        int   m_child2       = NULL_NODE;
+        int   m_height       = -1;          // 0 for leaves, -1 for free nodes
+        int   m_userData     = -1;
+
+        bool IsLeaf() const { return m_child1 == NULL_NODE; }
+    };
+
+    // Deep enough for any tree the rotations allow, with a wide margin
+    static int constexpr MAX_QUERY_STACK = 256;
+
+    int  AllocateNode();
+    void FreeNode(int nodeIndex);
+    void InsertLeaf(int leafIndex);
+    void RemoveLeaf(int leafIndex);
+    int  Balance(int nodeIndex);
+    int  BuildTopDown(int* leafIndexes, int leafCount, int parentIndex);
+
+    std::vector<sNode> m_nodes;
+    std::vector<int>   m_rebuildLeafIndexes;
+    int                m_root       = NULL_NODE;
+    int                m_freeList   = NULL_NODE;
+    int                m_proxyCount = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+inline bool DoAABB3sOverlap(AABB3 const& a, AABB3 const& b)
+{
+    return a.m_mins.x <= b.m_maxs.x && a.m_maxs.x >= b.m_mins.x &&
+           a.m_mins.y <= b.m_maxs.y && a.m_maxs.y >= b.m_mins.y &&
+           a.m_mins.z <= b.m_maxs.z && a.m_maxs.z >= b.m_mins.z;
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename Callback>
+void DynamicAABBTree::QueryAABB(AABB3 const& bounds, Callback&& callback) const
+{
+    int stack[MAX_QUERY_STACK];
+    int stackSize = 0;
+
+    if (m_root != NULL_NODE)
+    {
+        stack[stackSize++] = m_root;
+    }
+
+    while (stackSize > 0)
+    {
+        sNode const& node = m_nodes[stack[--stackSize]];
+
+        if (!DoAABB3sOverlap(node.m_bounds, bounds))
+        {
+            continue;
+        }
+
+        if (node.IsLeaf())
+        {
+            if (!callback(static_cast<int>(&node - m_nodes.data())))
+            {
+                return;
+            }
+            continue;
+        }
+
+        ASSERT_OR_DIE(stackSize + 2 <= MAX_QUERY_STACK, "DynamicAABBTree query stack overflow")
+        stack[stackSize++] = node.m_child1;
+        stack[stackSize++] = node.m_child2;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Prunes with the exact sphere-box distance rather than the sphere's box, so fewer corner leaves
+// reach the callback.
+//
+template <typename Callback>
+void DynamicAABBTree::QuerySphere(Vec3 const& center, float const radius, Callback&& callback) const
+{
+    int   stack[MAX_QUERY_STACK];
+    int   stackSize     = 0;
+    float radiusSquared = radius * radius;
+
+    if (m_root != NULL_NODE)
+    {
+        stack[stackSize++] = m_root;
+    }
+
+    while (stackSize > 0)
+    {
+        sNode const& node = m_nodes[stack[--stackSize]];
+        Vec3 const&  mins = node.m_bounds.m_mins;
+        Vec3 const&  maxs = node.m_bounds.m_maxs;
+
+        float const dx = center.x < mins.x ? mins.x - center.x : (center.x > maxs.x ? center.x - maxs.x : 0.f);
+        float const dy = center.y < mins.y ? mins.y - center.y : (center.y > maxs.y ? center.y - maxs.y : 0.f);
+        float const dz = center.z < mins.z ? mins.z - center.z : (center.z > maxs.z ? center.z - maxs.z : 0.f);
+
+        if (dx * dx + dy * dy + dz * dz > radiusSquared)
+        {
+            continue;
+        }
+
+        if (node.IsLeaf())
+        {
+            if (!callback(static_cast<int>(&node - m_nodes.data())))
+            {
+                return;
+            }
+            continue;
+        }
+
+        ASSERT_OR_DIE(stackSize + 2 <= MAX_QUERY_STACK, "DynamicAABBTree query stack overflow")
+        stack[stackSize++] = node.m_child1;
+        stack[stackSize++] = node.m_child2;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// A node fully inside every plane reports its whole subtree without testing it again, so large
+// visible regions cost one plane test per node instead of six per leaf.
+//
+template <typename Callback>
+void DynamicAABBTree::QueryFrustum(sFrustum const& frustum, Callback&& callback) const
+{
+    int  stack[MAX_QUERY_STACK];
+    bool stackIsInside[MAX_QUERY_STACK];
+    int  stackSize = 0;
+
+    if (m_root != NULL_NODE)
+    {
+        stack[stackSize]         = m_root;
+        stackIsInside[stackSize] = false;
+        ++stackSize;
+    }
+
+    while (stackSize > 0)
+    {
+        --stackSize;
+        sNode const& node     = m_nodes[stack[stackSize]];
+        bool         isInside = stackIsInside[stackSize];
+
+        if (!isInside)
+        {
+            Vec3 const center    = (node.m_bounds.m_mins + node.m_bounds.m_maxs) * 0.5f;
+            Vec3 const extents   = (node.m_bounds.m_maxs - node.m_bounds.m_mins) * 0.5f;
+            bool       isOutside = false;
+            isInside             = true;
+
+            for (float const (&plane)[4] : frustum.m_planes)
+            {
+                float const distance = plane[0] * center.x + plane[1] * center.y + plane[2] * center.z + plane[3];
+                float const radius   = fabsf(plane[0]) * extents.x + fabsf(plane[1]) * extents.y + fabsf(plane[2]) * extents.z;
+
+                if (distance < -radius)
+                {
+                    isOutside = true;
+                    break;
+                }
+
+                isInside = isInside && distance >= radius;
+            }
+
+            if (isOutside)
+            {
+                continue;
+            }
+        }
+
+        if (node.IsLeaf())
+        {
+            if (!callback(static_cast<int>(&node - m_nodes.data())))
+            {
+                return;
+            }
+            continue;
+        }
+
+        ASSERT_OR_DIE(stackSize + 2 <= MAX_QUERY_STACK, "DynamicAABBTree query stack overflow")
+        stack[stackSize]         = node.m_child1;
+        stackIsInside[stackSize] = isInside;
+        ++stackSize;
+        stack[stackSize]         = node.m_child2;
+        stackIsInside[stackSize] = isInside;
+        ++stackSize;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Slab test against each node box, clipped to the closest hit the callback has reported so far.
+//
+template <typename Callback>
+void DynamicAABBTree::Raycast(Vec3 const& start, Vec3 const& forwardNormal, float maxDistance, Callback&& callback) const
+{
+    int stack[MAX_QUERY_STACK];
+    int stackSize = 0;
+
+    float const inverseX = forwardNormal.x != 0.f ? 1.f / forwardNormal.x : 1e30f;
+    float const inverseY = forwardNormal.y != 0.f ? 1.f / forwardNormal.y : 1e30f;
+    float const inverseZ = forwardNormal.z != 0.f ? 1.f / forwardNormal.z : 1e30f;
+
+    if (m_root != NULL_NODE)
+    {
+        stack[stackSize++] = m_root;
+    }
+
+    while (stackSize > 0)
+    {
+        sNode const& node = m_nodes[stack[--stackSize]];
+        Vec3 const&  mins = node.m_bounds.m_mins;
+        Vec3 const&  maxs = node.m_bounds.m_maxs;
+
+        float const tx1   = (mins.x - start.x) * inverseX;
+        float const tx2   = (maxs.x - start.x) * inverseX;
+        float const ty1   = (mins.y - start.y) * inverseY;
+        float const ty2   = (maxs.y - start.y) * inverseY;
+        float const tz1   = (mins.z - start.z) * inverseZ;
+        float const tz2   = (maxs.z - start.z) * inverseZ;
+        float const txMin = tx1 < tx2 ? tx1 : tx2;
+        float const txMax = tx1 < tx2 ? tx2 : tx1;
+        float const tyMin = ty1 < ty2 ? ty1 : ty2;
+        float const tyMax = ty1 < ty2 ? ty2 : ty1;
+        float const tzMin = tz1 < tz2 ? tz1 : tz2;
+        float const tzMax = tz1 < tz2 ? tz2 : tz1;
+        float       tMin  = txMin > tyMin ? txMin : tyMin;
+        float       tMax  = txMax < tyMax ? txMax : tyMax;
+        tMin              = tzMin > tMin ? tzMin : tMin;
+        tMax              = tzMax < tMax ? tzMax : tMax;
+
+        if (tMax < 0.f || tMin > tMax || tMin > maxDistance)
+        {
+            continue;
+        }
+
+        if (node.IsLeaf())
+        {
+            maxDistance = callback(static_cast<int>(&node - m_nodes.data()), maxDistance);
+
+            if (maxDistance <= 0.f)
+            {
+                return;
+            }
+            continue;
+        }
+
+        ASSERT_OR_DIE(stackSize + 2 <= MAX_QUERY_STACK, "DynamicAABBTree query stack overflow")
+        stack[stackSize++] = node.m_child1;
+        stack[stackSize++] = node.m_child2;
+    }
+}
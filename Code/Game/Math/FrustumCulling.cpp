@@ -0,0 +1,156 @@
+//----------------------------------------------------------------------------------------------------
+// FrustumCulling.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Math/FrustumCulling.hpp"
+
+#include <cmath>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include "Game/Math/SIMD.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static_assert(sizeof(sBoundingSphere) == sizeof(float) * 4, "sBoundingSphere must be four packed floats");
+
+//----------------------------------------------------------------------------------------------------
+// Gribb/Hartmann: with clip = M * p, each plane is the sum or difference of row 3 and one other row.
+//
+STATIC sFrustum sFrustum::MakeFromWorldToClip(Mat44 const& worldToClip)
+{
+    float const* m = worldToClip.m_values;
+
+    float const row0[4] = { m[Mat44::Ix], m[Mat44::Jx], m[Mat44::Kx], m[Mat44::Tx] };
+    float const row1[4] = { m[Mat44::Iy], m[Mat44::Jy], m[Mat44::Ky], m[Mat44::Ty] };
+    float const row2[4] = { m[Mat44::Iz], m[Mat44::Jz], m[Mat44::Kz], m[Mat44::Tz] };
+    float const row3[4] = { m[Mat44::Iw], m[Mat44::Jw], m[Mat44::Kw], m[Mat44::Tw] };
+
+    sFrustum frustum;
+
+    for (int component = 0; component < 4; ++component)
+    {
+        frustum.m_planes[0][component] = row3[component] + row0[component];     // Left
+        frustum.m_planes[1][component] = row3[component] - row0[component];     // Right
+        frustum.m_planes[2][component] = row3[component] + row1[component];     // Bottom
+        frustum.m_planes[3][component] = row3[component] - row1[component];     // Top
+        frustum.m_planes[4][component] = row2[component];                       // Near (z >= 0)
+        frustum.m_planes[5][component] = row3[component] - row2[component];     // Far
+    }
+
+    for (float (&plane)[4] : frustum.m_planes)
+    {
+        float const normalLength = sqrtf(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+
+        if (normalLength > 0.f)
+        {
+            float const scale = 1.f / normalLength;
+            plane[0] *= scale;
+            plane[1] *= scale;
+            plane[2] *= scale;
+            plane[3] *= scale;
+        }
+    }
+
+    return frustum;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC sFrustum sFrustum::MakeFromCamera(Camera const& camera)
+{
+    Mat44 worldToClip = camera.GetRenderToClipTransform();
+    worldToClip.Append(camera.GetCameraToRenderTransform());
+    worldToClip.Append(camera.GetWorldToCameraTransform());
+
+    return MakeFromWorldToClip(worldToClip);
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool IsSphereInFrustum(sFrustum const& frustum, sBoundingSphere const& sphere)
+{
+    for (float const (&plane)[4] : frustum.m_planes)
+    {
+        float const distance = plane[0] * sphere.m_center.x + plane[1] * sphere.m_center.y + plane[2] * sphere.m_center.z + plane[3];
+
+        if (distance < -sphere.m_radius)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+int CullSpheresScalar(sFrustum const& frustum, sBoundingSphere const* spheres, int const count, uint8_t* out_isVisible)
+{
+    int visibleCount = 0;
+
+    for (int sphereIndex = 0; sphereIndex < count; ++sphereIndex)
+    {
+        bool const isVisible       = IsSphereInFrustum(frustum, spheres[sphereIndex]);
+        out_isVisible[sphereIndex] = isVisible ? 1 : 0;
+        visibleCount += isVisible ? 1 : 0;
+    }
+
+    return visibleCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Four spheres are loaded as four rows and transposed, so each plane test is three multiply-adds and
+// one compare across all four. A sphere is culled when it is fully behind any plane.
+//
+int CullSpheres(sFrustum const& frustum, sBoundingSphere const* spheres, int const count, uint8_t* out_isVisible)
+{
+    int sphereIndex  = 0;
+    int visibleCount = 0;
+
+#if defined(GAME_SIMD_SSE)
+    __m128 planeX[sFrustum::NUM_PLANES];
+    __m128 planeY[sFrustum::NUM_PLANES];
+    __m128 planeZ[sFrustum::NUM_PLANES];
+    __m128 planeW[sFrustum::NUM_PLANES];
+
+    for (int planeIndex = 0; planeIndex < sFrustum::NUM_PLANES; ++planeIndex)
+    {
+        planeX[planeIndex] = _mm_set1_ps(frustum.m_planes[planeIndex][0]);
+        planeY[planeIndex] = _mm_set1_ps(frustum.m_planes[planeIndex][1]);
+        planeZ[planeIndex] = _mm_set1_ps(frustum.m_planes[planeIndex][2]);
+        planeW[planeIndex] = _mm_set1_ps(frustum.m_planes[planeIndex][3]);
+    }
+
+    for (; sphereIndex + 4 <= count; sphereIndex += 4)
+    {
+        float const* sphereFloats = &spheres[sphereIndex].m_center.x;
+
+        __m128 centerX = _mm_loadu_ps(sphereFloats);
+        __m128 centerY = _mm_loadu_ps(sphereFloats + 4);
+        __m128 centerZ = _mm_loadu_ps(sphereFloats + 8);
+        __m128 radius  = _mm_loadu_ps(sphereFloats + 12);
+        _MM_TRANSPOSE4_PS(centerX, centerY, centerZ, radius);
+
+        __m128 const negativeRadius = _mm_sub_ps(_mm_setzero_ps(), radius);
+        __m128       isInside       = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        for (int planeIndex = 0; planeIndex < sFrustum::NUM_PLANES; ++planeIndex)
+        {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(planeX[planeIndex], centerX), planeW[planeIndex]);
+            distance        = _mm_add_ps(_mm_mul_ps(planeY[planeIndex], centerY), distance);
+            distance        = _mm_add_ps(_mm_mul_ps(planeZ[planeIndex], centerZ), distance);
+            isInside        = _mm_and_ps(isInside, _mm_cmpge_ps(distance, negativeRadius));
+        }
+
+        int const insideBits = _mm_movemask_ps(isInside);
+
+        out_isVisible[sphereIndex + 0] = static_cast<uint8_t>(insideBits & 1);
+        out_isVisible[sphereIndex + 1] = static_cast<uint8_t>((insideBits >> 1) & 1);
+        out_isVisible[sphereIndex + 2] = static_cast<uint8_t>((insideBits >> 2) & 1);
+        out_isVisible[sphereIndex + 3] = static_cast<uint8_t>((insideBits >> 3) & 1);
+
+        visibleCount += out_isVisible[sphereIndex + 0] + out_isVisible[sphereIndex + 1] + out_isVisible[sphereIndex + 2] + out_isVisible[sphereIndex + 3];
+    }
+#endif
+
+    return visibleCount + CullSpheresScalar(frustum, spheres + sphereIndex, count - sphereIndex, out_isVisible + sphereIndex);
+}
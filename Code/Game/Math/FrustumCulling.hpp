@@ -0,0 +1,48 @@
+//----------------------------------------------------------------------------------------------------
+// FrustumCulling.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+#include "Engine/Math/Vec3.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Camera;
+struct Mat44;
+
+//----------------------------------------------------------------------------------------------------
+// 16 bytes, so four spheres load as one 4x4 block in CullSpheres.
+//
+struct sBoundingSphere
+{
+    Vec3  m_center = Vec3::ZERO;
+    float m_radius = 0.f;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Each plane is (normal.x, normal.y, normal.z, distance) with the normal pointing into the frustum, so a
+// point p is inside when dot(normal, p) + distance >= 0. Normals are unit length.
+//
+struct sFrustum
+{
+    static int constexpr NUM_PLANES = 6;    // Left, right, bottom, top, near, far
+
+    float m_planes[NUM_PLANES][4] = {};
+
+    // Extracts the planes from a world-to-clip matrix; clip depth is D3D style, 0 to w.
+    static sFrustum MakeFromWorldToClip(Mat44 const& worldToClip);
+    static sFrustum MakeFromCamera(Camera const& camera);
+};
+
+//----------------------------------------------------------------------------------------------------
+// Writes 1 to out_isVisible[i] for every sphere that touches the frustum, 0 otherwise, and returns
+// the number of visible spheres. Tests four spheres against each plane at a time with SSE.
+//
+int CullSpheres(sFrustum const& frustum, sBoundingSphere const* spheres, int count, uint8_t* out_isVisible);
+
+//----------------------------------------------------------------------------------------------------
+// Reference path: one sphere and one plane at a time.
+//
+int CullSpheresScalar(sFrustum const& frustum, sBoundingSphere const* spheres, int count, uint8_t* out_isVisible);
@@ -0,0 +1,186 @@
+//----------------------------------------------------------------------------------------------------
+// IndexedMeshUtils.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Math/IndexedMeshUtils.hpp"
+
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+//----------------------------------------------------------------------------------------------------
+template <typename IndexType>
+static IndexType GetBaseIndexForAppend(std::vector<Vertex_PCU> const& verts, size_t const numVertsToAdd)
+{
+    GUARANTEE_OR_DIE(verts.size() + numVertsToAdd - 1 <= std::numeric_limits<IndexType>::max(), "Mesh has too many vertexes for its index type")
+
+    return static_cast<IndexType>(verts.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename IndexType>
+void AddVertsForIndexedQuad3D(std::vector<Vertex_PCU>& verts, std::vector<IndexType>& indexes, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topLeft, Vec3 const& topRight, Rgba8 const& color, AABB2 const& UVs)
+{
+    IndexType const baseIndex = GetBaseIndexForAppend<IndexType>(verts, 4);
+
+    verts.emplace_back(bottomLeft, color, Vec2(UVs.m_mins.x, UVs.m_mins.y));
+    verts.emplace_back(bottomRight, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y));
+    verts.emplace_back(topRight, color, Vec2(UVs.m_maxs.x, UVs.m_maxs.y));
+    verts.emplace_back(topLeft, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y));
+
+    IndexType const quadIndexes[6] = { 0, 1, 2, 0, 2, 3 };
+
+    for (IndexType const quadIndex : quadIndexes)
+    {
+        indexes.push_back(static_cast<IndexType>(baseIndex + quadIndex));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Faces are laid out like Prop::InitializeLocalVertsForCube: +X, -X, +Y, -Y, +Z, -Z.
+// Corners are not shared between faces because each face has its own UVs.
+//
+template <typename IndexType>
+void AddVertsForIndexedAABB3D(std::vector<Vertex_PCU>& verts, std::vector<IndexType>& indexes, AABB3 const& bounds, Rgba8 const& color, AABB2 const& UVs)
+{
+    Vec3 const& mins = bounds.m_mins;
+    Vec3 const& maxs = bounds.m_maxs;
+
+    Vec3 const frontBottomLeft(maxs.x, mins.y, mins.z);
+    Vec3 const frontBottomRight(maxs.x, maxs.y, mins.z);
+    Vec3 const frontTopLeft(maxs.x, mins.y, maxs.z);
+    Vec3 const frontTopRight(maxs.x, maxs.y, maxs.z);
+    Vec3 const backBottomLeft(mins.x, maxs.y, mins.z);
+    Vec3 const backBottomRight(mins.x, mins.y, mins.z);
+    Vec3 const backTopLeft(mins.x, maxs.y, maxs.z);
+    Vec3 const backTopRight(mins.x, mins.y, maxs.z);
+
+    AddVertsForIndexedQuad3D(verts, indexes, frontBottomLeft, frontBottomRight, frontTopLeft, frontTopRight, color, UVs);
+    AddVertsForIndexedQuad3D(verts, indexes, backBottomLeft, backBottomRight, backTopLeft, backTopRight, color, UVs);
+    AddVertsForIndexedQuad3D(verts, indexes, frontBottomRight, backBottomLeft, frontTopRight, backTopLeft, color, UVs);
+    AddVertsForIndexedQuad3D(verts, indexes, backBottomRight, frontBottomLeft, backTopRight, frontTopLeft, color, UVs);
+    AddVertsForIndexedQuad3D(verts, indexes, frontTopLeft, frontTopRight, backTopRight, backTopLeft, color, UVs);
+    AddVertsForIndexedQuad3D(verts, indexes, backBottomRight, backBottomLeft, frontBottomLeft, frontBottomRight, color, UVs);
+}
+
+//----------------------------------------------------------------------------------------------------
+// A (numSlices + 1) x (numStacks + 1) grid of latitude/longitude vertexes. The seam column is
+// duplicated so U can run 0 to 1 across it; the poles keep one vertex per slice for the same reason.
+//
+template <typename IndexType>
+void AddVertsForIndexedSphere3D(std::vector<Vertex_PCU>& verts, std::vector<IndexType>& indexes, Vec3 const& center, float const radius, Rgba8 const& color, AABB2 const& UVs, int const numSlices, int const numStacks)
+{
+    int const       numColumns = numSlices + 1;
+    IndexType const baseIndex  = GetBaseIndexForAppend<IndexType>(verts, static_cast<size_t>(numColumns * (numStacks + 1)));
+
+    verts.reserve(verts.size() + static_cast<size_t>(numColumns * (numStacks + 1)));
+    indexes.reserve(indexes.size() + static_cast<size_t>(numSlices * numStacks * 6));
+
+    for (int stackIndex = 0; stackIndex <= numStacks; ++stackIndex)
+    {
+        float const v               = static_cast<float>(stackIndex) / static_cast<float>(numStacks);
+        float const latitudeDegrees = -90.f + 180.f * v;
+        float const cosLatitude     = CosDegrees(latitudeDegrees);
+        float const sinLatitude     = SinDegrees(latitudeDegrees);
+
+        for (int sliceIndex = 0; sliceIndex <= numSlices; ++sliceIndex)
+        {
+            float const u                = static_cast<float>(sliceIndex) / static_cast<float>(numSlices);
+            float const longitudeDegrees = 360.f * u;
+            Vec3 const  direction(cosLatitude * CosDegrees(longitudeDegrees), cosLatitude * SinDegrees(longitudeDegrees), sinLatitude);
+            Vec2 const  uv(Interpolate(UVs.m_mins.x, UVs.m_maxs.x, u), Interpolate(UVs.m_mins.y, UVs.m_maxs.y, v));
+
+            verts.emplace_back(center + direction * radius, color, uv);
+        }
+    }
+
+    for (int stackIndex = 0; stackIndex < numStacks; ++stackIndex)
+    {
+        for (int sliceIndex = 0; sliceIndex < numSlices; ++sliceIndex)
+        {
+            IndexType const bottomLeft  = static_cast<IndexType>(baseIndex + stackIndex * numColumns + sliceIndex);
+            IndexType const bottomRight = static_cast<IndexType>(bottomLeft + 1);
+            IndexType const topLeft     = static_cast<IndexType>(bottomLeft + numColumns);
+            IndexType const topRight    = static_cast<IndexType>(topLeft + 1);
+
+            indexes.push_back(bottomLeft);
+            indexes.push_back(bottomRight);
+            indexes.push_back(topRight);
+            indexes.push_back(bottomLeft);
+            indexes.push_back(topRight);
+            indexes.push_back(topLeft);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Vertex_PCU is 24 bytes with no padding, so bitwise hashing and comparison are exact.
+//
+struct sVertexBitsHash
+{
+    size_t operator()(Vertex_PCU const& vertex) const
+    {
+        unsigned char const* bytes = reinterpret_cast<unsigned char const*>(&vertex);
+        size_t               hash  = 14695981039346656037ull;
+
+        for (size_t byteIndex = 0; byteIndex < sizeof(Vertex_PCU); ++byteIndex)
+        {
+            hash = (hash ^ bytes[byteIndex]) * 1099511628211ull;
+        }
+
+        return hash;
+    }
+};
+
+struct sVertexBitsEqual
+{
+    bool operator()(Vertex_PCU const& a, Vertex_PCU const& b) const
+    {
+        return memcmp(&a, &b, sizeof(Vertex_PCU)) == 0;
+    }
+};
+
+static_assert(sizeof(Vertex_PCU) == sizeof(Vec3) + sizeof(Rgba8) + sizeof(Vec2), "Vertex_PCU has padding; WeldVertexes would hash garbage bytes");
+
+//----------------------------------------------------------------------------------------------------
+template <typename IndexType>
+void WeldVertexes(std::vector<Vertex_PCU> const& flatVerts, std::vector<Vertex_PCU>& out_verts, std::vector<IndexType>& out_indexes)
+{
+    std::unordered_map<Vertex_PCU, IndexType, sVertexBitsHash, sVertexBitsEqual> indexForVertex;
+    indexForVertex.reserve(flatVerts.size());
+    out_indexes.reserve(out_indexes.size() + flatVerts.size());
+
+    for (Vertex_PCU const& vertex : flatVerts)
+    {
+        auto const found = indexForVertex.find(vertex);
+
+        if (found != indexForVertex.end())
+        {
+            out_indexes.push_back(found->second);
+            continue;
+        }
+
+        IndexType const newIndex = GetBaseIndexForAppend<IndexType>(out_verts, 1);
+        out_verts.push_back(vertex);
+        indexForVertex.emplace(vertex, newIndex);
+        out_indexes.push_back(newIndex);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+template void AddVertsForIndexedQuad3D<unsigned short>(std::vector<Vertex_PCU>&, std::vector<unsigned short>&, Vec3 const&, Vec3 const&, Vec3 const&, Vec3 const&, Rgba8 const&, AABB2 const&);
+template void AddVertsForIndexedQuad3D<unsigned int>(std::vector<Vertex_PCU>&, std::vector<unsigned int>&, Vec3 const&, Vec3 const&, Vec3 const&, Vec3 const&, Rgba8 const&, AABB2 const&);
+template void AddVertsForIndexedAABB3D<unsigned short>(std::vector<Vertex_PCU>&, std::vector<unsigned short>&, AABB3 const&, Rgba8 const&, AABB2 const&);
+template void AddVertsForIndexedAABB3D<unsigned int>(std::vector<Vertex_PCU>&, std::vector<unsigned int>&, AABB3 const&, Rgba8 const&, AABB2 const&);
+template void AddVertsForIndexedSphere3D<unsigned short>(std::vector<Vertex_PCU>&, std::vector<unsigned short>&, Vec3 const&, float, Rgba8 const&, AABB2 const&, int, int);
+template void AddVertsForIndexedSphere3D<unsigned int>(std::vector<Vertex_PCU>&, std::vector<unsigned int>&, Vec3 const&, float, Rgba8 const&, AABB2 const&, int, int);
+template void WeldVertexes<unsigned short>(std::vector<Vertex_PCU> const&, std::vector<Vertex_PCU>&, std::vector<unsigned short>&);
+template void WeldVertexes<unsigned int>(std::vector<Vertex_PCU> const&, std::vector<Vertex_PCU>&, std::vector<unsigned int>&);
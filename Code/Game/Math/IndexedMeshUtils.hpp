@@ -0,0 +1,38 @@
+//----------------------------------------------------------------------------------------------------
+// IndexedMeshUtils.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/AABB2.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+struct AABB3;
+struct Vec3;
+struct Vertex_PCU;
+
+//----------------------------------------------------------------------------------------------------
+// Indexed versions of the VertexUtils AddVertsFor* generators.
+// Each shape appends its unique corners to `verts` and its triangles to `indexes` (offset by the
+// vertex count on entry, so several shapes can share one list). Triangle winding and UV layout
+// match the flat AddVertsFor* versions.
+// IndexType is unsigned int or unsigned short; 16-bit lists die if a mesh passes 65535 vertexes.
+//
+template <typename IndexType>
+void AddVertsForIndexedQuad3D(std::vector<Vertex_PCU>& verts, std::vector<IndexType>& indexes, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topLeft, Vec3 const& topRight, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+
+template <typename IndexType>
+void AddVertsForIndexedAABB3D(std::vector<Vertex_PCU>& verts, std::vector<IndexType>& indexes, AABB3 const& bounds, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+
+template <typename IndexType>
+void AddVertsForIndexedSphere3D(std::vector<Vertex_PCU>& verts, std::vector<IndexType>& indexes, Vec3 const& center, float radius, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE, int numSlices = 32, int numStacks = 16);
+
+//----------------------------------------------------------------------------------------------------
+// Turns a flat triangle list into unique vertexes plus indexes, merging vertexes whose position,
+// color, and UVs are bit-identical. Output is appended, as with the generators above.
+//
+template <typename IndexType>
+void WeldVertexes(std::vector<Vertex_PCU> const& flatVerts, std::vector<Vertex_PCU>& out_verts, std::vector<IndexType>& out_indexes);
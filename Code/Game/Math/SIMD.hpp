@@ -0,0 +1,14 @@
+//----------------------------------------------------------------------------------------------------
+// SIMD.hpp
+//
+// Game-side SIMD kernels use SSE2, which every x64 target has. Include this instead of the
+// intrinsic headers and guard kernels with GAME_SIMD_SSE, so other targets fall back to scalar code.
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define GAME_SIMD_SSE
+#include <emmintrin.h>
+#endif
@@ -9,9 +9,14 @@
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
-#include "Engine/Input/InputSystem.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Renderer/Camera.hpp"
+#include "Game/Framework/App.hpp"
+#include "Game/Framework/GameCommon.hpp"
+
+#if defined(_WIN32)
+#include "Engine/Input/InputSystem.hpp"
+#endif
 
 //----------------------------------------------------------------------------------------------------
 Player::Player(Game* owner)
@@ -45,8 +50,23 @@ Player::~Player()
 }
 
 //----------------------------------------------------------------------------------------------------
-void Player::Update(float deltaSeconds)
+void Player::Update(float const deltaSeconds)
 {
+    // Headless runs create no InputSystem, so the player keeps its spawn pose
+    if (!g_theApp->IsHeadless())
+    {
+        UpdateFromInput(deltaSeconds);
+    }
+
+    m_worldCamera->SetPositionAndOrientation(m_position, m_orientation);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Only the Windows build has an InputSystem.
+//
+void Player::UpdateFromInput(float deltaSeconds)
+{
+#if defined(_WIN32)
     XboxController const& controller = g_theInput->GetController(0);
 
     if (g_theInput->WasKeyJustPressed(KEYCODE_H) || controller.WasButtonJustPressed(XBOX_BUTTON_START))
@@ -108,8 +128,9 @@ void Player::Update(float deltaSeconds)
 
     m_orientation.m_rollDegrees += m_angularVelocity.m_rollDegrees * deltaSeconds;
     m_orientation.m_rollDegrees = GetClamped(m_orientation.m_rollDegrees, -45.f, 45.f);
-
-    m_worldCamera->SetPositionAndOrientation(m_position, m_orientation);
+#else
+    UNUSED(deltaSeconds)
+#endif
 }
 
 //----------------------------------------------------------------------------------------------------
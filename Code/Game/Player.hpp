@@ -24,5 +24,7 @@ public:
     Camera* GetCamera() const;
 
 private:
+    void UpdateFromInput(float deltaSeconds);
+
     Camera* m_worldCamera = nullptr;
 };
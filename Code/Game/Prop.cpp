@@ -5,20 +5,40 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Prop.hpp"
 
+#include <cmath>
+
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Math/AABB3.hpp"
-#include "Engine/Renderer/BitmapFont.hpp"
-#include "Engine/Renderer/Renderer.hpp"
 #include "Game/Framework/GameCommon.hpp"
+#include "Game/Math/IndexedMeshUtils.hpp"
+#include "Game/Subsystem/Render/PipelineState.hpp"
+#include "Game/Subsystem/Render/GlyphFont.hpp"
+#include "Game/Subsystem/Render/RenderBackend.hpp"
 #include "ThirdParty/stb/stb_image.h"
 
 //----------------------------------------------------------------------------------------------------
 Prop::Prop(Game* owner, Texture const* texture)
-    : Entity(owner),
-      m_texture(texture)
+    : Entity(owner)
 {
+    sPipelineStateDesc pipelineStateDesc;
+    pipelineStateDesc.m_shaderName     = "Data/Shaders/Bloom";
+    pipelineStateDesc.m_rasterizerMode = eRenderRasterizerMode::SOLID_CULL_BACK;
+    pipelineStateDesc.m_depthMode      = eRenderDepthMode::READ_WRITE_LESS_EQUAL;
+
+    m_renderState.m_pipelineState = g_theRenderBackend->CreateOrGetPipelineState(pipelineStateDesc);
+    m_renderState.m_texture       = texture;
+}
+
+//----------------------------------------------------------------------------------------------------
+Prop::~Prop()
+{
+    if (m_staticMeshId >= 0 && !m_isStaticMeshShared)
+    {
+        g_theRenderBackend->DestroyStaticMesh(m_staticMeshId);
+        m_staticMeshId = -1;
+    }
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -32,14 +52,45 @@ void Prop::Update(float const deltaSeconds)
 //----------------------------------------------------------------------------------------------------
 void Prop::Render() const
 {
-    g_theRenderer->SetModelConstants(GetModelToWorldTransform(), m_color);
-    g_theRenderer->SetBlendMode(eBlendMode::OPAQUE); //AL
-    g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);  //SOLID_CULL_NONE
-    g_theRenderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
-    g_theRenderer->SetDepthMode(eDepthMode::READ_WRITE_LESS_EQUAL);  //DISABLE
-    g_theRenderer->BindTexture(m_texture);
-    g_theRenderer->BindShader(g_theRenderer->CreateOrGetShaderFromFile("Data/Shaders/Bloom",eVertexType::VERTEX_PCU));
-    g_theRenderer->DrawVertexArray(static_cast<int>(m_vertexes.size()), m_vertexes.data());
+    RenderWithTransform(GetModelToWorldTransform(), m_color);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Draws this prop's mesh with a transform and tint supplied by the caller, so one Prop can act as
+// the shared mesh for any number of entities in an EntityStore.
+//
+void Prop::RenderWithTransform(Mat44 const& modelToWorldTransform, Rgba8 const& color) const
+{
+    g_theRenderBackend->SetModelConstants(modelToWorldTransform, color);
+    g_theRenderBackend->BindPipelineState(m_renderState.m_pipelineState);
+    g_theRenderBackend->BindTexture(m_renderState.m_texture);
+
+    if (m_staticMeshId >= 0)
+    {
+        g_theRenderBackend->DrawStaticMesh(m_staticMeshId);
+    }
+    else
+    {
+        GUARANTEE_OR_DIE(m_indexes.empty(), "Indexed props must call CreateStaticMesh before they render")
+        g_theRenderBackend->DrawVertexArray(static_cast<int>(m_vertexes.size()), m_vertexes.data());
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Same draw as RenderWithTransform, deferred to `queue` so it can be sorted against every other
+// draw this frame and skip the state changes it shares with its neighbors.
+//
+void Prop::SubmitWithTransform(RenderQueue& queue, Mat44 const& modelToWorldTransform, Rgba8 const& color, sBoundingSphere const& worldBounds) const
+{
+    if (m_staticMeshId >= 0)
+    {
+        queue.Submit(m_renderState, m_staticMeshId, modelToWorldTransform, color, worldBounds);
+    }
+    else
+    {
+        GUARANTEE_OR_DIE(m_indexes.empty(), "Indexed props must call CreateStaticMesh before they render")
+        queue.Submit(m_renderState, static_cast<int>(m_vertexes.size()), m_vertexes.data(), modelToWorldTransform, color, worldBounds);
+    }
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -54,12 +105,12 @@ void Prop::InitializeLocalVertsForCube()
     Vec3 const backTopLeft(-0.5f, 0.5f, 0.5f);
     Vec3 const backTopRight(-0.5f, -0.5f, 0.5f);
 
-    AddVertsForQuad3D(m_vertexes, frontBottomLeft, frontBottomRight, frontTopLeft, frontTopRight, Rgba8::RED);          // +X Red
-    AddVertsForQuad3D(m_vertexes, backBottomLeft, backBottomRight, backTopLeft, backTopRight, Rgba8::CYAN);             // -X -Red (Cyan)
-    AddVertsForQuad3D(m_vertexes, frontBottomRight, backBottomLeft, frontTopRight, backTopLeft, Rgba8::GREEN);          // -Y -Green (Magenta)
-    AddVertsForQuad3D(m_vertexes, backBottomRight, frontBottomLeft, backTopRight, frontTopLeft, Rgba8::MAGENTA);        // +Y Green
-    AddVertsForQuad3D(m_vertexes, frontTopLeft, frontTopRight, backTopRight, backTopLeft, Rgba8::BLUE);                 // +Z Blue
-    AddVertsForQuad3D(m_vertexes, backBottomRight, backBottomLeft, frontBottomLeft, frontBottomRight, Rgba8::YELLOW);   // -Z -Blue (Yellow)
+    AddVertsForIndexedQuad3D(m_vertexes, m_indexes, frontBottomLeft, frontBottomRight, frontTopLeft, frontTopRight, Rgba8::RED);          // +X Red
+    AddVertsForIndexedQuad3D(m_vertexes, m_indexes, backBottomLeft, backBottomRight, backTopLeft, backTopRight, Rgba8::CYAN);             // -X -Red (Cyan)
+    AddVertsForIndexedQuad3D(m_vertexes, m_indexes, frontBottomRight, backBottomLeft, frontTopRight, backTopLeft, Rgba8::GREEN);          // -Y -Green (Magenta)
+    AddVertsForIndexedQuad3D(m_vertexes, m_indexes, backBottomRight, frontBottomLeft, backTopRight, frontTopLeft, Rgba8::MAGENTA);        // +Y Green
+    AddVertsForIndexedQuad3D(m_vertexes, m_indexes, frontTopLeft, frontTopRight, backTopRight, backTopLeft, Rgba8::BLUE);                 // +Z Blue
+    AddVertsForIndexedQuad3D(m_vertexes, m_indexes, backBottomRight, backBottomLeft, frontBottomLeft, frontBottomRight, Rgba8::YELLOW);   // -Z -Blue (Yellow)
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -71,7 +122,7 @@ void Prop::InitializeLocalVertsForSphere()
     Rgba8 const     color     = Rgba8::WHITE;
     AABB2 const     UVs       = AABB2::ZERO_TO_ONE;
 
-    AddVertsForSphere3D(m_vertexes, m_position, radius, color, UVs, numSlices, numStacks);
+    AddVertsForIndexedSphere3D(m_vertexes, m_indexes, m_position, radius, color, UVs, numSlices, numStacks);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -96,8 +147,8 @@ void Prop::InitializeLocalVertsForGrid()
             colorY = Rgba8::GREEN;
         }
 
-        AddVertsForAABB3D(m_vertexes, boundsX, colorX);
-        AddVertsForAABB3D(m_vertexes, boundsY, colorY);
+        AddVertsForIndexedAABB3D(m_vertexes, m_indexes, boundsX, colorX);
+        AddVertsForIndexedAABB3D(m_vertexes, m_indexes, boundsY, colorY);
     }
 }
 
@@ -110,8 +161,89 @@ void Prop::InitializeLocalVertsForWorldCoordinateArrows()
 }
 
 //----------------------------------------------------------------------------------------------------
+// Needs g_theGlyphFont, which only windowed runs load.
+//
 void Prop::InitializeLocalVertsForText2D()
 {
-    // g_theBitmapFont->AddVertsForTextInBox2D(m_vertexes, "XXX", AABB2::ZERO_TO_ONE, 10.f);
-    g_theBitmapFont->AddVertsForText3DAtOriginXForward(m_vertexes, "ABCDEFGHIJKL", 1.f);
+    g_theGlyphFont->AddVertsForText3DAtOriginXForward(m_vertexes, "ABCDEFGHIJKL", 1.f);
+}
+
+//----------------------------------------------------------------------------------------------------
+// The sphere is centered on the box, with the radius of the farthest vertex rather than the half
+// diagonal, which is noticeably tighter for round meshes.
+//
+void Prop::ComputeLocalBounds()
+{
+    if (m_vertexes.empty())
+    {
+        m_localBounds         = AABB3(Vec3::ZERO, Vec3::ZERO);
+        m_localBoundingSphere = sBoundingSphere();
+        return;
+    }
+
+    Vec3 mins = m_vertexes[0].m_position;
+    Vec3 maxs = m_vertexes[0].m_position;
+
+    for (Vertex_PCU const& vertex : m_vertexes)
+    {
+        Vec3 const& position = vertex.m_position;
+
+        mins.x = position.x < mins.x ? position.x : mins.x;
+        mins.y = position.y < mins.y ? position.y : mins.y;
+        mins.z = position.z < mins.z ? position.z : mins.z;
+        maxs.x = position.x > maxs.x ? position.x : maxs.x;
+        maxs.y = position.y > maxs.y ? position.y : maxs.y;
+        maxs.z = position.z > maxs.z ? position.z : maxs.z;
+    }
+
+    Vec3 const center           = (mins + maxs) * 0.5f;
+    float      maxRadiusSquared = 0.f;
+
+    for (Vertex_PCU const& vertex : m_vertexes)
+    {
+        Vec3 const  displacement  = vertex.m_position - center;
+        float const radiusSquared = displacement.x * displacement.x + displacement.y * displacement.y + displacement.z * displacement.z;
+        maxRadiusSquared          = radiusSquared > maxRadiusSquared ? radiusSquared : maxRadiusSquared;
+    }
+
+    m_localBounds                  = AABB3(mins, maxs);
+    m_localBoundingSphere.m_center = center;
+    m_localBoundingSphere.m_radius = sqrtf(maxRadiusSquared);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Call once the InitializeLocalVertsFor* calls are done. Uploads the vertexes to a GPU buffer that
+// every later Render reuses, so static geometry costs no upload bandwidth after load, and computes
+// the local bounds used for culling.
+//
+void Prop::CreateStaticMesh()
+{
+    ComputeLocalBounds();
+
+    if (m_staticMeshId >= 0 && !m_isStaticMeshShared)
+    {
+        g_theRenderBackend->DestroyStaticMesh(m_staticMeshId);
+    }
+
+    m_staticMeshId       = g_theRenderBackend->CreateStaticMesh(m_vertexes, m_indexes);
+    m_isStaticMeshShared = false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Draws a static mesh this Prop does not own, such as a streamed model or its placeholder; call
+// again to swap in the real mesh once it is ready.
+//
+void Prop::UseSharedStaticMesh(int const staticMeshId, sBoundingSphere const& localBoundingSphere)
+{
+    if (m_staticMeshId >= 0 && !m_isStaticMeshShared)
+    {
+        g_theRenderBackend->DestroyStaticMesh(m_staticMeshId);
+    }
+
+    m_vertexes.clear();
+    m_indexes.clear();
+
+    m_staticMeshId        = staticMeshId;
+    m_isStaticMeshShared  = true;
+    m_localBoundingSphere = localBoundingSphere;
 }
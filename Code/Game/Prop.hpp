@@ -8,8 +8,8 @@
 
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/VertexUtils.hpp"
-#include "Engine/Renderer/BitmapFont.hpp"
 #include "Game/Entity.hpp"
+#include "Game/Subsystem/Render/RenderQueue.hpp"
 
 //----------------------------------------------------------------------------------------------------
 class Texture;
@@ -20,17 +20,26 @@ class Prop : public Entity
 {
 public:
     Prop(Game* owner, Texture const* texture = nullptr);
+    ~Prop() override;
 
     void Update(float deltaSeconds) override;
     void Render() const override;
+    void RenderWithTransform(Mat44 const& modelToWorldTransform, Rgba8 const& color) const;
+    void SubmitWithTransform(RenderQueue& queue, Mat44 const& modelToWorldTransform, Rgba8 const& color, sBoundingSphere const& worldBounds) const;
     void InitializeLocalVertsForCube();
     void InitializeLocalVertsForSphere();
     void InitializeLocalVertsForGrid();
     void InitializeLocalVertsForCylinder();
     void InitializeLocalVertsForWorldCoordinateArrows();
     void InitializeLocalVertsForText2D();
+    void ComputeLocalBounds();
+    void CreateStaticMesh();
+    void UseSharedStaticMesh(int staticMeshId, sBoundingSphere const& localBoundingSphere);
 
 private:
-    std::vector<Vertex_PCU> m_vertexes;
-    Texture const* m_texture = nullptr;
+    std::vector<Vertex_PCU>   m_vertexes;
+    std::vector<unsigned int> m_indexes;                        // Empty for flat triangle lists (arrows, text)
+    sRenderState              m_renderState;
+    int                       m_staticMeshId       = -1;       // Set by CreateStaticMesh; -1 draws m_vertexes every frame
+    bool                      m_isStaticMeshShared = false;    // Owned elsewhere, e.g. by the ModelStreamer, so not destroyed here
 };
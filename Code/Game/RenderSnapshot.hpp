@@ -0,0 +1,50 @@
+//----------------------------------------------------------------------------------------------------
+// RenderSnapshot.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/Light.hpp"
+#include "Game/DebugPrimitiveList.hpp"
+#include "Game/Math/FrustumCulling.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// One visible entity, as Game::RenderSnapshot draws it: the Prop mesh in Game::m_propMeshes with
+// this transform and tint, lit by the lights that reach its world bounds.
+//
+struct sSnapshotDraw
+{
+    Mat44           m_modelToWorldTransform;
+    Rgba8           m_color;
+    sBoundingSphere m_worldBounds;
+    int             m_meshIndex = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Everything a frame draws, copied out of the Game at the end of its Update. Once submitted to a
+// RenderPipeline nothing in it is written until the render side is done with it, so the game can
+// simulate the next frame while this one is being drawn.
+//
+// Entities are already culled and interpolated. Debug primitives are carried as the calls that
+// added them, and reach DebugRender only when the render side replays them.
+//
+struct sRenderSnapshot
+{
+    uint64_t                   m_frameIndex       = 0;          // Set by RenderPipeline::SubmitSnapshot
+    bool                       m_isAttractMode    = false;
+    Camera                     m_worldCamera;
+    Camera                     m_screenCamera;
+    Vec3                       m_viewPosition;                  // The RenderQueue sorts by distance from here
+    Mat44                      m_playerTransform;
+    std::vector<sSnapshotDraw> m_draws;
+    std::vector<Light>         m_lights;                        // Every light, so the render side can select per draw
+    uint32_t                   m_lightChangeCount = 0;          // LightSubsystem::GetChangeCount when m_lights was copied
+    DebugPrimitiveList         m_debugPrimitives;               // Added since the previous snapshot; windowed only
+};
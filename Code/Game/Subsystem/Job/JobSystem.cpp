@@ -0,0 +1,410 @@
+//----------------------------------------------------------------------------------------------------
+// JobSystem.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Job/JobSystem.hpp"
+
+#include <algorithm>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Game/Subsystem/Profile/Profiler.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Several JobSystems can exist at once (the scaling benchmarks build their own), so a worker
+// records which one it belongs to as well as its index.
+//
+static thread_local JobSystem const* t_workerJobSystem = nullptr;
+static thread_local int              t_workerIndex     = -1;
+
+//----------------------------------------------------------------------------------------------------
+// The last job reaches zero while it holds m_mutex, so a counter on the stack of a thread that saw
+// it done could otherwise be destroyed under that job's lock.
+//
+JobCounter::~JobCounter()
+{
+    std::lock_guard<std::mutex> const lock(m_mutex);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool JobCounter::IsDone() const
+{
+    return m_pendingCount.load(std::memory_order_acquire) == 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+JobSystem::JobSystem(sJobSystemConfig const& config)
+{
+    int workerCount = config.m_workerCount;
+
+    if (workerCount < 0)
+    {
+        int const hardwareThreadCount = static_cast<int>(std::thread::hardware_concurrency());
+        workerCount                   = std::max(hardwareThreadCount - 1, 1);
+    }
+
+    m_workers.reserve(static_cast<size_t>(workerCount));
+
+    for (int workerIndex = 0; workerIndex < workerCount; ++workerIndex)
+    {
+        m_workers.push_back(new sWorker());
+    }
+
+    // Started only once every deque exists, since workers steal from all of them
+    for (int workerIndex = 0; workerIndex < workerCount; ++workerIndex)
+    {
+        m_workers[workerIndex]->m_thread = std::thread(&JobSystem::RunWorker, this, workerIndex);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> const lock(m_sleepMutex);
+        m_isQuitting = true;
+    }
+
+    m_wakeCondition.notify_all();
+
+    for (sWorker* worker : m_workers)
+    {
+        worker->m_thread.join();
+    }
+
+    // With no workers, queued jobs only ever ran inside Wait
+    sJob job;
+
+    while (TryPopJob(job, true))
+    {
+        Execute(job);
+    }
+
+    for (sWorker*& worker : m_workers)
+    {
+        delete worker;
+        worker = nullptr;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void JobSystem::Run(std::function<void()> function, JobCounter* counter, JobCounter* dependency)
+{
+    sJob job;
+    job.m_function = std::move(function);
+    job.m_counter  = counter;
+
+    if (counter != nullptr)
+    {
+        counter->m_pendingCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (dependency != nullptr)
+    {
+        // Checked under the dependency's lock, which its last job takes before releasing the
+        // continuations, so the job is either parked in time or pushed here
+        std::lock_guard<std::mutex> const lock(dependency->m_mutex);
+
+        if (!dependency->IsDone())
+        {
+            dependency->m_continuations.push_back(std::move(job));
+            return;
+        }
+    }
+
+    Push(std::move(job));
+}
+
+//----------------------------------------------------------------------------------------------------
+void JobSystem::RunBackground(std::function<void()> function, JobCounter* counter)
+{
+    sJob job;
+    job.m_function     = std::move(function);
+    job.m_counter      = counter;
+    job.m_isBackground = true;
+
+    if (counter != nullptr)
+    {
+        counter->m_pendingCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Push(std::move(job));
+}
+
+//----------------------------------------------------------------------------------------------------
+// Background jobs are left to the workers, so waiting on one only ever costs the wait.
+//
+void JobSystem::Wait(JobCounter& counter)
+{
+    if (counter.IsDone())
+    {
+        return;
+    }
+
+    PROFILE_SCOPE("JobSystem::Wait");
+
+    sJob job;
+
+    while (!counter.IsDone())
+    {
+        if (TryPopJob(job, false))
+        {
+            Execute(job);
+        }
+        else
+        {
+            std::this_thread::yield();     // Everything left is running on other threads
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int JobSystem::GetWorkerCount() const
+{
+    return static_cast<int>(m_workers.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+int JobSystem::GetThreadCount() const
+{
+    return GetWorkerCount() + 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+sJobSystemStatistics JobSystem::GetStatistics() const
+{
+    sJobSystemStatistics statistics;
+    statistics.m_jobsRun    = m_jobsRun.load(std::memory_order_relaxed);
+    statistics.m_jobsStolen = m_jobsStolen.load(std::memory_order_relaxed);
+
+    return statistics;
+}
+
+//----------------------------------------------------------------------------------------------------
+void JobSystem::Push(sJob&& job)
+{
+    int const workerIndex = GetCurrentWorkerIndex();
+
+    if (job.m_isBackground)
+    {
+        std::lock_guard<std::mutex> const lock(m_sharedMutex);
+        m_backgroundJobs.push_back(std::move(job));
+    }
+    else if (workerIndex >= 0)
+    {
+        sWorker* const                    worker = m_workers[workerIndex];
+        std::lock_guard<std::mutex> const lock(worker->m_mutex);
+        worker->m_jobs.push_back(std::move(job));
+    }
+    else
+    {
+        std::lock_guard<std::mutex> const lock(m_sharedMutex);
+        m_sharedJobs.push_back(std::move(job));
+    }
+
+    m_queuedJobCount.fetch_add(1, std::memory_order_release);
+
+    // Taking the lock orders this with a worker that has just checked the count and is about to sleep
+    {
+        std::lock_guard<std::mutex> const lock(m_sleepMutex);
+    }
+
+    m_wakeCondition.notify_one();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Own deque newest first, then the shared queue, then the other workers' oldest jobs, starting with
+// the next worker along so thieves spread out instead of all hitting worker 0. Background jobs
+// come last, and only when the caller allows them.
+//
+bool JobSystem::TryPopJob(sJob& out_job, bool const isBackgroundAllowed)
+{
+    if (m_queuedJobCount.load(std::memory_order_acquire) == 0)
+    {
+        return false;
+    }
+
+    int const workerIndex = GetCurrentWorkerIndex();
+
+    if (workerIndex >= 0)
+    {
+        sWorker* const                    worker = m_workers[workerIndex];
+        std::lock_guard<std::mutex> const lock(worker->m_mutex);
+
+        if (!worker->m_jobs.empty())
+        {
+            out_job = std::move(worker->m_jobs.back());
+            worker->m_jobs.pop_back();
+            m_queuedJobCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> const lock(m_sharedMutex);
+
+        if (!m_sharedJobs.empty())
+        {
+            out_job = std::move(m_sharedJobs.front());
+            m_sharedJobs.pop_front();
+            m_queuedJobCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    int const workerCount = GetWorkerCount();
+
+    for (int offset = 1; offset <= workerCount; ++offset)
+    {
+        int const victimIndex = (workerIndex + offset + workerCount) % workerCount;
+
+        if (victimIndex == workerIndex)
+        {
+            continue;
+        }
+
+        sWorker* const                    victim = m_workers[victimIndex];
+        std::lock_guard<std::mutex> const lock(victim->m_mutex);
+
+        if (!victim->m_jobs.empty())
+        {
+            out_job = std::move(victim->m_jobs.front());
+            victim->m_jobs.pop_front();
+            m_queuedJobCount.fetch_sub(1, std::memory_order_relaxed);
+            m_jobsStolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    if (isBackgroundAllowed)
+    {
+        std::lock_guard<std::mutex> const lock(m_sharedMutex);
+
+        if (!m_backgroundJobs.empty())
+        {
+            out_job = std::move(m_backgroundJobs.front());
+            m_backgroundJobs.pop_front();
+            m_queuedJobCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The last job of a counter releases the jobs that depend on it.
+//
+void JobSystem::Execute(sJob& job)
+{
+    if (job.m_slotFunction != nullptr)
+    {
+        job.m_slotFunction(job.m_context, job.m_slot);
+    }
+    else
+    {
+        job.m_function();
+        job.m_function = nullptr;     // Releases captures now, not when the slot is next reused
+    }
+
+    m_jobsRun.fetch_add(1, std::memory_order_relaxed);
+
+    JobCounter* const counter = job.m_counter;
+
+    if (counter == nullptr)
+    {
+        return;
+    }
+
+    std::vector<sJob> continuations;
+
+    {
+        std::lock_guard<std::mutex> const lock(counter->m_mutex);
+
+        if (counter->m_pendingCount.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        {
+            return;
+        }
+
+        continuations.swap(counter->m_continuations);
+    }
+
+    for (sJob& continuation : continuations)
+    {
+        Push(std::move(continuation));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void JobSystem::RunWorker(int const workerIndex)
+{
+    t_workerJobSystem = this;
+    t_workerIndex     = workerIndex;
+
+    SetProfilerThreadName("Job worker");
+
+    sJob job;
+
+    for (;;)
+    {
+        if (TryPopJob(job, true))
+        {
+            Execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+
+        if (m_isQuitting && m_queuedJobCount.load(std::memory_order_acquire) == 0)
+        {
+            return;
+        }
+
+        m_wakeCondition.wait(lock, [this]() { return m_isQuitting || m_queuedJobCount.load(std::memory_order_acquire) > 0; });
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// The caller is slot 0 and needs no job; a helper that starts after the ranges ran out returns at
+// once, so asking for one per worker costs little when the loop turns out to be short.
+//
+void JobSystem::RunParallelFor(sParallelForContext& context, int const maxSlotCount)
+{
+    int const rangeCount = (context.m_count + context.m_grainSize - 1) / context.m_grainSize;
+    int const slotCount  = std::min(std::min(rangeCount, GetThreadCount()), maxSlotCount);
+
+    JobCounter counter;
+
+    for (int slot = 1; slot < slotCount; ++slot)
+    {
+        sJob job;
+        job.m_slotFunction = &JobSystem::RunParallelForSlot;
+        job.m_context      = &context;
+        job.m_slot         = slot;
+        job.m_counter      = &counter;
+
+        counter.m_pendingCount.fetch_add(1, std::memory_order_relaxed);
+        Push(std::move(job));
+    }
+
+    RunParallelForSlot(&context, 0);
+    Wait(counter);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void JobSystem::RunParallelForSlot(void const* context, int const slot)
+{
+    sParallelForContext& parallelFor = *static_cast<sParallelForContext*>(const_cast<void*>(context));
+
+    for (int begin = parallelFor.m_nextBegin.fetch_add(parallelFor.m_grainSize); begin < parallelFor.m_count; begin = parallelFor.m_nextBegin.fetch_add(parallelFor.m_grainSize))
+    {
+        int const end = std::min(begin + parallelFor.m_grainSize, parallelFor.m_count);
+        parallelFor.m_invoke(parallelFor.m_function, begin, end, slot);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int JobSystem::GetCurrentWorkerIndex() const
+{
+    return t_workerJobSystem == this ? t_workerIndex : -1;
+}
@@ -0,0 +1,222 @@
+//----------------------------------------------------------------------------------------------------
+// JobSystem.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+#include <climits>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class JobCounter;
+
+//----------------------------------------------------------------------------------------------------
+struct sJobSystemConfig
+{
+    int m_workerCount = -1;     // -1 sizes to the hardware: one worker per hardware thread but the caller's, and at least one
+};
+
+//----------------------------------------------------------------------------------------------------
+// Counted since construction.
+//
+struct sJobSystemStatistics
+{
+    uint64_t m_jobsRun    = 0;
+    uint64_t m_jobsStolen = 0;      // Taken from another worker's deque rather than the thread's own
+};
+
+//----------------------------------------------------------------------------------------------------
+using JobSlotFunction = void (*)(void const* context, int slot);
+
+//----------------------------------------------------------------------------------------------------
+// One unit of work: a function, or one slot of a ParallelFor.
+//
+struct sJob
+{
+    std::function<void()> m_function;
+    JobSlotFunction       m_slotFunction = nullptr;     // Set instead of m_function for ParallelFor slots
+    void const*           m_context      = nullptr;
+    int                   m_slot         = 0;
+    JobCounter*           m_counter      = nullptr;     // Told when the job finishes
+    bool                  m_isBackground = false;       // Only idle workers take it; see RunBackground
+};
+
+//----------------------------------------------------------------------------------------------------
+// Tracks a group of jobs: each Run that names it adds one, and it is done once all of them have
+// finished. Jobs can wait on a counter as a dependency. A counter must outlive its jobs and every
+// job depending on it, and should not gain new jobs once anything waits on it.
+//
+class JobCounter
+{
+public:
+    JobCounter() = default;
+    ~JobCounter();      // Waits out a job that is still releasing the counter after finishing
+
+    JobCounter(JobCounter const&)            = delete;
+    JobCounter& operator=(JobCounter const&) = delete;
+
+    bool IsDone() const;
+
+private:
+    friend class JobSystem;
+
+    std::atomic<int>  m_pendingCount = { 0 };
+    std::mutex        m_mutex;                  // Guards m_continuations
+    std::vector<sJob> m_continuations;          // Jobs depending on this counter, held until it is done
+};
+
+//----------------------------------------------------------------------------------------------------
+// Work-stealing scheduler shared by every system that runs work in parallel.
+//
+// Each worker owns a deque: it pushes and pops its own jobs at the back, newest first, while idle
+// workers steal from the front, oldest first, so a thief takes the biggest remaining piece and the
+// owner stays in cache. Threads that are not workers (the main thread, the render thread) submit
+// to a shared queue, and while they wait on a counter they run jobs themselves instead of blocking,
+// so waiting never deadlocks and the calling thread is never idle while its work is queued.
+//
+// ParallelFor splits [0, count) into grain-sized ranges that the caller and up to one helper job per
+// worker take from a shared cursor, so uneven ranges balance themselves. Each of them is a slot:
+// slots run one range at a time, so ParallelForSlots callers can keep per-slot scratch without locks.
+// A count of one grain or less runs on the caller with no jobs at all.
+//
+// Background jobs (RunBackground) are for long work such as decoding assets. Only workers with
+// nothing else to do take them, never a thread inside Wait, so a frame that waits on its own jobs
+// cannot get stuck behind a background job. They need a worker to run at all, which sizing to the
+// hardware always provides.
+//
+class JobSystem
+{
+public:
+    explicit JobSystem(sJobSystemConfig const& config = sJobSystemConfig());
+    ~JobSystem();       // Runs whatever is still queued, then joins the workers
+
+    JobSystem(JobSystem const&)            = delete;
+    JobSystem& operator=(JobSystem const&) = delete;
+
+    // `counter` (optional) counts this job; `dependency` (optional) holds it back until that
+    // counter is done
+    void Run(std::function<void()> function, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+    void RunBackground(std::function<void()> function, JobCounter* counter = nullptr);
+    void Wait(JobCounter& counter);     // Runs queued jobs on the calling thread until counter is done
+
+    // function(int begin, int end) over consecutive ranges covering [0, count)
+    template <typename Function>
+    void ParallelFor(int count, int grainSize, Function const& function);
+
+    // function(int begin, int end, int slot), with slot in [0, min(maxSlotCount, GetThreadCount()))
+    template <typename Function>
+    void ParallelForSlots(int count, int grainSize, int maxSlotCount, Function const& function);
+
+    int                  GetWorkerCount() const;
+    int                  GetThreadCount() const;       // Workers plus the caller: the most slots a ParallelFor uses
+    sJobSystemStatistics GetStatistics() const;
+
+private:
+    struct sWorker
+    {
+        std::mutex       m_mutex;               // Guards m_jobs; the owner and thieves both take it
+        std::deque<sJob> m_jobs;
+        std::thread      m_thread;
+    };
+
+    using RangeFunction = void (*)(void const* function, int begin, int end, int slot);
+
+    struct sParallelForContext
+    {
+        RangeFunction    m_invoke    = nullptr;     // Calls *m_function, whatever its type
+        void const*      m_function  = nullptr;
+        int              m_count     = 0;
+        int              m_grainSize = 1;
+        std::atomic<int> m_nextBegin = { 0 };
+    };
+
+    void Push(sJob&& job);
+    bool TryPopJob(sJob& out_job, bool isBackgroundAllowed);
+    void Execute(sJob& job);
+    void RunWorker(int workerIndex);
+    void RunParallelFor(sParallelForContext& context, int maxSlotCount);
+    int  GetCurrentWorkerIndex() const;     // -1 on threads that are not this system's workers
+
+    static void RunParallelForSlot(void const* context, int slot);
+
+    std::vector<sWorker*>   m_workers;                      // Owned
+    std::mutex              m_sharedMutex;                  // Guards m_sharedJobs
+    std::deque<sJob>        m_sharedJobs;                   // Submitted from threads that are not workers
+    std::deque<sJob>        m_backgroundJobs;               // Guarded by m_sharedMutex
+    std::atomic<int>        m_queuedJobCount = { 0 };       // In any deque, not yet popped
+    std::mutex              m_sleepMutex;
+    std::condition_variable m_wakeCondition;
+    bool                    m_isQuitting     = false;       // Guarded by m_sleepMutex
+    std::atomic<uint64_t>   m_jobsRun        = { 0 };
+    std::atomic<uint64_t>   m_jobsStolen     = { 0 };
+};
+
+//----------------------------------------------------------------------------------------------------
+template <typename Function>
+void JobSystem::ParallelFor(int const count, int const grainSize, Function const& function)
+{
+    ParallelForSlots(count, grainSize, INT_MAX, [&function](int const begin, int const end, int)
+    {
+        function(begin, end);
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename Function>
+void JobSystem::ParallelForSlots(int const count, int const grainSize, int const maxSlotCount, Function const& function)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    if (count <= grainSize || maxSlotCount <= 1)
+    {
+        function(0, count, 0);
+        return;
+    }
+
+    sParallelForContext context;
+    context.m_invoke    = [](void const* functionPointer, int const begin, int const end, int const slot) { (*static_cast<Function const*>(functionPointer))(begin, end, slot); };
+    context.m_function  = &function;
+    context.m_count     = count;
+    context.m_grainSize = grainSize > 0 ? grainSize : 1;
+
+    RunParallelFor(context, maxSlotCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+// The same loops on `jobSystem`, or on the caller alone when it is null, so code that parallelizes
+// through g_theJobSystem still runs in tools and benchmarks that start no App.
+//
+template <typename Function>
+void ParallelFor(JobSystem* jobSystem, int const count, int const grainSize, Function const& function)
+{
+    if (jobSystem == nullptr)
+    {
+        function(0, count > 0 ? count : 0);
+        return;
+    }
+
+    jobSystem->ParallelFor(count, grainSize, function);
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename Function>
+void ParallelForSlots(JobSystem* jobSystem, int const count, int const grainSize, int const maxSlotCount, Function const& function)
+{
+    if (jobSystem == nullptr)
+    {
+        function(0, count > 0 ? count : 0, 0);
+        return;
+    }
+
+    jobSystem->ParallelForSlots(count, grainSize, maxSlotCount, function);
+}
@@ -0,0 +1,111 @@
+//----------------------------------------------------------------------------------------------------
+// LightBinder.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Light/LightBinder.hpp"
+
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Subsystem/Render/RenderBackend.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void LightBinder::SetLights(Light const* lights, int const lightCount, uint32_t const changeCount)
+{
+    if (changeCount == m_changeCount)
+    {
+        return;
+    }
+
+    m_lights.assign(lights, lights + lightCount);
+    m_changeCount = changeCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void LightBinder::BindDefaultLights()
+{
+    int const       lightCount = static_cast<int>(m_lights.size());
+    sLightSelection defaultSelection;
+    defaultSelection.m_lightCount = lightCount < MAX_LIGHTS ? lightCount : MAX_LIGHTS;
+
+    for (int slot = 0; slot < defaultSelection.m_lightCount; ++slot)
+    {
+        defaultSelection.m_lightIndexes[slot] = slot;
+    }
+
+    UploadLightSet(defaultSelection);
+}
+
+//----------------------------------------------------------------------------------------------------
+void LightBinder::BindLightsForBounds(sBoundingSphere const& bounds, int const maxLights)
+{
+    if (m_lightSelectorChangeCount != m_changeCount)
+    {
+        m_lightSelector.Build(m_lights.data(), static_cast<int>(m_lights.size()));
+        m_lightSelectorChangeCount = m_changeCount;
+    }
+
+    sLightSelection selection;
+    m_statistics.m_lightsEvaluated += m_lightSelector.SelectLights(bounds, maxLights, selection);
+
+    UploadLightSet(selection);
+}
+
+//----------------------------------------------------------------------------------------------------
+void LightBinder::ResetStatistics()
+{
+    m_statistics = sLightStatistics();
+}
+
+//----------------------------------------------------------------------------------------------------
+sLightStatistics const& LightBinder::GetStatistics() const
+{
+    return m_statistics;
+}
+
+//----------------------------------------------------------------------------------------------------
+void LightBinder::SetBackendUploadsEnabled(bool const areEnabled)
+{
+    m_areBackendUploadsEnabled = areEnabled;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Consecutive draws lit by the same lights (or a frame where no light changed) reuse what the light
+// constants already hold. A selection that is a prefix of the lights is uploaded straight from them.
+//
+void LightBinder::UploadLightSet(sLightSelection const& selection)
+{
+    if (selection == m_uploadedSelection && m_uploadedChangeCount == m_changeCount)
+    {
+        ++m_statistics.m_lightSetUploadsSkipped;
+        return;
+    }
+
+    Light const* lights   = m_lights.data();
+    bool         isPrefix = true;
+
+    for (int slot = 0; slot < selection.m_lightCount; ++slot)
+    {
+        isPrefix = isPrefix && selection.m_lightIndexes[slot] == slot;
+    }
+
+    if (!isPrefix)
+    {
+        for (int slot = 0; slot < selection.m_lightCount; ++slot)
+        {
+            m_uploadBuffer[slot] = m_lights[selection.m_lightIndexes[slot]];
+        }
+
+        lights = m_uploadBuffer;
+    }
+
+    if (m_areBackendUploadsEnabled)
+    {
+        g_theRenderBackend->SetLightConstants(lights, selection.m_lightCount);
+    }
+
+    ++m_statistics.m_lightSetUploads;
+    m_statistics.m_lightBytesUploaded += sizeof(Light) * static_cast<size_t>(selection.m_lightCount);
+
+    m_uploadedSelection   = selection;
+    m_uploadedChangeCount = m_changeCount;
+}
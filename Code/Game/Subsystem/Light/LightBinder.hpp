@@ -0,0 +1,57 @@
+//----------------------------------------------------------------------------------------------------
+// LightBinder.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Renderer/Light.hpp"
+#include "Game/Subsystem/Light/LightSelector.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// What light binding cost this frame: how many lights per-draw selection scored and how often the
+// light constants actually changed. An upload-to-skip ratio near zero means most draws share one set.
+//
+struct sLightStatistics
+{
+    int    m_lightsEvaluated        = 0;     // Lights scored by per-draw selection
+    int    m_lightSetUploads        = 0;
+    int    m_lightSetUploadsSkipped = 0;     // The light constants already held exactly that set
+    size_t m_lightBytesUploaded     = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Chooses light sets and uploads them to g_theRenderBackend's light constants, skipping any upload
+// the constants already hold. It keeps its own copy of the lights, taken only when SetLights sees a
+// new change count, so the caller's range may move or be freed afterwards. That is what lets the
+// render side of a pipelined frame bind from a snapshot while the game edits the LightPool.
+//
+class LightBinder
+{
+public:
+    void SetLights(Light const* lights, int lightCount, uint32_t changeCount);
+    void BindDefaultLights();                                                     // The first MAX_LIGHTS lights
+    void BindLightsForBounds(sBoundingSphere const& bounds, int maxLights = MAX_LIGHTS);
+
+    void                    ResetStatistics();
+    sLightStatistics const& GetStatistics() const;
+
+    // Selection and statistics run as usual with uploads disabled; nothing reaches the backend
+    void SetBackendUploadsEnabled(bool areEnabled);
+
+private:
+    void UploadLightSet(sLightSelection const& selection);
+
+    std::vector<Light> m_lights;
+    uint32_t           m_changeCount              = UINT32_MAX;    // Of the lights m_lights was copied from
+    LightSelector      m_lightSelector;
+    uint32_t           m_lightSelectorChangeCount = UINT32_MAX;    // Built lazily, by the first selection after a change
+    sLightSelection    m_uploadedSelection;                        // What the light constants hold now
+    uint32_t           m_uploadedChangeCount      = UINT32_MAX;
+    Light              m_uploadBuffer[MAX_LIGHTS];
+    sLightStatistics   m_statistics;
+    bool               m_areBackendUploadsEnabled = true;
+};
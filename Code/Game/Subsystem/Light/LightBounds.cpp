@@ -0,0 +1,111 @@
+//----------------------------------------------------------------------------------------------------
+// LightBounds.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Light/LightBounds.hpp"
+
+#include <cmath>
+
+#include "Engine/Renderer/Light.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// A cone of half angle t and length r is bounded by the sphere through its apex and rim when t is
+// under 45 degrees, and by the sphere around its rim disc otherwise.
+//
+sBoundingSphere GetLightBoundingSphere(Light const& light)
+{
+    sBoundingSphere sphere;
+    sphere.m_center = light.m_worldPosition;
+    sphere.m_radius = light.m_outerRadius;
+
+    if (light.m_lightType == static_cast<int>(eLightType::SPOT) && light.m_outerConeAngle > 0.f)
+    {
+        float const cosHalfAngle = light.m_outerConeAngle;
+        Vec3 const  direction    = light.m_direction.GetNormalized();
+
+        if (cosHalfAngle < 0.70710678f)
+        {
+            sphere.m_center = sphere.m_center + direction * (light.m_outerRadius * cosHalfAngle);
+            sphere.m_radius = light.m_outerRadius * sqrtf(1.f - cosHalfAngle * cosHalfAngle);
+        }
+        else
+        {
+            sphere.m_radius = light.m_outerRadius / (2.f * cosHalfAngle);
+            sphere.m_center = sphere.m_center + direction * sphere.m_radius;
+        }
+    }
+
+    return sphere;
+}
+
+//----------------------------------------------------------------------------------------------------
+float GetLightInfluence(Light const& light, sBoundingSphere const& bounds)
+{
+    float const brightness = light.m_color.w * fmaxf(fmaxf(light.m_color.x, light.m_color.y), light.m_color.z);
+
+    if (light.m_lightType == static_cast<int>(eLightType::DIRECTIONAL))
+    {
+        return brightness;
+    }
+
+    Vec3 const  toBounds         = bounds.m_center - light.m_worldPosition;
+    float const distanceToCenter = sqrtf(toBounds.x * toBounds.x + toBounds.y * toBounds.y + toBounds.z * toBounds.z);
+    float const distance         = fmaxf(distanceToCenter - bounds.m_radius, 0.f);
+
+    if (distance >= light.m_outerRadius)
+    {
+        return 0.f;
+    }
+
+    // Same linear falloff from inner to outer radius as the shader's RangeMap
+    float distanceFalloff = 1.f;
+
+    if (distance > light.m_innerRadius)
+    {
+        distanceFalloff = (light.m_outerRadius - distance) / (light.m_outerRadius - light.m_innerRadius);
+    }
+
+    if (light.m_lightType != static_cast<int>(eLightType::SPOT))
+    {
+        return brightness * distanceFalloff;
+    }
+
+    // The range and cone tests below are each conservative, and can both pass for bounds that miss
+    // the cone entirely; anything outside the cone's bounding sphere is unlit
+    sBoundingSphere const coneBounds = GetLightBoundingSphere(light);
+    Vec3 const            toCone     = bounds.m_center - coneBounds.m_center;
+    float const           reach      = coneBounds.m_radius + bounds.m_radius;
+
+    if (toCone.x * toCone.x + toCone.y * toCone.y + toCone.z * toCone.z > reach * reach)
+    {
+        return 0.f;
+    }
+
+    if (distanceToCenter <= bounds.m_radius)
+    {
+        return brightness * distanceFalloff;
+    }
+
+    // The bounds subtend asin(radius / distance) around their center, so the point of the bounds
+    // closest to the spot axis is that much nearer to it than the center is
+    Vec3 const  direction         = light.m_direction.GetNormalized();
+    float const cosAngleToCenter  = (toBounds.x * direction.x + toBounds.y * direction.y + toBounds.z * direction.z) / distanceToCenter;
+    float const angleToCenter     = acosf(fminf(fmaxf(cosAngleToCenter, -1.f), 1.f));
+    float const angularRadius     = asinf(bounds.m_radius / distanceToCenter);
+    float const cosAngleToNearest = cosf(fmaxf(angleToCenter - angularRadius, 0.f));
+    float const coneRange         = light.m_innerConeAngle - light.m_outerConeAngle;
+    float       angularFalloff    = 1.f;
+
+    if (cosAngleToNearest <= light.m_outerConeAngle)
+    {
+        return 0.f;
+    }
+
+    if (coneRange > 0.f && cosAngleToNearest < light.m_innerConeAngle)
+    {
+        angularFalloff = (cosAngleToNearest - light.m_outerConeAngle) / coneRange;
+    }
+
+    return brightness * distanceFalloff * angularFalloff;
+}
@@ -0,0 +1,23 @@
+//----------------------------------------------------------------------------------------------------
+// LightBounds.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Game/Math/FrustumCulling.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+struct Light;
+
+//----------------------------------------------------------------------------------------------------
+// Smallest sphere around everything a point or spot light can reach: its range for a point light,
+// and the sphere around its cone for a spot light. Directional lights reach everything; don't ask.
+//
+sBoundingSphere GetLightBoundingSphere(Light const& light);
+
+//----------------------------------------------------------------------------------------------------
+// Upper bound on how brightly `light` can light anything inside `bounds`, using the same distance
+// and cone falloff as BlinnPhong.hlsl, evaluated at the closest point of the bounds. 0 when the light
+// cannot reach the bounds at all. Used to rank lights against each other, not as a lighting result.
+//
+float GetLightInfluence(Light const& light, sBoundingSphere const& bounds);
@@ -0,0 +1,453 @@
+//----------------------------------------------------------------------------------------------------
+// LightClusterGrid.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Light/LightClusterGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Subsystem/Light/LightBounds.hpp"
+#include "Game/Math/SIMD.hpp"
+#include "Game/Subsystem/Job/JobSystem.hpp"
+#include "Game/Subsystem/Profile/Profiler.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static_assert(sizeof(sLightClusterRecord) == sizeof(uint32_t) * 2, "sLightClusterRecord must match uint2 in HLSL");
+static_assert(sizeof(sLightClusterConstants) % 16 == 0, "sLightClusterConstants must be a whole number of constant buffer rows");
+
+//----------------------------------------------------------------------------------------------------
+// Below this many lights per extra job slot, handing slices to another thread costs more than the
+// binning it saves.
+//
+static int constexpr LIGHTS_PER_EXTRA_SLOT = 64;
+
+//----------------------------------------------------------------------------------------------------
+LightClusterGrid::LightClusterGrid(sLightClusterGridConfig const& config)
+    : m_config(config)
+{
+    GUARANTEE_OR_DIE(config.m_tileCountX > 0 && config.m_tileCountY > 0 && config.m_sliceCount > 0, "LightClusterGrid needs at least one cluster")
+    GUARANTEE_OR_DIE(config.m_workerCount > 0, "LightClusterGrid needs at least one job slot")
+
+    int const clusterCount = GetClusterCount();
+
+    m_clusterMinX.resize(clusterCount);
+    m_clusterMinY.resize(clusterCount);
+    m_clusterMinZ.resize(clusterCount);
+    m_clusterMaxX.resize(clusterCount);
+    m_clusterMaxY.resize(clusterCount);
+    m_clusterMaxZ.resize(clusterCount);
+    m_sliceDepths.resize(config.m_sliceCount + 1);
+    m_clusterRecords.resize(clusterCount);
+    m_sliceLightIndexes.resize(config.m_sliceCount);
+    m_binScratch.resize(config.m_workerCount);
+
+    m_constants.m_tileCountX = static_cast<uint32_t>(config.m_tileCountX);
+    m_constants.m_tileCountY = static_cast<uint32_t>(config.m_tileCountY);
+    m_constants.m_sliceCount = static_cast<uint32_t>(config.m_sliceCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+void LightClusterGrid::Update(Camera const& camera, float const viewportWidth, float const viewportHeight, Light const* lights, int const lightCount)
+{
+    Mat44 worldToRender = camera.GetCameraToRenderTransform();
+    worldToRender.Append(camera.GetWorldToCameraTransform());
+
+    Update(worldToRender, camera.GetRenderToClipTransform(), viewportWidth, viewportHeight, lights, lightCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+// `renderToClip` must be a D3D-style perspective projection (clip w = render z, depth 0 to 1); the
+// x/y scales and near/far planes are read back from it.
+//
+void LightClusterGrid::Update(Mat44 const& worldToRender, Mat44 const& renderToClip, float const viewportWidth, float const viewportHeight, Light const* lights, int const lightCount)
+{
+    float const* projection = renderToClip.m_values;
+    GUARANTEE_OR_DIE(projection[Mat44::Kw] == 1.f && projection[Mat44::Tw] == 0.f, "LightClusterGrid needs a perspective projection")
+
+    float const scaleX       = projection[Mat44::Ix];
+    float const scaleY       = projection[Mat44::Jy];
+    float const nearDistance = -projection[Mat44::Tz] / projection[Mat44::Kz];
+    float const farDistance  = projection[Mat44::Tz] / (1.f - projection[Mat44::Kz]);
+
+    if (scaleX != m_scaleX || scaleY != m_scaleY || nearDistance != m_nearDistance || farDistance != m_farDistance)
+    {
+        UpdateClusterBounds(scaleX, scaleY, nearDistance, farDistance);
+    }
+
+    m_constants.m_viewportWidth  = viewportWidth;
+    m_constants.m_viewportHeight = viewportHeight;
+
+    GatherLights(worldToRender, lights, lightCount);
+    BinSlices();
+}
+
+//----------------------------------------------------------------------------------------------------
+int LightClusterGrid::GetClusterIndex(int const tileX, int const tileY, int const slice) const
+{
+    return (slice * m_config.m_tileCountY + tileY) * m_config.m_tileCountX + tileX;
+}
+
+//----------------------------------------------------------------------------------------------------
+int LightClusterGrid::GetClusterCount() const
+{
+    return m_config.m_tileCountX * m_config.m_tileCountY * m_config.m_sliceCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The same lookup the pixel shader does, from render space instead of pixel coordinates.
+//
+int LightClusterGrid::GetClusterIndexForRenderPosition(Vec3 const& renderPosition) const
+{
+    if (renderPosition.z < m_nearDistance || renderPosition.z > m_farDistance)
+    {
+        return -1;
+    }
+
+    float const ndcX = m_scaleX * renderPosition.x / renderPosition.z;
+    float const ndcY = m_scaleY * renderPosition.y / renderPosition.z;
+
+    if (ndcX < -1.f || ndcX > 1.f || ndcY < -1.f || ndcY > 1.f)
+    {
+        return -1;
+    }
+
+    int const tileX = static_cast<int>((ndcX * 0.5f + 0.5f) * static_cast<float>(m_config.m_tileCountX));
+    int const tileY = static_cast<int>((ndcY * 0.5f + 0.5f) * static_cast<float>(m_config.m_tileCountY));
+    int const slice = static_cast<int>(logf(renderPosition.z) * m_constants.m_logDepthScale + m_constants.m_logDepthBias);
+
+    return GetClusterIndex(tileX < m_config.m_tileCountX ? tileX : m_config.m_tileCountX - 1,
+                           tileY < m_config.m_tileCountY ? tileY : m_config.m_tileCountY - 1,
+                           slice < 0 ? 0 : (slice < m_config.m_sliceCount ? slice : m_config.m_sliceCount - 1));
+}
+
+//----------------------------------------------------------------------------------------------------
+int LightClusterGrid::GetTotalLightAssignments() const
+{
+    return static_cast<int>(m_lightIndexes.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<sLightClusterRecord> const& LightClusterGrid::GetClusterRecords() const
+{
+    return m_clusterRecords;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<uint32_t> const& LightClusterGrid::GetLightIndexes() const
+{
+    return m_lightIndexes;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<Light> const& LightClusterGrid::GetLightBuffer() const
+{
+    return m_lightBuffer;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<Vec3> const& LightClusterGrid::GetLightRenderCenters() const
+{
+    return m_lightRenderCenters;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<float> const& LightClusterGrid::GetLightRenderRadii() const
+{
+    return m_lightRenderRadii;
+}
+
+//----------------------------------------------------------------------------------------------------
+sLightClusterConstants const& LightClusterGrid::GetShaderConstants() const
+{
+    return m_constants;
+}
+
+//----------------------------------------------------------------------------------------------------
+void LightClusterGrid::GetClusterBounds(int const clusterIndex, Vec3& out_mins, Vec3& out_maxs) const
+{
+    out_mins = Vec3(m_clusterMinX[clusterIndex], m_clusterMinY[clusterIndex], m_clusterMinZ[clusterIndex]);
+    out_maxs = Vec3(m_clusterMaxX[clusterIndex], m_clusterMaxY[clusterIndex], m_clusterMaxZ[clusterIndex]);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Slice k spans depths near * (far / near)^(k / sliceCount) to the next boundary, so clusters stay
+// roughly cube-shaped from near to far. A tile edge at ndc x is the plane x = ndc * z / scaleX, so
+// each cluster's box takes its x and y extents from both of its depth boundaries.
+//
+void LightClusterGrid::UpdateClusterBounds(float const scaleX, float const scaleY, float const nearDistance, float const farDistance)
+{
+    m_scaleX       = scaleX;
+    m_scaleY       = scaleY;
+    m_nearDistance = nearDistance;
+    m_farDistance  = farDistance;
+
+    float const logDepthRange    = logf(farDistance / nearDistance);
+    m_constants.m_logDepthScale  = static_cast<float>(m_config.m_sliceCount) / logDepthRange;
+    m_constants.m_logDepthBias   = -logf(nearDistance) * m_constants.m_logDepthScale;
+
+    for (int slice = 0; slice <= m_config.m_sliceCount; ++slice)
+    {
+        m_sliceDepths[slice] = nearDistance * expf(logDepthRange * static_cast<float>(slice) / static_cast<float>(m_config.m_sliceCount));
+    }
+
+    m_sliceDepths[m_config.m_sliceCount] = farDistance;
+
+    for (int slice = 0; slice < m_config.m_sliceCount; ++slice)
+    {
+        float const nearZ = m_sliceDepths[slice];
+        float const farZ  = m_sliceDepths[slice + 1];
+
+        for (int tileY = 0; tileY < m_config.m_tileCountY; ++tileY)
+        {
+            float const bottom = (-1.f + 2.f * static_cast<float>(tileY) / static_cast<float>(m_config.m_tileCountY)) / scaleY;
+            float const top    = (-1.f + 2.f * static_cast<float>(tileY + 1) / static_cast<float>(m_config.m_tileCountY)) / scaleY;
+
+            for (int tileX = 0; tileX < m_config.m_tileCountX; ++tileX)
+            {
+                float const left  = (-1.f + 2.f * static_cast<float>(tileX) / static_cast<float>(m_config.m_tileCountX)) / scaleX;
+                float const right = (-1.f + 2.f * static_cast<float>(tileX + 1) / static_cast<float>(m_config.m_tileCountX)) / scaleX;
+                int const   index = GetClusterIndex(tileX, tileY, slice);
+
+                m_clusterMinX[index] = fminf(left * nearZ, left * farZ);
+                m_clusterMaxX[index] = fmaxf(right * nearZ, right * farZ);
+                m_clusterMinY[index] = fminf(bottom * nearZ, bottom * farZ);
+                m_clusterMaxY[index] = fmaxf(top * nearZ, top * farZ);
+                m_clusterMinZ[index] = nearZ;
+                m_clusterMaxZ[index] = farZ;
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Moves each point or spot light's bounding sphere to render space, drops the ones outside the
+// frustum, and finds the tile and slice ranges the rest can touch.
+//
+void LightClusterGrid::GatherLights(Mat44 const& worldToRender, Light const* lights, int const lightCount)
+{
+    m_lightBuffer.clear();
+    m_lightRenderCenters.clear();
+    m_lightRenderRadii.clear();
+    m_lightBinBounds.clear();
+
+    float const tileCountX = static_cast<float>(m_config.m_tileCountX);
+    float const tileCountY = static_cast<float>(m_config.m_tileCountY);
+
+    for (int lightIndex = 0; lightIndex < lightCount; ++lightIndex)
+    {
+        Light const& light = lights[lightIndex];
+
+        if (light.m_lightType == static_cast<int>(eLightType::DIRECTIONAL))
+        {
+            continue;
+        }
+
+        sBoundingSphere const worldBounds = GetLightBoundingSphere(light);
+        float const           radius      = worldBounds.m_radius;
+
+        Vec3 const  center = worldToRender.TransformPosition3D(worldBounds.m_center);
+        float const minZ   = center.z - radius;
+        float const maxZ   = center.z + radius;
+
+        if (maxZ < m_nearDistance || minZ > m_farDistance)
+        {
+            continue;
+        }
+
+        // For z > 0, x / z over the sphere's box is extreme at the box corners; clipping the box at
+        // the near plane keeps the denominators positive and the range conservative.
+        float const nearZ   = minZ > m_nearDistance ? minZ : m_nearDistance;
+        float const minNdcX = m_scaleX * fminf((center.x - radius) / nearZ, (center.x - radius) / maxZ);
+        float const maxNdcX = m_scaleX * fmaxf((center.x + radius) / nearZ, (center.x + radius) / maxZ);
+        float const minNdcY = m_scaleY * fminf((center.y - radius) / nearZ, (center.y - radius) / maxZ);
+        float const maxNdcY = m_scaleY * fmaxf((center.y + radius) / nearZ, (center.y + radius) / maxZ);
+
+        if (maxNdcX < -1.f || minNdcX > 1.f || maxNdcY < -1.f || minNdcY > 1.f)
+        {
+            continue;
+        }
+
+        sLightBinBounds bounds;
+        bounds.m_firstTileX = static_cast<int>(floorf((fmaxf(minNdcX, -1.f) * 0.5f + 0.5f) * tileCountX));
+        bounds.m_lastTileX  = static_cast<int>(floorf((fminf(maxNdcX, 1.f) * 0.5f + 0.5f) * tileCountX));
+        bounds.m_firstTileY = static_cast<int>(floorf((fmaxf(minNdcY, -1.f) * 0.5f + 0.5f) * tileCountY));
+        bounds.m_lastTileY  = static_cast<int>(floorf((fminf(maxNdcY, 1.f) * 0.5f + 0.5f) * tileCountY));
+        bounds.m_firstSlice = static_cast<int>(floorf(logf(nearZ) * m_constants.m_logDepthScale + m_constants.m_logDepthBias));
+        bounds.m_lastSlice  = static_cast<int>(floorf(logf(fminf(maxZ, m_farDistance)) * m_constants.m_logDepthScale + m_constants.m_logDepthBias));
+
+        // The floors above can land one past the last tile or slice on the far boundary, and one
+        // before the first on the near one through rounding in logf
+        bounds.m_lastTileX  = bounds.m_lastTileX < m_config.m_tileCountX ? bounds.m_lastTileX : m_config.m_tileCountX - 1;
+        bounds.m_lastTileY  = bounds.m_lastTileY < m_config.m_tileCountY ? bounds.m_lastTileY : m_config.m_tileCountY - 1;
+        bounds.m_firstSlice = bounds.m_firstSlice > 0 ? bounds.m_firstSlice - 1 : 0;
+        bounds.m_lastSlice  = bounds.m_lastSlice + 1 < m_config.m_sliceCount ? bounds.m_lastSlice + 1 : m_config.m_sliceCount - 1;
+
+        m_lightBuffer.push_back(light);
+        m_lightRenderCenters.push_back(center);
+        m_lightRenderRadii.push_back(radius);
+        m_lightBinBounds.push_back(bounds);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Slices go out one at a time on g_theJobSystem, so the near slices that many lights overlap don't
+// all land on one thread; each job slot bins into its own scratch. Each slice fills its own index
+// list; the lists are then concatenated in slice order and the cluster records rebased onto the
+// combined list.
+//
+void LightClusterGrid::BinSlices()
+{
+    int const lightCount = static_cast<int>(m_lightBuffer.size());
+    int       slotCount  = 1 + lightCount / LIGHTS_PER_EXTRA_SLOT;
+    slotCount            = slotCount < m_config.m_workerCount ? slotCount : m_config.m_workerCount;
+
+    ParallelForSlots(g_theJobSystem, m_config.m_sliceCount, 1, slotCount, [this](int const firstSlice, int const endSlice, int const slot)
+    {
+        PROFILE_SCOPE("LightClusterGrid::BinSlices");
+
+        for (int slice = firstSlice; slice < endSlice; ++slice)
+        {
+            BinSlice(slice, m_binScratch[slot]);
+        }
+    });
+
+    size_t totalIndexCount = 0;
+
+    for (std::vector<uint32_t> const& sliceIndexes : m_sliceLightIndexes)
+    {
+        totalIndexCount += sliceIndexes.size();
+    }
+
+    m_lightIndexes.resize(totalIndexCount);
+
+    int const clustersPerSlice = m_config.m_tileCountX * m_config.m_tileCountY;
+    uint32_t  sliceBase        = 0;
+
+    for (int slice = 0; slice < m_config.m_sliceCount; ++slice)
+    {
+        std::vector<uint32_t> const& sliceIndexes = m_sliceLightIndexes[slice];
+
+        for (int clusterIndex = slice * clustersPerSlice; clusterIndex < (slice + 1) * clustersPerSlice; ++clusterIndex)
+        {
+            m_clusterRecords[clusterIndex].m_firstIndex += sliceBase;
+        }
+
+        std::copy(sliceIndexes.begin(), sliceIndexes.end(), m_lightIndexes.begin() + sliceBase);
+        sliceBase += static_cast<uint32_t>(sliceIndexes.size());
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Tests every light whose range covers this slice against the clusters in its tile range, then
+// counting-sorts the hits by tile so each cluster's lights end up contiguous, in light order.
+//
+void LightClusterGrid::BinSlice(int const slice, sBinScratch& scratch)
+{
+    int const clustersPerSlice = m_config.m_tileCountX * m_config.m_tileCountY;
+    int const sliceBase        = slice * clustersPerSlice;
+
+    std::vector<uint32_t>& tileCounts     = scratch.m_tileCounts;
+    std::vector<uint64_t>& tileLightPairs = scratch.m_tileLightPairs;
+    tileCounts.assign(static_cast<size_t>(clustersPerSlice), 0);
+    tileLightPairs.clear();
+
+    float const* minX = m_clusterMinX.data();
+    float const* minY = m_clusterMinY.data();
+    float const* minZ = m_clusterMinZ.data();
+    float const* maxX = m_clusterMaxX.data();
+    float const* maxY = m_clusterMaxY.data();
+    float const* maxZ = m_clusterMaxZ.data();
+
+    int const lightCount = static_cast<int>(m_lightBinBounds.size());
+
+    for (int lightIndex = 0; lightIndex < lightCount; ++lightIndex)
+    {
+        sLightBinBounds const& bounds = m_lightBinBounds[lightIndex];
+
+        if (slice < bounds.m_firstSlice || slice > bounds.m_lastSlice)
+        {
+            continue;
+        }
+
+        Vec3 const  center        = m_lightRenderCenters[lightIndex];
+        float const radiusSquared = m_lightRenderRadii[lightIndex] * m_lightRenderRadii[lightIndex];
+
+#if defined(GAME_SIMD_SSE)
+        __m128 const centerX        = _mm_set1_ps(center.x);
+        __m128 const centerY        = _mm_set1_ps(center.y);
+        __m128 const centerZ        = _mm_set1_ps(center.z);
+        __m128 const radiusSquared4 = _mm_set1_ps(radiusSquared);
+        __m128 const zero           = _mm_setzero_ps();
+#endif
+
+        for (int tileY = bounds.m_firstTileY; tileY <= bounds.m_lastTileY; ++tileY)
+        {
+            int const rowBase = tileY * m_config.m_tileCountX;
+            int       tileX   = bounds.m_firstTileX;
+
+#if defined(GAME_SIMD_SSE)
+            for (; tileX + 4 <= bounds.m_lastTileX + 1; tileX += 4)
+            {
+                int const index = sliceBase + rowBase + tileX;
+
+                // Distance from the center to each box, per axis: max(min - c, 0, c - max)
+                __m128 const dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minX + index), centerX), _mm_sub_ps(centerX, _mm_loadu_ps(maxX + index))), zero);
+                __m128 const dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minY + index), centerY), _mm_sub_ps(centerY, _mm_loadu_ps(maxY + index))), zero);
+                __m128 const dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minZ + index), centerZ), _mm_sub_ps(centerZ, _mm_loadu_ps(maxZ + index))), zero);
+
+                __m128 const distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+                int          hitBits         = _mm_movemask_ps(_mm_cmple_ps(distanceSquared, radiusSquared4));
+
+                for (int lane = 0; hitBits != 0; ++lane, hitBits >>= 1)
+                {
+                    if ((hitBits & 1) != 0)
+                    {
+                        uint32_t const tile = static_cast<uint32_t>(rowBase + tileX + lane);
+                        ++tileCounts[tile];
+                        tileLightPairs.push_back(static_cast<uint64_t>(tile) << 32 | static_cast<uint32_t>(lightIndex));
+                    }
+                }
+            }
+#endif
+
+            for (; tileX <= bounds.m_lastTileX; ++tileX)
+            {
+                int const   index = sliceBase + rowBase + tileX;
+                float const dx    = fmaxf(fmaxf(minX[index] - center.x, center.x - maxX[index]), 0.f);
+                float const dy    = fmaxf(fmaxf(minY[index] - center.y, center.y - maxY[index]), 0.f);
+                float const dz    = fmaxf(fmaxf(minZ[index] - center.z, center.z - maxZ[index]), 0.f);
+
+                if (dx * dx + dy * dy + dz * dz <= radiusSquared)
+                {
+                    uint32_t const tile = static_cast<uint32_t>(rowBase + tileX);
+                    ++tileCounts[tile];
+                    tileLightPairs.push_back(static_cast<uint64_t>(tile) << 32 | static_cast<uint32_t>(lightIndex));
+                }
+            }
+        }
+    }
+
+    uint32_t offset = 0;
+
+    for (int tile = 0; tile < clustersPerSlice; ++tile)
+    {
+        sLightClusterRecord& record = m_clusterRecords[sliceBase + tile];
+        record.m_firstIndex         = offset;
+        record.m_lightCount         = tileCounts[tile];
+        tileCounts[tile]            = offset;
+        offset += record.m_lightCount;
+    }
+
+    std::vector<uint32_t>& sliceIndexes = m_sliceLightIndexes[slice];
+    sliceIndexes.resize(tileLightPairs.size());
+
+    for (uint64_t const pair : tileLightPairs)
+    {
+        sliceIndexes[tileCounts[pair >> 32]++] = static_cast<uint32_t>(pair);
+    }
+}
@@ -0,0 +1,135 @@
+//----------------------------------------------------------------------------------------------------
+// LightClusterGrid.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Renderer/Light.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Camera;
+
+//----------------------------------------------------------------------------------------------------
+struct sLightClusterGridConfig
+{
+    int m_tileCountX  = 16;
+    int m_tileCountY  = 9;
+    int m_sliceCount  = 24;
+    int m_workerCount = 4;         // Most job slots binning slices at once on g_theJobSystem
+};
+
+//----------------------------------------------------------------------------------------------------
+// One cluster's lights: GetLightIndexes()[m_firstIndex .. m_firstIndex + m_lightCount), each an
+// index into GetLightBuffer(). Matches uint2 in HLSL.
+//
+struct sLightClusterRecord
+{
+    uint32_t m_firstIndex = 0;
+    uint32_t m_lightCount = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// What the pixel shader needs to find its cluster; matches ClusterConstants in BlinnPhong.hlsl.
+//   tile x  = pixel.x * tileCountX / viewportWidth
+//   tile y  = (1 - pixel.y / viewportHeight) * tileCountY      (row 0 is the bottom of the screen)
+//   slice   = log(renderDepth) * logDepthScale + logDepthBias  (render depth is SV_Position.w)
+//
+struct sLightClusterConstants
+{
+    float    m_viewportWidth  = 1.f;
+    float    m_viewportHeight = 1.f;
+    float    m_logDepthScale  = 0.f;
+    float    m_logDepthBias   = 0.f;
+    uint32_t m_tileCountX     = 0;
+    uint32_t m_tileCountY     = 0;
+    uint32_t m_sliceCount     = 0;
+    uint32_t m_padding        = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Clustered (froxel) light assignment on the CPU.
+//
+// The view frustum is split into screen tiles and exponentially spaced depth slices, and each
+// cluster gets the list of point and spot lights whose bounding sphere touches it. A pixel shader
+// then loops over its own cluster's short list instead of every light in the scene. Directional
+// lights touch every cluster, so they are left out and stay in the regular light constants.
+//
+// Update works in the camera's render space (x right, y up, z forward), bins slices across
+// up to m_workerCount job slots, and tests four clusters of a row at a time against each light with SSE.
+// Lists are rebuilt from scratch every frame; memory is reused between frames.
+//
+class LightClusterGrid
+{
+public:
+    explicit LightClusterGrid(sLightClusterGridConfig const& config = sLightClusterGridConfig());
+
+    void Update(Camera const& camera, float viewportWidth, float viewportHeight, Light const* lights, int lightCount);
+    void Update(Mat44 const& worldToRender, Mat44 const& renderToClip, float viewportWidth, float viewportHeight, Light const* lights, int lightCount);
+
+    int GetClusterIndex(int tileX, int tileY, int slice) const;
+    int GetClusterCount() const;
+    int GetClusterIndexForRenderPosition(Vec3 const& renderPosition) const;     // -1 outside the grid
+    int GetTotalLightAssignments() const;
+
+    std::vector<sLightClusterRecord> const& GetClusterRecords() const;
+    std::vector<uint32_t> const&            GetLightIndexes() const;
+    std::vector<Light> const&               GetLightBuffer() const;             // Point and spot lights in view
+    std::vector<Vec3> const&                GetLightRenderCenters() const;      // Bounding spheres, parallel to GetLightBuffer
+    std::vector<float> const&               GetLightRenderRadii() const;
+    sLightClusterConstants const&           GetShaderConstants() const;
+
+    // Cluster bounds in render space, for validation and debug drawing
+    void GetClusterBounds(int clusterIndex, Vec3& out_mins, Vec3& out_maxs) const;
+
+private:
+    struct sBinScratch
+    {
+        std::vector<uint32_t> m_tileCounts;
+        std::vector<uint64_t> m_tileLightPairs;     // Tile index in the high half, light index in the low half
+    };
+
+    struct sLightBinBounds
+    {
+        int m_firstSlice = 0;
+        int m_lastSlice  = -1;
+        int m_firstTileX = 0;
+        int m_lastTileX  = -1;
+        int m_firstTileY = 0;
+        int m_lastTileY  = -1;
+    };
+
+    void UpdateClusterBounds(float scaleX, float scaleY, float nearDistance, float farDistance);
+    void GatherLights(Mat44 const& worldToRender, Light const* lights, int lightCount);
+    void BinSlices();
+    void BinSlice(int slice, sBinScratch& scratch);
+
+    sLightClusterGridConfig            m_config;
+    sLightClusterConstants             m_constants;
+    float                              m_scaleX       = 0.f;     // Projection scales and planes the cluster bounds were built for
+    float                              m_scaleY       = 0.f;
+    float                              m_nearDistance = 0.f;
+    float                              m_farDistance  = 0.f;
+
+    // Cluster AABBs in render space, structure-of-arrays so a row of clusters loads into SSE lanes
+    std::vector<float>                 m_clusterMinX;
+    std::vector<float>                 m_clusterMinY;
+    std::vector<float>                 m_clusterMinZ;
+    std::vector<float>                 m_clusterMaxX;
+    std::vector<float>                 m_clusterMaxY;
+    std::vector<float>                 m_clusterMaxZ;
+    std::vector<float>                 m_sliceDepths;             // m_sliceCount + 1 slice boundaries
+
+    std::vector<Light>                 m_lightBuffer;
+    std::vector<Vec3>                  m_lightRenderCenters;
+    std::vector<float>                 m_lightRenderRadii;
+    std::vector<sLightBinBounds>       m_lightBinBounds;
+
+    std::vector<sLightClusterRecord>   m_clusterRecords;
+    std::vector<uint32_t>              m_lightIndexes;
+    std::vector<std::vector<uint32_t>> m_sliceLightIndexes;     // Per-slice output, concatenated after binning
+    std::vector<sBinScratch>           m_binScratch;            // One per job slot
+};
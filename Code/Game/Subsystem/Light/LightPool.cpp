@@ -0,0 +1,96 @@
+//----------------------------------------------------------------------------------------------------
+// LightPool.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Light/LightPool.hpp"
+
+//----------------------------------------------------------------------------------------------------
+LightHandle LightPool::AddLight(Light const& light)
+{
+    m_lights.push_back(light);
+    ++m_changeCount;
+
+    return m_slots.Add();
+}
+
+//----------------------------------------------------------------------------------------------------
+void LightPool::RemoveLight(LightHandle const handle)
+{
+    uint32_t denseIndex = 0;
+
+    if (!m_slots.Remove(handle, denseIndex))
+    {
+        return;
+    }
+
+    m_lights[denseIndex] = m_lights.back();
+    m_lights.pop_back();
+    ++m_changeCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void LightPool::Reserve(int const capacity)
+{
+    m_lights.reserve(static_cast<size_t>(capacity));
+    m_slots.Reserve(capacity);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Counts as one change, however many lights there were, so one re-upload covers it.
+//
+void LightPool::Clear()
+{
+    m_lights.clear();
+    m_slots.Clear();
+    ++m_changeCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool LightPool::IsAlive(LightHandle const handle) const
+{
+    return m_slots.IsAlive(handle);
+}
+
+//----------------------------------------------------------------------------------------------------
+// The caller may write through the pointer, so handing it out has to count as a change.
+//
+Light* LightPool::GetLight(LightHandle const handle)
+{
+    int const denseIndex = m_slots.GetDenseIndex(handle);
+
+    if (denseIndex < 0)
+    {
+        return nullptr;
+    }
+
+    ++m_changeCount;
+
+    return &m_lights[denseIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+Light const* LightPool::GetLight(LightHandle const handle) const
+{
+    int const denseIndex = m_slots.GetDenseIndex(handle);
+
+    return denseIndex >= 0 ? &m_lights[denseIndex] : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+int LightPool::GetCount() const
+{
+    return static_cast<int>(m_lights.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+Light const* LightPool::GetLights() const
+{
+    return m_lights.data();
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t LightPool::GetChangeCount() const
+{
+    return m_changeCount;
+}
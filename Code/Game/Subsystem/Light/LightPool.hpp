@@ -0,0 +1,48 @@
+//----------------------------------------------------------------------------------------------------
+// LightPool.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Renderer/Light.hpp"
+#include "Game/Framework/GenerationalSlotMap.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// What LightSubsystem::AddLight hands back. Game code keeps one for a light it will edit or remove
+// later, e.g. a muzzle flash; a handle whose light was removed just resolves to nullptr.
+//
+struct sLightHandleTag;
+using LightHandle = GenerationalHandle<sLightHandleTag>;
+
+//----------------------------------------------------------------------------------------------------
+// Lights stored by value, packed in [0, GetCount()) in the layout the light constants take, so the
+// whole range can be handed to an upload or to LightClusterGrid without gathering. Add and remove
+// are O(1) and allocate nothing once Reserve has covered the peak light count. Removing a light
+// reorders the range; anything that caches dense indices should watch GetChangeCount.
+//
+class LightPool
+{
+public:
+    LightHandle AddLight(Light const& light);
+    void        RemoveLight(LightHandle handle);
+    void        Reserve(int capacity);
+    void        Clear();
+
+    bool         IsAlive(LightHandle handle) const;
+    Light*       GetLight(LightHandle handle);               // nullptr once the light is removed; counts as a change
+    Light const* GetLight(LightHandle handle) const;
+    int          GetCount() const;
+    Light const* GetLights() const;                          // The packed range, GetCount() long
+
+    // Bumped by every add, remove, clear, and non-const GetLight, so anything built from the packed
+    // range (uploads, spatial indexes) can tell whether it is stale without comparing lights.
+    uint32_t GetChangeCount() const;
+
+private:
+    std::vector<Light>               m_lights;               // In the slot map's dense order
+    GenerationalSlotMap<LightHandle> m_slots;
+    uint32_t                         m_changeCount = 0;
+};
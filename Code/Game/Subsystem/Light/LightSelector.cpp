@@ -0,0 +1,131 @@
+//----------------------------------------------------------------------------------------------------
+// LightSelector.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Light/LightSelector.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Renderer/Light.hpp"
+#include "Game/Subsystem/Light/LightBounds.hpp"
+
+//----------------------------------------------------------------------------------------------------
+bool sLightSelection::operator==(sLightSelection const& other) const
+{
+    if (m_lightCount != other.m_lightCount)
+    {
+        return false;
+    }
+
+    for (int slot = 0; slot < m_lightCount; ++slot)
+    {
+        if (m_lightIndexes[slot] != other.m_lightIndexes[slot])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool sLightSelection::operator!=(sLightSelection const& other) const
+{
+    return !(*this == other);
+}
+
+//----------------------------------------------------------------------------------------------------
+void LightSelector::Build(Light const* lights, int const lightCount)
+{
+    m_lights     = lights;
+    m_lightCount = lightCount;
+
+    m_localLights.Clear();
+    m_directionalLights.clear();
+
+    for (int lightIndex = 0; lightIndex < lightCount; ++lightIndex)
+    {
+        if (lights[lightIndex].m_lightType == static_cast<int>(eLightType::DIRECTIONAL))
+        {
+            m_directionalLights.push_back(lightIndex);
+            continue;
+        }
+
+        sBoundingSphere const sphere  = GetLightBoundingSphere(lights[lightIndex]);
+        Vec3 const            extents = Vec3(sphere.m_radius, sphere.m_radius, sphere.m_radius);
+
+        m_localLights.CreateProxy(AABB3(sphere.m_center - extents, sphere.m_center + extents), lightIndex, true);
+    }
+
+    m_localLights.Rebuild();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Keeps the best `maxLights` seen so far in descending order; with at most MAX_LIGHTS of them an
+// insertion into a small array beats a heap.
+//
+int LightSelector::SelectLights(sBoundingSphere const& bounds, int const maxLights, sLightSelection& out_selection) const
+{
+    ASSERT_OR_DIE(maxLights >= 0 && maxLights <= MAX_LIGHTS, "LightSelector can select at most MAX_LIGHTS lights")
+
+    float influences[MAX_LIGHTS];
+    int   evaluatedCount = 0;
+
+    out_selection.m_lightCount = 0;
+
+    // Ties go to the lower light index, so the result does not depend on the tree's visit order
+    auto const isBetterThanSlot = [&](float const influence, int const lightIndex, int const slot)
+    {
+        return influence > influences[slot] || (influence == influences[slot] && lightIndex < out_selection.m_lightIndexes[slot]);
+    };
+
+    auto const scoreLight = [&](int const lightIndex)
+    {
+        ++evaluatedCount;
+
+        float const influence = GetLightInfluence(m_lights[lightIndex], bounds);
+
+        if (influence <= 0.f)
+        {
+            return;
+        }
+
+        int slot = out_selection.m_lightCount;
+
+        if (slot == maxLights)
+        {
+            if (slot == 0 || !isBetterThanSlot(influence, lightIndex, slot - 1))
+            {
+                return;
+            }
+
+            --slot;
+        }
+        else
+        {
+            ++out_selection.m_lightCount;
+        }
+
+        for (; slot > 0 && isBetterThanSlot(influence, lightIndex, slot - 1); --slot)
+        {
+            influences[slot]                   = influences[slot - 1];
+            out_selection.m_lightIndexes[slot] = out_selection.m_lightIndexes[slot - 1];
+        }
+
+        influences[slot]                   = influence;
+        out_selection.m_lightIndexes[slot] = lightIndex;
+    };
+
+    for (int const lightIndex : m_directionalLights)
+    {
+        scoreLight(lightIndex);
+    }
+
+    m_localLights.QuerySphere(bounds.m_center, bounds.m_radius, [&](int const proxyId)
+    {
+        scoreLight(m_localLights.GetUserData(proxyId));
+        return true;
+    });
+
+    return evaluatedCount;
+}
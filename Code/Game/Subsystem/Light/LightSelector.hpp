@@ -0,0 +1,51 @@
+//----------------------------------------------------------------------------------------------------
+// LightSelector.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Engine/Renderer/RenderCommon.hpp"
+#include "Game/Math/DynamicAABBTree.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+struct Light;
+
+//----------------------------------------------------------------------------------------------------
+// The lights one draw shades with, most influential first. Indexes are into the light range the
+// LightSelector was built from.
+//
+struct sLightSelection
+{
+    int m_lightCount                = 0;
+    int m_lightIndexes[MAX_LIGHTS] = {};
+
+    bool operator==(sLightSelection const& other) const;
+    bool operator!=(sLightSelection const& other) const;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Picks, per draw, the few lights that matter most to an object instead of giving every object the
+// same global list.
+//
+// Build indexes the point and spot lights' bounding spheres in a DynamicAABBTree, so SelectLights
+// only scores the lights whose range overlaps the object's bounds; directional lights reach
+// everything and are scored for every object. Lights are ranked by GetLightInfluence.
+// The selector keeps a pointer to the light range, which must outlive it and not change until the
+// next Build.
+//
+class LightSelector
+{
+public:
+    void Build(Light const* lights, int lightCount);
+
+    // Returns how many lights were scored
+    int SelectLights(sBoundingSphere const& bounds, int maxLights, sLightSelection& out_selection) const;
+
+private:
+    Light const*     m_lights     = nullptr;
+    int              m_lightCount = 0;
+    DynamicAABBTree  m_localLights;                  // Leaf user data is the light index
+    std::vector<int> m_directionalLights;
+};
@@ -5,10 +5,12 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Subsystem/Light/LightSubsystem.hpp"
 
+#include "Engine/Math/Vec2.hpp"
 #include "Engine/Renderer/Light.hpp"
 #include "Engine/Renderer/RenderCommon.hpp"
-#include "Engine/Renderer/Renderer.hpp"
 #include "Game/Framework/GameCommon.hpp"
+#include "Game/Subsystem/Light/LightClusterGrid.hpp"
+#include "Game/Subsystem/Profile/Profiler.hpp"
 
 //------------------------------------------------------------------------------------------------
 LightSubsystem::LightSubsystem()
@@ -23,8 +25,10 @@ LightSubsystem::LightSubsystem(sLightConfig const config)
 
 void LightSubsystem::StartUp()
 {
-    Light* light1 = new Light();
-    light1->SetType(eLightType::SPOT)
+    m_lights.Reserve(m_config.m_initialLightCapacity);
+
+    Light light1;
+    light1.SetType(eLightType::SPOT)
           .SetWorldPosition(Vec3(2.f, 2.f, 5.f))
           .SetRadius(0.5f, 15.f)
           .SetColor(Rgba8::CYAN.GetAsVec3())
@@ -32,16 +36,16 @@ void LightSubsystem::StartUp()
           .SetDirection(-Vec3::Z_BASIS)
           .SetConeAngles(CosDegrees(5.f), CosDegrees(25.f));
 
-    Light* light2 = new Light();
-    light2->SetType(eLightType::SPOT)
+    Light light2;
+    light2.SetType(eLightType::SPOT)
           .SetWorldPosition(Vec3(4, 4, 5))
           .SetRadius(0.5f, 15.f)
           .SetColorWithIntensity(Vec4(1.f, 0.f, 1.f, 8.f))
           .SetDirection(-Vec3::Z_BASIS)
           .SetConeAngles(CosDegrees(5.f), CosDegrees(25.f));
 
-    Light* light3 = new Light();
-    light3->SetType(eLightType::DIRECTIONAL)
+    Light light3;
+    light3.SetType(eLightType::DIRECTIONAL)
           .SetColor(Rgba8::WHITE.GetAsVec3())
           .SetIntensity(1.f)
           .SetDirection(Vec3(2.f, 1.f, -1.f).GetNormalized());
@@ -52,9 +56,16 @@ void LightSubsystem::StartUp()
     AddLight(light3);
 }
 
+// The first MAX_LIGHTS lights of the packed pool are the default set for draws that don't select
+// their own. Removing a light moves the last one into its place, so which lights make that set
+// changes as lights come and go; draws that need the right lights bind them by bounds instead.
 void LightSubsystem::BeginFrame()
 {
-    g_theRenderer->SetLightConstants(m_lights, GetLightCount());
+    PROFILE_SCOPE("LightSubsystem::BeginFrame");
+
+    m_binder.ResetStatistics();
+    SyncBinder();
+    m_binder.BindDefaultLights();
 }
 
 void LightSubsystem::Update()
@@ -67,48 +78,86 @@ void LightSubsystem::Render()
 
 void LightSubsystem::EndFrame()
 {
+    PROFILE_SCOPE("LightSubsystem::EndFrame");
 }
 
 void LightSubsystem::ShutDown()
 {
-    for (Light* light : m_lights)
-    {
-        GAME_SAFE_RELEASE(light);
-    }
+    m_lights.Clear();
+    GAME_SAFE_RELEASE(m_lightClusterGrid);
 }
 
-void LightSubsystem::AddLight(Light* light)
+LightHandle LightSubsystem::AddLight(Light const& light)
 {
-    if (m_lights.size() < MAX_LIGHTS)
-    {
-        if (light == nullptr) return;
-        m_lights.push_back(light);
-    }
+    return m_lights.AddLight(light);
 }
 
-void LightSubsystem::RemoveLight(int index)
+void LightSubsystem::RemoveLight(LightHandle const handle)
 {
-    if (index >= 0 && index < (int)m_lights.size())
-    {
-        m_lights.erase(m_lights.begin() + index);
-    }
+    m_lights.RemoveLight(handle);
 }
 
 void LightSubsystem::ClearLights()
 {
-    m_lights.clear();
+    m_lights.Clear();
+}
+
+Light* LightSubsystem::GetLight(LightHandle const handle)
+{
+    return m_lights.GetLight(handle);
+}
+
+int LightSubsystem::GetLightCount() const
+{
+    return m_lights.GetCount();
+}
+
+Light const* LightSubsystem::GetLights() const
+{
+    return m_lights.GetLights();
 }
 
-Light* LightSubsystem::GetLight(int index)
+uint32_t LightSubsystem::GetChangeCount() const
 {
-    if (index >= 0 && index < (int)m_lights.size())
+    return m_lights.GetChangeCount();
+}
+
+// The grid is only allocated by the first call, so a game that never clusters pays nothing for it.
+void LightSubsystem::UpdateLightClusters(Camera const& camera, Vec2 const& viewportDimensions)
+{
+    PROFILE_SCOPE("LightSubsystem::UpdateLightClusters");
+
+    if (m_lightClusterGrid == nullptr)
     {
-        return m_lights[index];
+        m_lightClusterGrid = new LightClusterGrid();
     }
-    return nullptr;
+
+    m_lightClusterGrid->Update(camera, viewportDimensions.x, viewportDimensions.y, m_lights.GetLights(), m_lights.GetCount());
 }
 
-int LightSubsystem::GetLightCount() const
+LightClusterGrid const* LightSubsystem::GetLightClusterGrid() const
+{
+    return m_lightClusterGrid;
+}
+
+void LightSubsystem::BindLightsForBounds(sBoundingSphere const& bounds, int const maxLights)
+{
+    SyncBinder();
+    m_binder.BindLightsForBounds(bounds, maxLights);
+}
+
+sLightStatistics const& LightSubsystem::GetFrameStatistics() const
+{
+    return m_binder.GetStatistics();
+}
+
+void LightSubsystem::SetBackendUploadsEnabled(bool const areEnabled)
+{
+    m_binder.SetBackendUploadsEnabled(areEnabled);
+}
+
+// Lights can be added, removed or edited between draws; the binder only copies them when they were.
+void LightSubsystem::SyncBinder()
 {
-    return (int)m_lights.size();
+    m_binder.SetLights(m_lights.GetLights(), m_lights.GetCount(), m_lights.GetChangeCount());
 }
@@ -4,14 +4,20 @@
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
-#include <vector>
+#include <cstddef>
+
+#include "Game/Subsystem/Light/LightBinder.hpp"
+#include "Game/Subsystem/Light/LightPool.hpp"
 
 //-Forward-Declaration--------------------------------------------------------------------------------
-struct Light;
+class Camera;
+class LightClusterGrid;
+struct Vec2;
 
 //----------------------------------------------------------------------------------------------------
 struct sLightConfig
 {
+    int m_initialLightCapacity = 256;     // Reserved up front so spawning short-lived lights never reallocates
 };
 
 //----------------------------------------------------------------------------------------------------
@@ -29,21 +35,46 @@ public:
     void EndFrame();
     void ShutDown();
 
-    // Light management
-    void   AddLight(Light* light);
-    void   RemoveLight(int index);
-    void   ClearLights();
-    Light* GetLight(int index);
-    int    GetLightCount() const;
+    // Light management. Lights are stored by value in a LightPool; AddLight copies the light in and
+    // the handle stays valid until RemoveLight or ClearLights, however many lights come and go.
+    LightHandle  AddLight(Light const& light);
+    void         RemoveLight(LightHandle handle);
+    void         ClearLights();
+    Light*       GetLight(LightHandle handle);     // nullptr once the light is removed
+    int          GetLightCount() const;
+    Light const* GetLights() const;                // Packed, GetLightCount() long; order changes on remove
+    uint32_t     GetChangeCount() const;           // Changes whenever any light is added, removed or edited
+
+    // Clustered lighting: bins point and spot lights by screen tile and depth slice for the camera,
+    // so the light count is not limited by MAX_LIGHTS. Nothing calls it per frame yet: its buffers
+    // need structured buffer binding, which the Engine Renderer lacks, before BlinnPhong's
+    // CLUSTERED_LIGHTING path can read them. GetLightClusterGrid is null until the first update.
+    void                    UpdateLightClusters(Camera const& camera, Vec2 const& viewportDimensions);
+    LightClusterGrid const* GetLightClusterGrid() const;
 
+    // Per-draw lights: binds the (at most maxLights) lights that reach `bounds` most strongly, instead
+    // of the global first MAX_LIGHTS that BeginFrame binds. The light constants are only uploaded
+    // when the selected set, or any light, changed since the last upload. Game frames bind from their
+    // render snapshot through a LightBinder instead, once per RenderQueue batch.
+    void                    BindLightsForBounds(sBoundingSphere const& bounds, int maxLights = MAX_LIGHTS);
+    sLightStatistics const& GetFrameStatistics() const;
 
     // Update and bind
     void UpdateLightConstants();
     void BindLightConstants();
 
+    // With uploads disabled, light selection and its statistics run as usual but nothing reaches
+    // g_theRenderBackend; headless frames carry their lights to the render side in a sRenderSnapshot,
+    // where a LightBinder of the App's binds them.
+    void SetBackendUploadsEnabled(bool areEnabled);
+
 private:
-    sLightConfig        m_config;
-    std::vector<Light*> m_lights;
+    void SyncBinder();
+
+    sLightConfig      m_config;
+    LightPool         m_lights;
+    LightClusterGrid* m_lightClusterGrid = nullptr;     // Created by the first UpdateLightClusters
+    LightBinder       m_binder;
 
     // LightConstants* m_lightConstants = nullptr;
     // ConstantBuffer* m_lightCBO = nullptr;
@@ -0,0 +1,98 @@
+//----------------------------------------------------------------------------------------------------
+// FrameTimeStatistics.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Profile/FrameTimeStatistics.hpp"
+
+#include <algorithm>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+//----------------------------------------------------------------------------------------------------
+FrameTimeStatistics::FrameTimeStatistics(int const windowSize)
+{
+    GUARANTEE_OR_DIE(windowSize > 0, "FrameTimeStatistics needs a window of at least one frame");
+
+    m_frameMilliseconds.resize(static_cast<size_t>(windowSize), 0.f);
+    m_sortedMilliseconds.resize(static_cast<size_t>(windowSize), 0.f);
+}
+
+//----------------------------------------------------------------------------------------------------
+void FrameTimeStatistics::AddFrame(float const frameSeconds)
+{
+    int const windowSize = GetWindowSize();
+
+    m_frameMilliseconds[m_nextIndex] = frameSeconds * 1000.f;
+    m_nextIndex                      = (m_nextIndex + 1) % windowSize;
+    m_frameCount                     = m_frameCount < windowSize ? m_frameCount + 1 : windowSize;
+
+    UpdateSummary();
+}
+
+//----------------------------------------------------------------------------------------------------
+void FrameTimeStatistics::Clear()
+{
+    m_nextIndex  = 0;
+    m_frameCount = 0;
+    m_summary    = sFrameTimeSummary();
+}
+
+//----------------------------------------------------------------------------------------------------
+int FrameTimeStatistics::GetWindowSize() const
+{
+    return static_cast<int>(m_frameMilliseconds.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+int FrameTimeStatistics::GetFrameCount() const
+{
+    return m_frameCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+float FrameTimeStatistics::GetFrameMilliseconds(int const age) const
+{
+    int const windowSize = GetWindowSize();
+
+    return m_frameMilliseconds[(m_nextIndex - 1 - age + windowSize * 2) % windowSize];
+}
+
+//----------------------------------------------------------------------------------------------------
+sFrameTimeSummary const& FrameTimeStatistics::GetSummary() const
+{
+    return m_summary;
+}
+
+//----------------------------------------------------------------------------------------------------
+// A full sort of a few hundred floats is cheaper than it sounds, and gives every percentile from
+// one pass.
+//
+void FrameTimeStatistics::UpdateSummary()
+{
+    float totalMilliseconds = 0.f;
+
+    for (int age = 0; age < m_frameCount; ++age)
+    {
+        float const milliseconds = GetFrameMilliseconds(age);
+
+        m_sortedMilliseconds[age]  = milliseconds;
+        totalMilliseconds         += milliseconds;
+    }
+
+    std::sort(m_sortedMilliseconds.begin(), m_sortedMilliseconds.begin() + m_frameCount);
+
+    auto const getPercentile = [this](int const percent)
+    {
+        int const rank = (m_frameCount * percent + 99) / 100;      // ceil(n * p), 1-based
+        return m_sortedMilliseconds[rank > 0 ? rank - 1 : 0];
+    };
+
+    m_summary.m_frameCount          = m_frameCount;
+    m_summary.m_minMilliseconds     = m_sortedMilliseconds[0];
+    m_summary.m_maxMilliseconds     = m_sortedMilliseconds[m_frameCount - 1];
+    m_summary.m_averageMilliseconds = totalMilliseconds / static_cast<float>(m_frameCount);
+    m_summary.m_p50Milliseconds     = getPercentile(50);
+    m_summary.m_p95Milliseconds     = getPercentile(95);
+    m_summary.m_p99Milliseconds     = getPercentile(99);
+}
@@ -0,0 +1,48 @@
+//----------------------------------------------------------------------------------------------------
+// FrameTimeStatistics.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// Over the frames currently in the window. Percentiles are nearest-rank, so p99 of 100 frames is the
+// second slowest one.
+//
+struct sFrameTimeSummary
+{
+    int   m_frameCount          = 0;
+    float m_minMilliseconds     = 0.f;
+    float m_averageMilliseconds = 0.f;
+    float m_p50Milliseconds     = 0.f;
+    float m_p95Milliseconds     = 0.f;
+    float m_p99Milliseconds     = 0.f;
+    float m_maxMilliseconds     = 0.f;
+};
+
+//----------------------------------------------------------------------------------------------------
+// A rolling window of the last `windowSize` frame times. Both buffers are allocated in the
+// constructor, so adding frames and summarizing them never allocates.
+//
+class FrameTimeStatistics
+{
+public:
+    explicit FrameTimeStatistics(int windowSize = 240);
+
+    void                     AddFrame(float frameSeconds);
+    void                     Clear();
+    int                      GetWindowSize() const;
+    int                      GetFrameCount() const;
+    float                    GetFrameMilliseconds(int age) const;      // 0 is the newest frame
+    sFrameTimeSummary const& GetSummary() const;                       // As of the last AddFrame
+
+private:
+    void UpdateSummary();
+
+    std::vector<float> m_frameMilliseconds;      // Ring of frame times
+    std::vector<float> m_sortedMilliseconds;     // Scratch for the percentiles
+    int                m_nextIndex  = 0;
+    int                m_frameCount = 0;
+    sFrameTimeSummary  m_summary;
+};
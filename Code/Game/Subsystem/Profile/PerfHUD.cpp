@@ -0,0 +1,215 @@
+//----------------------------------------------------------------------------------------------------
+// PerfHUD.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Profile/PerfHUD.hpp"
+
+#include <cstdio>
+
+#include "Engine/Platform/Window.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Subsystem/Profile/Profiler.hpp"
+#include "Game/Subsystem/Render/GlyphFont.hpp"
+#include "Game/Subsystem/Render/PipelineState.hpp"
+#include "Game/Subsystem/Render/RenderBackend.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr   TEXT_LINE_CAPACITY = 96;
+static float constexpr TEXT_CELL_HEIGHT   = 14.f;
+static float constexpr TEXT_CELL_ASPECT   = 0.6f;
+static float constexpr PANEL_WIDTH        = 540.f;
+static float constexpr PANEL_MARGIN       = 10.f;
+static float constexpr PANEL_PADDING      = 8.f;
+static float constexpr GRAPH_HEIGHT       = 100.f;
+static float constexpr LINE_SPACING       = TEXT_CELL_HEIGHT + 4.f;
+static float constexpr MILLISECONDS_60HZ  = 1000.f / 60.f;
+static float constexpr MILLISECONDS_30HZ  = 1000.f / 30.f;
+
+//----------------------------------------------------------------------------------------------------
+PerfHUD::PerfHUD(sPerfHUDConfig const& config)
+    : m_config(config),
+      m_frameTimes(config.m_windowSize)
+{
+    m_shapeVertexes.reserve(static_cast<size_t>(m_config.m_maxVertexes));
+    m_textVertexes.reserve(static_cast<size_t>(m_config.m_maxVertexes));
+    m_textLine.reserve(TEXT_LINE_CAPACITY);
+
+    sPipelineStateDesc pipelineDesc;
+    pipelineDesc.m_blendMode      = eRenderBlendMode::ALPHA;
+    pipelineDesc.m_rasterizerMode = eRenderRasterizerMode::SOLID_CULL_NONE;
+    pipelineDesc.m_samplerMode    = eRenderSamplerMode::BILINEAR_CLAMP;
+    pipelineDesc.m_depthMode      = eRenderDepthMode::DISABLED;
+    m_pipeline                    = g_theRenderBackend->CreateOrGetPipelineState(pipelineDesc);
+
+    Vec2 const clientDimensions = Window::s_mainWindow != nullptr ? Window::s_mainWindow->GetClientDimensions() : Vec2(1600.f, 800.f);
+
+    m_camera.SetOrthoGraphicView(Vec2::ZERO, clientDimensions);
+    m_camera.SetNormalizedViewport(AABB2::ZERO_TO_ONE);
+}
+
+//----------------------------------------------------------------------------------------------------
+PerfHUD::~PerfHUD()
+{
+    SetVisible(false);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Lines are formatted into a stack buffer rather than with Stringf, which would allocate per line.
+//
+void PerfHUD::Update(float const systemDeltaSeconds)
+{
+    PROFILE_SCOPE("PerfHUD::Update");
+
+    if (systemDeltaSeconds > 0.f)
+    {
+        m_frameTimes.AddFrame(systemDeltaSeconds);
+    }
+
+    if (!m_isVisible)
+    {
+        return;
+    }
+
+    m_shapeVertexes.clear();
+    m_textVertexes.clear();
+
+    sFrameTimeSummary const&     frames  = m_frameTimes.GetSummary();
+    sProfilerFrameSummary const& scopes  = GetProfilerFrameSummary();
+    int const                    rows    = m_config.m_breakdownScopeCount < scopes.m_scopeCount ? m_config.m_breakdownScopeCount : scopes.m_scopeCount;
+    float const                  top     = m_camera.GetOrthographicTopRight().y - PANEL_MARGIN;
+    int const                    lines   = 3 + rows + (scopes.m_skippedScopeCount > 0 ? 1 : 0);
+    float const                  height  = PANEL_PADDING * 4.f + LINE_SPACING * static_cast<float>(lines) + GRAPH_HEIGHT;
+    AABB2 const                  panel   = AABB2(Vec2(PANEL_MARGIN, top - height), Vec2(PANEL_MARGIN + PANEL_WIDTH, top));
+    float const                  left    = panel.m_mins.x + PANEL_PADDING;
+    float                        lineTop = top - PANEL_PADDING;
+
+    AddVertsForAABB2D(m_shapeVertexes, panel, Rgba8(0, 0, 0, 160));
+
+    char        line[TEXT_LINE_CAPACITY];
+    float const averageFramesPerSecond = frames.m_averageMilliseconds > 0.f ? 1000.f / frames.m_averageMilliseconds : 0.f;
+
+    snprintf(line, sizeof(line), "Frame %6.2f ms avg  %6.1f fps  (%d frames)", frames.m_averageMilliseconds, averageFramesPerSecond, frames.m_frameCount);
+    lineTop -= LINE_SPACING;
+    AddTextLine(Vec2(left, lineTop), TEXT_CELL_HEIGHT, Rgba8::WHITE, line);
+
+    snprintf(line, sizeof(line), "min %6.2f  p50 %6.2f  p95 %6.2f  p99 %6.2f  max %6.2f", frames.m_minMilliseconds, frames.m_p50Milliseconds, frames.m_p95Milliseconds, frames.m_p99Milliseconds, frames.m_maxMilliseconds);
+    lineTop -= LINE_SPACING;
+    AddTextLine(Vec2(left, lineTop), TEXT_CELL_HEIGHT, Rgba8::WHITE, line);
+
+    lineTop -= PANEL_PADDING + GRAPH_HEIGHT;
+    AddGraph(AABB2(Vec2(left, lineTop), Vec2(panel.m_maxs.x - PANEL_PADDING, lineTop + GRAPH_HEIGHT)));
+
+    snprintf(line, sizeof(line), "Last frame per scope, inclusive        ms  calls");
+    lineTop -= LINE_SPACING + PANEL_PADDING;
+    AddTextLine(Vec2(left, lineTop), TEXT_CELL_HEIGHT, Rgba8::YELLOW, line);
+
+    for (int row = 0; row < rows; ++row)
+    {
+        sProfilerScopeTotal const& scope = scopes.m_scopes[row];
+
+        snprintf(line, sizeof(line), "%-34.34s %7.2f %6d", scope.m_name, scope.m_milliseconds, scope.m_callCount);
+        lineTop -= LINE_SPACING;
+        AddTextLine(Vec2(left, lineTop), TEXT_CELL_HEIGHT, Rgba8::WHITE, line);
+    }
+
+    if (scopes.m_skippedScopeCount > 0)
+    {
+        snprintf(line, sizeof(line), "(%d scopes past the %d-name summary limit)", scopes.m_skippedScopeCount, MAX_PROFILER_SUMMARY_SCOPES);
+        lineTop -= LINE_SPACING;
+        AddTextLine(Vec2(left, lineTop), TEXT_CELL_HEIGHT, Rgba8::RED, line);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void PerfHUD::Render() const
+{
+    if (!m_isVisible)
+    {
+        return;
+    }
+
+    g_theRenderBackend->BeginCamera(m_camera);
+    g_theRenderBackend->SetModelConstants();
+    g_theRenderBackend->BindPipelineState(m_pipeline);
+    g_theRenderBackend->BindTexture(nullptr);
+    g_theRenderBackend->DrawVertexArray(static_cast<int>(m_shapeVertexes.size()), m_shapeVertexes.data());
+    g_theRenderBackend->BindTexture(g_theGlyphFont->GetTexture());
+    g_theRenderBackend->DrawVertexArray(static_cast<int>(m_textVertexes.size()), m_textVertexes.data());
+    g_theRenderBackend->EndCamera(m_camera);
+}
+
+//----------------------------------------------------------------------------------------------------
+// The frame summary costs a recorded scope per marker, so it only runs while the overlay shows it.
+//
+void PerfHUD::SetVisible(bool const isVisible)
+{
+    m_isVisible = isVisible;
+    SetProfilerFrameSummaryEnabled(isVisible);
+}
+
+//----------------------------------------------------------------------------------------------------
+void PerfHUD::ToggleVisible()
+{
+    SetVisible(!m_isVisible);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool PerfHUD::IsVisible() const
+{
+    return m_isVisible;
+}
+
+//----------------------------------------------------------------------------------------------------
+FrameTimeStatistics const& PerfHUD::GetFrameTimeStatistics() const
+{
+    return m_frameTimes;
+}
+
+//----------------------------------------------------------------------------------------------------
+// One bar per frame in the window, newest on the right, with guides at 60 Hz and 30 Hz.
+//
+void PerfHUD::AddGraph(AABB2 const& bounds)
+{
+    int const    windowSize  = m_frameTimes.GetWindowSize();
+    float const  barWidth    = (bounds.m_maxs.x - bounds.m_mins.x) / static_cast<float>(windowSize);
+    float const  graphHeight = bounds.m_maxs.y - bounds.m_mins.y;
+    size_t const capacity    = static_cast<size_t>(m_config.m_maxVertexes);
+
+    AddVertsForAABB2D(m_shapeVertexes, bounds, Rgba8(255, 255, 255, 24));
+
+    for (int age = 0; age < m_frameTimes.GetFrameCount() && m_shapeVertexes.size() + 6 <= capacity; ++age)
+    {
+        float const milliseconds = m_frameTimes.GetFrameMilliseconds(age);
+        float const fraction     = milliseconds < m_config.m_graphMaxMilliseconds ? milliseconds / m_config.m_graphMaxMilliseconds : 1.f;
+        float const barRight     = bounds.m_maxs.x - barWidth * static_cast<float>(age);
+        Rgba8 const color        = milliseconds <= MILLISECONDS_60HZ ? Rgba8::GREEN : (milliseconds <= MILLISECONDS_30HZ ? Rgba8::YELLOW : Rgba8::RED);
+
+        AddVertsForAABB2D(m_shapeVertexes, AABB2(Vec2(barRight - barWidth, bounds.m_mins.y), Vec2(barRight, bounds.m_mins.y + graphHeight * fraction)), color);
+    }
+
+    for (float const guideMilliseconds : { MILLISECONDS_60HZ, MILLISECONDS_30HZ })
+    {
+        if (guideMilliseconds >= m_config.m_graphMaxMilliseconds || m_shapeVertexes.size() + 6 > capacity)
+        {
+            continue;
+        }
+
+        float const guideY = bounds.m_mins.y + graphHeight * guideMilliseconds / m_config.m_graphMaxMilliseconds;
+
+        AddVertsForAABB2D(m_shapeVertexes, AABB2(Vec2(bounds.m_mins.x, guideY), Vec2(bounds.m_maxs.x, guideY + 1.f)), Rgba8(255, 255, 255, 128));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void PerfHUD::AddTextLine(Vec2 const& position, float const cellHeight, Rgba8 const& color, char const* text)
+{
+    m_textLine.assign(text);
+
+    if (m_textVertexes.size() + m_textLine.size() * 6 > static_cast<size_t>(m_config.m_maxVertexes))
+    {
+        return;
+    }
+
+    g_theGlyphFont->AddVertsForText2D(m_textVertexes, position, cellHeight, m_textLine, color, TEXT_CELL_ASPECT);
+}
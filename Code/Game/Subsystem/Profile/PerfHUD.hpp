@@ -0,0 +1,58 @@
+//----------------------------------------------------------------------------------------------------
+// PerfHUD.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include "Game/Subsystem/Profile/FrameTimeStatistics.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class PipelineState;
+
+//----------------------------------------------------------------------------------------------------
+struct sPerfHUDConfig
+{
+    int   m_windowSize           = 240;       // Frames in the rolling statistics and the graph
+    int   m_breakdownScopeCount  = 12;        // Slowest profiler scopes listed under the graph
+    float m_graphMaxMilliseconds = 50.f;      // Frame time at the top of the graph
+    int   m_maxVertexes          = 16384;     // Reserved up front; lines that would not fit are left out
+};
+
+//----------------------------------------------------------------------------------------------------
+// Frame-time overlay: min, average, p50, p95 and p99 over a rolling window of system-clock frame
+// times, a graph of that window, and the last frame's time per profiler scope.
+//
+// Frame times are recorded whether or not it is visible. While it is visible the profiler's frame
+// summary is on, and Update rebuilds the overlay into vertex lists reserved in the constructor, so
+// showing it adds no per-frame allocations of its own.
+//
+class PerfHUD
+{
+public:
+    explicit PerfHUD(sPerfHUDConfig const& config = sPerfHUDConfig());
+    ~PerfHUD();
+
+    void Update(float systemDeltaSeconds);
+    void Render() const;
+
+    void                       SetVisible(bool isVisible);
+    void                       ToggleVisible();
+    bool                       IsVisible() const;
+    FrameTimeStatistics const& GetFrameTimeStatistics() const;
+
+private:
+    void AddGraph(AABB2 const& bounds);
+    void AddTextLine(Vec2 const& position, float cellHeight, Rgba8 const& color, char const* text);
+
+    sPerfHUDConfig       m_config;
+    FrameTimeStatistics  m_frameTimes;
+    Camera               m_camera;
+    PipelineState const* m_pipeline  = nullptr;
+    VertexList_PCU       m_shapeVertexes;           // Untextured: panel, graph bars and guides
+    VertexList_PCU       m_textVertexes;            // Bitmap font glyphs
+    String               m_textLine;                // Reserved, so assigning a line never allocates
+    bool                 m_isVisible = false;
+};
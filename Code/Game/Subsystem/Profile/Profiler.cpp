@@ -0,0 +1,590 @@
+//----------------------------------------------------------------------------------------------------
+// Profiler.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Profile/Profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+#if defined(_WIN32)
+#include "Engine/Core/DevConsole.hpp"
+#endif
+
+//----------------------------------------------------------------------------------------------------
+std::atomic<bool> g_isProfilerRecording(false);
+
+//----------------------------------------------------------------------------------------------------
+struct sProfileEvent
+{
+    char const* m_name       = nullptr;
+    uint64_t    m_beginTicks = 0;
+    uint64_t    m_endTicks   = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// One ring entry. The main thread may read a slot while its thread wraps around and overwrites it,
+// so every field is atomic and m_writeTag works as a sequence lock: it is 0 while the slot is being
+// written and the slot's write count + 1 once it is complete. A reader that sees the same tag before
+// and after copying the fields has a whole event; otherwise the event was overwritten.
+//
+struct sProfileSlot
+{
+    std::atomic<uint64_t>    m_writeTag   = { 0 };
+    std::atomic<char const*> m_name       = { nullptr };
+    std::atomic<uint64_t>    m_beginTicks = { 0 };
+    std::atomic<uint64_t>    m_endTicks   = { 0 };
+};
+
+//----------------------------------------------------------------------------------------------------
+// One thread's ring. Only the thread holding the lane writes its slots and m_writeCount; the main
+// thread reads them through ReadProfileSlot, after loading the write count with acquire ordering.
+//
+struct sProfileLane
+{
+    std::unique_ptr<sProfileSlot[]> m_slots;
+    uint64_t                        m_mask              = 0;
+    std::atomic<uint64_t>           m_writeCount        = { 0 };
+    uint64_t                        m_captureWriteCount = 0;        // m_writeCount when the capture started
+    uint64_t                        m_summaryReadCount  = 0;        // m_writeCount the frame summary has read up to
+    std::atomic<char const*>        m_threadName        = { nullptr };
+    int                             m_laneIndex         = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sProfilerState
+{
+    sProfilerConfig            m_config;
+    std::mutex                 m_laneMutex;         // Guards m_lanes and m_freeLanes, never held while recording
+    std::vector<sProfileLane*> m_lanes;             // Owned; freed with the state at exit, after every thread is gone
+    std::vector<sProfileLane*> m_freeLanes;
+
+    // Main thread only
+    bool                       m_isCaptureRequested      = false;
+    int                        m_requestedFrameCount     = 0;
+    String                     m_requestedFilePath;
+    bool                       m_isCapturing             = false;
+    int                        m_captureFrameCount       = 0;
+    int                        m_captureTargetFrameCount = 0;
+    String                     m_captureFilePath;
+    uint64_t                   m_captureBeginTicks       = 0;
+    int64_t                    m_captureBeginNanoseconds = 0;
+    uint64_t                   m_frameBeginTicks         = 0;
+    sProfilerCaptureStatistics m_lastCaptureStatistics;
+    bool                       m_isSummaryEnabled        = false;
+    uint64_t                   m_summaryBeginTicks       = 0;
+    int64_t                    m_summaryBeginNanoseconds = 0;
+    sProfilerFrameSummary      m_frameSummary;
+
+    ~sProfilerState()
+    {
+        for (sProfileLane* lane : m_lanes)
+        {
+            delete lane;
+        }
+    }
+};
+
+//----------------------------------------------------------------------------------------------------
+static sProfilerState s_profiler;
+
+//----------------------------------------------------------------------------------------------------
+static int64_t GetSteadyNanoseconds()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//----------------------------------------------------------------------------------------------------
+static void UpdateIsRecording()
+{
+    g_isProfilerRecording.store(s_profiler.m_isCapturing || s_profiler.m_isSummaryEnabled, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+static sProfileLane* AcquireProfileLane(char const* threadName)
+{
+    std::lock_guard<std::mutex> const lock(s_profiler.m_laneMutex);
+
+    sProfileLane* lane = nullptr;
+
+    if (!s_profiler.m_freeLanes.empty())
+    {
+        // A reused lane keeps its capture start, so the previous thread's scopes in this capture stay
+        lane = s_profiler.m_freeLanes.back();
+        s_profiler.m_freeLanes.pop_back();
+    }
+    else
+    {
+        uint64_t capacity = 1;
+
+        while (capacity < static_cast<uint64_t>(s_profiler.m_config.m_eventsPerThread))
+        {
+            capacity <<= 1;
+        }
+
+        lane              = new sProfileLane();
+        lane->m_slots.reset(new sProfileSlot[static_cast<size_t>(capacity)]);
+        lane->m_mask      = capacity - 1;
+        lane->m_laneIndex = static_cast<int>(s_profiler.m_lanes.size());
+        s_profiler.m_lanes.push_back(lane);
+    }
+
+    lane->m_threadName.store(threadName, std::memory_order_relaxed);
+
+    return lane;
+}
+
+//----------------------------------------------------------------------------------------------------
+static void ReleaseProfileLane(sProfileLane* lane)
+{
+    std::lock_guard<std::mutex> const lock(s_profiler.m_laneMutex);
+    s_profiler.m_freeLanes.push_back(lane);
+}
+
+//----------------------------------------------------------------------------------------------------
+// The lane is only acquired on the thread's first recorded scope, so threads that never record
+// during a capture never allocate a ring.
+//
+struct sProfileThreadLane
+{
+    sProfileLane* m_lane       = nullptr;
+    char const*   m_threadName = nullptr;
+
+    ~sProfileThreadLane()
+    {
+        if (m_lane != nullptr)
+        {
+            ReleaseProfileLane(m_lane);
+        }
+    }
+};
+
+static thread_local sProfileThreadLane s_threadLane;
+
+//----------------------------------------------------------------------------------------------------
+void RecordProfileScope(char const* name, uint64_t const beginTicks, uint64_t const endTicks)
+{
+    sProfileLane* lane = s_threadLane.m_lane;
+
+    if (lane == nullptr)
+    {
+        lane                = AcquireProfileLane(s_threadLane.m_threadName);
+        s_threadLane.m_lane = lane;
+    }
+
+    uint64_t const writeCount = lane->m_writeCount.load(std::memory_order_relaxed);
+    sProfileSlot&  slot       = lane->m_slots[static_cast<size_t>(writeCount & lane->m_mask)];
+
+    // On x86 every store here is a plain mov; only the fence orders the tag before the fields
+    slot.m_writeTag.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.m_name.store(name, std::memory_order_relaxed);
+    slot.m_beginTicks.store(beginTicks, std::memory_order_relaxed);
+    slot.m_endTicks.store(endTicks, std::memory_order_relaxed);
+    slot.m_writeTag.store(writeCount + 1, std::memory_order_release);
+
+    lane->m_writeCount.store(writeCount + 1, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Copies the event written as the lane's `writeCount`-th. False when that event is gone or was being
+// overwritten during the copy; the caller counts it as dropped.
+//
+static bool ReadProfileSlot(sProfileLane const& lane, uint64_t const writeCount, sProfileEvent& out_event)
+{
+    sProfileSlot const& slot = lane.m_slots[static_cast<size_t>(writeCount & lane.m_mask)];
+
+    if (slot.m_writeTag.load(std::memory_order_acquire) != writeCount + 1)
+    {
+        return false;
+    }
+
+    out_event.m_name       = slot.m_name.load(std::memory_order_relaxed);
+    out_event.m_beginTicks = slot.m_beginTicks.load(std::memory_order_relaxed);
+    out_event.m_endTicks   = slot.m_endTicks.load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    return slot.m_writeTag.load(std::memory_order_relaxed) == writeCount + 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+static void WriteJsonString(FILE* file, char const* text)
+{
+    fputc('"', file);
+
+    for (char const* character = text; *character != '\0'; ++character)
+    {
+        if (*character == '"' || *character == '\\')
+        {
+            fputc('\\', file);
+        }
+
+        fputc(*character, file);
+    }
+
+    fputc('"', file);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Stops recording and copies every lane's scopes since the capture began. A lane that wrapped lost
+// its oldest scopes; those, and any a still-running thread overwrote while being copied, are
+// counted as dropped rather than written torn.
+//
+static void FinishCapture()
+{
+    s_profiler.m_isCapturing = false;
+    UpdateIsRecording();
+
+    uint64_t const captureEndTicks       = GetProfilerTicks();
+    int64_t const  captureEndNanoseconds = GetSteadyNanoseconds();
+
+    struct sLaneEvents
+    {
+        int                        m_laneIndex  = 0;
+        char const*                m_threadName = nullptr;
+        std::vector<sProfileEvent> m_events;
+    };
+
+    std::vector<sLaneEvents>   laneEvents;
+    sProfilerCaptureStatistics statistics;
+    statistics.m_frameCount = s_profiler.m_captureFrameCount;
+
+    {
+        std::lock_guard<std::mutex> const lock(s_profiler.m_laneMutex);
+
+        for (sProfileLane* lane : s_profiler.m_lanes)
+        {
+            uint64_t const capacity   = lane->m_mask + 1;
+            uint64_t const writeCount = lane->m_writeCount.load(std::memory_order_acquire);
+            uint64_t       firstCount = writeCount > capacity ? writeCount - capacity : 0;
+            firstCount                = firstCount > lane->m_captureWriteCount ? firstCount : lane->m_captureWriteCount;
+
+            sLaneEvents copy;
+            copy.m_laneIndex  = lane->m_laneIndex;
+            copy.m_threadName = lane->m_threadName.load(std::memory_order_relaxed);
+
+            uint64_t overwritten = 0;
+
+            for (uint64_t count = firstCount; count < writeCount; ++count)
+            {
+                sProfileEvent event;
+
+                if (ReadProfileSlot(*lane, count, event))
+                {
+                    copy.m_events.push_back(event);
+                }
+                else
+                {
+                    ++overwritten;
+                }
+            }
+
+            statistics.m_droppedCount += static_cast<int>(firstCount - lane->m_captureWriteCount + overwritten);
+            statistics.m_eventCount   += static_cast<int>(copy.m_events.size());
+
+            if (!copy.m_events.empty())
+            {
+                ++statistics.m_threadCount;
+                laneEvents.push_back(std::move(copy));
+            }
+        }
+    }
+
+    double const elapsedMicroseconds = static_cast<double>(captureEndNanoseconds - s_profiler.m_captureBeginNanoseconds) / 1000.0;
+    double const ticksPerMicrosecond = elapsedMicroseconds > 0.0 ? static_cast<double>(captureEndTicks - s_profiler.m_captureBeginTicks) / elapsedMicroseconds : 1.0;
+
+    FILE* file = nullptr;
+
+#if defined(_WIN32)
+    if (fopen_s(&file, s_profiler.m_captureFilePath.c_str(), "wb") != 0)
+    {
+        file = nullptr;
+    }
+#else
+    file = fopen(s_profiler.m_captureFilePath.c_str(), "wb");
+#endif
+
+    if (file != nullptr)
+    {
+        fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+        bool isFirstEvent = true;
+
+        for (sLaneEvents const& lane : laneEvents)
+        {
+            String const threadName = lane.m_threadName != nullptr ? String(lane.m_threadName) : Stringf("Thread %d", lane.m_laneIndex);
+
+            fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", isFirstEvent ? "" : ",\n", lane.m_laneIndex);
+            WriteJsonString(file, threadName.c_str());
+            fputs("}}", file);
+            isFirstEvent = false;
+
+            for (sProfileEvent const& event : lane.m_events)
+            {
+                double const beginMicroseconds    = static_cast<double>(event.m_beginTicks - s_profiler.m_captureBeginTicks) / ticksPerMicrosecond;
+                double const durationMicroseconds = static_cast<double>(event.m_endTicks - event.m_beginTicks) / ticksPerMicrosecond;
+
+                fputs(",\n{\"name\":", file);
+                WriteJsonString(file, event.m_name);
+                fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", lane.m_laneIndex, beginMicroseconds, durationMicroseconds);
+            }
+        }
+
+        fputs("\n]}\n", file);
+        statistics.m_isWritten = ferror(file) == 0;
+        fclose(file);
+    }
+
+    s_profiler.m_lastCaptureStatistics = statistics;
+
+    String const line = statistics.m_isWritten
+                            ? Stringf("Profiler: wrote %d frames, %d scopes from %d threads (%d dropped) to \"%s\"\n", statistics.m_frameCount, statistics.m_eventCount, statistics.m_threadCount, statistics.m_droppedCount, s_profiler.m_captureFilePath.c_str())
+                            : Stringf("Profiler: could not write \"%s\"\n", s_profiler.m_captureFilePath.c_str());
+
+    DebuggerPrintf("%s", line.c_str());
+
+#if defined(_WIN32)
+    if (g_theDevConsole != nullptr)
+    {
+        g_theDevConsole->AddLine(statistics.m_isWritten ? DevConsole::INFO_MINOR : DevConsole::ERROR, line);
+    }
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------
+// Totals the scopes every lane recorded since the last summary. Tick rate comes from the whole time
+// the summary has been enabled, so it steadies after the first few frames. Scopes a worker
+// overwrote before they were read are left out.
+//
+static void UpdateFrameSummary()
+{
+    sProfilerFrameSummary& summary = s_profiler.m_frameSummary;
+    summary.m_scopeCount           = 0;
+    summary.m_skippedScopeCount    = 0;
+
+    double const elapsedMilliseconds = static_cast<double>(GetSteadyNanoseconds() - s_profiler.m_summaryBeginNanoseconds) / 1000000.0;
+    double const ticksPerMillisecond = elapsedMilliseconds > 0.0 ? static_cast<double>(GetProfilerTicks() - s_profiler.m_summaryBeginTicks) / elapsedMilliseconds : 1.0;
+
+    std::lock_guard<std::mutex> const lock(s_profiler.m_laneMutex);
+
+    for (sProfileLane* lane : s_profiler.m_lanes)
+    {
+        uint64_t const capacity   = lane->m_mask + 1;
+        uint64_t const writeCount = lane->m_writeCount.load(std::memory_order_acquire);
+        uint64_t       firstCount = writeCount > capacity ? writeCount - capacity : 0;
+        firstCount                = firstCount > lane->m_summaryReadCount ? firstCount : lane->m_summaryReadCount;
+
+        for (uint64_t count = firstCount; count < writeCount; ++count)
+        {
+            sProfileEvent event;
+
+            if (!ReadProfileSlot(*lane, count, event))
+            {
+                continue;
+            }
+
+            int slot = 0;
+
+            while (slot < summary.m_scopeCount && summary.m_scopes[slot].m_name != event.m_name)
+            {
+                ++slot;
+            }
+
+            if (slot == MAX_PROFILER_SUMMARY_SCOPES)
+            {
+                ++summary.m_skippedScopeCount;
+                continue;
+            }
+
+            if (slot == summary.m_scopeCount)
+            {
+                summary.m_scopes[slot]        = sProfilerScopeTotal();
+                summary.m_scopes[slot].m_name = event.m_name;
+                ++summary.m_scopeCount;
+            }
+
+            summary.m_scopes[slot].m_milliseconds += static_cast<float>(static_cast<double>(event.m_endTicks - event.m_beginTicks) / ticksPerMillisecond);
+            ++summary.m_scopes[slot].m_callCount;
+        }
+
+        lane->m_summaryReadCount = writeCount;
+    }
+
+    std::sort(summary.m_scopes, summary.m_scopes + summary.m_scopeCount, [](sProfilerScopeTotal const& a, sProfilerScopeTotal const& b)
+    {
+        return a.m_milliseconds > b.m_milliseconds;
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+// DevConsole: ProfileCapture frames=120 file=Trace.json
+//
+static bool OnProfileCapture(EventArgs& args)
+{
+    int const    frameCount = args.GetValue("frames", 120);
+    String const filePath   = args.GetValue("file", String(s_profiler.m_config.m_defaultFilePath));
+
+    ProfilerRequestCapture(frameCount, filePath.c_str());
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ProfilerStartup(sProfilerConfig const& config)
+{
+    s_profiler.m_config = config;
+
+    if (g_theEventSystem != nullptr)
+    {
+        g_theEventSystem->SubscribeEventCallbackFunction("ProfileCapture", OnProfileCapture);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// A capture still running is written with the frames it has. The lanes stay allocated, since
+// threads still alive may hold one.
+//
+void ProfilerShutdown()
+{
+    if (s_profiler.m_isCapturing)
+    {
+        FinishCapture();
+    }
+
+    s_profiler.m_isCaptureRequested = false;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ProfilerBeginFrame()
+{
+    if (s_profiler.m_isCaptureRequested && !s_profiler.m_isCapturing)
+    {
+        s_profiler.m_isCaptureRequested      = false;
+        s_profiler.m_isCapturing             = true;
+        s_profiler.m_captureFrameCount       = 0;
+        s_profiler.m_captureTargetFrameCount = s_profiler.m_requestedFrameCount;
+        s_profiler.m_captureFilePath         = s_profiler.m_requestedFilePath;
+
+        {
+            std::lock_guard<std::mutex> const lock(s_profiler.m_laneMutex);
+
+            for (sProfileLane* lane : s_profiler.m_lanes)
+            {
+                lane->m_captureWriteCount = lane->m_writeCount.load(std::memory_order_acquire);
+            }
+        }
+
+        s_profiler.m_captureBeginNanoseconds = GetSteadyNanoseconds();
+        s_profiler.m_captureBeginTicks       = GetProfilerTicks();
+        UpdateIsRecording();
+    }
+
+    if (s_profiler.m_isCapturing || s_profiler.m_isSummaryEnabled)
+    {
+        s_profiler.m_frameBeginTicks = GetProfilerTicks();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void ProfilerEndFrame()
+{
+    if (!s_profiler.m_isCapturing && !s_profiler.m_isSummaryEnabled)
+    {
+        return;
+    }
+
+    RecordProfileScope("Frame", s_profiler.m_frameBeginTicks, GetProfilerTicks());
+
+    if (s_profiler.m_isSummaryEnabled)
+    {
+        UpdateFrameSummary();
+    }
+
+    if (!s_profiler.m_isCapturing)
+    {
+        return;
+    }
+
+    ++s_profiler.m_captureFrameCount;
+
+    if (s_profiler.m_captureFrameCount >= s_profiler.m_captureTargetFrameCount)
+    {
+        FinishCapture();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Main thread only. A request made during a capture starts once that capture is written.
+//
+void ProfilerRequestCapture(int const frameCount, char const* filePath)
+{
+    s_profiler.m_isCaptureRequested  = true;
+    s_profiler.m_requestedFrameCount = frameCount > 1 ? frameCount : 1;
+    s_profiler.m_requestedFilePath   = filePath != nullptr ? filePath : s_profiler.m_config.m_defaultFilePath;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool IsProfilerCapturing()
+{
+    return s_profiler.m_isCapturing || s_profiler.m_isCaptureRequested;
+}
+
+//----------------------------------------------------------------------------------------------------
+sProfilerCaptureStatistics const& GetProfilerCaptureStatistics()
+{
+    return s_profiler.m_lastCaptureStatistics;
+}
+
+//----------------------------------------------------------------------------------------------------
+void SetProfilerThreadName(char const* threadName)
+{
+    s_threadLane.m_threadName = threadName;
+
+    if (s_threadLane.m_lane != nullptr)
+    {
+        s_threadLane.m_lane->m_threadName.store(threadName, std::memory_order_relaxed);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Main thread only. The summary starts from scopes recorded after this call.
+//
+void SetProfilerFrameSummaryEnabled(bool const isEnabled)
+{
+    if (isEnabled == s_profiler.m_isSummaryEnabled)
+    {
+        return;
+    }
+
+    if (isEnabled)
+    {
+        std::lock_guard<std::mutex> const lock(s_profiler.m_laneMutex);
+
+        for (sProfileLane* lane : s_profiler.m_lanes)
+        {
+            lane->m_summaryReadCount = lane->m_writeCount.load(std::memory_order_acquire);
+        }
+    }
+
+    s_profiler.m_isSummaryEnabled        = isEnabled;
+    s_profiler.m_summaryBeginNanoseconds = GetSteadyNanoseconds();
+    s_profiler.m_summaryBeginTicks       = GetProfilerTicks();
+    s_profiler.m_frameSummary            = sProfilerFrameSummary();
+    UpdateIsRecording();
+}
+
+//----------------------------------------------------------------------------------------------------
+sProfilerFrameSummary const& GetProfilerFrameSummary()
+{
+    return s_profiler.m_frameSummary;
+}
@@ -0,0 +1,149 @@
+//----------------------------------------------------------------------------------------------------
+// Profiler.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+//----------------------------------------------------------------------------------------------------
+// Define GAME_DISABLE_PROFILER for the whole project to compile every PROFILE_SCOPE to nothing.
+// The capture functions below stay available either way; with markers compiled out a capture only
+// holds the frame events.
+//
+// PROFILE_STATEMENT times a single statement, for calls into code that has no markers of its own,
+// e.g. PROFILE_STATEMENT("InputSystem::BeginFrame", g_theInput->BeginFrame());
+//
+#if defined(GAME_DISABLE_PROFILER)
+#define PROFILE_SCOPE(name)
+#define PROFILE_STATEMENT(name, statement)    do { statement; } while (false)
+#else
+#define PROFILE_SCOPE_JOIN(a, b)              a##b
+#define PROFILE_SCOPE_NAME(line)              PROFILE_SCOPE_JOIN(profileScope_, line)
+#define PROFILE_SCOPE(name)                   ProfileScope const PROFILE_SCOPE_NAME(__LINE__)(name)
+#define PROFILE_STATEMENT(name, statement)    do { PROFILE_SCOPE(name); statement; } while (false)
+#endif
+
+//----------------------------------------------------------------------------------------------------
+struct sProfilerConfig
+{
+    int         m_eventsPerThread = 65536;                  // Ring capacity per thread, rounded up to a power of two
+    char const* m_defaultFilePath = "ProfileCapture.json";
+};
+
+//----------------------------------------------------------------------------------------------------
+// What the last finished capture wrote.
+//
+struct sProfilerCaptureStatistics
+{
+    int    m_frameCount   = 0;
+    int    m_eventCount   = 0;      // Scopes written, frame events included
+    int    m_droppedCount = 0;      // Scopes lost to a full ring
+    int    m_threadCount  = 0;      // Threads with at least one scope in the capture
+    bool   m_isWritten    = false;
+};
+
+//----------------------------------------------------------------------------------------------------
+int constexpr MAX_PROFILER_SUMMARY_SCOPES = 64;
+
+//----------------------------------------------------------------------------------------------------
+// Time per scope name over the last frame, from every thread. A scope's time includes the scopes
+// nested in it, so a parent and its children each show their full time.
+//
+struct sProfilerScopeTotal
+{
+    char const* m_name         = nullptr;
+    float       m_milliseconds = 0.f;
+    int         m_callCount    = 0;
+};
+
+struct sProfilerFrameSummary
+{
+    sProfilerScopeTotal m_scopes[MAX_PROFILER_SUMMARY_SCOPES];
+    int                 m_scopeCount        = 0;    // Slowest first
+    int                 m_skippedScopeCount = 0;    // Scopes whose name did not fit in m_scopes
+};
+
+//----------------------------------------------------------------------------------------------------
+// Scoped markers record into a ring buffer owned by the calling thread, so recording never takes a
+// lock or touches another thread's memory. Markers only read the clock while a capture or the frame
+// summary is running; otherwise they cost one relaxed atomic load.
+//
+// A capture starts on the next ProfilerBeginFrame, records `frameCount` frames and is then written
+// as Chrome trace_event JSON (open it in chrome://tracing or ui.perfetto.dev). Start one from the
+// DevConsole with "ProfileCapture frames=120 file=Trace.json", or from the command line with
+// "profile=120 trace=Trace.json".
+//
+// With the frame summary enabled, markers record every frame, and ProfilerEndFrame totals each
+// scope name into a fixed table without allocating; the perf HUD shows it as the per-subsystem
+// breakdown.
+//
+// Threads that exit hand their ring to the next new thread, so the short-lived workers spawned per
+// call share a handful of lanes in the trace instead of adding one per spawn.
+//
+void ProfilerStartup(sProfilerConfig const& config);
+void ProfilerShutdown();
+void ProfilerBeginFrame();
+void ProfilerEndFrame();
+
+void                              ProfilerRequestCapture(int frameCount, char const* filePath = nullptr);
+bool                              IsProfilerCapturing();
+sProfilerCaptureStatistics const& GetProfilerCaptureStatistics();
+void                              SetProfilerThreadName(char const* threadName);    // Shown for this thread's lane in the trace
+void                              SetProfilerFrameSummaryEnabled(bool isEnabled);
+sProfilerFrameSummary const&      GetProfilerFrameSummary();                        // As of the last ProfilerEndFrame
+
+//----------------------------------------------------------------------------------------------------
+extern std::atomic<bool> g_isProfilerRecording;
+
+void RecordProfileScope(char const* name, uint64_t beginTicks, uint64_t endTicks);
+
+//----------------------------------------------------------------------------------------------------
+// Ticks are TSC cycles on x86 and nanoseconds elsewhere; a capture converts them to microseconds
+// with the rate it measures against steady_clock while it runs.
+//
+inline uint64_t GetProfilerTicks()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------
+class ProfileScope
+{
+public:
+    explicit ProfileScope(char const* name)
+        : m_name(name),
+          m_beginTicks(g_isProfilerRecording.load(std::memory_order_relaxed) ? GetProfilerTicks() : 0)
+    {
+    }
+
+    ~ProfileScope()
+    {
+        if (m_beginTicks != 0)
+        {
+            RecordProfileScope(m_name, m_beginTicks, GetProfilerTicks());
+        }
+    }
+
+    ProfileScope(ProfileScope const&)            = delete;
+    ProfileScope& operator=(ProfileScope const&) = delete;
+
+private:
+    char const* m_name       = nullptr;     // Must outlive the capture; string literals in practice
+    uint64_t    m_beginTicks = 0;           // 0 when the scope began while not recording
+};
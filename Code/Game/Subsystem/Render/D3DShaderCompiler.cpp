@@ -0,0 +1,92 @@
+//----------------------------------------------------------------------------------------------------
+// D3DShaderCompiler.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Render/D3DShaderCompiler.hpp"
+
+#if defined(_WIN32)
+#include <d3dcompiler.h>
+#pragma comment(lib, "d3dcompiler.lib")
+#endif
+
+#include "Engine/Core/EngineCommon.hpp"
+
+#if defined(_WIN32)
+//----------------------------------------------------------------------------------------------------
+#if defined(_DEBUG)
+static UINT constexpr SHADER_COMPILE_FLAGS = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+#else
+static UINT constexpr SHADER_COMPILE_FLAGS = D3DCOMPILE_OPTIMIZATION_LEVEL3;
+#endif
+
+//----------------------------------------------------------------------------------------------------
+String D3DShaderCompiler::GetIdentity() const
+{
+    return Stringf("D3DCompile %d flags %08x", D3D_COMPILER_VERSION, SHADER_COMPILE_FLAGS);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool D3DShaderCompiler::Compile(sShaderPermutation const& permutation, String const& source, String const& sourcePath, std::vector<unsigned char>& out_bytecode, String* out_error) const
+{
+    std::vector<D3D_SHADER_MACRO> macros;
+
+    for (sShaderDefine const& define : permutation.m_defines)
+    {
+        macros.push_back({ define.m_name.c_str(), define.m_value.c_str() });
+    }
+
+    macros.push_back({ nullptr, nullptr });
+
+    char const* const target   = permutation.m_stage == eShaderStage::VERTEX ? "vs_5_0" : "ps_5_0";
+    ID3DBlob*         bytecode = nullptr;
+    ID3DBlob*         errors   = nullptr;
+    HRESULT const     result   = D3DCompile(source.data(), source.size(), sourcePath.c_str(), macros.data(), D3D_COMPILE_STANDARD_FILE_INCLUDE,
+                                            permutation.m_entryPoint.c_str(), target, SHADER_COMPILE_FLAGS, 0, &bytecode, &errors);
+
+    if (SUCCEEDED(result))
+    {
+        unsigned char const* data = static_cast<unsigned char const*>(bytecode->GetBufferPointer());
+        out_bytecode.assign(data, data + bytecode->GetBufferSize());
+    }
+    else if (out_error != nullptr)
+    {
+        *out_error = errors != nullptr ? String(static_cast<char const*>(errors->GetBufferPointer()), errors->GetBufferSize()) : Stringf("D3DCompile failed with %08lx", result);
+    }
+
+    if (bytecode != nullptr)
+    {
+        bytecode->Release();
+    }
+
+    if (errors != nullptr)
+    {
+        errors->Release();
+    }
+
+    return SUCCEEDED(result);
+}
+
+#else
+//----------------------------------------------------------------------------------------------------
+String D3DShaderCompiler::GetIdentity() const
+{
+    return "D3DCompile unavailable";
+}
+
+//----------------------------------------------------------------------------------------------------
+bool D3DShaderCompiler::Compile(sShaderPermutation const& permutation, String const& source, String const& sourcePath, std::vector<unsigned char>& out_bytecode, String* out_error) const
+{
+    UNUSED(permutation)
+    UNUSED(source)
+    UNUSED(sourcePath)
+    UNUSED(out_bytecode)
+
+    if (out_error != nullptr)
+    {
+        *out_error = "D3DCompile is only available on Windows";
+    }
+
+    return false;
+}
+#endif
@@ -0,0 +1,19 @@
+//----------------------------------------------------------------------------------------------------
+// D3DShaderCompiler.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Game/Subsystem/Render/ShaderCompiler.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Compiles with D3DCompile to shader model 5.0: debug info and no optimization in Debug builds, full
+// optimization otherwise. #include is resolved relative to the including file. On other platforms
+// every compile fails.
+//
+class D3DShaderCompiler : public ShaderCompiler
+{
+public:
+    String GetIdentity() const override;
+    bool   Compile(sShaderPermutation const& permutation, String const& source, String const& sourcePath, std::vector<unsigned char>& out_bytecode, String* out_error) const override;
+};
@@ -0,0 +1,315 @@
+//----------------------------------------------------------------------------------------------------
+// EngineRenderBackend.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Render/EngineRenderBackend.hpp"
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Renderer/IndexBuffer.hpp"
+#include "Engine/Renderer/Light.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+#include "Game/Subsystem/Profile/Profiler.hpp"
+#include "Game/Subsystem/Render/PipelineState.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// The game's render states mirror the Renderer's one to one; these are the only places that map them.
+//
+static eBlendMode GetEngineBlendMode(eRenderBlendMode const mode)
+{
+    switch (mode)
+    {
+    case eRenderBlendMode::ALPHA:    return eBlendMode::ALPHA;
+    case eRenderBlendMode::ADDITIVE: return eBlendMode::ADDITIVE;
+    default:                         return eBlendMode::OPAQUE;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+static eRasterizerMode GetEngineRasterizerMode(eRenderRasterizerMode const mode)
+{
+    switch (mode)
+    {
+    case eRenderRasterizerMode::SOLID_CULL_NONE:     return eRasterizerMode::SOLID_CULL_NONE;
+    case eRenderRasterizerMode::WIREFRAME_CULL_NONE: return eRasterizerMode::WIREFRAME_CULL_NONE;
+    case eRenderRasterizerMode::WIREFRAME_CULL_BACK: return eRasterizerMode::WIREFRAME_CULL_BACK;
+    default:                                         return eRasterizerMode::SOLID_CULL_BACK;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+static eSamplerMode GetEngineSamplerMode(eRenderSamplerMode const mode)
+{
+    switch (mode)
+    {
+    case eRenderSamplerMode::BILINEAR_CLAMP: return eSamplerMode::BILINEAR_CLAMP;
+    case eRenderSamplerMode::BILINEAR_WRAP:  return eSamplerMode::BILINEAR_WRAP;
+    default:                                 return eSamplerMode::POINT_CLAMP;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+static eDepthMode GetEngineDepthMode(eRenderDepthMode const mode)
+{
+    switch (mode)
+    {
+    case eRenderDepthMode::DISABLED:             return eDepthMode::DISABLED;
+    case eRenderDepthMode::READ_ONLY_ALWAYS:     return eDepthMode::READ_ONLY_ALWAYS;
+    case eRenderDepthMode::READ_ONLY_LESS_EQUAL: return eDepthMode::READ_ONLY_LESS_EQUAL;
+    default:                                     return eDepthMode::READ_WRITE_LESS_EQUAL;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+static eVertexType GetEngineVertexType(eRenderVertexType const vertexType)
+{
+    return vertexType == eRenderVertexType::VERTEX_PCUTBN ? eVertexType::VERTEX_PCUTBN : eVertexType::VERTEX_PCU;
+}
+
+//----------------------------------------------------------------------------------------------------
+EngineRenderBackend::EngineRenderBackend(Renderer* renderer)
+    : m_renderer(renderer)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+EngineRenderBackend::~EngineRenderBackend()
+{
+    for (int staticMeshId = 0; staticMeshId < static_cast<int>(m_staticMeshes.size()); ++staticMeshId)
+    {
+        DestroyStaticMesh(staticMeshId);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void EngineRenderBackend::BeginFrame()
+{
+    PROFILE_SCOPE("EngineRenderBackend::BeginFrame");
+
+    RenderBackend::BeginFrame();
+    m_renderer->BeginFrame();
+}
+
+//----------------------------------------------------------------------------------------------------
+void EngineRenderBackend::EndFrame()
+{
+    PROFILE_SCOPE("EngineRenderBackend::EndFrame");
+
+    m_renderer->EndFrame();
+}
+
+//----------------------------------------------------------------------------------------------------
+void EngineRenderBackend::ClearScreen(Rgba8 const& clearColor, Rgba8 const& depthClearColor)
+{
+    m_renderer->ClearScreen(clearColor, depthClearColor);
+}
+
+//----------------------------------------------------------------------------------------------------
+void EngineRenderBackend::BeginCamera(Camera const& camera)
+{
+    m_renderer->BeginCamera(camera);
+}
+
+//----------------------------------------------------------------------------------------------------
+void EngineRenderBackend::EndCamera(Camera const& camera)
+{
+    m_renderer->EndCamera(camera);
+}
+
+//----------------------------------------------------------------------------------------------------
+void EngineRenderBackend::RenderEmissive()
+{
+    m_renderer->RenderEmissive();
+}
+
+//----------------------------------------------------------------------------------------------------
+void EngineRenderBackend::SetModelConstants(Mat44 const& modelToWorldTransform, Rgba8 const& modelColor)
+{
+    RecordConstantUpload(sizeof(Mat44) + sizeof(float) * 4);
+    m_renderer->SetModelConstants(modelToWorldTransform, modelColor);
+}
+
+//----------------------------------------------------------------------------------------------------
+void EngineRenderBackend::SetBlendMode(eRenderBlendMode const mode)
+{
+    RecordStateChange();
+    m_renderer->SetBlendMode(GetEngineBlendMode(mode));
+}
+
+//----------------------------------------------------------------------------------------------------
+void EngineRenderBackend::SetRasterizerMode(eRenderRasterizerMode const mode)
+{
+    RecordStateChange();
+    m_renderer->SetRasterizerMode(GetEngineRasterizerMode(mode));
+}
+
+//----------------------------------------------------------------------------------------------------
+void EngineRenderBackend::SetSamplerMode(eRenderSamplerMode const mode)
+{
+    RecordStateChange();
+    m_renderer->SetSamplerMode(GetEngineSamplerMode(mode));
+}
+
+//----------------------------------------------------------------------------------------------------
+void EngineRenderBackend::SetDepthMode(eRenderDepthMode const mode)
+{
+    RecordStateChange();
+    m_renderer->SetDepthMode(GetEngineDepthMode(mode));
+}
+
+//----------------------------------------------------------------------------------------------------
+void EngineRenderBackend::BindTexture(Texture const* texture)
+{
+    RecordStateChange();
+    m_renderer->BindTexture(texture);
+}
+
+//----------------------------------------------------------------------------------------------------
+void EngineRenderBackend::BindShader(Shader* shader)
+{
+    RecordStateChange();
+    m_renderer->BindShader(shader);
+}
+
+//----------------------------------------------------------------------------------------------------
+// The Engine Renderer takes the lights as pointers; they point straight into the caller's packed
+// range, so nothing is copied here. The Renderer only reads through them.
+//
+void EngineRenderBackend::SetLightConstants(Light const* lights, int const lightCount)
+{
+    RecordConstantUpload(sizeof(Light) * static_cast<size_t>(lightCount));
+
+    m_lightPointers.clear();
+
+    for (int lightIndex = 0; lightIndex < lightCount; ++lightIndex)
+    {
+        m_lightPointers.push_back(const_cast<Light*>(&lights[lightIndex]));
+    }
+
+    m_renderer->SetLightConstants(m_lightPointers, lightCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+// The Engine Renderer has no pipeline object, so this sets each part; it still skips the shader
+// lookup by name and counts as one state change, like a single PSO bind would.
+//
+void EngineRenderBackend::BindPipelineState(PipelineState const* pipelineState)
+{
+    sPipelineStateDesc const& desc = pipelineState->GetDesc();
+
+    RecordStateChange();
+    m_renderer->BindShader(pipelineState->GetShader());
+    m_renderer->SetBlendMode(GetEngineBlendMode(desc.m_blendMode));
+    m_renderer->SetRasterizerMode(GetEngineRasterizerMode(desc.m_rasterizerMode));
+    m_renderer->SetSamplerMode(GetEngineSamplerMode(desc.m_samplerMode));
+    m_renderer->SetDepthMode(GetEngineDepthMode(desc.m_depthMode));
+}
+
+//----------------------------------------------------------------------------------------------------
+void EngineRenderBackend::DrawVertexArray(int const numVertexes, Vertex_PCU const* vertexes)
+{
+    RecordDraw(numVertexes);
+    RecordVertexUpload(static_cast<size_t>(numVertexes) * sizeof(Vertex_PCU));
+    m_renderer->DrawVertexArray(numVertexes, vertexes);
+}
+
+//----------------------------------------------------------------------------------------------------
+int EngineRenderBackend::CreateStaticMesh(Vertex_PCU const* vertexes, int const vertexCount, unsigned int const* indexes, int const indexCount)
+{
+    sStaticMesh staticMesh;
+    staticMesh.m_vertexCount = static_cast<unsigned int>(vertexCount);
+    staticMesh.m_indexCount  = static_cast<unsigned int>(indexCount);
+
+    unsigned int const vertexBytes = staticMesh.m_vertexCount * sizeof(Vertex_PCU);
+    staticMesh.m_vertexBuffer      = m_renderer->CreateVertexBuffer(vertexBytes, sizeof(Vertex_PCU));
+    m_renderer->CopyCPUToGPU(vertexes, vertexBytes, staticMesh.m_vertexBuffer);
+    RecordVertexUpload(vertexBytes);
+
+    if (indexCount > 0)
+    {
+        unsigned int const indexBytes = staticMesh.m_indexCount * sizeof(unsigned int);
+        staticMesh.m_indexBuffer      = m_renderer->CreateIndexBuffer(indexBytes, sizeof(unsigned int));
+        m_renderer->CopyCPUToGPU(indexes, indexBytes, staticMesh.m_indexBuffer);
+        RecordVertexUpload(indexBytes);
+    }
+
+    int const staticMeshId = AllocateStaticMeshId();
+
+    if (staticMeshId >= static_cast<int>(m_staticMeshes.size()))
+    {
+        m_staticMeshes.resize(staticMeshId + 1);
+    }
+
+    m_staticMeshes[staticMeshId] = staticMesh;
+
+    return staticMeshId;
+}
+
+//----------------------------------------------------------------------------------------------------
+void EngineRenderBackend::DestroyStaticMesh(int const staticMeshId)
+{
+    if (!FreeStaticMeshId(staticMeshId))
+    {
+        return;
+    }
+
+    sStaticMesh& staticMesh = m_staticMeshes[staticMeshId];
+
+    delete staticMesh.m_vertexBuffer;
+    delete staticMesh.m_indexBuffer;
+
+    staticMesh = sStaticMesh();
+}
+
+//----------------------------------------------------------------------------------------------------
+void EngineRenderBackend::DrawStaticMesh(int const staticMeshId)
+{
+    bool const isLive = IsStaticMeshIdLive(staticMeshId);
+    ASSERT_OR_DIE(isLive, "DrawStaticMesh on a destroyed static mesh")
+
+    if (!isLive)
+    {
+        return;
+    }
+
+    sStaticMesh const& staticMesh = m_staticMeshes[staticMeshId];
+
+    if (staticMesh.m_indexBuffer != nullptr)
+    {
+        RecordDraw(static_cast<int>(staticMesh.m_indexCount));
+        m_renderer->DrawIndexedVertexBuffer(staticMesh.m_vertexBuffer, staticMesh.m_indexBuffer, staticMesh.m_indexCount);
+    }
+    else
+    {
+        RecordDraw(static_cast<int>(staticMesh.m_vertexCount));
+        m_renderer->DrawVertexBuffer(staticMesh.m_vertexBuffer, staticMesh.m_vertexCount);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// The Engine Renderer has no instanced draw call and the shaders have no per-instance input, so the
+// instances are replayed as single draws. Callers still batch by mesh, so a Renderer that gains
+// DrawIndexedInstanced only needs this function changed.
+//
+void EngineRenderBackend::DrawStaticMeshInstanced(int const staticMeshId, sInstanceData const* instances, int const instanceCount)
+{
+    for (int instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex)
+    {
+        SetModelConstants(instances[instanceIndex].m_modelToWorldTransform, instances[instanceIndex].m_color);
+        DrawStaticMesh(staticMeshId);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+Shader* EngineRenderBackend::CreateOrGetShaderFromFile(char const* shaderName, eRenderVertexType const vertexType)
+{
+    return m_renderer->CreateOrGetShaderFromFile(shaderName, GetEngineVertexType(vertexType));
+}
+
+//----------------------------------------------------------------------------------------------------
+Texture* EngineRenderBackend::CreateOrGetTextureFromFile(char const* imageFilePath)
+{
+    return m_renderer->CreateOrGetTextureFromFile(imageFilePath);
+}
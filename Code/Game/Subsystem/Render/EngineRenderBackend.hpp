@@ -0,0 +1,65 @@
+//----------------------------------------------------------------------------------------------------
+// EngineRenderBackend.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Game/Subsystem/Render/RenderBackend.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class IndexBuffer;
+class Renderer;
+class VertexBuffer;
+
+//----------------------------------------------------------------------------------------------------
+// Forwards every call to the Engine's D3D11 Renderer.
+//
+class EngineRenderBackend : public RenderBackend
+{
+public:
+    explicit EngineRenderBackend(Renderer* renderer);
+    ~EngineRenderBackend() override;
+
+    void BeginFrame() override;
+    void EndFrame() override;
+
+    void ClearScreen(Rgba8 const& clearColor, Rgba8 const& depthClearColor) override;
+    void BeginCamera(Camera const& camera) override;
+    void EndCamera(Camera const& camera) override;
+    void RenderEmissive() override;
+
+    void SetModelConstants(Mat44 const& modelToWorldTransform, Rgba8 const& modelColor) override;
+    void SetBlendMode(eRenderBlendMode mode) override;
+    void SetRasterizerMode(eRenderRasterizerMode mode) override;
+    void SetSamplerMode(eRenderSamplerMode mode) override;
+    void SetDepthMode(eRenderDepthMode mode) override;
+    void BindTexture(Texture const* texture) override;
+    void BindShader(Shader* shader) override;
+    void SetLightConstants(Light const* lights, int lightCount) override;
+    void BindPipelineState(PipelineState const* pipelineState) override;
+
+    using RenderBackend::DrawVertexArray;
+    void DrawVertexArray(int numVertexes, Vertex_PCU const* vertexes) override;
+
+    using RenderBackend::CreateStaticMesh;
+    int  CreateStaticMesh(Vertex_PCU const* vertexes, int vertexCount, unsigned int const* indexes, int indexCount) override;
+    void DestroyStaticMesh(int staticMeshId) override;
+    void DrawStaticMesh(int staticMeshId) override;
+    void DrawStaticMeshInstanced(int staticMeshId, sInstanceData const* instances, int instanceCount) override;
+
+    Shader*  CreateOrGetShaderFromFile(char const* shaderName, eRenderVertexType vertexType) override;
+    Texture* CreateOrGetTextureFromFile(char const* imageFilePath) override;
+
+private:
+    struct sStaticMesh
+    {
+        VertexBuffer* m_vertexBuffer = nullptr;
+        IndexBuffer*  m_indexBuffer  = nullptr;
+        unsigned int  m_vertexCount  = 0;
+        unsigned int  m_indexCount   = 0;
+    };
+
+    Renderer*                m_renderer = nullptr;
+    std::vector<sStaticMesh> m_staticMeshes;        // Indexed by static mesh id; destroyed ones are reused
+    std::vector<Light*>      m_lightPointers;       // Reused each SetLightConstants for the Renderer's pointer API
+};
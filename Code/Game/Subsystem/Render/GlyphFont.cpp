@@ -0,0 +1,60 @@
+//----------------------------------------------------------------------------------------------------
+// GlyphFont.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Render/GlyphFont.hpp"
+
+#include "Engine/Math/AABB2.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr   GLYPHS_PER_SIDE = 16;
+static float constexpr GLYPH_UV_SIZE   = 1.f / static_cast<float>(GLYPHS_PER_SIDE);
+
+//----------------------------------------------------------------------------------------------------
+GlyphFont::GlyphFont(Texture const* glyphTexture)
+    : m_glyphTexture(glyphTexture)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+// Textures run v = 0 at the bottom of the image, so glyph row 0 is the top band of v.
+//
+void GlyphFont::AddVertsForText2D(VertexList_PCU& verts, Vec2 const& textMins, float const cellHeight, String const& text, Rgba8 const& tint, float const cellAspect) const
+{
+    float const cellWidth = cellHeight * cellAspect;
+
+    for (size_t charIndex = 0; charIndex < text.size(); ++charIndex)
+    {
+        int const   glyphIndex = static_cast<unsigned char>(text[charIndex]);
+        float const uvLeft     = static_cast<float>(glyphIndex % GLYPHS_PER_SIDE) * GLYPH_UV_SIZE;
+        float const uvTop      = 1.f - static_cast<float>(glyphIndex / GLYPHS_PER_SIDE) * GLYPH_UV_SIZE;
+        Vec2 const  cellMins   = Vec2(textMins.x + cellWidth * static_cast<float>(charIndex), textMins.y);
+
+        AddVertsForAABB2D(verts, AABB2(cellMins, Vec2(cellMins.x + cellWidth, cellMins.y + cellHeight)), tint, Vec2(uvLeft, uvTop - GLYPH_UV_SIZE), Vec2(uvLeft + GLYPH_UV_SIZE, uvTop));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Lays the text out in 2D, then maps x to +Y and y to +Z, which keeps the quads' winding facing +X.
+//
+void GlyphFont::AddVertsForText3DAtOriginXForward(VertexList_PCU& verts, String const& text, float const cellHeight, Rgba8 const& tint, float const cellAspect, Vec2 const& alignment) const
+{
+    size_t const firstVertIndex = verts.size();
+    Vec2 const   textSize       = Vec2(cellHeight * cellAspect * static_cast<float>(text.size()), cellHeight);
+    Vec2 const   textMins       = Vec2(-textSize.x * alignment.x, -textSize.y * alignment.y);
+
+    AddVertsForText2D(verts, textMins, cellHeight, text, tint, cellAspect);
+
+    for (size_t vertIndex = firstVertIndex; vertIndex < verts.size(); ++vertIndex)
+    {
+        Vec3& position = verts[vertIndex].m_position;
+        position       = Vec3(0.f, position.x, position.y);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+Texture const* GlyphFont::GetTexture() const
+{
+    return m_glyphTexture;
+}
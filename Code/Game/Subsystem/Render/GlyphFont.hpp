@@ -0,0 +1,38 @@
+//----------------------------------------------------------------------------------------------------
+// GlyphFont.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Math/Vec2.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Texture;
+
+//----------------------------------------------------------------------------------------------------
+// A fixed-width font laid out like the Engine's BitmapFont: a 16 x 16 grid of glyphs, character
+// code 0 at the top left, read left to right then top to bottom. The glyph image is whatever texture
+// the caller loaded it as, normally through g_theRenderBackend, so the font draws on any backend.
+//
+// Only lays out vertexes; bind GetTexture to draw them.
+//
+class GlyphFont
+{
+public:
+    explicit GlyphFont(Texture const* glyphTexture);
+
+    // One cellHeight x cellHeight * cellAspect quad per character, from textMins to the right
+    void AddVertsForText2D(VertexList_PCU& verts, Vec2 const& textMins, float cellHeight, String const& text, Rgba8 const& tint = Rgba8::WHITE, float cellAspect = 1.f) const;
+
+    // The same quads in the world's Y-Z plane, facing +X and reading toward +Y, with `alignment` of
+    // the text's box at the origin
+    void AddVertsForText3DAtOriginXForward(VertexList_PCU& verts, String const& text, float cellHeight, Rgba8 const& tint = Rgba8::WHITE, float cellAspect = 1.f, Vec2 const& alignment = Vec2(0.5f, 0.5f)) const;
+
+    Texture const* GetTexture() const;
+
+private:
+    Texture const* m_glyphTexture = nullptr;
+};
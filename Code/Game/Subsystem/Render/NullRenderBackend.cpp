@@ -0,0 +1,180 @@
+//----------------------------------------------------------------------------------------------------
+// NullRenderBackend.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Render/NullRenderBackend.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Renderer/Light.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void NullRenderBackend::ClearScreen(Rgba8 const& clearColor, Rgba8 const& depthClearColor)
+{
+    UNUSED(clearColor)
+    UNUSED(depthClearColor)
+}
+
+//----------------------------------------------------------------------------------------------------
+void NullRenderBackend::BeginCamera(Camera const& camera)
+{
+    UNUSED(camera)
+}
+
+//----------------------------------------------------------------------------------------------------
+void NullRenderBackend::EndCamera(Camera const& camera)
+{
+    UNUSED(camera)
+}
+
+//----------------------------------------------------------------------------------------------------
+void NullRenderBackend::RenderEmissive()
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+void NullRenderBackend::SetModelConstants(Mat44 const& modelToWorldTransform, Rgba8 const& modelColor)
+{
+    UNUSED(modelToWorldTransform)
+    UNUSED(modelColor)
+
+    RecordConstantUpload(sizeof(Mat44) + sizeof(float) * 4);
+}
+
+//----------------------------------------------------------------------------------------------------
+void NullRenderBackend::SetBlendMode(eRenderBlendMode const mode)
+{
+    UNUSED(mode)
+    RecordStateChange();
+}
+
+//----------------------------------------------------------------------------------------------------
+void NullRenderBackend::SetRasterizerMode(eRenderRasterizerMode const mode)
+{
+    UNUSED(mode)
+    RecordStateChange();
+}
+
+//----------------------------------------------------------------------------------------------------
+void NullRenderBackend::SetSamplerMode(eRenderSamplerMode const mode)
+{
+    UNUSED(mode)
+    RecordStateChange();
+}
+
+//----------------------------------------------------------------------------------------------------
+void NullRenderBackend::SetDepthMode(eRenderDepthMode const mode)
+{
+    UNUSED(mode)
+    RecordStateChange();
+}
+
+//----------------------------------------------------------------------------------------------------
+void NullRenderBackend::BindTexture(Texture const* texture)
+{
+    UNUSED(texture)
+    RecordStateChange();
+}
+
+//----------------------------------------------------------------------------------------------------
+void NullRenderBackend::BindShader(Shader* shader)
+{
+    UNUSED(shader)
+    RecordStateChange();
+}
+
+//----------------------------------------------------------------------------------------------------
+void NullRenderBackend::SetLightConstants(Light const* lights, int const lightCount)
+{
+    UNUSED(lights)
+    RecordConstantUpload(sizeof(Light) * static_cast<size_t>(lightCount));
+}
+
+//----------------------------------------------------------------------------------------------------
+void NullRenderBackend::BindPipelineState(PipelineState const* pipelineState)
+{
+    UNUSED(pipelineState)
+    RecordStateChange();
+}
+
+//----------------------------------------------------------------------------------------------------
+void NullRenderBackend::DrawVertexArray(int const numVertexes, Vertex_PCU const* vertexes)
+{
+    UNUSED(vertexes)
+    RecordDraw(numVertexes);
+    RecordVertexUpload(static_cast<size_t>(numVertexes) * sizeof(Vertex_PCU));
+}
+
+//----------------------------------------------------------------------------------------------------
+int NullRenderBackend::CreateStaticMesh(Vertex_PCU const* vertexes, int const vertexCount, unsigned int const* indexes, int const indexCount)
+{
+    UNUSED(vertexes)
+    UNUSED(indexes)
+    RecordVertexUpload(static_cast<size_t>(vertexCount) * sizeof(Vertex_PCU) + static_cast<size_t>(indexCount) * sizeof(unsigned int));
+
+    int const staticMeshId = AllocateStaticMeshId();
+
+    if (staticMeshId >= static_cast<int>(m_staticMeshDrawCounts.size()))
+    {
+        m_staticMeshDrawCounts.resize(staticMeshId + 1);
+    }
+
+    m_staticMeshDrawCounts[staticMeshId] = indexCount == 0 ? vertexCount : indexCount;
+
+    return staticMeshId;
+}
+
+//----------------------------------------------------------------------------------------------------
+void NullRenderBackend::DestroyStaticMesh(int const staticMeshId)
+{
+    if (FreeStaticMeshId(staticMeshId))
+    {
+        m_staticMeshDrawCounts[staticMeshId] = 0;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void NullRenderBackend::DrawStaticMesh(int const staticMeshId)
+{
+    bool const isLive = IsStaticMeshIdLive(staticMeshId);
+    ASSERT_OR_DIE(isLive, "DrawStaticMesh on a destroyed static mesh")
+
+    if (isLive)
+    {
+        RecordDraw(m_staticMeshDrawCounts[staticMeshId]);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void NullRenderBackend::DrawStaticMeshInstanced(int const staticMeshId, sInstanceData const* instances, int const instanceCount)
+{
+    UNUSED(instances)
+
+    bool const isLive = IsStaticMeshIdLive(staticMeshId);
+    ASSERT_OR_DIE(isLive, "DrawStaticMeshInstanced on a destroyed static mesh")
+
+    if (isLive)
+    {
+        RecordDraw(m_staticMeshDrawCounts[staticMeshId] * instanceCount);
+        RecordVertexUpload(sizeof(sInstanceData) * static_cast<size_t>(instanceCount));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+Shader* NullRenderBackend::CreateOrGetShaderFromFile(char const* shaderName, eRenderVertexType const vertexType)
+{
+    UNUSED(shaderName)
+    UNUSED(vertexType)
+
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+Texture* NullRenderBackend::CreateOrGetTextureFromFile(char const* imageFilePath)
+{
+    UNUSED(imageFilePath)
+
+    return nullptr;
+}
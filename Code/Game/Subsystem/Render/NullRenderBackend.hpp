@@ -0,0 +1,45 @@
+//----------------------------------------------------------------------------------------------------
+// NullRenderBackend.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Game/Subsystem/Render/RenderBackend.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Accepts every call without a window or GPU and only records sRenderStatistics.
+// Used by headless runs so the whole frame, including render submission, can be measured.
+//
+class NullRenderBackend : public RenderBackend
+{
+public:
+    void ClearScreen(Rgba8 const& clearColor, Rgba8 const& depthClearColor) override;
+    void BeginCamera(Camera const& camera) override;
+    void EndCamera(Camera const& camera) override;
+    void RenderEmissive() override;
+
+    void SetModelConstants(Mat44 const& modelToWorldTransform, Rgba8 const& modelColor) override;
+    void SetBlendMode(eRenderBlendMode mode) override;
+    void SetRasterizerMode(eRenderRasterizerMode mode) override;
+    void SetSamplerMode(eRenderSamplerMode mode) override;
+    void SetDepthMode(eRenderDepthMode mode) override;
+    void BindTexture(Texture const* texture) override;
+    void BindShader(Shader* shader) override;
+    void SetLightConstants(Light const* lights, int lightCount) override;
+    void BindPipelineState(PipelineState const* pipelineState) override;
+
+    using RenderBackend::DrawVertexArray;
+    void DrawVertexArray(int numVertexes, Vertex_PCU const* vertexes) override;
+
+    using RenderBackend::CreateStaticMesh;
+    int  CreateStaticMesh(Vertex_PCU const* vertexes, int vertexCount, unsigned int const* indexes, int indexCount) override;
+    void DestroyStaticMesh(int staticMeshId) override;
+    void DrawStaticMesh(int staticMeshId) override;
+    void DrawStaticMeshInstanced(int staticMeshId, sInstanceData const* instances, int instanceCount) override;
+
+    Shader*  CreateOrGetShaderFromFile(char const* shaderName, eRenderVertexType vertexType) override;
+    Texture* CreateOrGetTextureFromFile(char const* imageFilePath) override;
+
+private:
+    std::vector<int> m_staticMeshDrawCounts;        // Vertexes (or indexes) each static mesh id draws
+};
@@ -0,0 +1,49 @@
+//----------------------------------------------------------------------------------------------------
+// PipelineState.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Render/PipelineState.hpp"
+
+//----------------------------------------------------------------------------------------------------
+bool sPipelineStateDesc::operator==(sPipelineStateDesc const& other) const
+{
+    return m_vertexType == other.m_vertexType &&
+           m_blendMode == other.m_blendMode &&
+           m_rasterizerMode == other.m_rasterizerMode &&
+           m_samplerMode == other.m_samplerMode &&
+           m_depthMode == other.m_depthMode &&
+           m_shaderName == other.m_shaderName;
+}
+
+//----------------------------------------------------------------------------------------------------
+PipelineState::PipelineState(sPipelineStateDesc const& desc, Shader* shader, int const id)
+    : m_desc(desc),
+      m_shader(shader),
+      m_id(id)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+sPipelineStateDesc const& PipelineState::GetDesc() const
+{
+    return m_desc;
+}
+
+//----------------------------------------------------------------------------------------------------
+Shader* PipelineState::GetShader() const
+{
+    return m_shader;
+}
+
+//----------------------------------------------------------------------------------------------------
+int PipelineState::GetId() const
+{
+    return m_id;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool PipelineState::IsOpaque() const
+{
+    return m_desc.m_blendMode == eRenderBlendMode::OPAQUE;
+}
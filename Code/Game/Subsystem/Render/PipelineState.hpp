@@ -0,0 +1,48 @@
+//----------------------------------------------------------------------------------------------------
+// PipelineState.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Engine/Core/StringUtils.hpp"
+#include "Game/Subsystem/Render/RenderStates.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Shader;
+
+//----------------------------------------------------------------------------------------------------
+// Everything a PipelineState is built from. The shader is named by path here, and only looked up once
+// when the PipelineState is created.
+//
+struct sPipelineStateDesc
+{
+    String                m_shaderName     = "Data/Shaders/Default";
+    eRenderVertexType     m_vertexType     = eRenderVertexType::VERTEX_PCU;
+    eRenderBlendMode      m_blendMode      = eRenderBlendMode::OPAQUE;
+    eRenderRasterizerMode m_rasterizerMode = eRenderRasterizerMode::SOLID_CULL_BACK;
+    eRenderSamplerMode    m_samplerMode    = eRenderSamplerMode::POINT_CLAMP;
+    eRenderDepthMode      m_depthMode      = eRenderDepthMode::READ_WRITE_LESS_EQUAL;
+
+    bool operator==(sPipelineStateDesc const& other) const;
+};
+
+//----------------------------------------------------------------------------------------------------
+// A resolved shader plus the fixed-function modes it draws with. Immutable once created.
+// Create through RenderBackend::CreateOrGetPipelineState, which owns it and returns the same object
+// for equal descs, so two pipeline states are equal exactly when their pointers are.
+//
+class PipelineState
+{
+public:
+    PipelineState(sPipelineStateDesc const& desc, Shader* shader, int id);
+
+    sPipelineStateDesc const& GetDesc() const;
+    Shader*                   GetShader() const;
+    int                       GetId() const;
+    bool                      IsOpaque() const;
+
+private:
+    sPipelineStateDesc const m_desc;
+    Shader* const            m_shader = nullptr;
+    int const                m_id     = -1;        // Dense per backend, from 0; small enough for sort keys
+};
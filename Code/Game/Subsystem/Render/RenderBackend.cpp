@@ -0,0 +1,139 @@
+//----------------------------------------------------------------------------------------------------
+// RenderBackend.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Render/RenderBackend.hpp"
+
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Game/Subsystem/Render/PipelineState.hpp"
+
+//----------------------------------------------------------------------------------------------------
+RenderBackend::~RenderBackend()
+{
+    for (PipelineState*& pipelineState : m_pipelineStates)
+    {
+        delete pipelineState;
+        pipelineState = nullptr;
+    }
+
+    m_pipelineStates.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+void RenderBackend::BeginFrame()
+{
+    m_frameStatistics = sRenderStatistics();
+}
+
+//----------------------------------------------------------------------------------------------------
+void RenderBackend::EndFrame()
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+void RenderBackend::DrawVertexArray(std::vector<Vertex_PCU> const& vertexes)
+{
+    DrawVertexArray(static_cast<int>(vertexes.size()), vertexes.data());
+}
+
+//----------------------------------------------------------------------------------------------------
+int RenderBackend::CreateStaticMesh(std::vector<Vertex_PCU> const& vertexes, std::vector<unsigned int> const& indexes)
+{
+    return CreateStaticMesh(vertexes.data(), static_cast<int>(vertexes.size()), indexes.data(), static_cast<int>(indexes.size()));
+}
+
+//----------------------------------------------------------------------------------------------------
+// A linear search with a string compare, which is fine for the handful of pipeline states a game
+// creates at load time.
+//
+PipelineState const* RenderBackend::CreateOrGetPipelineState(sPipelineStateDesc const& desc)
+{
+    for (PipelineState const* pipelineState : m_pipelineStates)
+    {
+        if (pipelineState->GetDesc() == desc)
+        {
+            return pipelineState;
+        }
+    }
+
+    Shader*        shader        = CreateOrGetShaderFromFile(desc.m_shaderName.c_str(), desc.m_vertexType);
+    PipelineState* pipelineState = new PipelineState(desc, shader, static_cast<int>(m_pipelineStates.size()));
+    m_pipelineStates.push_back(pipelineState);
+
+    return pipelineState;
+}
+
+//----------------------------------------------------------------------------------------------------
+sRenderStatistics const& RenderBackend::GetFrameStatistics() const
+{
+    return m_frameStatistics;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RenderBackend::RecordDraw(int const numVertexes)
+{
+    ++m_frameStatistics.m_drawCalls;
+    m_frameStatistics.m_verticesSubmitted += numVertexes;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RenderBackend::RecordVertexUpload(size_t const numBytes)
+{
+    m_frameStatistics.m_vertexBytesUploaded += numBytes;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RenderBackend::RecordConstantUpload(size_t const numBytes)
+{
+    m_frameStatistics.m_constantBytesUploaded += numBytes;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RenderBackend::RecordStateChange()
+{
+    ++m_frameStatistics.m_stateChanges;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns a destroyed id when there is one, so a game that streams meshes in and out keeps its mesh
+// arrays at the peak number alive rather than growing them forever. The caller sizes its own
+// per-mesh array to cover the id.
+//
+int RenderBackend::AllocateStaticMeshId()
+{
+    if (!m_freeStaticMeshIds.empty())
+    {
+        int const staticMeshId = m_freeStaticMeshIds.back();
+        m_freeStaticMeshIds.pop_back();
+        m_isStaticMeshIdLive[staticMeshId] = true;
+
+        return staticMeshId;
+    }
+
+    m_isStaticMeshIdLive.push_back(true);
+
+    return static_cast<int>(m_isStaticMeshIdLive.size()) - 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns false, and frees nothing, for an id that is out of range or already destroyed.
+//
+bool RenderBackend::FreeStaticMeshId(int const staticMeshId)
+{
+    if (!IsStaticMeshIdLive(staticMeshId))
+    {
+        return false;
+    }
+
+    m_isStaticMeshIdLive[staticMeshId] = false;
+    m_freeStaticMeshIds.push_back(staticMeshId);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool RenderBackend::IsStaticMeshIdLive(int const staticMeshId) const
+{
+    return staticMeshId >= 0 && staticMeshId < static_cast<int>(m_isStaticMeshIdLive.size()) && m_isStaticMeshIdLive[staticMeshId];
+}
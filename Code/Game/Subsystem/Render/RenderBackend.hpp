@@ -0,0 +1,113 @@
+//----------------------------------------------------------------------------------------------------
+// RenderBackend.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Game/Subsystem/Render/RenderStates.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Camera;
+class PipelineState;
+class Shader;
+class Texture;
+struct Light;
+struct Vertex_PCU;
+struct sPipelineStateDesc;
+
+//----------------------------------------------------------------------------------------------------
+// Counters every backend records while the game submits a frame.
+// Reset in BeginFrame, so they always describe the frame currently being built.
+//
+struct sRenderStatistics
+{
+    int    m_drawCalls             = 0;
+    int    m_verticesSubmitted     = 0;
+    size_t m_vertexBytesUploaded   = 0;     // Vertex and index data copied to the GPU
+    size_t m_constantBytesUploaded = 0;     // Model and light constant buffer updates
+    int    m_stateChanges          = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Per-instance data for DrawStaticMeshInstanced: what SetModelConstants sets for a single draw.
+//
+struct sInstanceData
+{
+    Mat44 m_modelToWorldTransform;
+    Rgba8 m_color;
+};
+
+//----------------------------------------------------------------------------------------------------
+// The subset of Renderer the game talks to.
+// Game code calls g_theRenderBackend instead of g_theRenderer, so the same frame can be submitted to
+// the D3D11 Renderer, or to a backend that needs no window or GPU (headless runs, CI machines).
+//
+class RenderBackend
+{
+public:
+    virtual ~RenderBackend();
+
+    virtual void BeginFrame();
+    virtual void EndFrame();
+
+    virtual void ClearScreen(Rgba8 const& clearColor, Rgba8 const& depthClearColor) = 0;
+    virtual void BeginCamera(Camera const& camera) = 0;
+    virtual void EndCamera(Camera const& camera) = 0;
+    virtual void RenderEmissive() = 0;
+
+    virtual void SetModelConstants(Mat44 const& modelToWorldTransform = Mat44(), Rgba8 const& modelColor = Rgba8::WHITE) = 0;
+    virtual void SetBlendMode(eRenderBlendMode mode) = 0;
+    virtual void SetRasterizerMode(eRenderRasterizerMode mode) = 0;
+    virtual void SetSamplerMode(eRenderSamplerMode mode) = 0;
+    virtual void SetDepthMode(eRenderDepthMode mode) = 0;
+    virtual void BindTexture(Texture const* texture) = 0;
+    virtual void BindShader(Shader* shader) = 0;
+    virtual void SetLightConstants(Light const* lights, int lightCount) = 0;
+
+    // Resolves the shader and builds the PipelineState once; call at load time, not per draw.
+    // BindPipelineState then sets the shader and all four modes in one call with no lookups.
+    PipelineState const* CreateOrGetPipelineState(sPipelineStateDesc const& desc);
+    virtual void         BindPipelineState(PipelineState const* pipelineState) = 0;
+
+    virtual void DrawVertexArray(int numVertexes, Vertex_PCU const* vertexes) = 0;
+    void         DrawVertexArray(std::vector<Vertex_PCU> const& vertexes);
+
+    // Static meshes are uploaded once and stay on the GPU until destroyed; drawing one costs no
+    // vertex upload. Returns an id for DrawStaticMesh; an empty index list draws non-indexed.
+    // The arrays are only read during the call, so they can point into a mapped file.
+    // Destroyed ids are handed out again by later creates; drawing one is an error.
+    virtual int  CreateStaticMesh(Vertex_PCU const* vertexes, int vertexCount, unsigned int const* indexes, int indexCount) = 0;
+    int          CreateStaticMesh(std::vector<Vertex_PCU> const& vertexes, std::vector<unsigned int> const& indexes);
+    virtual void DestroyStaticMesh(int staticMeshId) = 0;
+    virtual void DrawStaticMesh(int staticMeshId) = 0;
+
+    // Draws a static mesh once per instance in a single draw call, each instance with its own
+    // transform and tint. Uploads the instance data, not the mesh.
+    virtual void DrawStaticMeshInstanced(int staticMeshId, sInstanceData const* instances, int instanceCount) = 0;
+
+    virtual Shader*  CreateOrGetShaderFromFile(char const* shaderName, eRenderVertexType vertexType = eRenderVertexType::VERTEX_PCU) = 0;
+    virtual Texture* CreateOrGetTextureFromFile(char const* imageFilePath) = 0;
+
+    sRenderStatistics const& GetFrameStatistics() const;
+
+protected:
+    void RecordDraw(int numVertexes);
+    void RecordVertexUpload(size_t numBytes);
+    void RecordConstantUpload(size_t numBytes);
+    void RecordStateChange();
+
+    // Static mesh id bookkeeping shared by every backend; each keeps its own meshes indexed by id
+    int  AllocateStaticMeshId();
+    bool FreeStaticMeshId(int staticMeshId);
+    bool IsStaticMeshIdLive(int staticMeshId) const;
+
+    sRenderStatistics           m_frameStatistics;
+    std::vector<PipelineState*> m_pipelineStates;       // Owned; index is PipelineState::GetId
+    std::vector<bool>           m_isStaticMeshIdLive;   // Indexed by static mesh id
+    std::vector<int>            m_freeStaticMeshIds;    // Destroyed ids, reused before new ones are added
+};
@@ -0,0 +1,359 @@
+//----------------------------------------------------------------------------------------------------
+// RenderQueue.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Render/RenderQueue.hpp"
+
+#include <cmath>
+#include <utility>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Game/Subsystem/Profile/Profiler.hpp"
+#include "Game/Subsystem/Render/PipelineState.hpp"
+#include "Game/Subsystem/Render/RenderBackend.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// The smallest sphere holding both; a batch's bounds grow by one item at a time this way.
+//
+static sBoundingSphere GetEnclosingSphere(sBoundingSphere const& a, sBoundingSphere const& b)
+{
+    Vec3 const  aToB     = b.m_center - a.m_center;
+    float const distance = sqrtf(aToB.x * aToB.x + aToB.y * aToB.y + aToB.z * aToB.z);
+
+    if (distance + b.m_radius <= a.m_radius)
+    {
+        return a;
+    }
+
+    if (distance + a.m_radius <= b.m_radius)
+    {
+        return b;
+    }
+
+    sBoundingSphere enclosing;
+    enclosing.m_radius = (distance + a.m_radius + b.m_radius) * 0.5f;
+    enclosing.m_center = a.m_center + aToB * ((enclosing.m_radius - a.m_radius) / distance);
+
+    return enclosing;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Clears last frame's items. Depth in the sort key is the distance from `viewPosition`, quantized
+// over [0, maxViewDistance]; anything farther shares the last bucket.
+//
+void RenderQueue::Begin(Vec3 const& viewPosition, float const maxViewDistance)
+{
+    m_items.clear();
+    m_sortEntries.clear();
+    m_batches.clear();
+    m_instances.clear();
+    m_viewPosition    = viewPosition;
+    m_maxViewDistance = maxViewDistance;
+    m_isSorted        = false;
+    m_isBatched       = false;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RenderQueue::Submit(sRenderState const& state, int const staticMeshId, Mat44 const& modelToWorldTransform, Rgba8 const& color, sBoundingSphere const& worldBounds)
+{
+    sDrawItem item;
+    item.m_modelToWorldTransform = modelToWorldTransform;
+    item.m_color                 = color;
+    item.m_worldBounds           = worldBounds;
+    item.m_state                 = state;
+    item.m_staticMeshId          = staticMeshId;
+
+    AddItem(item);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RenderQueue::Submit(sRenderState const& state, int const vertexCount, Vertex_PCU const* vertexes, Mat44 const& modelToWorldTransform, Rgba8 const& color, sBoundingSphere const& worldBounds)
+{
+    sDrawItem item;
+    item.m_modelToWorldTransform = modelToWorldTransform;
+    item.m_color                 = color;
+    item.m_worldBounds           = worldBounds;
+    item.m_state                 = state;
+    item.m_vertexCount           = vertexCount;
+    item.m_vertexes              = vertexes;
+
+    AddItem(item);
+}
+
+//----------------------------------------------------------------------------------------------------
+// LSD radix sort, one byte per pass, over (key, item index) pairs so the draw items never move.
+// All eight histograms come from a single read of the keys, and a pass whose byte is the same in
+// every key is skipped; with a few shaders and textures most of the high bytes are.
+//
+void RenderQueue::Sort()
+{
+    int const count = static_cast<int>(m_sortEntries.size());
+    m_isSorted      = true;
+    m_isBatched     = false;
+
+    if (count < 2)
+    {
+        return;
+    }
+
+    uint32_t histograms[8][256] = {};
+
+    for (sSortEntry const& entry : m_sortEntries)
+    {
+        for (int pass = 0; pass < 8; ++pass)
+        {
+            ++histograms[pass][(entry.m_key >> (pass * 8)) & 0xFF];
+        }
+    }
+
+    m_sortScratch.resize(static_cast<size_t>(count));
+    sSortEntry* source      = m_sortEntries.data();
+    sSortEntry* destination = m_sortScratch.data();
+
+    for (int pass = 0; pass < 8; ++pass)
+    {
+        int const shift     = pass * 8;
+        uint32_t* histogram = histograms[pass];
+
+        if (histogram[(source[0].m_key >> shift) & 0xFF] == static_cast<uint32_t>(count))
+        {
+            continue;
+        }
+
+        uint32_t offset = 0;
+
+        for (int bucket = 0; bucket < 256; ++bucket)
+        {
+            uint32_t const bucketCount = histogram[bucket];
+            histogram[bucket]          = offset;
+            offset += bucketCount;
+        }
+
+        for (int entryIndex = 0; entryIndex < count; ++entryIndex)
+        {
+            sSortEntry const& entry = source[entryIndex];
+            destination[histogram[(entry.m_key >> shift) & 0xFF]++] = entry;
+        }
+
+        std::swap(source, destination);
+    }
+
+    if (source != m_sortEntries.data())
+    {
+        m_sortEntries.swap(m_sortScratch);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Walks the sorted items and merges each run that shares state and static mesh into one batch,
+// packing every item's transform and tint into the instance buffer in draw order.
+//
+void RenderQueue::BuildBatches()
+{
+    if (!m_isSorted)
+    {
+        Sort();
+    }
+
+    m_batches.clear();
+    m_instances.clear();
+    m_instances.reserve(m_sortEntries.size());
+
+    int const entryCount = static_cast<int>(m_sortEntries.size());
+    int       entryIndex = 0;
+
+    while (entryIndex < entryCount)
+    {
+        sDrawItem const& firstItem = m_items[m_sortEntries[entryIndex].m_itemIndex];
+
+        sDrawBatch batch;
+        batch.m_state         = firstItem.m_state;
+        batch.m_worldBounds   = firstItem.m_worldBounds;
+        batch.m_staticMeshId  = firstItem.m_staticMeshId;
+        batch.m_firstInstance = static_cast<int>(m_instances.size());
+        batch.m_vertexCount   = firstItem.m_vertexCount;
+        batch.m_vertexes      = firstItem.m_vertexes;
+
+        while (entryIndex < entryCount)
+        {
+            sDrawItem const& item = m_items[m_sortEntries[entryIndex].m_itemIndex];
+
+            bool const canJoinBatch = batch.m_instanceCount == 0 ||
+                                      (item.m_staticMeshId >= 0 &&
+                                       item.m_staticMeshId == batch.m_staticMeshId &&
+                                       item.m_state.m_pipelineState == batch.m_state.m_pipelineState &&
+                                       item.m_state.m_texture == batch.m_state.m_texture);
+
+            if (!canJoinBatch)
+            {
+                break;
+            }
+
+            if (batch.m_instanceCount > 0)
+            {
+                batch.m_worldBounds = GetEnclosingSphere(batch.m_worldBounds, item.m_worldBounds);
+            }
+
+            sInstanceData instance;
+            instance.m_modelToWorldTransform = item.m_modelToWorldTransform;
+            instance.m_color                 = item.m_color;
+            m_instances.push_back(instance);
+
+            ++batch.m_instanceCount;
+            ++entryIndex;
+        }
+
+        m_batches.push_back(batch);
+    }
+
+    m_isBatched = true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Sorts and batches if needed, then submits every batch. The first batch sets every state, because
+// other code (debug render, attract mode) may have changed it since the last flush; after that a
+// state is only set when it differs from the previous batch's. With `bindLights`, each batch's
+// lights are bound for its world bounds before it is drawn. Clears the queue.
+//
+void RenderQueue::Flush(RenderBackend& backend, BindLightsCallback const& bindLights)
+{
+    PROFILE_SCOPE("RenderQueue::Flush");
+
+    if (!m_isBatched)
+    {
+        BuildBatches();
+    }
+
+    sRenderState boundState;
+    bool         hasBoundState = false;
+
+    for (sDrawBatch const& batch : m_batches)
+    {
+        sRenderState const& state = batch.m_state;
+
+        if (!hasBoundState || state.m_pipelineState != boundState.m_pipelineState)
+        {
+            backend.BindPipelineState(state.m_pipelineState);
+        }
+
+        if (!hasBoundState || state.m_texture != boundState.m_texture)
+        {
+            backend.BindTexture(state.m_texture);
+        }
+
+        boundState    = state;
+        hasBoundState = true;
+
+        if (bindLights)
+        {
+            bindLights(batch.m_worldBounds);
+        }
+
+        sInstanceData const& firstInstance = m_instances[batch.m_firstInstance];
+
+        if (batch.m_instanceCount >= MIN_INSTANCE_COUNT)
+        {
+            backend.DrawStaticMeshInstanced(batch.m_staticMeshId, &firstInstance, batch.m_instanceCount);
+        }
+        else if (batch.m_staticMeshId >= 0)
+        {
+            backend.SetModelConstants(firstInstance.m_modelToWorldTransform, firstInstance.m_color);
+            backend.DrawStaticMesh(batch.m_staticMeshId);
+        }
+        else
+        {
+            backend.SetModelConstants(firstInstance.m_modelToWorldTransform, firstInstance.m_color);
+            backend.DrawVertexArray(batch.m_vertexCount, batch.m_vertexes);
+        }
+    }
+
+    m_items.clear();
+    m_sortEntries.clear();
+    m_batches.clear();
+    m_instances.clear();
+    m_isSorted  = false;
+    m_isBatched = false;
+}
+
+//----------------------------------------------------------------------------------------------------
+int RenderQueue::GetItemCount() const
+{
+    return static_cast<int>(m_items.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<sDrawBatch> const& RenderQueue::GetBatches() const
+{
+    return m_batches;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<sInstanceData> const& RenderQueue::GetInstances() const
+{
+    return m_instances;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RenderQueue::AddItem(sDrawItem const& item)
+{
+    ASSERT_OR_DIE(item.m_state.m_pipelineState != nullptr, "RenderQueue items need a PipelineState")
+
+    Vec3 const  toItem       = item.m_modelToWorldTransform.GetTranslation3D() - m_viewPosition;
+    float const viewDistance = sqrtf(toItem.x * toItem.x + toItem.y * toItem.y + toItem.z * toItem.z);
+
+    sSortEntry entry;
+    entry.m_key       = MakeSortKey(item, viewDistance);
+    entry.m_itemIndex = static_cast<int>(m_items.size());
+
+    m_items.push_back(item);
+    m_sortEntries.push_back(entry);
+    m_isSorted  = false;
+    m_isBatched = false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Mesh field 0 is every vertex-array item; static mesh ids start at 1.
+//
+uint64_t RenderQueue::MakeSortKey(sDrawItem const& item, float const viewDistance)
+{
+    uint64_t constexpr depthMax      = (1ull << DEPTH_BITS) - 1;
+    float const        depthFraction = viewDistance < m_maxViewDistance ? viewDistance / m_maxViewDistance : 1.f;
+    uint64_t const     depth         = static_cast<uint64_t>(depthFraction * static_cast<float>(depthMax));
+
+    PipelineState const* pipelineState = item.m_state.m_pipelineState;
+    uint64_t const       pipelineId    = static_cast<uint64_t>(pipelineState->GetId()) & ((1ull << PIPELINE_ID_BITS) - 1);
+    uint64_t const       textureId     = GetTextureId(item.m_state.m_texture);
+    uint64_t const       meshId        = static_cast<uint64_t>(item.m_staticMeshId + 1) & ((1ull << MESH_ID_BITS) - 1);
+
+    if (pipelineState->IsOpaque())
+    {
+        return pipelineId << (TEXTURE_ID_BITS + MESH_ID_BITS + DEPTH_BITS) |
+               textureId << (MESH_ID_BITS + DEPTH_BITS) |
+               meshId << DEPTH_BITS |
+               depth;
+    }
+
+    return 1ull << 63 |
+           (depthMax - depth) << (PIPELINE_ID_BITS + TEXTURE_ID_BITS + MESH_ID_BITS) |
+           pipelineId << (TEXTURE_ID_BITS + MESH_ID_BITS) |
+           textureId << MESH_ID_BITS |
+           meshId;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Ids past the field width wrap and share a key with another texture, like pipeline and mesh ids
+// do. That only costs sorting quality; batching and Flush compare the real values, so no needed
+// bind is skipped and no batch mixes meshes.
+//
+uint32_t RenderQueue::GetTextureId(Texture const* texture)
+{
+    if (texture == nullptr)
+    {
+        return 0;
+    }
+
+    uint32_t const textureId = m_textureIds.emplace(texture, static_cast<uint32_t>(m_textureIds.size()) + 1).first->second;
+
+    return textureId & ((1u << TEXTURE_ID_BITS) - 1);
+}
@@ -0,0 +1,122 @@
+//----------------------------------------------------------------------------------------------------
+// RenderQueue.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Game/Math/FrustumCulling.hpp"
+#include "Game/Subsystem/Render/RenderBackend.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class PipelineState;
+class Texture;
+struct Vertex_PCU;
+
+//----------------------------------------------------------------------------------------------------
+// Everything a draw binds before it is issued. The queue compares these by pointer, so each is only
+// bound when it differs from the one the previous draw left bound.
+//
+struct sRenderState
+{
+    PipelineState const* m_pipelineState = nullptr;
+    Texture const*       m_texture       = nullptr;
+};
+
+//----------------------------------------------------------------------------------------------------
+// One draw: either a static mesh id from RenderBackend::CreateStaticMesh, or a vertex array that
+// must stay alive until the queue is flushed. The world bounds choose the lights it is drawn with.
+//
+struct sDrawItem
+{
+    Mat44             m_modelToWorldTransform;
+    Rgba8             m_color;
+    sBoundingSphere   m_worldBounds;
+    sRenderState      m_state;
+    int               m_staticMeshId = -1;
+    int               m_vertexCount  = 0;
+    Vertex_PCU const* m_vertexes     = nullptr;
+};
+
+//----------------------------------------------------------------------------------------------------
+// A run of sorted items that share state and static mesh, drawn with one call. Instances index into
+// RenderQueue::GetInstances; vertex-array items are always a batch of one. The world bounds enclose
+// every item in the batch.
+//
+struct sDrawBatch
+{
+    sRenderState      m_state;
+    sBoundingSphere   m_worldBounds;
+    int               m_staticMeshId  = -1;
+    int               m_firstInstance = 0;
+    int               m_instanceCount = 0;
+    int               m_vertexCount   = 0;
+    Vertex_PCU const* m_vertexes      = nullptr;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Collects a frame's draws, sorts them by a packed 64-bit key, and submits them to a RenderBackend
+// with only the state changes the sorted order actually needs. Neighboring items that share state
+// and static mesh become one instanced draw.
+//
+// Key layout, most significant bit first:
+//   opaque:      [63] 0 | [62..48] pipeline state | [47..36] texture | [35..24] mesh | [23..0] depth
+//   translucent: [63] 1 | [62..39] inverted depth | [38..24] pipeline state | [23..12] texture | [11..0] mesh
+// Opaque draws group by pipeline state, then texture, then mesh, then front to back. Translucent
+// draws come after every opaque draw and sort back to front, because blending needs that order;
+// they only instance when consecutive draws happen to share a mesh.
+// Pipeline states use PipelineState::GetId and meshes their static mesh id; textures get small ids
+// the first time they are submitted, and keep them afterwards.
+//
+class RenderQueue
+{
+public:
+    // Binds the lights for one batch's world bounds, e.g. LightSubsystem::BindLightsForBounds
+    using BindLightsCallback = std::function<void(sBoundingSphere const&)>;
+
+    void Begin(Vec3 const& viewPosition, float maxViewDistance);
+    void Submit(sRenderState const& state, int staticMeshId, Mat44 const& modelToWorldTransform, Rgba8 const& color, sBoundingSphere const& worldBounds);
+    void Submit(sRenderState const& state, int vertexCount, Vertex_PCU const* vertexes, Mat44 const& modelToWorldTransform, Rgba8 const& color, sBoundingSphere const& worldBounds);
+    void Sort();
+    void BuildBatches();
+    void Flush(RenderBackend& backend, BindLightsCallback const& bindLights = nullptr);
+
+    int                               GetItemCount() const;
+    std::vector<sDrawBatch> const&    GetBatches() const;
+    std::vector<sInstanceData> const& GetInstances() const;
+
+private:
+    struct sSortEntry
+    {
+        uint64_t m_key       = 0;
+        int      m_itemIndex = 0;
+    };
+
+    static int constexpr PIPELINE_ID_BITS   = 15;
+    static int constexpr TEXTURE_ID_BITS    = 12;
+    static int constexpr MESH_ID_BITS       = 12;
+    static int constexpr DEPTH_BITS         = 24;
+    static int constexpr MIN_INSTANCE_COUNT = 2;       // A lone item draws without an instance upload
+
+    void     AddItem(sDrawItem const& item);
+    uint64_t MakeSortKey(sDrawItem const& item, float viewDistance);
+    uint32_t GetTextureId(Texture const* texture);
+
+    std::vector<sDrawItem>                       m_items;
+    std::vector<sSortEntry>                      m_sortEntries;
+    std::vector<sSortEntry>                      m_sortScratch;             // Ping-pong buffer for the radix passes
+    std::vector<sDrawBatch>                      m_batches;
+    std::vector<sInstanceData>                   m_instances;               // Every item's transform and tint, in sorted order
+    std::unordered_map<Texture const*, uint32_t> m_textureIds;              // nullptr is always id 0
+    Vec3                                         m_viewPosition;
+    float                                        m_maxViewDistance = 100.f;
+    bool                                         m_isSorted        = false;
+    bool                                         m_isBatched       = false;
+};
@@ -0,0 +1,52 @@
+//----------------------------------------------------------------------------------------------------
+// RenderStates.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+// The fixed-function states and vertex layouts the game asks a RenderBackend for. They mirror the
+// Engine Renderer's modes one to one, but live here so RenderBackend and PipelineState compile
+// without the D3D11 Renderer headers; EngineRenderBackend translates them.
+//
+enum class eRenderBlendMode : uint8_t
+{
+    OPAQUE,
+    ALPHA,
+    ADDITIVE
+};
+
+//----------------------------------------------------------------------------------------------------
+enum class eRenderRasterizerMode : uint8_t
+{
+    SOLID_CULL_NONE,
+    SOLID_CULL_BACK,
+    WIREFRAME_CULL_NONE,
+    WIREFRAME_CULL_BACK
+};
+
+//----------------------------------------------------------------------------------------------------
+enum class eRenderSamplerMode : uint8_t
+{
+    POINT_CLAMP,
+    BILINEAR_CLAMP,
+    BILINEAR_WRAP
+};
+
+//----------------------------------------------------------------------------------------------------
+enum class eRenderDepthMode : uint8_t
+{
+    DISABLED,
+    READ_ONLY_ALWAYS,
+    READ_ONLY_LESS_EQUAL,
+    READ_WRITE_LESS_EQUAL
+};
+
+//----------------------------------------------------------------------------------------------------
+enum class eRenderVertexType : uint8_t
+{
+    VERTEX_PCU,
+    VERTEX_PCUTBN
+};
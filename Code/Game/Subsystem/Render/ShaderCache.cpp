@@ -0,0 +1,415 @@
+//----------------------------------------------------------------------------------------------------
+// ShaderCache.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Render/ShaderCache.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <unordered_set>
+#include <utility>
+
+#include "Game/Subsystem/Job/JobSystem.hpp"
+#include "Game/Subsystem/Profile/Profiler.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static uint64_t constexpr FNV_OFFSET_BASIS = 14695981039346656037ull;
+static uint64_t constexpr FNV_PRIME        = 1099511628211ull;
+
+//----------------------------------------------------------------------------------------------------
+static uint64_t HashBytes(uint64_t hash, void const* data, size_t const size)
+{
+    unsigned char const* bytes = static_cast<unsigned char const*>(data);
+
+    for (size_t index = 0; index < size; ++index)
+    {
+        hash = (hash ^ bytes[index]) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The terminator is hashed too, so "ab" + "c" and "a" + "bc" give different keys.
+//
+static uint64_t HashString(uint64_t const hash, String const& text)
+{
+    return HashBytes(hash, text.c_str(), text.size() + 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+static FILE* OpenFile(char const* filePath, char const* mode)
+{
+    FILE* file = nullptr;
+
+#if defined(_WIN32)
+    if (fopen_s(&file, filePath, mode) != 0)
+    {
+        file = nullptr;
+    }
+#else
+    file = fopen(filePath, mode);
+#endif
+
+    return file;
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool ReadWholeFile(char const* filePath, String& out_contents)
+{
+    FILE* file = OpenFile(filePath, "rb");
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    out_contents.clear();
+
+    char   buffer[16384];
+    size_t readSize = 0;
+
+    while ((readSize = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        out_contents.append(buffer, readSize);
+    }
+
+    bool const isRead = ferror(file) == 0;
+    fclose(file);
+
+    return isRead;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Up to and including the last separator; empty for a bare file name.
+//
+static String GetDirectory(String const& filePath)
+{
+    size_t const separator = filePath.find_last_of("/\\");
+    return separator == String::npos ? String() : filePath.substr(0, separator + 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Every #include "name" or #include <name> at the start of a line. Directives inside #if blocks or
+// block comments are included too, which can only make a key depend on more files than it needs.
+//
+static void FindIncludes(String const& source, std::vector<String>& out_includeNames)
+{
+    size_t lineStart = 0;
+
+    while (lineStart < source.size())
+    {
+        size_t lineEnd = source.find('\n', lineStart);
+        lineEnd        = lineEnd == String::npos ? source.size() : lineEnd;
+
+        size_t cursor = source.find_first_not_of(" \t", lineStart);
+
+        if (cursor < lineEnd && source[cursor] == '#')
+        {
+            cursor = source.find_first_not_of(" \t", cursor + 1);
+
+            if (cursor < lineEnd && source.compare(cursor, 7, "include") == 0)
+            {
+                cursor = source.find_first_not_of(" \t", cursor + 7);
+
+                if (cursor < lineEnd && (source[cursor] == '"' || source[cursor] == '<'))
+                {
+                    char const   closer   = source[cursor] == '"' ? '"' : '>';
+                    size_t const nameEnd  = source.find(closer, cursor + 1);
+
+                    if (nameEnd < lineEnd)
+                    {
+                        out_includeNames.push_back(source.substr(cursor + 1, nameEnd - cursor - 1));
+                    }
+                }
+            }
+        }
+
+        lineStart = lineEnd + 1;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+ShaderCache::ShaderCache(sShaderCacheConfig const& config, ShaderCompiler const& compiler)
+    : m_config(config)
+    , m_compiler(compiler)
+    , m_compilerIdentity(compiler.GetIdentity())
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ShaderCache::GetBytecode(sShaderPermutation const& permutation, std::vector<unsigned char>& out_bytecode, String* out_error)
+{
+    PROFILE_SCOPE("ShaderCache::GetBytecode");
+
+    uint64_t key = 0;
+
+    if (!ComputeKey(permutation, key, out_error))
+    {
+        CountResult(&sShaderCacheStatistics::m_failedCount);
+        return false;
+    }
+
+    if (ReadCachedBytecode(key, out_bytecode))
+    {
+        CountResult(&sShaderCacheStatistics::m_hitCount);
+        return true;
+    }
+
+    return CompileAndStore(permutation, key, out_bytecode, out_error);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Keys are computed and checked against the cache on the caller, which only reads small files;
+// the compiles, which are what take time, are the parallel part.
+//
+int ShaderCache::CompileMissing(std::vector<sShaderPermutation> const& permutations, JobSystem* jobSystem)
+{
+    PROFILE_SCOPE("ShaderCache::CompileMissing");
+
+    std::vector<std::pair<int, uint64_t>> missing;      // Permutation index, key
+    std::unordered_set<uint64_t>          seenKeys;
+    std::vector<unsigned char>            cachedBytecode;
+    int                                   keyFailureCount = 0;
+
+    for (int permutationIndex = 0; permutationIndex < static_cast<int>(permutations.size()); ++permutationIndex)
+    {
+        uint64_t key = 0;
+
+        if (!ComputeKey(permutations[permutationIndex], key))
+        {
+            CountResult(&sShaderCacheStatistics::m_failedCount);
+            ++keyFailureCount;
+            continue;
+        }
+
+        if (seenKeys.insert(key).second && !ReadCachedBytecode(key, cachedBytecode))
+        {
+            missing.push_back(std::make_pair(permutationIndex, key));
+        }
+    }
+
+    std::atomic<int> compileFailureCount = { 0 };
+
+    auto const compileRange = [this, &permutations, &missing, &compileFailureCount](int const begin, int const end)
+    {
+        for (int missingIndex = begin; missingIndex < end; ++missingIndex)
+        {
+            std::vector<unsigned char> bytecode;
+
+            if (!CompileAndStore(permutations[missing[missingIndex].first], missing[missingIndex].second, bytecode, nullptr))
+            {
+                ++compileFailureCount;
+            }
+        }
+    };
+
+    if (jobSystem != nullptr)
+    {
+        jobSystem->ParallelFor(static_cast<int>(missing.size()), 1, compileRange);
+    }
+    else
+    {
+        compileRange(0, static_cast<int>(missing.size()));
+    }
+
+    return keyFailureCount + compileFailureCount.load();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ShaderCache::ComputeKey(sShaderPermutation const& permutation, uint64_t& out_key, String* out_error) const
+{
+    uint64_t hash = HashBytes(FNV_OFFSET_BASIS, &SHADER_CACHE_VERSION, sizeof(SHADER_CACHE_VERSION));
+    hash          = HashString(hash, m_compilerIdentity);
+
+    std::vector<String> filePaths;
+
+    if (!ReadSourceClosure(permutation.m_shaderName + SHADER_SOURCE_EXTENSION, filePaths, hash, out_error))
+    {
+        return false;
+    }
+
+    uint8_t const stage      = static_cast<uint8_t>(permutation.m_stage);
+    int const     vertexType = static_cast<int>(permutation.m_vertexType);
+
+    hash = HashString(hash, permutation.m_entryPoint);
+    hash = HashBytes(hash, &stage, sizeof(stage));
+    hash = HashBytes(hash, &vertexType, sizeof(vertexType));
+
+    // Sorted, so the same set of defines is one key whatever order the caller lists them in
+    std::vector<sShaderDefine> defines = permutation.m_defines;
+    std::sort(defines.begin(), defines.end(), [](sShaderDefine const& a, sShaderDefine const& b)
+    {
+        return a.m_name != b.m_name ? a.m_name < b.m_name : a.m_value < b.m_value;
+    });
+
+    for (sShaderDefine const& define : defines)
+    {
+        hash = HashString(hash, define.m_name);
+        hash = HashString(hash, define.m_value);
+    }
+
+    out_key = hash;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+String ShaderCache::GetCachedFilePath(uint64_t const key) const
+{
+    return Stringf("%s/%016llx%s", m_config.m_directory.c_str(), static_cast<unsigned long long>(key), SHADER_CACHE_EXTENSION);
+}
+
+//----------------------------------------------------------------------------------------------------
+sShaderCacheStatistics ShaderCache::GetStatistics() const
+{
+    std::lock_guard<std::mutex> const lock(m_statisticsMutex);
+    return m_statistics;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Hashes `filePath` and its text, then each file it includes, depth first in the order they appear.
+// A file already in `inout_filePaths` is skipped, so include cycles and repeated includes end.
+//
+bool ShaderCache::ReadSourceClosure(String const& filePath, std::vector<String>& inout_filePaths, uint64_t& inout_hash, String* out_error) const
+{
+    if (std::find(inout_filePaths.begin(), inout_filePaths.end(), filePath) != inout_filePaths.end())
+    {
+        return true;
+    }
+
+    inout_filePaths.push_back(filePath);
+
+    String source;
+
+    if (!ReadWholeFile(filePath.c_str(), source))
+    {
+        if (out_error != nullptr)
+        {
+            *out_error = Stringf("could not read \"%s\"", filePath.c_str());
+        }
+
+        return false;
+    }
+
+    inout_hash = HashString(inout_hash, filePath);
+    inout_hash = HashString(inout_hash, source);
+
+    std::vector<String> includeNames;
+    FindIncludes(source, includeNames);
+
+    String const directory = GetDirectory(filePath);
+
+    for (String const& includeName : includeNames)
+    {
+        if (!ReadSourceClosure(directory + includeName, inout_filePaths, inout_hash, out_error))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ShaderCache::ReadCachedBytecode(uint64_t const key, std::vector<unsigned char>& out_bytecode) const
+{
+    String contents;
+
+    if (!ReadWholeFile(GetCachedFilePath(key).c_str(), contents) || contents.size() < sizeof(sShaderCacheHeader))
+    {
+        return false;
+    }
+
+    sShaderCacheHeader header;
+    memcpy(&header, contents.data(), sizeof(header));
+
+    char const*  bytecode     = contents.data() + sizeof(header);
+    size_t const bytecodeSize = contents.size() - sizeof(header);
+
+    if (header.m_magic != SHADER_CACHE_MAGIC || header.m_version != SHADER_CACHE_VERSION || header.m_key != key || header.m_bytecodeSize != bytecodeSize ||
+        header.m_bytecodeHash != HashBytes(FNV_OFFSET_BASIS, bytecode, bytecodeSize))
+    {
+        return false;
+    }
+
+    out_bytecode.assign(bytecode, bytecode + bytecodeSize);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+// The bytecode is written to a temporary file and renamed into place, so a crash mid-write never
+// leaves a truncated file under a valid key. Failing to write it only costs a compile next time, so
+// the bytecode is still returned.
+//
+bool ShaderCache::CompileAndStore(sShaderPermutation const& permutation, uint64_t const key, std::vector<unsigned char>& out_bytecode, String* out_error)
+{
+    PROFILE_SCOPE("ShaderCache::CompileAndStore");
+
+    String const sourcePath = permutation.m_shaderName + SHADER_SOURCE_EXTENSION;
+    String       source;
+
+    if (!ReadWholeFile(sourcePath.c_str(), source))
+    {
+        if (out_error != nullptr)
+        {
+            *out_error = Stringf("could not read \"%s\"", sourcePath.c_str());
+        }
+
+        CountResult(&sShaderCacheStatistics::m_failedCount);
+        return false;
+    }
+
+    if (!m_compiler.Compile(permutation, source, sourcePath, out_bytecode, out_error))
+    {
+        CountResult(&sShaderCacheStatistics::m_failedCount);
+        return false;
+    }
+
+    sShaderCacheHeader header;
+    memset(&header, 0, sizeof(header));
+
+    header.m_magic        = SHADER_CACHE_MAGIC;
+    header.m_version      = SHADER_CACHE_VERSION;
+    header.m_key          = key;
+    header.m_bytecodeSize = out_bytecode.size();
+    header.m_bytecodeHash = HashBytes(FNV_OFFSET_BASIS, out_bytecode.data(), out_bytecode.size());
+
+    std::error_code directoryError;
+    std::filesystem::create_directories(m_config.m_directory, directoryError);
+
+    String const cachedFilePath    = GetCachedFilePath(key);
+    String const temporaryFilePath = Stringf("%s.%u.tmp", cachedFilePath.c_str(), m_nextTemporaryFileId++);
+    FILE*        file              = OpenFile(temporaryFilePath.c_str(), "wb");
+
+    if (file != nullptr)
+    {
+        bool isWritten = fwrite(&header, sizeof(header), 1, file) == 1;
+        isWritten      = isWritten && (out_bytecode.empty() || fwrite(out_bytecode.data(), 1, out_bytecode.size(), file) == out_bytecode.size());
+        isWritten      = fclose(file) == 0 && isWritten;
+
+        if (isWritten)
+        {
+            remove(cachedFilePath.c_str());
+            isWritten = rename(temporaryFilePath.c_str(), cachedFilePath.c_str()) == 0;
+        }
+
+        if (!isWritten)
+        {
+            remove(temporaryFilePath.c_str());
+        }
+    }
+
+    CountResult(&sShaderCacheStatistics::m_compiledCount);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ShaderCache::CountResult(int sShaderCacheStatistics::* counter)
+{
+    std::lock_guard<std::mutex> const lock(m_statisticsMutex);
+    ++(m_statistics.*counter);
+}
@@ -0,0 +1,92 @@
+//----------------------------------------------------------------------------------------------------
+// ShaderCache.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "Engine/Core/StringUtils.hpp"
+#include "Game/Subsystem/Render/ShaderCompiler.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class JobSystem;
+
+//----------------------------------------------------------------------------------------------------
+char constexpr     SHADER_CACHE_EXTENSION[] = ".shc";
+uint32_t constexpr SHADER_CACHE_MAGIC       = 0x43485353;     // "SSHC" read as little-endian bytes
+uint32_t constexpr SHADER_CACHE_VERSION     = 1;              // Bump on any key or layout change; old files are recompiled
+
+//----------------------------------------------------------------------------------------------------
+// The start of a cached shader file; the bytecode follows it.
+//
+struct sShaderCacheHeader
+{
+    uint32_t m_magic;
+    uint32_t m_version;
+    uint64_t m_key;                     // Repeated from the file name, so a renamed file is never served
+    uint64_t m_bytecodeSize;
+    uint64_t m_bytecodeHash;            // Catches a file damaged after it was written
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sShaderCacheConfig
+{
+    String m_directory = "Data/Cache/Shaders";      // Created on the first compile
+};
+
+//----------------------------------------------------------------------------------------------------
+// Counted since construction.
+//
+struct sShaderCacheStatistics
+{
+    int m_hitCount      = 0;
+    int m_compiledCount = 0;        // Misses: no cached file yet, or a stale or corrupt one replaced
+    int m_failedCount   = 0;        // Unreadable source or include, or a compile error
+};
+
+//----------------------------------------------------------------------------------------------------
+// Compiled shader bytecode on disk, keyed by everything that decides it: the compiler's identity,
+// the text of the shader file and of every file it #includes, the entry point, the stage, the
+// vertex type and the defines (in any order). Editing a shader or one of its includes changes the
+// key, so nothing is ever served stale and no timestamps are trusted. A hit reads the sources to
+// hash them and then the cached file; a miss compiles and writes it.
+//
+// Safe to use from several threads at once; CompileMissing relies on it to compile permutations in
+// parallel on job workers.
+//
+class ShaderCache
+{
+public:
+    ShaderCache(sShaderCacheConfig const& config, ShaderCompiler const& compiler);
+
+    ShaderCache(ShaderCache const&)            = delete;
+    ShaderCache& operator=(ShaderCache const&) = delete;
+
+    bool GetBytecode(sShaderPermutation const& permutation, std::vector<unsigned char>& out_bytecode, String* out_error = nullptr);
+
+    // Compiles every permutation that is not cached yet, spread over `jobSystem`'s threads, or on the
+    // caller alone when it is null. Permutations with the same key compile once. Returns how many
+    // could not be compiled.
+    int CompileMissing(std::vector<sShaderPermutation> const& permutations, JobSystem* jobSystem);
+
+    bool                   ComputeKey(sShaderPermutation const& permutation, uint64_t& out_key, String* out_error = nullptr) const;
+    String                 GetCachedFilePath(uint64_t key) const;
+    sShaderCacheStatistics GetStatistics() const;
+
+private:
+    bool ReadSourceClosure(String const& filePath, std::vector<String>& inout_filePaths, uint64_t& inout_hash, String* out_error) const;
+    bool ReadCachedBytecode(uint64_t key, std::vector<unsigned char>& out_bytecode) const;
+    bool CompileAndStore(sShaderPermutation const& permutation, uint64_t key, std::vector<unsigned char>& out_bytecode, String* out_error);
+    void CountResult(int sShaderCacheStatistics::* counter);
+
+    sShaderCacheConfig const m_config;
+    ShaderCompiler const&    m_compiler;
+    String const             m_compilerIdentity;
+    std::atomic<uint32_t>    m_nextTemporaryFileId = { 0 };     // Keeps concurrent writes of one key apart
+    mutable std::mutex       m_statisticsMutex;
+    sShaderCacheStatistics   m_statistics;
+};
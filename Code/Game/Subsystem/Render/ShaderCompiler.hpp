@@ -0,0 +1,60 @@
+//----------------------------------------------------------------------------------------------------
+// ShaderCompiler.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/StringUtils.hpp"
+#include "Game/Subsystem/Render/RenderStates.hpp"
+
+//----------------------------------------------------------------------------------------------------
+char constexpr SHADER_SOURCE_EXTENSION[] = ".hlsl";
+
+//----------------------------------------------------------------------------------------------------
+enum class eShaderStage : uint8_t
+{
+    VERTEX,
+    PIXEL
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sShaderDefine
+{
+    String m_name;
+    String m_value = "1";
+};
+
+//----------------------------------------------------------------------------------------------------
+// One compile: a shader file, one of its entry points, and the defines it is built with. The shader
+// is named like CreateOrGetShaderFromFile names it, without the extension.
+//
+struct sShaderPermutation
+{
+    String                     m_shaderName = "Data/Shaders/Default";
+    String                     m_entryPoint = "VertexMain";
+    eShaderStage               m_stage      = eShaderStage::VERTEX;
+    eRenderVertexType          m_vertexType = eRenderVertexType::VERTEX_PCU;     // The Renderer builds one Shader, with its input layout, per vertex type
+    std::vector<sShaderDefine> m_defines;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Turns HLSL source into bytecode. ShaderCache only talks to this interface, so the cache can run
+// with a stand-in compiler where D3DCompile does not exist.
+// Compile is called from job workers, several at once, and must be thread-safe.
+//
+class ShaderCompiler
+{
+public:
+    virtual ~ShaderCompiler() = default;
+
+    // Names the compiler, its version and its flags. Part of every cache key, so bytecode from
+    // another compiler or another set of flags is never served.
+    virtual String GetIdentity() const = 0;
+
+    // `source` is the shader file's text; `sourcePath` is where it was read from, for #include
+    // lookups and error messages.
+    virtual bool Compile(sShaderPermutation const& permutation, String const& source, String const& sourcePath, std::vector<unsigned char>& out_bytecode, String* out_error) const = 0;
+};
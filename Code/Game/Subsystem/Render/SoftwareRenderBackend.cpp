@@ -0,0 +1,1071 @@
+//----------------------------------------------------------------------------------------------------
+// SoftwareRenderBackend.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Render/SoftwareRenderBackend.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/Light.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Math/SIMD.hpp"
+#include "Game/Subsystem/Job/JobSystem.hpp"
+#include "Game/Subsystem/Profile/Profiler.hpp"
+#include "Game/Subsystem/Render/PipelineState.hpp"
+#include "Game/Subsystem/Resource/CookedTexture.hpp"
+#include "Game/Subsystem/Resource/TextureCache.hpp"
+#include "ThirdParty/stb/stb_image.h"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr TILE_SIZE            = 64;          // Pixels; a multiple of the 4-pixel SSE chunk
+static int constexpr SUBPIXEL_BITS        = 4;
+static int constexpr SUBPIXEL_SCALE       = 1 << SUBPIXEL_BITS;
+static int constexpr CLIP_PLANE_COUNT     = 6;
+static int constexpr MAX_CLIPPED_VERTEXES = 3 + CLIP_PLANE_COUNT;
+
+// An edge function at a pixel inside the target is at most 2 * (16 * width) * (16 * height), which
+// has to fit in an int32_t.
+static int constexpr MAX_TARGET_PIXELS = 4000000;
+
+// Below this many triangles per extra job slot, handing tiles to another thread costs more than they take.
+static int constexpr TRIANGLES_PER_EXTRA_SLOT = 256;
+
+static float constexpr INVERSE_255 = 1.f / 255.f;
+
+//----------------------------------------------------------------------------------------------------
+// Signed distance to each clip plane in D3D clip space: -w <= x, y <= w and 0 <= z <= w.
+//
+static float GetClipPlaneDistance(Vec4 const& position, int const plane)
+{
+    switch (plane)
+    {
+    case 0:  return position.w + position.x;
+    case 1:  return position.w - position.x;
+    case 2:  return position.w + position.y;
+    case 3:  return position.w - position.y;
+    case 4:  return position.z;
+    default: return position.w - position.z;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Inline rather than GetClampedZeroToOne; this runs four times for every pixel written.
+//
+static unsigned char GetByteFromNormalized(float const value)
+{
+    float const clamped = value < 0.f ? 0.f : value > 1.f ? 1.f : value;
+    return static_cast<unsigned char>(clamped * 255.f + 0.5f);
+}
+
+//----------------------------------------------------------------------------------------------------
+static int GetWrappedOrClampedTexel(int const index, int const size, bool const isWrapping)
+{
+    if (isWrapping)
+    {
+        int const wrapped = index % size;
+        return wrapped < 0 ? wrapped + size : wrapped;
+    }
+
+    return index < 0 ? 0 : index >= size ? size - 1 : index;
+}
+
+//----------------------------------------------------------------------------------------------------
+SoftwareRenderBackend::SoftwareRenderBackend(sSoftwareRenderConfig const& config)
+    : m_config(config)
+{
+    GUARANTEE_OR_DIE(config.m_width > 0 && config.m_height > 0, "SoftwareRenderBackend needs a render target")
+    GUARANTEE_OR_DIE(config.m_width * config.m_height <= MAX_TARGET_PIXELS, "SoftwareRenderBackend target is too large for 28.4 fixed-point edge functions")
+    GUARANTEE_OR_DIE(config.m_workerCount > 0, "SoftwareRenderBackend needs at least one job slot")
+
+    m_pitch      = (config.m_width + 3) & ~3;
+    m_tileCountX = (config.m_width + TILE_SIZE - 1) / TILE_SIZE;
+    m_tileCountY = (config.m_height + TILE_SIZE - 1) / TILE_SIZE;
+
+    m_colorBuffer.assign(static_cast<size_t>(m_pitch) * config.m_height, Rgba8::BLACK);
+    m_depthBuffer.assign(static_cast<size_t>(m_pitch) * config.m_height, 1.f);
+    m_tileBins.resize(static_cast<size_t>(m_tileCountX) * m_tileCountY);
+}
+
+//----------------------------------------------------------------------------------------------------
+SoftwareRenderBackend::~SoftwareRenderBackend()
+{
+    for (sSoftwareTexture*& texture : m_textures)
+    {
+        delete texture;
+        texture = nullptr;
+    }
+
+    m_textures.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::BeginFrame()
+{
+    PROFILE_SCOPE("SoftwareRenderBackend::BeginFrame");
+
+    RenderBackend::BeginFrame();
+
+    m_rasterStatistics = sSoftwareRenderStatistics();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Anything still binned was drawn before the clear, so it is rasterized first.
+//
+void SoftwareRenderBackend::ClearScreen(Rgba8 const& clearColor, Rgba8 const& depthClearColor)
+{
+    UNUSED(depthClearColor)
+
+    RasterizeBins();
+
+    std::fill(m_colorBuffer.begin(), m_colorBuffer.end(), clearColor);
+    std::fill(m_depthBuffer.begin(), m_depthBuffer.end(), 1.f);
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::BeginCamera(Camera const& camera)
+{
+    Mat44 worldToRender = camera.GetCameraToRenderTransform();
+    worldToRender.Append(camera.GetWorldToCameraTransform());
+
+    BeginCamera(worldToRender, camera.GetRenderToClipTransform());
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::BeginCamera(Mat44 const& worldToRender, Mat44 const& renderToClip)
+{
+    m_worldToClip = renderToClip;
+    m_worldToClip.Append(worldToRender);
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::EndCamera(Camera const& camera)
+{
+    UNUSED(camera)
+
+    EndCamera();
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::EndCamera()
+{
+    RasterizeBins();
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::RenderEmissive()
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::SetModelConstants(Mat44 const& modelToWorldTransform, Rgba8 const& modelColor)
+{
+    m_modelToWorldTransform = modelToWorldTransform;
+    m_modelColor            = modelColor;
+
+    RecordConstantUpload(sizeof(Mat44) + sizeof(float) * 4);
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::SetBlendMode(eRenderBlendMode const mode)
+{
+    m_blendMode = mode;
+    RecordStateChange();
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::SetRasterizerMode(eRenderRasterizerMode const mode)
+{
+    m_rasterizerMode = mode;
+    RecordStateChange();
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::SetSamplerMode(eRenderSamplerMode const mode)
+{
+    m_samplerMode = mode;
+    RecordStateChange();
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::SetDepthMode(eRenderDepthMode const mode)
+{
+    m_depthMode = mode;
+    RecordStateChange();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Every Texture this backend hands out is one of its own sSoftwareTextures.
+//
+void SoftwareRenderBackend::BindTexture(Texture const* texture)
+{
+    m_texture = reinterpret_cast<sSoftwareTexture const*>(texture);
+    RecordStateChange();
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::BindShader(Shader* shader)
+{
+    UNUSED(shader)
+    RecordStateChange();
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::SetLightConstants(Light const* lights, int const lightCount)
+{
+    UNUSED(lights)
+    RecordConstantUpload(sizeof(Light) * static_cast<size_t>(lightCount));
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::BindPipelineState(PipelineState const* pipelineState)
+{
+    sPipelineStateDesc const& desc = pipelineState->GetDesc();
+
+    RecordStateChange();
+    m_blendMode      = desc.m_blendMode;
+    m_rasterizerMode = desc.m_rasterizerMode;
+    m_samplerMode    = desc.m_samplerMode;
+    m_depthMode      = desc.m_depthMode;
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::DrawVertexArray(int const numVertexes, Vertex_PCU const* vertexes)
+{
+    RecordDraw(numVertexes);
+    RecordVertexUpload(static_cast<size_t>(numVertexes) * sizeof(Vertex_PCU));
+
+    DrawTriangles(m_modelToWorldTransform, m_modelColor, vertexes, numVertexes, nullptr, 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+int SoftwareRenderBackend::CreateStaticMesh(Vertex_PCU const* vertexes, int const vertexCount, unsigned int const* indexes, int const indexCount)
+{
+    RecordVertexUpload(static_cast<size_t>(vertexCount) * sizeof(Vertex_PCU) + static_cast<size_t>(indexCount) * sizeof(unsigned int));
+
+    int const staticMeshId = AllocateStaticMeshId();
+
+    if (staticMeshId >= static_cast<int>(m_staticMeshes.size()))
+    {
+        m_staticMeshes.resize(staticMeshId + 1);
+    }
+
+    sStaticMesh& staticMesh = m_staticMeshes[staticMeshId];
+    staticMesh.m_vertexes.assign(vertexes, vertexes + vertexCount);
+    staticMesh.m_indexes.assign(indexes, indexes + indexCount);
+
+    return staticMeshId;
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::DestroyStaticMesh(int const staticMeshId)
+{
+    if (FreeStaticMeshId(staticMeshId))
+    {
+        m_staticMeshes[staticMeshId] = sStaticMesh();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::DrawStaticMesh(int const staticMeshId)
+{
+    bool const isLive = IsStaticMeshIdLive(staticMeshId);
+    ASSERT_OR_DIE(isLive, "DrawStaticMesh on a destroyed static mesh")
+
+    if (!isLive)
+    {
+        return;
+    }
+
+    sStaticMesh const&  staticMesh  = m_staticMeshes[staticMeshId];
+    int const           vertexCount = static_cast<int>(staticMesh.m_vertexes.size());
+    int const           indexCount  = static_cast<int>(staticMesh.m_indexes.size());
+    unsigned int const* indexes     = indexCount == 0 ? nullptr : staticMesh.m_indexes.data();
+    int const           drawCount   = indexCount == 0 ? vertexCount : indexCount;
+
+    RecordDraw(drawCount);
+    DrawTriangles(m_modelToWorldTransform, m_modelColor, staticMesh.m_vertexes.data(), vertexCount, indexes, indexCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::DrawStaticMeshInstanced(int const staticMeshId, sInstanceData const* instances, int const instanceCount)
+{
+    bool const isLive = IsStaticMeshIdLive(staticMeshId);
+    ASSERT_OR_DIE(isLive, "DrawStaticMeshInstanced on a destroyed static mesh")
+
+    if (!isLive)
+    {
+        return;
+    }
+
+    sStaticMesh const&  staticMesh  = m_staticMeshes[staticMeshId];
+    int const           vertexCount = static_cast<int>(staticMesh.m_vertexes.size());
+    int const           indexCount  = static_cast<int>(staticMesh.m_indexes.size());
+    unsigned int const* indexes     = indexCount == 0 ? nullptr : staticMesh.m_indexes.data();
+    int const           drawCount   = indexCount == 0 ? vertexCount : indexCount;
+
+    RecordDraw(drawCount * instanceCount);
+    RecordVertexUpload(sizeof(sInstanceData) * static_cast<size_t>(instanceCount));
+
+    for (int instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex)
+    {
+        DrawTriangles(instances[instanceIndex].m_modelToWorldTransform, instances[instanceIndex].m_color, staticMesh.m_vertexes.data(), vertexCount, indexes, indexCount);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+Shader* SoftwareRenderBackend::CreateOrGetShaderFromFile(char const* shaderName, eRenderVertexType const vertexType)
+{
+    UNUSED(shaderName)
+    UNUSED(vertexType)
+
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Loaded as RGBA8 with the rows flipped, so v = 0 is the bottom of the image as on the GPU path.
+// With a TextureCache the top mip of the cooked texture is copied as it is, already in that layout;
+// if the cache cannot serve it the image is decoded here instead.
+//
+Texture* SoftwareRenderBackend::CreateOrGetTextureFromFile(char const* imageFilePath)
+{
+    for (sSoftwareTexture* texture : m_textures)
+    {
+        if (texture->m_filePath == imageFilePath)
+        {
+            return reinterpret_cast<Texture*>(texture);
+        }
+    }
+
+    sSoftwareTexture* texture = new sSoftwareTexture();
+    texture->m_filePath       = imageFilePath;
+
+    CookedTexture cookedTexture;
+
+    if (m_config.m_textureCache != nullptr && m_config.m_textureCache->Load(imageFilePath, cookedTexture))
+    {
+        Rgba8 const* topMip = cookedTexture.GetMipTexels(0);
+
+        texture->m_width  = cookedTexture.GetWidth();
+        texture->m_height = cookedTexture.GetHeight();
+        texture->m_texels.assign(topMip, topMip + static_cast<size_t>(texture->m_width) * texture->m_height);
+        m_textures.push_back(texture);
+
+        return reinterpret_cast<Texture*>(texture);
+    }
+
+    int            width        = 0;
+    int            height       = 0;
+    int            channelCount = 0;
+    unsigned char* pixels       = stbi_load(imageFilePath, &width, &height, &channelCount, 4);
+
+    GUARANTEE_OR_DIE(pixels != nullptr, Stringf("SoftwareRenderBackend could not load texture \"%s\"", imageFilePath))
+
+    texture->m_width  = width;
+    texture->m_height = height;
+    texture->m_texels.resize(static_cast<size_t>(width) * height);
+
+    for (int row = 0; row < height; ++row)
+    {
+        unsigned char const* source = pixels + static_cast<size_t>(height - 1 - row) * width * 4;
+
+        for (int column = 0; column < width; ++column)
+        {
+            texture->m_texels[static_cast<size_t>(row) * width + column] = Rgba8(source[column * 4], source[column * 4 + 1], source[column * 4 + 2], source[column * 4 + 3]);
+        }
+    }
+
+    stbi_image_free(pixels);
+    m_textures.push_back(texture);
+
+    return reinterpret_cast<Texture*>(texture);
+}
+
+//----------------------------------------------------------------------------------------------------
+int SoftwareRenderBackend::GetWidth() const
+{
+    return m_config.m_width;
+}
+
+//----------------------------------------------------------------------------------------------------
+int SoftwareRenderBackend::GetHeight() const
+{
+    return m_config.m_height;
+}
+
+//----------------------------------------------------------------------------------------------------
+Rgba8 SoftwareRenderBackend::GetPixel(int const x, int const y) const
+{
+    return m_colorBuffer[static_cast<size_t>(y) * m_pitch + x];
+}
+
+//----------------------------------------------------------------------------------------------------
+void SoftwareRenderBackend::ReadColorBuffer(std::vector<Rgba8>& out_pixels) const
+{
+    out_pixels.resize(static_cast<size_t>(m_config.m_width) * m_config.m_height);
+
+    for (int y = 0; y < m_config.m_height; ++y)
+    {
+        std::copy_n(m_colorBuffer.begin() + static_cast<ptrdiff_t>(y) * m_pitch, m_config.m_width, out_pixels.begin() + static_cast<ptrdiff_t>(y) * m_config.m_width);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t SoftwareRenderBackend::GetColorBufferHash() const
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    for (int y = 0; y < m_config.m_height; ++y)
+    {
+        for (int x = 0; x < m_config.m_width; ++x)
+        {
+            Rgba8 const         pixel    = GetPixel(x, y);
+            unsigned char const bytes[4] = { pixel.r, pixel.g, pixel.b, pixel.a };
+
+            for (unsigned char const byte : bytes)
+            {
+                hash = (hash ^ byte) * 1099511628211ull;
+            }
+        }
+    }
+
+    return hash;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Uncompressed 32-bit TGA. TGA rows run bottom to top by default, the same as the color buffer.
+//
+bool SoftwareRenderBackend::WriteColorBufferToTGA(char const* filePath) const
+{
+    FILE* file = nullptr;
+
+#if defined(_WIN32)
+    if (fopen_s(&file, filePath, "wb") != 0)
+    {
+        file = nullptr;
+    }
+#else
+    file = fopen(filePath, "wb");
+#endif
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    unsigned char header[18] = {};
+    header[2]                = 2;       // Uncompressed true-color
+    header[12]               = static_cast<unsigned char>(m_config.m_width & 0xFF);
+    header[13]               = static_cast<unsigned char>(m_config.m_width >> 8);
+    header[14]               = static_cast<unsigned char>(m_config.m_height & 0xFF);
+    header[15]               = static_cast<unsigned char>(m_config.m_height >> 8);
+    header[16]               = 32;
+    header[17]               = 8;       // Alpha bits, bottom-left origin
+
+    std::vector<unsigned char> pixels;
+    pixels.reserve(static_cast<size_t>(m_config.m_width) * m_config.m_height * 4);
+
+    for (int y = 0; y < m_config.m_height; ++y)
+    {
+        for (int x = 0; x < m_config.m_width; ++x)
+        {
+            Rgba8 const pixel = GetPixel(x, y);
+            pixels.push_back(pixel.b);
+            pixels.push_back(pixel.g);
+            pixels.push_back(pixel.r);
+            pixels.push_back(pixel.a);
+        }
+    }
+
+    bool const isWritten = fwrite(header, sizeof(header), 1, file) == 1 && fwrite(pixels.data(), pixels.size(), 1, file) == 1;
+    fclose(file);
+
+    return isWritten;
+}
+
+//----------------------------------------------------------------------------------------------------
+sSoftwareRenderStatistics const& SoftwareRenderBackend::GetRasterStatistics() const
+{
+    return m_rasterStatistics;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Transforms each vertex once, the way a post-transform cache would, then clips and bins the
+// triangles in order.
+//
+void SoftwareRenderBackend::DrawTriangles(Mat44 const& modelToWorldTransform, Rgba8 const& modelColor, Vertex_PCU const* vertexes, int const vertexCount, unsigned int const* indexes, int const indexCount)
+{
+    Mat44 modelToClip = m_worldToClip;
+    modelToClip.Append(modelToWorldTransform);
+
+    float const* matrix = modelToClip.m_values;
+
+    m_clipVertexes.resize(static_cast<size_t>(vertexCount));
+
+    for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+    {
+        Vertex_PCU const& vertex   = vertexes[vertexIndex];
+        Vec3 const&       position = vertex.m_position;
+        sClipVertex&      clip     = m_clipVertexes[vertexIndex];
+
+        clip.m_position.x = matrix[Mat44::Ix] * position.x + matrix[Mat44::Jx] * position.y + matrix[Mat44::Kx] * position.z + matrix[Mat44::Tx];
+        clip.m_position.y = matrix[Mat44::Iy] * position.x + matrix[Mat44::Jy] * position.y + matrix[Mat44::Ky] * position.z + matrix[Mat44::Ty];
+        clip.m_position.z = matrix[Mat44::Iz] * position.x + matrix[Mat44::Jz] * position.y + matrix[Mat44::Kz] * position.z + matrix[Mat44::Tz];
+        clip.m_position.w = matrix[Mat44::Iw] * position.x + matrix[Mat44::Jw] * position.y + matrix[Mat44::Kw] * position.z + matrix[Mat44::Tw];
+
+        clip.m_attributes[0] = static_cast<float>(vertex.m_color.r) * INVERSE_255;
+        clip.m_attributes[1] = static_cast<float>(vertex.m_color.g) * INVERSE_255;
+        clip.m_attributes[2] = static_cast<float>(vertex.m_color.b) * INVERSE_255;
+        clip.m_attributes[3] = static_cast<float>(vertex.m_color.a) * INVERSE_255;
+        clip.m_attributes[4] = vertex.m_uvTexCoords.x;
+        clip.m_attributes[5] = vertex.m_uvTexCoords.y;
+    }
+
+    int const stateIndex = GetRasterStateIndex(modelColor);
+
+    int const drawCount = indexes == nullptr ? vertexCount : indexCount;
+
+    for (int first = 0; first + 2 < drawCount; first += 3)
+    {
+        sClipVertex triangle[3];
+
+        for (int corner = 0; corner < 3; ++corner)
+        {
+            triangle[corner] = m_clipVertexes[indexes == nullptr ? first + corner : static_cast<int>(indexes[first + corner])];
+        }
+
+        ++m_rasterStatistics.m_trianglesSubmitted;
+        ClipAndBinTriangle(triangle, stateIndex);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Consecutive draws with the same state share one sRasterState.
+//
+int SoftwareRenderBackend::GetRasterStateIndex(Rgba8 const& modelColor)
+{
+    sRasterState state;
+    state.m_texture     = m_texture;
+    state.m_blendMode   = m_blendMode;
+    state.m_samplerMode = m_samplerMode;
+    state.m_depthMode   = m_depthMode;
+    state.m_tint[0]     = static_cast<float>(modelColor.r) * INVERSE_255;
+    state.m_tint[1]     = static_cast<float>(modelColor.g) * INVERSE_255;
+    state.m_tint[2]     = static_cast<float>(modelColor.b) * INVERSE_255;
+    state.m_tint[3]     = static_cast<float>(modelColor.a) * INVERSE_255;
+
+    if (!m_rasterStates.empty())
+    {
+        sRasterState const& last = m_rasterStates.back();
+
+        if (last.m_texture == state.m_texture && last.m_blendMode == state.m_blendMode && last.m_samplerMode == state.m_samplerMode && last.m_depthMode == state.m_depthMode &&
+            last.m_tint[0] == state.m_tint[0] && last.m_tint[1] == state.m_tint[1] && last.m_tint[2] == state.m_tint[2] && last.m_tint[3] == state.m_tint[3])
+        {
+            return static_cast<int>(m_rasterStates.size()) - 1;
+        }
+    }
+
+    m_rasterStates.push_back(state);
+
+    return static_cast<int>(m_rasterStates.size()) - 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Sutherland-Hodgman against the six clip planes, then a fan over what is left.
+// A new vertex is always interpolated from the inside end of its edge toward the outside end, so two
+// triangles sharing an edge get bit-identical clip vertexes on it and stay watertight.
+//
+void SoftwareRenderBackend::ClipAndBinTriangle(sClipVertex const* triangle, int const stateIndex)
+{
+    int outsideMask = 0;
+    int outsideAll  = (1 << CLIP_PLANE_COUNT) - 1;
+
+    for (int corner = 0; corner < 3; ++corner)
+    {
+        int cornerMask = 0;
+
+        for (int plane = 0; plane < CLIP_PLANE_COUNT; ++plane)
+        {
+            cornerMask |= GetClipPlaneDistance(triangle[corner].m_position, plane) < 0.f ? 1 << plane : 0;
+        }
+
+        outsideMask |= cornerMask;
+        outsideAll  &= cornerMask;
+    }
+
+    if (outsideAll != 0)
+    {
+        ++m_rasterStatistics.m_trianglesCulled;
+        return;
+    }
+
+    if (outsideMask == 0)
+    {
+        SetUpAndBinTriangle(triangle[0], triangle[1], triangle[2], stateIndex);
+        return;
+    }
+
+    sClipVertex polygons[2][MAX_CLIPPED_VERTEXES];
+    int         vertexCount = 3;
+    int         current     = 0;
+
+    for (int corner = 0; corner < 3; ++corner)
+    {
+        polygons[0][corner] = triangle[corner];
+    }
+
+    for (int plane = 0; plane < CLIP_PLANE_COUNT && vertexCount > 0; ++plane)
+    {
+        if ((outsideMask & (1 << plane)) == 0)
+        {
+            continue;
+        }
+
+        sClipVertex const* input       = polygons[current];
+        sClipVertex*       output      = polygons[current ^ 1];
+        int                outputCount = 0;
+
+        for (int index = 0; index < vertexCount; ++index)
+        {
+            sClipVertex const& start         = input[index];
+            sClipVertex const& end           = input[(index + 1) % vertexCount];
+            float const        startDistance = GetClipPlaneDistance(start.m_position, plane);
+            float const        endDistance   = GetClipPlaneDistance(end.m_position, plane);
+            bool const         isStartInside = startDistance >= 0.f;
+            bool const         isEndInside   = endDistance >= 0.f;
+
+            if (isStartInside)
+            {
+                output[outputCount++] = start;
+            }
+
+            if (isStartInside == isEndInside)
+            {
+                continue;
+            }
+
+            sClipVertex const& inside          = isStartInside ? start : end;
+            sClipVertex const& outside         = isStartInside ? end : start;
+            float const        insideDistance  = isStartInside ? startDistance : endDistance;
+            float const        outsideDistance = isStartInside ? endDistance : startDistance;
+            float const        t               = insideDistance / (insideDistance - outsideDistance);
+            sClipVertex&       clipped         = output[outputCount++];
+
+            clipped.m_position.x = inside.m_position.x + t * (outside.m_position.x - inside.m_position.x);
+            clipped.m_position.y = inside.m_position.y + t * (outside.m_position.y - inside.m_position.y);
+            clipped.m_position.z = inside.m_position.z + t * (outside.m_position.z - inside.m_position.z);
+            clipped.m_position.w = inside.m_position.w + t * (outside.m_position.w - inside.m_position.w);
+
+            for (int attribute = 0; attribute < 6; ++attribute)
+            {
+                clipped.m_attributes[attribute] = inside.m_attributes[attribute] + t * (outside.m_attributes[attribute] - inside.m_attributes[attribute]);
+            }
+        }
+
+        vertexCount = outputCount;
+        current    ^= 1;
+    }
+
+    if (vertexCount < 3)
+    {
+        ++m_rasterStatistics.m_trianglesCulled;
+        return;
+    }
+
+    for (int index = 1; index + 1 < vertexCount; ++index)
+    {
+        SetUpAndBinTriangle(polygons[current][0], polygons[current][index], polygons[current][index + 1], stateIndex);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Projects to 28.4 fixed-point pixels (y up), culls or rewinds to counter-clockwise, computes the
+// edge functions, and adds the triangle to every tile its bounds touch.
+//
+void SoftwareRenderBackend::SetUpAndBinTriangle(sClipVertex const& vertex0, sClipVertex const& vertex1, sClipVertex const& vertex2, int const stateIndex)
+{
+    sClipVertex const* corners[3] = { &vertex0, &vertex1, &vertex2 };
+    sRasterTriangle    triangle;
+
+    float const maxX = static_cast<float>(m_config.m_width * SUBPIXEL_SCALE);
+    float const maxY = static_cast<float>(m_config.m_height * SUBPIXEL_SCALE);
+
+    for (int corner = 0; corner < 3; ++corner)
+    {
+        Vec4 const& position = corners[corner]->m_position;
+
+        if (position.w <= 0.f)
+        {
+            ++m_rasterStatistics.m_trianglesCulled;
+            return;
+        }
+
+        float const inverseW = 1.f / position.w;
+        float const screenX  = (position.x * inverseW * 0.5f + 0.5f) * maxX;
+        float const screenY  = (position.y * inverseW * 0.5f + 0.5f) * maxY;
+
+        triangle.m_x[corner]        = static_cast<int32_t>(floorf((screenX < 0.f ? 0.f : screenX > maxX ? maxX : screenX) + 0.5f));
+        triangle.m_y[corner]        = static_cast<int32_t>(floorf((screenY < 0.f ? 0.f : screenY > maxY ? maxY : screenY) + 0.5f));
+        triangle.m_depth[corner]    = position.z * inverseW;
+        triangle.m_inverseW[corner] = inverseW;
+
+        for (int attribute = 0; attribute < 6; ++attribute)
+        {
+            triangle.m_attributesOverW[corner][attribute] = corners[corner]->m_attributes[attribute] * inverseW;
+        }
+    }
+
+    int64_t const doubleArea = static_cast<int64_t>(triangle.m_x[1] - triangle.m_x[0]) * (triangle.m_y[2] - triangle.m_y[0]) -
+                               static_cast<int64_t>(triangle.m_y[1] - triangle.m_y[0]) * (triangle.m_x[2] - triangle.m_x[0]);
+
+    bool const isCullingBack = m_rasterizerMode == eRenderRasterizerMode::SOLID_CULL_BACK || m_rasterizerMode == eRenderRasterizerMode::WIREFRAME_CULL_BACK;
+
+    if (doubleArea == 0 || (doubleArea < 0 && isCullingBack))
+    {
+        ++m_rasterStatistics.m_trianglesCulled;
+        return;
+    }
+
+    if (doubleArea < 0)
+    {
+        std::swap(triangle.m_x[1], triangle.m_x[2]);
+        std::swap(triangle.m_y[1], triangle.m_y[2]);
+        std::swap(triangle.m_depth[1], triangle.m_depth[2]);
+        std::swap(triangle.m_inverseW[1], triangle.m_inverseW[2]);
+        std::swap(triangle.m_attributesOverW[1], triangle.m_attributesOverW[2]);
+    }
+
+    for (int edge = 0; edge < 3; ++edge)
+    {
+        int const start = (edge + 1) % 3;
+        int const end   = (edge + 2) % 3;
+
+        triangle.m_edgeA[edge] = triangle.m_y[start] - triangle.m_y[end];
+        triangle.m_edgeB[edge] = triangle.m_x[end] - triangle.m_x[start];
+
+        // Counter-clockwise with y up: left edges run downward, top edges run right to left
+        bool const isTopLeft      = triangle.m_edgeA[edge] > 0 || (triangle.m_edgeA[edge] == 0 && triangle.m_edgeB[edge] < 0);
+        triangle.m_edgeBias[edge] = isTopLeft ? 0 : -1;
+    }
+
+    int32_t const minFixedX = std::min(triangle.m_x[0], std::min(triangle.m_x[1], triangle.m_x[2]));
+    int32_t const minFixedY = std::min(triangle.m_y[0], std::min(triangle.m_y[1], triangle.m_y[2]));
+    int32_t const maxFixedX = std::max(triangle.m_x[0], std::max(triangle.m_x[1], triangle.m_x[2]));
+    int32_t const maxFixedY = std::max(triangle.m_y[0], std::max(triangle.m_y[1], triangle.m_y[2]));
+
+    // Pixels whose centers (x * 16 + 8) can be inside the bounds
+    triangle.m_minX = std::max((minFixedX - SUBPIXEL_SCALE / 2 + SUBPIXEL_SCALE - 1) >> SUBPIXEL_BITS, 0);
+    triangle.m_minY = std::max((minFixedY - SUBPIXEL_SCALE / 2 + SUBPIXEL_SCALE - 1) >> SUBPIXEL_BITS, 0);
+    triangle.m_maxX = std::min((maxFixedX - SUBPIXEL_SCALE / 2) >> SUBPIXEL_BITS, m_config.m_width - 1);
+    triangle.m_maxY = std::min((maxFixedY - SUBPIXEL_SCALE / 2) >> SUBPIXEL_BITS, m_config.m_height - 1);
+
+    if (triangle.m_minX > triangle.m_maxX || triangle.m_minY > triangle.m_maxY)
+    {
+        ++m_rasterStatistics.m_trianglesCulled;
+        return;
+    }
+
+    triangle.m_inverseDoubleArea = 1.f / static_cast<float>(doubleArea < 0 ? -doubleArea : doubleArea);
+    triangle.m_stateIndex        = stateIndex;
+
+    int const triangleIndex = static_cast<int>(m_triangles.size());
+    m_triangles.push_back(triangle);
+    ++m_rasterStatistics.m_trianglesBinned;
+
+    for (int tileY = triangle.m_minY / TILE_SIZE; tileY <= triangle.m_maxY / TILE_SIZE; ++tileY)
+    {
+        for (int tileX = triangle.m_minX / TILE_SIZE; tileX <= triangle.m_maxX / TILE_SIZE; ++tileX)
+        {
+            m_tileBins[tileY * m_tileCountX + tileX].push_back(triangleIndex);
+            ++m_rasterStatistics.m_tileBinEntries;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Tiles go out one at a time on g_theJobSystem. A tile is only ever touched by the job slot that
+// took it, so no pixel needs a lock and the result does not depend on which slot took which tile.
+//
+void SoftwareRenderBackend::RasterizeBins()
+{
+    if (m_triangles.empty())
+    {
+        return;
+    }
+
+    PROFILE_SCOPE("SoftwareRenderBackend::RasterizeBins");
+
+    int const tileCount = m_tileCountX * m_tileCountY;
+    int       slotCount = 1 + static_cast<int>(m_triangles.size()) / TRIANGLES_PER_EXTRA_SLOT;
+    slotCount           = std::min(std::min(slotCount, m_config.m_workerCount), tileCount);
+
+    std::vector<int64_t> pixelsWritten(static_cast<size_t>(slotCount), 0);
+
+    ParallelForSlots(g_theJobSystem, tileCount, 1, slotCount, [this, &pixelsWritten](int const firstTile, int const endTile, int const slot)
+    {
+        PROFILE_SCOPE("SoftwareRenderBackend::RasterizeTiles");
+
+        for (int tileIndex = firstTile; tileIndex < endTile; ++tileIndex)
+        {
+            RasterizeTile(tileIndex, pixelsWritten[slot]);
+        }
+    });
+
+    for (int64_t const slotPixels : pixelsWritten)
+    {
+        m_rasterStatistics.m_pixelsWritten += slotPixels;
+    }
+
+    for (std::vector<int>& bin : m_tileBins)
+    {
+        bin.clear();
+    }
+
+    m_triangles.clear();
+    m_rasterStates.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Walks each triangle's bounds inside the tile a row at a time. With SSE, the edge functions of four
+// neighboring pixels step together and the depth test runs on all four before any of them is shaded.
+//
+void SoftwareRenderBackend::RasterizeTile(int const tileIndex, int64_t& out_pixelsWritten)
+{
+    std::vector<int> const& bin = m_tileBins[tileIndex];
+
+    if (bin.empty())
+    {
+        return;
+    }
+
+    int const tileMinX = (tileIndex % m_tileCountX) * TILE_SIZE;
+    int const tileMinY = (tileIndex / m_tileCountX) * TILE_SIZE;
+    int const tileMaxX = std::min(tileMinX + TILE_SIZE, m_config.m_width) - 1;
+    int const tileMaxY = std::min(tileMinY + TILE_SIZE, m_config.m_height) - 1;
+
+    for (int const triangleIndex : bin)
+    {
+        sRasterTriangle const& triangle = m_triangles[triangleIndex];
+        sRasterState const&    state    = m_rasterStates[triangle.m_stateIndex];
+
+        // Rows start on a 4-pixel boundary; tiles are 4-aligned and the buffer rows are padded, so the
+        // extra pixels are still in this tile and fail the edge test
+        int const  minX        = std::max(triangle.m_minX, tileMinX) & ~3;
+        int const  maxX        = std::min(triangle.m_maxX, tileMaxX);
+        int const  minY        = std::max(triangle.m_minY, tileMinY);
+        int const  maxY        = std::min(triangle.m_maxY, tileMaxY);
+        bool const isDepthTest = state.m_depthMode == eRenderDepthMode::READ_ONLY_LESS_EQUAL || state.m_depthMode == eRenderDepthMode::READ_WRITE_LESS_EQUAL;
+        float const depth0     = triangle.m_depth[0];
+        float const depthStep1 = triangle.m_depth[1] - depth0;
+        float const depthStep2 = triangle.m_depth[2] - depth0;
+
+        for (int y = minY; y <= maxY; ++y)
+        {
+            int32_t const pixelY = y * SUBPIXEL_SCALE + SUBPIXEL_SCALE / 2;
+            int32_t const pixelX = minX * SUBPIXEL_SCALE + SUBPIXEL_SCALE / 2;
+            int32_t       rowEdges[3];
+
+            for (int edge = 0; edge < 3; ++edge)
+            {
+                int const origin = (edge + 1) % 3;
+                rowEdges[edge]   = triangle.m_edgeA[edge] * (pixelX - triangle.m_x[origin]) + triangle.m_edgeB[edge] * (pixelY - triangle.m_y[origin]);
+            }
+
+            int const rowStart = y * m_pitch;
+
+#if defined(GAME_SIMD_SSE)
+            __m128i const laneSteps = _mm_set_epi32(3 * SUBPIXEL_SCALE, 2 * SUBPIXEL_SCALE, SUBPIXEL_SCALE, 0);
+            __m128i       edges[3];
+            __m128i       biases[3];
+            __m128i       chunkSteps[3];
+
+            for (int edge = 0; edge < 3; ++edge)
+            {
+                __m128i const edgeA = _mm_set1_epi32(triangle.m_edgeA[edge]);
+
+                // A * {0, 16, 32, 48} without SSE4.1's 32-bit multiply: A is exact in a float
+                __m128i const laneOffsets = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(edgeA), _mm_cvtepi32_ps(laneSteps)));
+
+                edges[edge]      = _mm_add_epi32(_mm_set1_epi32(rowEdges[edge]), laneOffsets);
+                biases[edge]     = _mm_set1_epi32(triangle.m_edgeBias[edge]);
+                chunkSteps[edge] = _mm_set1_epi32(triangle.m_edgeA[edge] * 4 * SUBPIXEL_SCALE);
+            }
+
+            __m128 const  inverseDoubleArea = _mm_set1_ps(triangle.m_inverseDoubleArea);
+            __m128i const minusOne          = _mm_set1_epi32(-1);
+
+            for (int x = minX; x <= maxX; x += 4)
+            {
+                __m128i const biased = _mm_or_si128(_mm_or_si128(_mm_add_epi32(edges[0], biases[0]), _mm_add_epi32(edges[1], biases[1])), _mm_add_epi32(edges[2], biases[2]));
+                __m128        inside = _mm_castsi128_ps(_mm_cmpgt_epi32(biased, minusOne));
+
+                if (_mm_movemask_ps(inside) != 0)
+                {
+                    __m128 const weight1 = _mm_mul_ps(_mm_cvtepi32_ps(edges[1]), inverseDoubleArea);
+                    __m128 const weight2 = _mm_mul_ps(_mm_cvtepi32_ps(edges[2]), inverseDoubleArea);
+                    __m128 const depth   = _mm_add_ps(_mm_set1_ps(depth0), _mm_add_ps(_mm_mul_ps(weight1, _mm_set1_ps(depthStep1)), _mm_mul_ps(weight2, _mm_set1_ps(depthStep2))));
+
+                    if (isDepthTest)
+                    {
+                        inside = _mm_and_ps(inside, _mm_cmple_ps(depth, _mm_loadu_ps(&m_depthBuffer[rowStart + x])));
+                    }
+
+                    int const passMask = _mm_movemask_ps(inside);
+
+                    if (passMask != 0)
+                    {
+                        float weights1[4];
+                        float weights2[4];
+                        float depths[4];
+                        _mm_storeu_ps(weights1, weight1);
+                        _mm_storeu_ps(weights2, weight2);
+                        _mm_storeu_ps(depths, depth);
+
+                        for (int lane = 0; lane < 4; ++lane)
+                        {
+                            if ((passMask & (1 << lane)) != 0)
+                            {
+                                ShadePixel(triangle, state, weights1[lane], weights2[lane], depths[lane], rowStart + x + lane, out_pixelsWritten);
+                            }
+                        }
+                    }
+                }
+
+                for (int edge = 0; edge < 3; ++edge)
+                {
+                    edges[edge] = _mm_add_epi32(edges[edge], chunkSteps[edge]);
+                }
+            }
+#else
+            for (int x = minX; x <= maxX; ++x)
+            {
+                int32_t const offset = (x - minX) * SUBPIXEL_SCALE;
+                int32_t const edge0  = rowEdges[0] + triangle.m_edgeA[0] * offset;
+                int32_t const edge1  = rowEdges[1] + triangle.m_edgeA[1] * offset;
+                int32_t const edge2  = rowEdges[2] + triangle.m_edgeA[2] * offset;
+
+                if (((edge0 + triangle.m_edgeBias[0]) | (edge1 + triangle.m_edgeBias[1]) | (edge2 + triangle.m_edgeBias[2])) < 0)
+                {
+                    continue;
+                }
+
+                float const weight1 = static_cast<float>(edge1) * triangle.m_inverseDoubleArea;
+                float const weight2 = static_cast<float>(edge2) * triangle.m_inverseDoubleArea;
+                float const depth   = depth0 + (weight1 * depthStep1 + weight2 * depthStep2);
+
+                if (isDepthTest && !(depth <= m_depthBuffer[rowStart + x]))
+                {
+                    continue;
+                }
+
+                ShadePixel(triangle, state, weight1, weight2, depth, rowStart + x, out_pixelsWritten);
+            }
+#endif
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Perspective-correct attributes, then Data/Shaders/Default's PixelMain and the output merger.
+//
+void SoftwareRenderBackend::ShadePixel(sRasterTriangle const& triangle, sRasterState const& state, float const weight1, float const weight2, float const depth, int const pixelIndex, int64_t& out_pixelsWritten)
+{
+    float const weight0  = 1.f - weight1 - weight2;
+    float const inverseW = weight0 * triangle.m_inverseW[0] + weight1 * triangle.m_inverseW[1] + weight2 * triangle.m_inverseW[2];
+    float const w        = 1.f / inverseW;
+    float       attributes[6];
+
+    for (int attribute = 0; attribute < 6; ++attribute)
+    {
+        attributes[attribute] = (weight0 * triangle.m_attributesOverW[0][attribute] + weight1 * triangle.m_attributesOverW[1][attribute] + weight2 * triangle.m_attributesOverW[2][attribute]) * w;
+    }
+
+    float color[4] = { attributes[0] * state.m_tint[0], attributes[1] * state.m_tint[1], attributes[2] * state.m_tint[2], attributes[3] * state.m_tint[3] };
+
+    if (state.m_texture != nullptr)
+    {
+        sSoftwareTexture const& texture    = *state.m_texture;
+        bool const              isWrapping = state.m_samplerMode == eRenderSamplerMode::BILINEAR_WRAP;
+        float                   texel[4]   = {};
+
+        if (state.m_samplerMode == eRenderSamplerMode::POINT_CLAMP)
+        {
+            int const   column = GetWrappedOrClampedTexel(static_cast<int>(floorf(attributes[4] * static_cast<float>(texture.m_width))), texture.m_width, false);
+            int const   row    = GetWrappedOrClampedTexel(static_cast<int>(floorf(attributes[5] * static_cast<float>(texture.m_height))), texture.m_height, false);
+            Rgba8 const sample = texture.m_texels[static_cast<size_t>(row) * texture.m_width + column];
+
+            texel[0] = static_cast<float>(sample.r) * INVERSE_255;
+            texel[1] = static_cast<float>(sample.g) * INVERSE_255;
+            texel[2] = static_cast<float>(sample.b) * INVERSE_255;
+            texel[3] = static_cast<float>(sample.a) * INVERSE_255;
+        }
+        else
+        {
+            float const texelX    = attributes[4] * static_cast<float>(texture.m_width) - 0.5f;
+            float const texelY    = attributes[5] * static_cast<float>(texture.m_height) - 0.5f;
+            float const floorX    = floorf(texelX);
+            float const floorY    = floorf(texelY);
+            float const fractionX = texelX - floorX;
+            float const fractionY = texelY - floorY;
+            int const   columns[2] = { GetWrappedOrClampedTexel(static_cast<int>(floorX), texture.m_width, isWrapping), GetWrappedOrClampedTexel(static_cast<int>(floorX) + 1, texture.m_width, isWrapping) };
+            int const   rows[2]    = { GetWrappedOrClampedTexel(static_cast<int>(floorY), texture.m_height, isWrapping), GetWrappedOrClampedTexel(static_cast<int>(floorY) + 1, texture.m_height, isWrapping) };
+            float const weights[4] = { (1.f - fractionX) * (1.f - fractionY), fractionX * (1.f - fractionY), (1.f - fractionX) * fractionY, fractionX * fractionY };
+
+            for (int corner = 0; corner < 4; ++corner)
+            {
+                Rgba8 const sample = texture.m_texels[static_cast<size_t>(rows[corner / 2]) * texture.m_width + columns[corner % 2]];
+
+                texel[0] += weights[corner] * static_cast<float>(sample.r) * INVERSE_255;
+                texel[1] += weights[corner] * static_cast<float>(sample.g) * INVERSE_255;
+                texel[2] += weights[corner] * static_cast<float>(sample.b) * INVERSE_255;
+                texel[3] += weights[corner] * static_cast<float>(sample.a) * INVERSE_255;
+            }
+        }
+
+        for (int channel = 0; channel < 4; ++channel)
+        {
+            color[channel] *= texel[channel];
+        }
+    }
+
+    if (color[3] <= 0.001f)
+    {
+        return;
+    }
+
+    if (state.m_depthMode == eRenderDepthMode::READ_WRITE_LESS_EQUAL)
+    {
+        m_depthBuffer[pixelIndex] = depth;
+    }
+
+    Rgba8&      destination = m_colorBuffer[pixelIndex];
+    float const alpha       = color[3] > 1.f ? 1.f : color[3];
+
+    if (state.m_blendMode == eRenderBlendMode::ALPHA)
+    {
+        float const destinationColor[4] = { static_cast<float>(destination.r) * INVERSE_255, static_cast<float>(destination.g) * INVERSE_255, static_cast<float>(destination.b) * INVERSE_255, static_cast<float>(destination.a) * INVERSE_255 };
+
+        for (int channel = 0; channel < 4; ++channel)
+        {
+            color[channel] = color[channel] * alpha + destinationColor[channel] * (1.f - alpha);
+        }
+    }
+    else if (state.m_blendMode == eRenderBlendMode::ADDITIVE)
+    {
+        float const destinationColor[4] = { static_cast<float>(destination.r) * INVERSE_255, static_cast<float>(destination.g) * INVERSE_255, static_cast<float>(destination.b) * INVERSE_255, static_cast<float>(destination.a) * INVERSE_255 };
+
+        for (int channel = 0; channel < 4; ++channel)
+        {
+            color[channel] = color[channel] * alpha + destinationColor[channel];
+        }
+    }
+
+    destination = Rgba8(GetByteFromNormalized(color[0]), GetByteFromNormalized(color[1]), GetByteFromNormalized(color[2]), GetByteFromNormalized(color[3]));
+    ++out_pixelsWritten;
+}
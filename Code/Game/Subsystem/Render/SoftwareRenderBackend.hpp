@@ -0,0 +1,187 @@
+//----------------------------------------------------------------------------------------------------
+// SoftwareRenderBackend.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+#include "Engine/Core/StringUtils.hpp"
+#include "Game/Subsystem/Render/RenderBackend.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class TextureCache;
+
+//----------------------------------------------------------------------------------------------------
+struct sSoftwareRenderConfig
+{
+    int           m_width        = 1600;
+    int           m_height       = 800;
+    int           m_workerCount  = 4;           // Most job slots rasterizing tiles at once on g_theJobSystem
+    TextureCache* m_textureCache = nullptr;     // Not owned; when null every texture is decoded from its image
+};
+
+//----------------------------------------------------------------------------------------------------
+// What the rasterizer did in the frame currently being built, on top of sRenderStatistics.
+//
+struct sSoftwareRenderStatistics
+{
+    int     m_trianglesSubmitted = 0;
+    int     m_trianglesCulled    = 0;       // Back-facing, degenerate, or entirely outside the view
+    int     m_trianglesBinned    = 0;       // After clipping, so one submitted triangle can bin several
+    int     m_tileBinEntries     = 0;       // Sum over tiles of the triangles each one rasterizes
+    int64_t m_pixelsWritten      = 0;       // Passed the depth test and the alpha discard
+};
+
+//----------------------------------------------------------------------------------------------------
+// Renders on the CPU into its own color and depth buffers, so frames can be drawn, timed, and
+// captured on machines with no GPU or window.
+//
+// Draw calls transform, clip, and set up their triangles right away and bin them into 64 x 64 pixel
+// tiles. EndCamera (or the next ClearScreen) rasterizes the bins, with tiles handed out to up to
+// m_workerCount job slots; each tile draws its triangles in submission order and no two threads share
+// a pixel, so the image is identical for any worker count. Coverage uses 28.4 fixed-point edge
+// functions with the D3D top-left fill rule, and four pixels of a row are edge- and depth-tested at
+// once with SSE.
+//
+// Every draw is shaded like Data/Shaders/Default: texel * vertex color * model tint, discarded at
+// alpha <= 0.001. The bound shader is ignored, wireframe modes fill, and the camera viewport is
+// always the whole target. Row 0 of the color buffer is the bottom of the image.
+//
+class SoftwareRenderBackend : public RenderBackend
+{
+public:
+    explicit SoftwareRenderBackend(sSoftwareRenderConfig const& config = sSoftwareRenderConfig());
+    ~SoftwareRenderBackend() override;
+
+    void BeginFrame() override;
+
+    void ClearScreen(Rgba8 const& clearColor, Rgba8 const& depthClearColor) override;
+    void BeginCamera(Camera const& camera) override;
+    void EndCamera(Camera const& camera) override;
+    void RenderEmissive() override;
+
+    // The same as BeginCamera / EndCamera, for callers that build the transforms themselves
+    void BeginCamera(Mat44 const& worldToRender, Mat44 const& renderToClip);
+    void EndCamera();
+
+    void SetModelConstants(Mat44 const& modelToWorldTransform, Rgba8 const& modelColor) override;
+    void SetBlendMode(eRenderBlendMode mode) override;
+    void SetRasterizerMode(eRenderRasterizerMode mode) override;
+    void SetSamplerMode(eRenderSamplerMode mode) override;
+    void SetDepthMode(eRenderDepthMode mode) override;
+    void BindTexture(Texture const* texture) override;
+    void BindShader(Shader* shader) override;
+    void SetLightConstants(Light const* lights, int lightCount) override;
+    void BindPipelineState(PipelineState const* pipelineState) override;
+
+    using RenderBackend::DrawVertexArray;
+    void DrawVertexArray(int numVertexes, Vertex_PCU const* vertexes) override;
+
+    using RenderBackend::CreateStaticMesh;
+    int  CreateStaticMesh(Vertex_PCU const* vertexes, int vertexCount, unsigned int const* indexes, int indexCount) override;
+    void DestroyStaticMesh(int staticMeshId) override;
+    void DrawStaticMesh(int staticMeshId) override;
+    void DrawStaticMeshInstanced(int staticMeshId, sInstanceData const* instances, int instanceCount) override;
+
+    // Shaders are not compiled; the returned pointer is always nullptr.
+    // Textures are loaded into CPU memory; the returned pointer is only meaningful to this backend.
+    Shader*  CreateOrGetShaderFromFile(char const* shaderName, eRenderVertexType vertexType) override;
+    Texture* CreateOrGetTextureFromFile(char const* imageFilePath) override;
+
+    // Draws binned since the last EndCamera are not in the image until the next EndCamera.
+    int                              GetWidth() const;
+    int                              GetHeight() const;
+    Rgba8                            GetPixel(int x, int y) const;
+    void                             ReadColorBuffer(std::vector<Rgba8>& out_pixels) const;   // Width * height, bottom row first
+    uint64_t                         GetColorBufferHash() const;                              // FNV-1a over ReadColorBuffer, for golden images
+    bool                             WriteColorBufferToTGA(char const* filePath) const;
+    sSoftwareRenderStatistics const& GetRasterStatistics() const;
+
+private:
+    struct sSoftwareTexture
+    {
+        String             m_filePath;
+        int                m_width  = 0;
+        int                m_height = 0;
+        std::vector<Rgba8> m_texels;            // Row 0 is v = 0, the bottom of the image
+    };
+
+    // The per-draw state a triangle is shaded with
+    struct sRasterState
+    {
+        sSoftwareTexture const* m_texture     = nullptr;
+        eRenderBlendMode        m_blendMode   = eRenderBlendMode::OPAQUE;
+        eRenderSamplerMode      m_samplerMode = eRenderSamplerMode::POINT_CLAMP;
+        eRenderDepthMode        m_depthMode   = eRenderDepthMode::READ_WRITE_LESS_EQUAL;
+        float                   m_tint[4]     = { 1.f, 1.f, 1.f, 1.f };
+    };
+
+    // Clip-space vertex; attributes are r, g, b, a, u, v
+    struct sClipVertex
+    {
+        Vec4  m_position;
+        float m_attributes[6] = {};
+    };
+
+    // A counter-clockwise screen-space triangle, ready to rasterize.
+    // Edge i runs between the two vertexes other than vertex i, and is positive inside.
+    struct sRasterTriangle
+    {
+        int32_t m_x[3]                  = {};   // 28.4 fixed point, y up
+        int32_t m_y[3]                  = {};
+        int32_t m_edgeA[3]              = {};   // Edge i = A * (x - x[o]) + B * (y - y[o]), o = (i + 1) % 3
+        int32_t m_edgeB[3]              = {};
+        int32_t m_edgeBias[3]           = {};   // -1 on edges that are not top or left
+        int     m_minX                  = 0;    // Pixel bounds, inclusive and inside the target
+        int     m_minY                  = 0;
+        int     m_maxX                  = 0;
+        int     m_maxY                  = 0;
+        float   m_inverseDoubleArea     = 0.f;
+        float   m_depth[3]              = {};
+        float   m_inverseW[3]           = {};
+        float   m_attributesOverW[3][6] = {};
+        int     m_stateIndex            = 0;
+    };
+
+    struct sStaticMesh
+    {
+        std::vector<Vertex_PCU>   m_vertexes;
+        std::vector<unsigned int> m_indexes;
+    };
+
+    void DrawTriangles(Mat44 const& modelToWorldTransform, Rgba8 const& modelColor, Vertex_PCU const* vertexes, int vertexCount, unsigned int const* indexes, int indexCount);
+    int  GetRasterStateIndex(Rgba8 const& modelColor);
+    void ClipAndBinTriangle(sClipVertex const* triangle, int stateIndex);
+    void SetUpAndBinTriangle(sClipVertex const& vertex0, sClipVertex const& vertex1, sClipVertex const& vertex2, int stateIndex);
+    void RasterizeBins();
+    void RasterizeTile(int tileIndex, int64_t& out_pixelsWritten);
+    void ShadePixel(sRasterTriangle const& triangle, sRasterState const& state, float weight1, float weight2, float depth, int pixelIndex, int64_t& out_pixelsWritten);
+
+    sSoftwareRenderConfig             m_config;
+    int                               m_pitch      = 0;     // m_width rounded up to a whole SSE row chunk
+    int                               m_tileCountX = 0;
+    int                               m_tileCountY = 0;
+    std::vector<Rgba8>                m_colorBuffer;
+    std::vector<float>                m_depthBuffer;
+
+    // Current state, captured into an sRasterState per draw
+    Mat44                             m_worldToClip;
+    Mat44                             m_modelToWorldTransform;
+    Rgba8                             m_modelColor;
+    eRenderBlendMode                  m_blendMode      = eRenderBlendMode::OPAQUE;
+    eRenderRasterizerMode             m_rasterizerMode = eRenderRasterizerMode::SOLID_CULL_BACK;
+    eRenderSamplerMode                m_samplerMode    = eRenderSamplerMode::POINT_CLAMP;
+    eRenderDepthMode                  m_depthMode      = eRenderDepthMode::READ_WRITE_LESS_EQUAL;
+    sSoftwareTexture const*           m_texture        = nullptr;
+
+    // Work binned since the last RasterizeBins
+    std::vector<sRasterState>         m_rasterStates;
+    std::vector<sRasterTriangle>      m_triangles;
+    std::vector<std::vector<int>>     m_tileBins;           // Triangle indices per tile, in submission order
+    std::vector<sClipVertex>          m_clipVertexes;       // One draw's vertexes in clip space, reused
+
+    std::vector<sStaticMesh>          m_staticMeshes;       // Indexed by static mesh id
+    std::vector<sSoftwareTexture*>    m_textures;           // Owned
+    sSoftwareRenderStatistics         m_rasterStatistics;
+};
@@ -0,0 +1,384 @@
+//----------------------------------------------------------------------------------------------------
+// BakedMesh.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Resource/BakedMesh.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Subsystem/Resource/ObjMeshParser.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static_assert(sizeof(sBakedMeshHeader) % 16 == 0, "sBakedMeshHeader must keep the first section aligned");
+static_assert(sizeof(sSubmesh) == 12, "sSubmesh is stored in .bmesh files as three 32-bit fields");
+
+//----------------------------------------------------------------------------------------------------
+static uint64_t constexpr SECTION_ALIGNMENT = 16;
+
+//----------------------------------------------------------------------------------------------------
+static uint64_t AlignSectionOffset(uint64_t const offset)
+{
+    return (offset + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool IsSectionInFile(uint64_t const offset, uint32_t const recordCount, uint64_t const recordSize, uint64_t const fileSize)
+{
+    return offset % SECTION_ALIGNMENT == 0 && offset <= fileSize && recordCount * recordSize <= fileSize - offset;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Only the header and submesh table are read here; the vertex and index pages stay on disk until
+// something touches them.
+//
+bool BakedMesh::Load(char const* filePath, String* out_error)
+{
+    Unload();
+
+    auto const fail = [this, out_error](char const* reason)
+    {
+        Unload();
+
+        if (out_error != nullptr)
+        {
+            *out_error = reason;
+        }
+
+        return false;
+    };
+
+    if (!m_file.Open(filePath))
+    {
+        return fail("could not map the file");
+    }
+
+    uint64_t const fileSize = m_file.GetSize();
+
+    if (fileSize < sizeof(sBakedMeshHeader))
+    {
+        return fail("too small to hold a header");
+    }
+
+    sBakedMeshHeader const* header = reinterpret_cast<sBakedMeshHeader const*>(m_file.GetData());
+
+    if (header->m_magic != BAKED_MESH_MAGIC)
+    {
+        return fail("not a baked mesh");
+    }
+
+    if (header->m_version != BAKED_MESH_VERSION)
+    {
+        return fail("baked with another version; rebake it");
+    }
+
+    if (header->m_fileSize != fileSize)
+    {
+        return fail("file size does not match its header");
+    }
+
+    uint64_t vertexStride = 0;
+
+    if (header->m_vertexFormat == static_cast<uint32_t>(eBakedVertexFormat::PCU)) vertexStride = sizeof(Vertex_PCU);
+    if (header->m_vertexFormat == static_cast<uint32_t>(eBakedVertexFormat::PCUTBN)) vertexStride = sizeof(Vertex_PCUTBN);
+
+    if (vertexStride == 0)
+    {
+        return fail("unknown vertex format");
+    }
+
+    if (header->m_vertexStride != vertexStride)
+    {
+        return fail("vertex layout does not match this build; rebake it");
+    }
+
+    if (!IsSectionInFile(header->m_vertexOffset, header->m_vertexCount, vertexStride, fileSize) ||
+        !IsSectionInFile(header->m_indexOffset, header->m_indexCount, sizeof(uint32_t), fileSize) ||
+        !IsSectionInFile(header->m_submeshOffset, header->m_submeshCount, sizeof(sSubmesh), fileSize) ||
+        !IsSectionInFile(header->m_materialOffset, header->m_materialCount, BAKED_MATERIAL_NAME_SIZE, fileSize))
+    {
+        return fail("a section lies outside the file");
+    }
+
+    m_header = header;
+
+    uint64_t const drawCount = header->m_indexCount > 0 ? header->m_indexCount : header->m_vertexCount;
+
+    for (int submeshIndex = 0; submeshIndex < GetSubmeshCount(); ++submeshIndex)
+    {
+        sSubmesh const& submesh = GetSubmeshes()[submeshIndex];
+
+        if (static_cast<uint64_t>(submesh.m_firstIndex) + submesh.m_indexCount > drawCount)
+        {
+            return fail("a submesh lies outside the mesh");
+        }
+
+        if (submesh.m_materialIndex < -1 || submesh.m_materialIndex >= GetMaterialCount())
+        {
+            return fail("a submesh names a missing material");
+        }
+    }
+
+    for (int materialIndex = 0; materialIndex < GetMaterialCount(); ++materialIndex)
+    {
+        if (memchr(GetMaterialName(materialIndex), '\0', BAKED_MATERIAL_NAME_SIZE) == nullptr)
+        {
+            return fail("a material name is not terminated");
+        }
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void BakedMesh::Unload()
+{
+    m_header = nullptr;
+    m_file.Close();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool BakedMesh::IsLoaded() const
+{
+    return m_header != nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+eBakedVertexFormat BakedMesh::GetVertexFormat() const
+{
+    return static_cast<eBakedVertexFormat>(m_header->m_vertexFormat);
+}
+
+//----------------------------------------------------------------------------------------------------
+Vertex_PCU const* BakedMesh::GetVertexesPCU() const
+{
+    bool const isPCU = m_header != nullptr && GetVertexFormat() == eBakedVertexFormat::PCU;
+    return isPCU ? static_cast<Vertex_PCU const*>(GetSection(m_header->m_vertexOffset)) : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+Vertex_PCUTBN const* BakedMesh::GetVertexesPCUTBN() const
+{
+    bool const isPCUTBN = m_header != nullptr && GetVertexFormat() == eBakedVertexFormat::PCUTBN;
+    return isPCUTBN ? static_cast<Vertex_PCUTBN const*>(GetSection(m_header->m_vertexOffset)) : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+int BakedMesh::GetVertexCount() const
+{
+    return m_header != nullptr ? static_cast<int>(m_header->m_vertexCount) : 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+unsigned int const* BakedMesh::GetIndexes() const
+{
+    return m_header != nullptr ? static_cast<unsigned int const*>(GetSection(m_header->m_indexOffset)) : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+int BakedMesh::GetIndexCount() const
+{
+    return m_header != nullptr ? static_cast<int>(m_header->m_indexCount) : 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+sSubmesh const* BakedMesh::GetSubmeshes() const
+{
+    return m_header != nullptr ? static_cast<sSubmesh const*>(GetSection(m_header->m_submeshOffset)) : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+int BakedMesh::GetSubmeshCount() const
+{
+    return m_header != nullptr ? static_cast<int>(m_header->m_submeshCount) : 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+int BakedMesh::GetMaterialCount() const
+{
+    return m_header != nullptr ? static_cast<int>(m_header->m_materialCount) : 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+char const* BakedMesh::GetMaterialName(int const materialIndex) const
+{
+    return static_cast<char const*>(GetSection(m_header->m_materialOffset)) + static_cast<size_t>(materialIndex) * BAKED_MATERIAL_NAME_SIZE;
+}
+
+//----------------------------------------------------------------------------------------------------
+sBoundingSphere BakedMesh::GetLocalBoundingSphere() const
+{
+    sBoundingSphere sphere;
+    sphere.m_center = Vec3(m_header->m_boundingSphereCenter[0], m_header->m_boundingSphereCenter[1], m_header->m_boundingSphereCenter[2]);
+    sphere.m_radius = m_header->m_boundingSphereRadius;
+
+    return sphere;
+}
+
+//----------------------------------------------------------------------------------------------------
+AABB3 BakedMesh::GetLocalBounds() const
+{
+    Vec3 const mins(m_header->m_boundsMins[0], m_header->m_boundsMins[1], m_header->m_boundsMins[2]);
+    Vec3 const maxs(m_header->m_boundsMaxs[0], m_header->m_boundsMaxs[1], m_header->m_boundsMaxs[2]);
+
+    return AABB3(mins, maxs);
+}
+
+//----------------------------------------------------------------------------------------------------
+void const* BakedMesh::GetSection(uint64_t const offset) const
+{
+    return m_file.GetData() + offset;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Sections are laid out back to back at aligned offsets, and the gaps written as zeros.
+//
+bool WriteBakedMesh(char const* filePath, sMeshData const& mesh, String* out_error)
+{
+    auto const fail = [out_error](char const* reason)
+    {
+        if (out_error != nullptr)
+        {
+            *out_error = reason;
+        }
+
+        return false;
+    };
+
+    std::vector<sSubmesh> submeshes = mesh.m_submeshes;
+
+    if (submeshes.empty())
+    {
+        sSubmesh wholeMesh;
+        wholeMesh.m_indexCount = static_cast<unsigned int>(mesh.m_indexes.empty() ? mesh.m_vertexes.size() : mesh.m_indexes.size());
+        submeshes.push_back(wholeMesh);
+    }
+
+    std::vector<char> materialNames(mesh.m_materialNames.size() * BAKED_MATERIAL_NAME_SIZE, '\0');
+
+    for (size_t materialIndex = 0; materialIndex < mesh.m_materialNames.size(); ++materialIndex)
+    {
+        String const& name = mesh.m_materialNames[materialIndex];
+
+        if (name.size() >= static_cast<size_t>(BAKED_MATERIAL_NAME_SIZE))
+        {
+            return fail("a material name is too long to bake");
+        }
+
+        memcpy(&materialNames[materialIndex * BAKED_MATERIAL_NAME_SIZE], name.data(), name.size());
+    }
+
+    sBakedMeshHeader header;
+    memset(&header, 0, sizeof(header));
+
+    header.m_magic          = BAKED_MESH_MAGIC;
+    header.m_version        = BAKED_MESH_VERSION;
+    header.m_vertexFormat   = static_cast<uint32_t>(eBakedVertexFormat::PCU);
+    header.m_vertexStride   = sizeof(Vertex_PCU);
+    header.m_vertexCount    = static_cast<uint32_t>(mesh.m_vertexes.size());
+    header.m_indexCount     = static_cast<uint32_t>(mesh.m_indexes.size());
+    header.m_submeshCount   = static_cast<uint32_t>(submeshes.size());
+    header.m_materialCount  = static_cast<uint32_t>(mesh.m_materialNames.size());
+    header.m_vertexOffset   = AlignSectionOffset(sizeof(sBakedMeshHeader));
+    header.m_indexOffset    = AlignSectionOffset(header.m_vertexOffset + mesh.m_vertexes.size() * sizeof(Vertex_PCU));
+    header.m_submeshOffset  = AlignSectionOffset(header.m_indexOffset + mesh.m_indexes.size() * sizeof(uint32_t));
+    header.m_materialOffset = AlignSectionOffset(header.m_submeshOffset + submeshes.size() * sizeof(sSubmesh));
+    header.m_fileSize       = header.m_materialOffset + materialNames.size();
+
+    header.m_boundingSphereCenter[0] = mesh.m_localBoundingSphere.m_center.x;
+    header.m_boundingSphereCenter[1] = mesh.m_localBoundingSphere.m_center.y;
+    header.m_boundingSphereCenter[2] = mesh.m_localBoundingSphere.m_center.z;
+    header.m_boundingSphereRadius    = mesh.m_localBoundingSphere.m_radius;
+
+    Vec3 mins = mesh.m_vertexes.empty() ? Vec3::ZERO : mesh.m_vertexes[0].m_position;
+    Vec3 maxs = mins;
+
+    for (Vertex_PCU const& vertex : mesh.m_vertexes)
+    {
+        Vec3 const& position = vertex.m_position;
+
+        mins.x = position.x < mins.x ? position.x : mins.x;
+        mins.y = position.y < mins.y ? position.y : mins.y;
+        mins.z = position.z < mins.z ? position.z : mins.z;
+        maxs.x = position.x > maxs.x ? position.x : maxs.x;
+        maxs.y = position.y > maxs.y ? position.y : maxs.y;
+        maxs.z = position.z > maxs.z ? position.z : maxs.z;
+    }
+
+    header.m_boundsMins[0] = mins.x;
+    header.m_boundsMins[1] = mins.y;
+    header.m_boundsMins[2] = mins.z;
+    header.m_boundsMaxs[0] = maxs.x;
+    header.m_boundsMaxs[1] = maxs.y;
+    header.m_boundsMaxs[2] = maxs.z;
+
+    FILE* file = nullptr;
+
+#if defined(_WIN32)
+    if (fopen_s(&file, filePath, "wb") != 0)
+    {
+        file = nullptr;
+    }
+#else
+    file = fopen(filePath, "wb");
+#endif
+
+    if (file == nullptr)
+    {
+        return fail("could not open the file for writing");
+    }
+
+    uint64_t   position  = 0;
+    bool       isWritten = true;
+    auto const write     = [file, &position, &isWritten](uint64_t const offset, void const* data, size_t const size)
+    {
+        char constexpr padding[SECTION_ALIGNMENT] = {};
+        size_t const   paddingSize                = static_cast<size_t>(offset - position);
+
+        isWritten = isWritten && fwrite(padding, 1, paddingSize, file) == paddingSize;
+        isWritten = isWritten && (size == 0 || fwrite(data, 1, size, file) == size);
+        position  = offset + size;
+    };
+
+    write(0, &header, sizeof(header));
+    write(header.m_vertexOffset, mesh.m_vertexes.data(), mesh.m_vertexes.size() * sizeof(Vertex_PCU));
+    write(header.m_indexOffset, mesh.m_indexes.data(), mesh.m_indexes.size() * sizeof(uint32_t));
+    write(header.m_submeshOffset, submeshes.data(), submeshes.size() * sizeof(sSubmesh));
+    write(header.m_materialOffset, materialNames.data(), materialNames.size());
+
+    isWritten = fclose(file) == 0 && isWritten;
+
+    return isWritten ? true : fail("could not write the file");
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ConvertObjToBakedMesh(char const* objFilePath, char const* bakedFilePath, String* out_error)
+{
+    MappedFile objFile;
+
+    if (!objFile.Open(objFilePath))
+    {
+        if (out_error != nullptr)
+        {
+            *out_error = "could not map the OBJ file";
+        }
+
+        return false;
+    }
+
+    sMeshData mesh;
+
+    if (!ParseObjMeshParallel(g_theJobSystem, reinterpret_cast<char const*>(objFile.GetData()), objFile.GetSize(), mesh, out_error))
+    {
+        return false;
+    }
+
+    objFile.Close();
+
+    return WriteBakedMesh(bakedFilePath, mesh, out_error);
+}
@@ -0,0 +1,106 @@
+//----------------------------------------------------------------------------------------------------
+// BakedMesh.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Game/Subsystem/Resource/MappedFile.hpp"
+#include "Game/Subsystem/Resource/MeshData.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+struct Vertex_PCUTBN;
+
+//----------------------------------------------------------------------------------------------------
+char constexpr     BAKED_MESH_EXTENSION[]   = ".bmesh";
+uint32_t constexpr BAKED_MESH_MAGIC         = 0x48534D42;     // "BMSH" read as little-endian bytes
+uint32_t constexpr BAKED_MESH_VERSION       = 1;              // Bump on any layout change; old files are rejected, not converted
+int constexpr      BAKED_MATERIAL_NAME_SIZE = 64;             // Including the terminator
+
+//----------------------------------------------------------------------------------------------------
+enum class eBakedVertexFormat : uint32_t
+{
+    PCU,
+    PCUTBN
+};
+
+//----------------------------------------------------------------------------------------------------
+// The start of a .bmesh file. Every section is 16-byte aligned and holds its records exactly as
+// they sit in memory, little-endian, so the loader points straight into the mapped file:
+//   vertexes  m_vertexCount x Vertex_PCU or Vertex_PCUTBN
+//   indexes   m_indexCount x uint32_t; none for a flat triangle list
+//   submeshes m_submeshCount x sSubmesh
+//   materials m_materialCount x BAKED_MATERIAL_NAME_SIZE chars, null-terminated
+//
+struct sBakedMeshHeader
+{
+    uint32_t m_magic;
+    uint32_t m_version;
+    uint32_t m_vertexFormat;            // eBakedVertexFormat
+    uint32_t m_vertexStride;            // Must equal the running build's sizeof, so a layout change is caught
+    uint32_t m_vertexCount;
+    uint32_t m_indexCount;
+    uint32_t m_submeshCount;
+    uint32_t m_materialCount;
+    uint64_t m_vertexOffset;
+    uint64_t m_indexOffset;
+    uint64_t m_submeshOffset;
+    uint64_t m_materialOffset;
+    float    m_boundingSphereCenter[3];
+    float    m_boundingSphereRadius;
+    float    m_boundsMins[3];
+    float    m_boundsMaxs[3];
+    uint64_t m_fileSize;                // Catches a truncated file before any section is read
+};
+
+//----------------------------------------------------------------------------------------------------
+// A .bmesh file mapped into memory. Load checks the header and that every section and submesh lies
+// inside the file, then the getters point into the mapping: nothing is parsed or copied, and the
+// spans can go to RenderBackend::CreateStaticMesh as they are. Index values are not checked against
+// the vertex count, since that would read the whole index buffer; files should come from
+// WriteBakedMesh. The spans are valid until Unload or destruction.
+//
+class BakedMesh
+{
+public:
+    BakedMesh() = default;
+
+    BakedMesh(BakedMesh const&)            = delete;
+    BakedMesh& operator=(BakedMesh const&) = delete;
+
+    bool Load(char const* filePath, String* out_error = nullptr);
+    void Unload();
+
+    bool                 IsLoaded() const;
+    eBakedVertexFormat   GetVertexFormat() const;
+    Vertex_PCU const*    GetVertexesPCU() const;        // Null unless the format is PCU
+    Vertex_PCUTBN const* GetVertexesPCUTBN() const;     // Null unless the format is PCUTBN
+    int                  GetVertexCount() const;
+    unsigned int const*  GetIndexes() const;
+    int                  GetIndexCount() const;
+    sSubmesh const*      GetSubmeshes() const;
+    int                  GetSubmeshCount() const;
+    int                  GetMaterialCount() const;
+    char const*          GetMaterialName(int materialIndex) const;
+    sBoundingSphere      GetLocalBoundingSphere() const;
+    AABB3                GetLocalBounds() const;
+
+private:
+    void const* GetSection(uint64_t offset) const;
+
+    MappedFile              m_file;
+    sBakedMeshHeader const* m_header = nullptr;     // Into m_file; null when nothing is loaded
+};
+
+//----------------------------------------------------------------------------------------------------
+// Writes `mesh` as a PCU .bmesh. A mesh with no submeshes gets one covering all of it.
+//
+bool WriteBakedMesh(char const* filePath, sMeshData const& mesh, String* out_error = nullptr);
+
+//----------------------------------------------------------------------------------------------------
+// The offline converter: parses an OBJ file and writes it as a .bmesh.
+//
+bool ConvertObjToBakedMesh(char const* objFilePath, char const* bakedFilePath, String* out_error = nullptr);
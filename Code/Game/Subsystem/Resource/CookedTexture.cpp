@@ -0,0 +1,363 @@
+//----------------------------------------------------------------------------------------------------
+// CookedTexture.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Resource/CookedTexture.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Game/Math/SIMD.hpp"
+#include "ThirdParty/stb/stb_image.h"
+
+//----------------------------------------------------------------------------------------------------
+static_assert(sizeof(sCookedTextureHeader) % 16 == 0, "sCookedTextureHeader must keep the first mip aligned");
+static_assert(sizeof(Rgba8) == 4, "Cooked mips are stored as packed 4-byte Rgba8 texels");
+
+//----------------------------------------------------------------------------------------------------
+static uint64_t constexpr MIP_ALIGNMENT       = 16;
+static int constexpr      MAX_COOKED_MIP_SIZE = 1 << (MAX_COOKED_MIP_COUNT - 1);
+
+//----------------------------------------------------------------------------------------------------
+static uint64_t AlignMipOffset(uint64_t const offset)
+{
+    return (offset + MIP_ALIGNMENT - 1) & ~(MIP_ALIGNMENT - 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+static uint64_t GetMipByteSize(int const width, int const height, int const mipLevel)
+{
+    return static_cast<uint64_t>(GetTextureMipSize(width, mipLevel)) * GetTextureMipSize(height, mipLevel) * sizeof(Rgba8);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool CookedTexture::Load(char const* filePath, String* out_error)
+{
+    Unload();
+
+    auto const fail = [this, out_error](char const* reason)
+    {
+        Unload();
+
+        if (out_error != nullptr)
+        {
+            *out_error = reason;
+        }
+
+        return false;
+    };
+
+    if (!m_file.Open(filePath))
+    {
+        return fail("could not map the file");
+    }
+
+    uint64_t const fileSize = m_file.GetSize();
+
+    if (fileSize < sizeof(sCookedTextureHeader))
+    {
+        return fail("too small to hold a header");
+    }
+
+    sCookedTextureHeader const* header = reinterpret_cast<sCookedTextureHeader const*>(m_file.GetData());
+
+    if (header->m_magic != COOKED_TEXTURE_MAGIC)
+    {
+        return fail("not a cooked texture");
+    }
+
+    if (header->m_version != COOKED_TEXTURE_VERSION)
+    {
+        return fail("cooked with another version; recook it");
+    }
+
+    if (header->m_fileSize != fileSize)
+    {
+        return fail("file size does not match its header");
+    }
+
+    if (header->m_pixelFormat != static_cast<uint32_t>(eCookedPixelFormat::RGBA8))
+    {
+        return fail("unknown pixel format");
+    }
+
+    if (header->m_width == 0 || header->m_height == 0 || header->m_width > static_cast<uint32_t>(MAX_COOKED_MIP_SIZE) || header->m_height > static_cast<uint32_t>(MAX_COOKED_MIP_SIZE))
+    {
+        return fail("bad texture size");
+    }
+
+    int const width  = static_cast<int>(header->m_width);
+    int const height = static_cast<int>(header->m_height);
+
+    if (header->m_mipCount != static_cast<uint32_t>(GetTextureMipCount(width, height)))
+    {
+        return fail("mip chain is not complete");
+    }
+
+    for (int mipLevel = 0; mipLevel < static_cast<int>(header->m_mipCount); ++mipLevel)
+    {
+        uint64_t const offset = header->m_mipOffsets[mipLevel];
+
+        if (offset % MIP_ALIGNMENT != 0 || offset > fileSize || GetMipByteSize(width, height, mipLevel) > fileSize - offset)
+        {
+            return fail("a mip lies outside the file");
+        }
+    }
+
+    m_header = header;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void CookedTexture::Unload()
+{
+    m_header = nullptr;
+    m_file.Close();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool CookedTexture::IsLoaded() const
+{
+    return m_header != nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+int CookedTexture::GetWidth() const
+{
+    return m_header != nullptr ? static_cast<int>(m_header->m_width) : 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+int CookedTexture::GetHeight() const
+{
+    return m_header != nullptr ? static_cast<int>(m_header->m_height) : 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+int CookedTexture::GetMipCount() const
+{
+    return m_header != nullptr ? static_cast<int>(m_header->m_mipCount) : 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+Rgba8 const* CookedTexture::GetMipTexels(int const mipLevel) const
+{
+    if (m_header == nullptr || mipLevel < 0 || mipLevel >= GetMipCount())
+    {
+        return nullptr;
+    }
+
+    return reinterpret_cast<Rgba8 const*>(m_file.GetData() + m_header->m_mipOffsets[mipLevel]);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t CookedTexture::GetSourceHash() const
+{
+    return m_header != nullptr ? m_header->m_sourceHash : 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t CookedTexture::GetSourceSize() const
+{
+    return m_header != nullptr ? m_header->m_sourceSize : 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+int GetTextureMipCount(int const width, int const height)
+{
+    int mipCount = 1;
+
+    for (int size = std::max(width, height); size > 1; size >>= 1)
+    {
+        ++mipCount;
+    }
+
+    return mipCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int GetTextureMipSize(int const topMipSize, int const mipLevel)
+{
+    return std::max(topMipSize >> mipLevel, 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+static Rgba8 AverageTexels(Rgba8 const& a, Rgba8 const& b, Rgba8 const& c, Rgba8 const& d)
+{
+    return Rgba8(static_cast<unsigned char>((a.r + b.r + c.r + d.r + 2) >> 2),
+                 static_cast<unsigned char>((a.g + b.g + c.g + d.g + 2) >> 2),
+                 static_cast<unsigned char>((a.b + b.b + c.b + d.b + 2) >> 2),
+                 static_cast<unsigned char>((a.a + b.a + c.a + d.a + 2) >> 2));
+}
+
+//----------------------------------------------------------------------------------------------------
+// The SSE path makes four texels from two rows of eight, with the same rounding as AverageTexels,
+// so both paths give identical mips.
+//
+void BuildTextureMip(Rgba8 const* source, int const sourceWidth, int const sourceHeight, Rgba8* out_mip)
+{
+    int const mipWidth   = GetTextureMipSize(sourceWidth, 1);
+    int const mipHeight  = GetTextureMipSize(sourceHeight, 1);
+    int const lastColumn = sourceWidth - 1;
+
+    for (int y = 0; y < mipHeight; ++y)
+    {
+        Rgba8 const* topRow    = source + static_cast<size_t>(2 * y) * sourceWidth;
+        Rgba8 const* bottomRow = source + static_cast<size_t>(std::min(2 * y + 1, sourceHeight - 1)) * sourceWidth;
+        Rgba8*       mipRow    = out_mip + static_cast<size_t>(y) * mipWidth;
+        int          x         = 0;
+
+#if defined(GAME_SIMD_SSE)
+        if (sourceWidth >= 2)
+        {
+            __m128i const zero     = _mm_setzero_si128();
+            __m128i const rounding = _mm_set1_epi16(2);
+
+            for (; x + 4 <= mipWidth; x += 4)
+            {
+                __m128i const top0    = _mm_loadu_si128(reinterpret_cast<__m128i const*>(topRow + 2 * x));
+                __m128i const top1    = _mm_loadu_si128(reinterpret_cast<__m128i const*>(topRow + 2 * x + 4));
+                __m128i const bottom0 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(bottomRow + 2 * x));
+                __m128i const bottom1 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(bottomRow + 2 * x + 4));
+
+                // Column sums as 16-bit channels, one source column per 64-bit half
+                __m128i const columns01 = _mm_add_epi16(_mm_unpacklo_epi8(top0, zero), _mm_unpacklo_epi8(bottom0, zero));
+                __m128i const columns23 = _mm_add_epi16(_mm_unpackhi_epi8(top0, zero), _mm_unpackhi_epi8(bottom0, zero));
+                __m128i const columns45 = _mm_add_epi16(_mm_unpacklo_epi8(top1, zero), _mm_unpacklo_epi8(bottom1, zero));
+                __m128i const columns67 = _mm_add_epi16(_mm_unpackhi_epi8(top1, zero), _mm_unpackhi_epi8(bottom1, zero));
+
+                // Even column plus odd column gives each output texel's 2 x 2 sum
+                __m128i const sums01 = _mm_add_epi16(_mm_unpacklo_epi64(columns01, columns23), _mm_unpackhi_epi64(columns01, columns23));
+                __m128i const sums23 = _mm_add_epi16(_mm_unpacklo_epi64(columns45, columns67), _mm_unpackhi_epi64(columns45, columns67));
+
+                __m128i const averages01 = _mm_srli_epi16(_mm_add_epi16(sums01, rounding), 2);
+                __m128i const averages23 = _mm_srli_epi16(_mm_add_epi16(sums23, rounding), 2);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(mipRow + x), _mm_packus_epi16(averages01, averages23));
+            }
+        }
+#endif
+
+        for (; x < mipWidth; ++x)
+        {
+            int const leftColumn  = 2 * x;
+            int const rightColumn = std::min(leftColumn + 1, lastColumn);
+
+            mipRow[x] = AverageTexels(topRow[leftColumn], topRow[rightColumn], bottomRow[leftColumn], bottomRow[rightColumn]);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t HashTextureSource(unsigned char const* data, size_t const size)
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    for (size_t index = 0; index < size; ++index)
+    {
+        hash = (hash ^ data[index]) * 1099511628211ull;
+    }
+
+    return hash;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Rows are flipped on the way in, so v = 0 is the bottom of the image as on the GPU path.
+//
+bool CookTexture(unsigned char const* sourceData, size_t const sourceSize, char const* cookedFilePath, String* out_error)
+{
+    auto const fail = [out_error](char const* reason)
+    {
+        if (out_error != nullptr)
+        {
+            *out_error = reason;
+        }
+
+        return false;
+    };
+
+    int            width        = 0;
+    int            height       = 0;
+    int            channelCount = 0;
+    unsigned char* pixels       = stbi_load_from_memory(sourceData, static_cast<int>(sourceSize), &width, &height, &channelCount, 4);
+
+    if (pixels == nullptr)
+    {
+        return fail("could not decode the image");
+    }
+
+    if (width > MAX_COOKED_MIP_SIZE || height > MAX_COOKED_MIP_SIZE)
+    {
+        stbi_image_free(pixels);
+        return fail("the image is too large to cook");
+    }
+
+    sCookedTextureHeader header;
+    memset(&header, 0, sizeof(header));
+
+    header.m_magic       = COOKED_TEXTURE_MAGIC;
+    header.m_version     = COOKED_TEXTURE_VERSION;
+    header.m_pixelFormat = static_cast<uint32_t>(eCookedPixelFormat::RGBA8);
+    header.m_width       = static_cast<uint32_t>(width);
+    header.m_height      = static_cast<uint32_t>(height);
+    header.m_mipCount    = static_cast<uint32_t>(GetTextureMipCount(width, height));
+    header.m_sourceSize  = sourceSize;
+    header.m_sourceHash  = HashTextureSource(sourceData, sourceSize);
+
+    uint64_t offset = AlignMipOffset(sizeof(sCookedTextureHeader));
+
+    for (int mipLevel = 0; mipLevel < static_cast<int>(header.m_mipCount); ++mipLevel)
+    {
+        header.m_mipOffsets[mipLevel] = offset;
+        offset                        = AlignMipOffset(offset + GetMipByteSize(width, height, mipLevel));
+    }
+
+    header.m_fileSize = offset;
+
+    // The whole file is built in memory, so each mip is filtered straight from the one before it
+    std::vector<unsigned char> fileBytes(static_cast<size_t>(header.m_fileSize), 0);
+    memcpy(fileBytes.data(), &header, sizeof(header));
+
+    Rgba8* topMip = reinterpret_cast<Rgba8*>(&fileBytes[static_cast<size_t>(header.m_mipOffsets[0])]);
+
+    for (int row = 0; row < height; ++row)
+    {
+        memcpy(topMip + static_cast<size_t>(row) * width, pixels + static_cast<size_t>(height - 1 - row) * width * 4, static_cast<size_t>(width) * 4);
+    }
+
+    stbi_image_free(pixels);
+
+    for (int mipLevel = 1; mipLevel < static_cast<int>(header.m_mipCount); ++mipLevel)
+    {
+        Rgba8 const* source = reinterpret_cast<Rgba8 const*>(&fileBytes[static_cast<size_t>(header.m_mipOffsets[mipLevel - 1])]);
+        Rgba8*       mip    = reinterpret_cast<Rgba8*>(&fileBytes[static_cast<size_t>(header.m_mipOffsets[mipLevel])]);
+
+        BuildTextureMip(source, GetTextureMipSize(width, mipLevel - 1), GetTextureMipSize(height, mipLevel - 1), mip);
+    }
+
+    FILE* file = nullptr;
+
+#if defined(_WIN32)
+    if (fopen_s(&file, cookedFilePath, "wb") != 0)
+    {
+        file = nullptr;
+    }
+#else
+    file = fopen(cookedFilePath, "wb");
+#endif
+
+    if (file == nullptr)
+    {
+        return fail("could not open the file for writing");
+    }
+
+    bool isWritten = fwrite(fileBytes.data(), 1, fileBytes.size(), file) == fileBytes.size();
+    isWritten      = fclose(file) == 0 && isWritten;
+
+    return isWritten ? true : fail("could not write the file");
+}
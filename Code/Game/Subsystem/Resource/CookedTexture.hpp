@@ -0,0 +1,98 @@
+//----------------------------------------------------------------------------------------------------
+// CookedTexture.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "Engine/Core/StringUtils.hpp"
+#include "Game/Subsystem/Resource/MappedFile.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+struct Rgba8;
+
+//----------------------------------------------------------------------------------------------------
+char constexpr     COOKED_TEXTURE_EXTENSION[] = ".ctex";
+uint32_t constexpr COOKED_TEXTURE_MAGIC       = 0x58455443;     // "CTEX" read as little-endian bytes
+uint32_t constexpr COOKED_TEXTURE_VERSION     = 1;              // Bump on any layout or filter change; old files are recooked
+int constexpr      MAX_COOKED_MIP_COUNT       = 16;             // Enough for a 32768 x 32768 top mip
+
+//----------------------------------------------------------------------------------------------------
+enum class eCookedPixelFormat : uint32_t
+{
+    RGBA8
+};
+
+//----------------------------------------------------------------------------------------------------
+// The start of a .ctex file: a full mip chain, largest first, each level a 16-byte aligned section
+// of width x height Rgba8 texels with row 0 at v = 0, the bottom of the image. Levels are laid out
+// as a GPU upload wants them, one tightly packed subresource per mip.
+//
+struct sCookedTextureHeader
+{
+    uint32_t m_magic;
+    uint32_t m_version;
+    uint32_t m_pixelFormat;                             // eCookedPixelFormat
+    uint32_t m_width;
+    uint32_t m_height;
+    uint32_t m_mipCount;
+    uint64_t m_sourceSize;
+    uint64_t m_sourceHash;                              // HashTextureSource of the image it was cooked from
+    uint64_t m_mipOffsets[MAX_COOKED_MIP_COUNT];
+    uint64_t m_fileSize;                                // Catches a truncated file before any level is read
+};
+
+//----------------------------------------------------------------------------------------------------
+// A .ctex file mapped into memory. Load checks the header and that every mip lies inside the file,
+// then GetMipTexels points into the mapping; nothing is decoded or copied. The texels are valid
+// until Unload or destruction.
+//
+class CookedTexture
+{
+public:
+    CookedTexture() = default;
+
+    CookedTexture(CookedTexture const&)            = delete;
+    CookedTexture& operator=(CookedTexture const&) = delete;
+
+    bool Load(char const* filePath, String* out_error = nullptr);
+    void Unload();
+
+    bool         IsLoaded() const;
+    int          GetWidth() const;
+    int          GetHeight() const;
+    int          GetMipCount() const;
+    Rgba8 const* GetMipTexels(int mipLevel) const;
+    uint64_t     GetSourceHash() const;
+    uint64_t     GetSourceSize() const;
+
+private:
+    MappedFile                  m_file;
+    sCookedTextureHeader const* m_header = nullptr;     // Into m_file; null when nothing is loaded
+};
+
+//----------------------------------------------------------------------------------------------------
+// Mip sizes follow D3D: each level halves the last, rounding down, and stops at 1 x 1.
+//
+int GetTextureMipCount(int width, int height);
+int GetTextureMipSize(int topMipSize, int mipLevel);
+
+//----------------------------------------------------------------------------------------------------
+// Box-filters `source` down one mip level into `out_mip`, which must hold GetTextureMipSize(width, 1)
+// x GetTextureMipSize(height, 1) texels. Each texel is the rounded average of a 2 x 2 block; an odd
+// last row or column is dropped, and a side that is already 1 texel is averaged with itself.
+//
+void BuildTextureMip(Rgba8 const* source, int sourceWidth, int sourceHeight, Rgba8* out_mip);
+
+//----------------------------------------------------------------------------------------------------
+// 64-bit FNV-1a over an image file's bytes, the key a cooked texture is stored under.
+//
+uint64_t HashTextureSource(unsigned char const* data, size_t size);
+
+//----------------------------------------------------------------------------------------------------
+// Decodes an image file held in memory (any format stb_image reads), builds its mip chain and
+// writes it as a .ctex.
+//
+bool CookTexture(unsigned char const* sourceData, size_t sourceSize, char const* cookedFilePath, String* out_error = nullptr);
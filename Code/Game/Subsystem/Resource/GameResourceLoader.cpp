@@ -0,0 +1,176 @@
+//----------------------------------------------------------------------------------------------------
+// GameResourceLoader.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Resource/GameResourceLoader.hpp"
+
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Subsystem/Profile/Profiler.hpp"
+
+//----------------------------------------------------------------------------------------------------
+GameResourceLoader::GameResourceLoader(sGameResourceLoaderConfig const& config)
+    : m_config(config)
+{
+    m_config.m_maxLoadsInFlight = m_config.m_maxLoadsInFlight > 0 ? m_config.m_maxLoadsInFlight : 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+GameResourceLoader::~GameResourceLoader()
+{
+    WaitForLoads();
+    delete m_modelStreamer;
+}
+
+//----------------------------------------------------------------------------------------------------
+void GameResourceLoader::Startup()
+{
+    m_modelStreamer = new ModelStreamer(*this, m_config.m_modelStreamerConfig);
+}
+
+//----------------------------------------------------------------------------------------------------
+// The streamer waits out its own decodes before destroying its meshes.
+//
+void GameResourceLoader::Shutdown()
+{
+    delete m_modelStreamer;
+    m_modelStreamer = nullptr;
+
+    WaitForLoads();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Starts a loader job only when fewer than m_maxLoadsInFlight are running; otherwise one that is
+// running takes this load when it finishes its current one.
+//
+void GameResourceLoader::QueueLoad(char const* name, ResourceLoadFunction const& load)
+{
+    if (g_theJobSystem == nullptr)
+    {
+        PROFILE_SCOPE(name);
+        load();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> const lock(m_queueMutex);
+
+        sQueuedLoad queuedLoad;
+        queuedLoad.m_name = name;
+        queuedLoad.m_load = load;
+
+        m_queuedLoads.push_back(std::move(queuedLoad));
+        ++m_statistics.m_queuedCount;
+
+        if (m_inFlightCount >= m_config.m_maxLoadsInFlight)
+        {
+            return;
+        }
+
+        ++m_inFlightCount;
+        m_statistics.m_maxInFlightCount = m_inFlightCount > m_statistics.m_maxInFlightCount ? m_inFlightCount : m_statistics.m_maxInFlightCount;
+    }
+
+    g_theJobSystem->RunBackground([this]() { RunQueuedLoads(); }, &m_loaderCounter);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Loads queued meanwhile are either taken by a loader job this waits on, or start a new one, since
+// a loader job only stops once it finds the queue empty.
+//
+void GameResourceLoader::WaitForLoads()
+{
+    if (g_theJobSystem != nullptr)
+    {
+        g_theJobSystem->Wait(m_loaderCounter);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+sGameResourceLoaderStatistics GameResourceLoader::GetStatistics() const
+{
+    std::lock_guard<std::mutex> const lock(m_queueMutex);
+    return m_statistics;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Runs as a background job. The queue is checked and m_inFlightCount released under one lock, so
+// a load queued while this job is stopping either lands in the queue it sees or starts a new job.
+//
+void GameResourceLoader::RunQueuedLoads()
+{
+    for (;;)
+    {
+        sQueuedLoad queuedLoad;
+
+        {
+            std::lock_guard<std::mutex> const lock(m_queueMutex);
+
+            if (m_queuedLoads.empty())
+            {
+                --m_inFlightCount;
+                return;
+            }
+
+            queuedLoad = std::move(m_queuedLoads.front());
+            m_queuedLoads.pop_front();
+        }
+
+        PROFILE_SCOPE(queuedLoad.m_name);
+        queuedLoad.m_load();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+ModelHandle GameResourceLoader::RequestModel(String const& filePath, ModelReadyCallback const& onReady)
+{
+    return m_modelStreamer->RequestModel(filePath, onReady);
+}
+
+//----------------------------------------------------------------------------------------------------
+int GameResourceLoader::PublishFinishedModels()
+{
+    return m_modelStreamer->PublishFinishedModels();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool GameResourceLoader::HasFinishedModels() const
+{
+    return m_modelStreamer->HasFinishedModels();
+}
+
+//----------------------------------------------------------------------------------------------------
+eModelState GameResourceLoader::GetModelState(ModelHandle const handle) const
+{
+    return m_modelStreamer->GetState(handle);
+}
+
+//----------------------------------------------------------------------------------------------------
+int GameResourceLoader::GetModelStaticMeshId(ModelHandle const handle) const
+{
+    return m_modelStreamer->GetStaticMeshId(handle);
+}
+
+//----------------------------------------------------------------------------------------------------
+sBoundingSphere const& GameResourceLoader::GetModelLocalBoundingSphere(ModelHandle const handle) const
+{
+    return m_modelStreamer->GetLocalBoundingSphere(handle);
+}
+
+//----------------------------------------------------------------------------------------------------
+int GameResourceLoader::GetPlaceholderStaticMeshId() const
+{
+    return m_modelStreamer->GetPlaceholderStaticMeshId();
+}
+
+//----------------------------------------------------------------------------------------------------
+int GameResourceLoader::GetLoadingModelCount() const
+{
+    return m_modelStreamer->GetLoadingCount();
+}
+
+//----------------------------------------------------------------------------------------------------
+sModelStreamerStatistics GameResourceLoader::GetModelStreamerStatistics() const
+{
+    return m_modelStreamer->GetStatistics();
+}
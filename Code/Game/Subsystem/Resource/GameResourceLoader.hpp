@@ -0,0 +1,92 @@
+//----------------------------------------------------------------------------------------------------
+// GameResourceLoader.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include "Game/Subsystem/Job/JobSystem.hpp"
+#include "Game/Subsystem/Resource/ModelStreamer.hpp"
+
+//----------------------------------------------------------------------------------------------------
+struct sGameResourceLoaderConfig
+{
+    int                  m_maxLoadsInFlight = 2;    // Loads running at once; later ones queue until one finishes
+    sModelStreamerConfig m_modelStreamerConfig;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Counted since construction.
+//
+struct sGameResourceLoaderStatistics
+{
+    int m_queuedCount      = 0;
+    int m_maxInFlightCount = 0;     // Most loader jobs running at once
+};
+
+//----------------------------------------------------------------------------------------------------
+using ResourceLoadFunction = std::function<void()>;
+
+//----------------------------------------------------------------------------------------------------
+// Runs resource loads (file reads and decodes) as background jobs on g_theJobSystem. It has no
+// threads of its own: at most m_maxLoadsInFlight loader jobs run at once, each taking queued loads
+// in order until none are left, so a burst of requests never holds every idle worker. Each load is
+// marked in profiler captures with the name it was queued under.
+//
+// Loads run on the caller instead when there is no g_theJobSystem, as in tools that start no App.
+// Queue from the main thread.
+//
+// Models load through here too: the GameResourceLoader owns the ModelStreamer, which queues its
+// decodes as loads, and forwards its request, placeholder and publish calls. Startup creates the
+// streamer and Shutdown destroys it, both while g_theRenderBackend is up, since the placeholder and
+// every published model are static meshes on it.
+//
+class GameResourceLoader
+{
+public:
+    explicit GameResourceLoader(sGameResourceLoaderConfig const& config = sGameResourceLoaderConfig());
+    ~GameResourceLoader();       // Waits for every queued load
+
+    GameResourceLoader(GameResourceLoader const&)            = delete;
+    GameResourceLoader& operator=(GameResourceLoader const&) = delete;
+
+    void Startup();
+    void Shutdown();
+
+    // `name` must outlive any profiler capture; string literals in practice
+    void QueueLoad(char const* name, ResourceLoadFunction const& load);
+    void WaitForLoads();
+
+    sGameResourceLoaderStatistics GetStatistics() const;
+
+    // Models; see ModelStreamer. Between Startup and Shutdown only.
+    ModelHandle              RequestModel(String const& filePath, ModelReadyCallback const& onReady = nullptr);
+    int                      PublishFinishedModels();                                    // On the thread that owns g_theRenderBackend
+    bool                     HasFinishedModels() const;
+    eModelState              GetModelState(ModelHandle handle) const;
+    int                      GetModelStaticMeshId(ModelHandle handle) const;             // The placeholder's until READY
+    sBoundingSphere const&   GetModelLocalBoundingSphere(ModelHandle handle) const;      // The placeholder's until READY
+    int                      GetPlaceholderStaticMeshId() const;
+    int                      GetLoadingModelCount() const;
+    sModelStreamerStatistics GetModelStreamerStatistics() const;
+
+private:
+    struct sQueuedLoad
+    {
+        char const*          m_name = nullptr;
+        ResourceLoadFunction m_load;
+    };
+
+    void RunQueuedLoads();
+
+    sGameResourceLoaderConfig     m_config;
+    ModelStreamer*                m_modelStreamer = nullptr;
+    JobCounter                    m_loaderCounter;
+    mutable std::mutex            m_queueMutex;            // Guards everything below
+    std::deque<sQueuedLoad>       m_queuedLoads;
+    int                           m_inFlightCount = 0;     // Loader jobs running or pushed
+    sGameResourceLoaderStatistics m_statistics;
+};
@@ -0,0 +1,130 @@
+//----------------------------------------------------------------------------------------------------
+// MappedFile.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Resource/MappedFile.hpp"
+
+#if defined(_WIN32)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//----------------------------------------------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+//----------------------------------------------------------------------------------------------------
+// A view keeps its mapping, and the mapping its file, alive on both platforms, so only the view is
+// kept.
+//
+bool MappedFile::Open(char const* filePath)
+{
+    Close();
+
+#if defined(_WIN32)
+    HANDLE const file = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    HANDLE        mapping = nullptr;
+
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+    {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+
+    CloseHandle(file);
+
+    if (mapping == nullptr)
+    {
+        return false;
+    }
+
+    m_data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+
+    if (m_data == nullptr)
+    {
+        return false;
+    }
+
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int const file = open(filePath, O_RDONLY);
+
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStatus;
+    void*       data = MAP_FAILED;
+
+    if (fstat(file, &fileStatus) == 0 && fileStatus.st_size > 0)
+    {
+        data = mmap(nullptr, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    }
+
+    close(file);
+
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    m_data = data;
+    m_size = static_cast<size_t>(fileStatus.st_size);
+#endif
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void MappedFile::Close()
+{
+    if (m_data == nullptr)
+    {
+        return;
+    }
+
+#if defined(_WIN32)
+    UnmapViewOfFile(m_data);
+#else
+    munmap(const_cast<void*>(m_data), m_size);
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool MappedFile::IsOpen() const
+{
+    return m_data != nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+unsigned char const* MappedFile::GetData() const
+{
+    return static_cast<unsigned char const*>(m_data);
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t MappedFile::GetSize() const
+{
+    return m_size;
+}
@@ -0,0 +1,33 @@
+//----------------------------------------------------------------------------------------------------
+// MappedFile.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+
+//----------------------------------------------------------------------------------------------------
+// A whole file mapped read-only into memory. Nothing is read up front: pages come in from the OS
+// file cache the first time they are touched, so opening costs the same for any file size and
+// data that is never touched is never read.
+//
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile const&)            = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    bool Open(char const* filePath);        // Closes what was open first; fails on an empty file
+    void Close();
+
+    bool                 IsOpen() const;
+    unsigned char const* GetData() const;
+    size_t               GetSize() const;
+
+private:
+    void const* m_data = nullptr;       // The mapped view; the file and mapping handles close once it exists
+    size_t      m_size = 0;
+};
@@ -0,0 +1,48 @@
+//----------------------------------------------------------------------------------------------------
+// MeshData.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Resource/MeshData.hpp"
+
+#include <cmath>
+
+//----------------------------------------------------------------------------------------------------
+sBoundingSphere ComputeLocalBoundingSphere(std::vector<Vertex_PCU> const& vertexes)
+{
+    if (vertexes.empty())
+    {
+        return sBoundingSphere();
+    }
+
+    Vec3 mins = vertexes[0].m_position;
+    Vec3 maxs = vertexes[0].m_position;
+
+    for (Vertex_PCU const& vertex : vertexes)
+    {
+        Vec3 const& position = vertex.m_position;
+
+        mins.x = position.x < mins.x ? position.x : mins.x;
+        mins.y = position.y < mins.y ? position.y : mins.y;
+        mins.z = position.z < mins.z ? position.z : mins.z;
+        maxs.x = position.x > maxs.x ? position.x : maxs.x;
+        maxs.y = position.y > maxs.y ? position.y : maxs.y;
+        maxs.z = position.z > maxs.z ? position.z : maxs.z;
+    }
+
+    Vec3 const center           = (mins + maxs) * 0.5f;
+    float      maxRadiusSquared = 0.f;
+
+    for (Vertex_PCU const& vertex : vertexes)
+    {
+        Vec3 const  displacement  = vertex.m_position - center;
+        float const radiusSquared = displacement.x * displacement.x + displacement.y * displacement.y + displacement.z * displacement.z;
+        maxRadiusSquared          = radiusSquared > maxRadiusSquared ? radiusSquared : maxRadiusSquared;
+    }
+
+    sBoundingSphere sphere;
+    sphere.m_center = center;
+    sphere.m_radius = sqrtf(maxRadiusSquared);
+
+    return sphere;
+}
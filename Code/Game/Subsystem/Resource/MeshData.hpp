@@ -0,0 +1,40 @@
+//----------------------------------------------------------------------------------------------------
+// MeshData.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Game/Math/FrustumCulling.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// A run of consecutive triangles drawn with one material.
+//
+struct sSubmesh
+{
+    unsigned int m_firstIndex    = 0;
+    unsigned int m_indexCount    = 0;
+    int          m_materialIndex = -1;      // Into sMeshData::m_materialNames; -1 for none
+};
+
+//----------------------------------------------------------------------------------------------------
+// A decoded mesh on the CPU, in the form RenderBackend::CreateStaticMesh takes. Built off the main
+// thread by the mesh loaders; only the upload has to happen on the thread that owns the backend.
+//
+struct sMeshData
+{
+    std::vector<Vertex_PCU>   m_vertexes;
+    std::vector<unsigned int> m_indexes;                 // Empty for flat triangle lists
+    std::vector<sSubmesh>     m_submeshes;               // Cover m_indexes in order, without gaps
+    std::vector<String>       m_materialNames;
+    sBoundingSphere           m_localBoundingSphere;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Centered on the vertexes' bounding box, so it is not the tightest sphere but is stable and cheap.
+// Matches Prop::ComputeLocalBounds.
+//
+sBoundingSphere ComputeLocalBoundingSphere(std::vector<Vertex_PCU> const& vertexes);
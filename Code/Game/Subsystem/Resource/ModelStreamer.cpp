@@ -0,0 +1,315 @@
+//----------------------------------------------------------------------------------------------------
+// ModelStreamer.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Resource/ModelStreamer.hpp"
+
+#include <cstdio>
+
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Subsystem/Profile/Profiler.hpp"
+#include "Game/Subsystem/Render/RenderBackend.hpp"
+#include "Game/Subsystem/Resource/BakedMesh.hpp"
+#include "Game/Subsystem/Resource/ObjMeshParser.hpp"
+#include "Game/Subsystem/Resource/GameResourceLoader.hpp"
+
+//----------------------------------------------------------------------------------------------------
+bool ModelHandle::IsValid() const
+{
+    return m_index != UINT32_MAX;
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool ReadFileToBuffer(char const* filePath, std::vector<char>& out_buffer)
+{
+    FILE* file = nullptr;
+
+#if defined(_WIN32)
+    if (fopen_s(&file, filePath, "rb") != 0)
+    {
+        file = nullptr;
+    }
+#else
+    file = fopen(filePath, "rb");
+#endif
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long const fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    out_buffer.resize(fileSize > 0 ? static_cast<size_t>(fileSize) : 0);
+    size_t const readSize = out_buffer.empty() ? 0 : fread(out_buffer.data(), 1, out_buffer.size(), file);
+    fclose(file);
+
+    return fileSize >= 0 && readSize == out_buffer.size();
+}
+
+//----------------------------------------------------------------------------------------------------
+// The placeholder is a flat-shaded unit cube, the same size as the game's cube prop.
+//
+ModelStreamer::ModelStreamer(GameResourceLoader& resourceLoader, sModelStreamerConfig const& config)
+    : m_resourceLoader(resourceLoader),
+      m_config(config)
+{
+    std::vector<Vertex_PCU> placeholderVertexes;
+    AddVertsForAABB3D(placeholderVertexes, AABB3(Vec3(-0.5f, -0.5f, -0.5f), Vec3(0.5f, 0.5f, 0.5f)), Rgba8::GREY);
+
+    m_placeholderStaticMeshId   = g_theRenderBackend->CreateStaticMesh(placeholderVertexes, std::vector<unsigned int>());
+    m_placeholderBoundingSphere = ComputeLocalBoundingSphere(placeholderVertexes);
+}
+
+//----------------------------------------------------------------------------------------------------
+ModelStreamer::~ModelStreamer()
+{
+    WaitForDecodes();
+
+    for (sDecodedModel const& decoded : m_decodedModels)
+    {
+        delete decoded.m_bakedMesh;
+    }
+
+    for (sModel const& model : m_models)
+    {
+        if (model.m_staticMeshId >= 0)
+        {
+            g_theRenderBackend->DestroyStaticMesh(model.m_staticMeshId);
+        }
+    }
+
+    g_theRenderBackend->DestroyStaticMesh(m_placeholderStaticMeshId);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Costs a lookup and a queued load; the file is not touched on this thread.
+//
+ModelHandle ModelStreamer::RequestModel(String const& filePath, ModelReadyCallback const& onReady)
+{
+    ModelHandle handle;
+    auto const  found = m_indexesByPath.find(filePath);
+
+    if (found != m_indexesByPath.end())
+    {
+        handle.m_index = found->second;
+        sModel& model  = m_models[handle.m_index];
+
+        if (model.m_state != eModelState::LOADING && onReady)
+        {
+            onReady(handle, model.m_state);
+        }
+        else if (onReady)
+        {
+            model.m_callbacks.push_back(onReady);
+        }
+
+        return handle;
+    }
+
+    handle.m_index = static_cast<uint32_t>(m_models.size());
+
+    sModel model;
+    model.m_filePath = filePath;
+
+    if (onReady)
+    {
+        model.m_callbacks.push_back(onReady);
+    }
+
+    m_models.push_back(std::move(model));
+    m_indexesByPath.emplace(filePath, handle.m_index);
+    ++m_loadingCount;
+    ++m_statistics.m_requestedCount;
+
+    uint32_t const index = handle.m_index;
+
+    m_resourceLoader.QueueLoad("ModelStreamer::DecodeModel", [this, index, filePath]() { DecodeModel(index, filePath); });
+
+    return handle;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Always publishes at least one model, so a mesh that alone takes longer than the budget still
+// gets through.
+//
+int ModelStreamer::PublishFinishedModels()
+{
+    PROFILE_SCOPE("ModelStreamer::PublishFinishedModels");
+
+    double const startSeconds   = GetCurrentTimeSeconds();
+    int          publishedCount = 0;
+
+    for (;;)
+    {
+        sDecodedModel decoded;
+
+        {
+            std::lock_guard<std::mutex> const lock(m_decodedMutex);
+
+            if (m_decodedModels.empty())
+            {
+                break;
+            }
+
+            decoded = std::move(m_decodedModels.front());
+            m_decodedModels.pop_front();
+        }
+
+        PublishModel(decoded);
+        ++publishedCount;
+
+        if (GetCurrentTimeSeconds() - startSeconds >= m_config.m_publishBudgetSeconds)
+        {
+            break;
+        }
+    }
+
+    double const publishSeconds      = GetCurrentTimeSeconds() - startSeconds;
+    m_statistics.m_maxPublishSeconds = publishSeconds > m_statistics.m_maxPublishSeconds ? publishSeconds : m_statistics.m_maxPublishSeconds;
+
+    return publishedCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ModelStreamer::HasFinishedModels() const
+{
+    std::lock_guard<std::mutex> const lock(m_decodedMutex);
+    return !m_decodedModels.empty();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Decoded models still wait for PublishFinishedModels afterwards. Waits for every other load queued
+// on the GameResourceLoader too.
+//
+void ModelStreamer::WaitForDecodes()
+{
+    m_resourceLoader.WaitForLoads();
+}
+
+//----------------------------------------------------------------------------------------------------
+eModelState ModelStreamer::GetState(ModelHandle const handle) const
+{
+    return m_models[handle.m_index].m_state;
+}
+
+//----------------------------------------------------------------------------------------------------
+int ModelStreamer::GetStaticMeshId(ModelHandle const handle) const
+{
+    sModel const& model = m_models[handle.m_index];
+    return model.m_state == eModelState::READY ? model.m_staticMeshId : m_placeholderStaticMeshId;
+}
+
+//----------------------------------------------------------------------------------------------------
+sBoundingSphere const& ModelStreamer::GetLocalBoundingSphere(ModelHandle const handle) const
+{
+    sModel const& model = m_models[handle.m_index];
+    return model.m_state == eModelState::READY ? model.m_localBoundingSphere : m_placeholderBoundingSphere;
+}
+
+//----------------------------------------------------------------------------------------------------
+int ModelStreamer::GetPlaceholderStaticMeshId() const
+{
+    return m_placeholderStaticMeshId;
+}
+
+//----------------------------------------------------------------------------------------------------
+int ModelStreamer::GetLoadingCount() const
+{
+    return m_loadingCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+sModelStreamerStatistics ModelStreamer::GetStatistics() const
+{
+    return m_statistics;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Runs as a GameResourceLoader load, which marks it for the profiler; touches nothing but its own
+// locals and m_decodedModels.
+//
+void ModelStreamer::DecodeModel(uint32_t const index, String const& filePath)
+{
+    sDecodedModel     decoded;
+    std::vector<char> fileBuffer;
+    decoded.m_index = index;
+
+    size_t const extensionLength = sizeof(BAKED_MESH_EXTENSION) - 1;
+    bool const   isBaked         = filePath.size() > extensionLength && filePath.compare(filePath.size() - extensionLength, extensionLength, BAKED_MESH_EXTENSION) == 0;
+
+    if (isBaked)
+    {
+        decoded.m_bakedMesh = new BakedMesh();
+        decoded.m_isLoaded  = decoded.m_bakedMesh->Load(filePath.c_str(), &decoded.m_error);
+    }
+    else if (!ReadFileToBuffer(filePath.c_str(), fileBuffer))
+    {
+        decoded.m_error = "could not read the file";
+    }
+    else
+    {
+        decoded.m_isLoaded = ParseObjMeshParallel(g_theJobSystem, fileBuffer.data(), fileBuffer.size(), decoded.m_mesh, &decoded.m_error);
+    }
+
+    std::lock_guard<std::mutex> const lock(m_decodedMutex);
+    m_decodedModels.push_back(std::move(decoded));
+}
+
+//----------------------------------------------------------------------------------------------------
+void ModelStreamer::PublishModel(sDecodedModel& decoded)
+{
+    sModel&     model  = m_models[decoded.m_index];
+    ModelHandle handle;
+    handle.m_index = decoded.m_index;
+
+    BakedMesh const* bakedMesh = decoded.m_bakedMesh;
+
+    if (bakedMesh != nullptr && decoded.m_isLoaded && bakedMesh->GetVertexesPCU() == nullptr)
+    {
+        decoded.m_isLoaded = false;
+        decoded.m_error    = "static meshes take PCU vertexes only";
+    }
+
+    if (decoded.m_isLoaded && bakedMesh != nullptr)
+    {
+        model.m_staticMeshId        = g_theRenderBackend->CreateStaticMesh(bakedMesh->GetVertexesPCU(), bakedMesh->GetVertexCount(), bakedMesh->GetIndexes(), bakedMesh->GetIndexCount());
+        model.m_localBoundingSphere = bakedMesh->GetLocalBoundingSphere();
+        model.m_state               = eModelState::READY;
+        ++m_statistics.m_publishedCount;
+    }
+    else if (decoded.m_isLoaded)
+    {
+        model.m_staticMeshId        = g_theRenderBackend->CreateStaticMesh(decoded.m_mesh.m_vertexes, decoded.m_mesh.m_indexes);
+        model.m_localBoundingSphere = decoded.m_mesh.m_localBoundingSphere;
+        model.m_state               = eModelState::READY;
+        ++m_statistics.m_publishedCount;
+    }
+    else
+    {
+        DebuggerPrintf("ModelStreamer: \"%s\" failed to load: %s\n", model.m_filePath.c_str(), decoded.m_error.c_str());
+        model.m_state = eModelState::FAILED;
+        ++m_statistics.m_failedCount;
+    }
+
+    delete decoded.m_bakedMesh;
+    decoded.m_bakedMesh = nullptr;
+    --m_loadingCount;
+
+    // Moved out first, since a callback may request more models and grow m_models
+    eModelState const               state = model.m_state;
+    std::vector<ModelReadyCallback> callbacks;
+    callbacks.swap(model.m_callbacks);
+
+    for (ModelReadyCallback const& callback : callbacks)
+    {
+        callback(handle, state);
+    }
+}
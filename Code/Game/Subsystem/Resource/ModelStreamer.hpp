@@ -0,0 +1,131 @@
+//----------------------------------------------------------------------------------------------------
+// ModelStreamer.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Core/StringUtils.hpp"
+#include "Game/Subsystem/Resource/MeshData.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class BakedMesh;
+class GameResourceLoader;
+
+//----------------------------------------------------------------------------------------------------
+struct sModelStreamerConfig
+{
+    double m_publishBudgetSeconds = 0.002;      // Main-thread time PublishFinishedModels spends per call
+};
+
+//----------------------------------------------------------------------------------------------------
+// Counted since construction.
+//
+struct sModelStreamerStatistics
+{
+    int    m_requestedCount    = 0;     // Distinct files; repeated requests for a file are not counted
+    int    m_publishedCount    = 0;
+    int    m_failedCount       = 0;
+    double m_maxPublishSeconds = 0.0;   // Longest single PublishFinishedModels call
+};
+
+//----------------------------------------------------------------------------------------------------
+// Stable reference to a model requested from a ModelStreamer.
+//
+struct ModelHandle
+{
+    uint32_t m_index = UINT32_MAX;
+
+    bool IsValid() const;
+};
+
+//----------------------------------------------------------------------------------------------------
+enum class eModelState : uint8_t
+{
+    LOADING,
+    READY,
+    FAILED
+};
+
+//----------------------------------------------------------------------------------------------------
+// Fired on the main thread once the model is ready to draw, or has failed to load.
+//
+using ModelReadyCallback = std::function<void(ModelHandle handle, eModelState state)>;
+
+//----------------------------------------------------------------------------------------------------
+// Loads OBJ and baked (.bmesh) models without blocking the frame.
+//
+// RequestModel returns a handle at once and queues the file read and parse as a load on the
+// GameResourceLoader, which runs it as a background job. Decoded meshes wait in a queue until
+// PublishFinishedModels, called at a frame boundary on the thread that owns g_theRenderBackend, uploads them; it stops once it has spent
+// m_publishBudgetSeconds, so a large batch finishing at once spreads over several frames instead
+// of stalling one. Until its model is published a handle resolves to a placeholder cube, so callers
+// can draw it right away. A baked model is only mapped by its job, and uploads straight from the
+// mapping.
+//
+// Models are cached by path for the streamer's lifetime. Everything but the decode runs on the
+// main thread.
+//
+// The GameResourceLoader owns the streamer and is how the game reaches it.
+//
+class ModelStreamer
+{
+public:
+    explicit ModelStreamer(GameResourceLoader& resourceLoader, sModelStreamerConfig const& config = sModelStreamerConfig());
+    ~ModelStreamer();       // Waits out decodes still running, then destroys every mesh it created
+
+    ModelStreamer(ModelStreamer const&)            = delete;
+    ModelStreamer& operator=(ModelStreamer const&) = delete;
+
+    // A model that is already ready or failed fires onReady before this returns
+    ModelHandle RequestModel(String const& filePath, ModelReadyCallback const& onReady = nullptr);
+    int         PublishFinishedModels();        // Returns the number published or failed
+    bool        HasFinishedModels() const;      // Decoded and waiting for PublishFinishedModels
+    void        WaitForDecodes();
+
+    eModelState              GetState(ModelHandle handle) const;
+    int                      GetStaticMeshId(ModelHandle handle) const;                  // The placeholder's until READY
+    sBoundingSphere const&   GetLocalBoundingSphere(ModelHandle handle) const;           // The placeholder's until READY
+    int                      GetPlaceholderStaticMeshId() const;
+    int                      GetLoadingCount() const;
+    sModelStreamerStatistics GetStatistics() const;
+
+private:
+    struct sModel
+    {
+        String                          m_filePath;
+        eModelState                     m_state        = eModelState::LOADING;
+        int                             m_staticMeshId = -1;
+        sBoundingSphere                 m_localBoundingSphere;
+        std::vector<ModelReadyCallback> m_callbacks;            // Fired and cleared on publish
+    };
+
+    struct sDecodedModel
+    {
+        uint32_t   m_index     = 0;
+        bool       m_isLoaded  = false;
+        sMeshData  m_mesh;
+        BakedMesh* m_bakedMesh = nullptr;       // Owned; set instead of m_mesh for .bmesh files
+        String     m_error;
+    };
+
+    void DecodeModel(uint32_t index, String const& filePath);
+    void PublishModel(sDecodedModel& decoded);
+
+    GameResourceLoader&                  m_resourceLoader;
+    sModelStreamerConfig                 m_config;
+    std::vector<sModel>                  m_models;            // Main thread only
+    std::unordered_map<String, uint32_t> m_indexesByPath;
+    int                                  m_placeholderStaticMeshId = -1;
+    sBoundingSphere                      m_placeholderBoundingSphere;
+    int                                  m_loadingCount            = 0;
+    mutable std::mutex                   m_decodedMutex;      // Guards m_decodedModels
+    std::deque<sDecodedModel>            m_decodedModels;     // Filled by decode jobs, drained by PublishFinishedModels
+    sModelStreamerStatistics             m_statistics;
+};
@@ -0,0 +1,905 @@
+//----------------------------------------------------------------------------------------------------
+// ObjMeshParser.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Resource/ObjMeshParser.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Game/Math/SIMD.hpp"
+#include "Game/Subsystem/Job/JobSystem.hpp"
+#include "Game/Subsystem/Profile/Profiler.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static size_t constexpr MAX_NUMBER_LENGTH = 63;
+
+//----------------------------------------------------------------------------------------------------
+static bool IsBlank(char const character)
+{
+    return character == ' ' || character == '\t' || character == '\r';
+}
+
+//----------------------------------------------------------------------------------------------------
+static void SkipBlanks(char const*& cursor, char const* lineEnd)
+{
+    while (cursor < lineEnd && IsBlank(*cursor))
+    {
+        ++cursor;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// strtof needs a terminated string, and the text may not be terminated, so the token is copied out.
+//
+static bool ParseFloat(char const*& cursor, char const* lineEnd, float& out_value)
+{
+    SkipBlanks(cursor, lineEnd);
+
+    char   token[MAX_NUMBER_LENGTH + 1];
+    size_t length = 0;
+
+    while (cursor + length < lineEnd && !IsBlank(cursor[length]) && length < MAX_NUMBER_LENGTH)
+    {
+        token[length] = cursor[length];
+        ++length;
+    }
+
+    token[length] = '\0';
+
+    char* tokenEnd = nullptr;
+    out_value      = strtof(token, &tokenEnd);
+
+    if (length == 0 || tokenEnd != token + length)
+    {
+        return false;
+    }
+
+    cursor += length;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool ParseInt(char const*& cursor, char const* lineEnd, int& out_value)
+{
+    bool const isNegative = cursor < lineEnd && *cursor == '-';
+    cursor += isNegative ? 1 : 0;
+
+    char const* const digitsStart = cursor;
+    int64_t           value       = 0;
+
+    while (cursor < lineEnd && *cursor >= '0' && *cursor <= '9' && value <= INT32_MAX)
+    {
+        value = value * 10 + (*cursor - '0');
+        ++cursor;
+    }
+
+    out_value = static_cast<int>(isNegative ? -value : value);
+    return cursor != digitsStart && value <= INT32_MAX;
+}
+
+//----------------------------------------------------------------------------------------------------
+// OBJ indexes are 1-based, or negative to count back from the latest record; 0 is never valid.
+//
+static bool ResolveIndex(int const objIndex, size_t const count, uint32_t& out_index)
+{
+    int64_t const index = objIndex > 0 ? static_cast<int64_t>(objIndex) - 1 : static_cast<int64_t>(count) + objIndex;
+
+    if (objIndex == 0 || index < 0 || index >= static_cast<int64_t>(count))
+    {
+        return false;
+    }
+
+    out_index = static_cast<uint32_t>(index);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool IsUseMaterialRecord(char const* cursor, char const* lineEnd)
+{
+    return lineEnd - cursor >= 7 && strncmp(cursor, "usemtl", 6) == 0 && IsBlank(cursor[6]);
+}
+
+//----------------------------------------------------------------------------------------------------
+// The rest of a usemtl line, without surrounding blanks; false when that is empty.
+//
+static bool ParseMaterialName(char const* cursor, char const* lineEnd, String& out_name)
+{
+    cursor += 6;
+    SkipBlanks(cursor, lineEnd);
+
+    char const* nameEnd = lineEnd;
+
+    while (nameEnd > cursor && IsBlank(nameEnd[-1]))
+    {
+        --nameEnd;
+    }
+
+    out_name.assign(cursor, nameEnd);
+    return nameEnd != cursor;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Materials are numbered in order of first use.
+//
+static int FindOrAddMaterial(std::vector<String>& materialNames, String const& name)
+{
+    int materialIndex = 0;
+
+    while (materialIndex < static_cast<int>(materialNames.size()) && materialNames[materialIndex] != name)
+    {
+        ++materialIndex;
+    }
+
+    if (materialIndex == static_cast<int>(materialNames.size()))
+    {
+        materialNames.push_back(name);
+    }
+
+    return materialIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ParseObjMesh(char const* text, size_t const textLength, sMeshData& out_mesh, String* out_error)
+{
+    out_mesh.m_vertexes.clear();
+    out_mesh.m_indexes.clear();
+    out_mesh.m_submeshes.clear();
+    out_mesh.m_materialNames.clear();
+
+    std::vector<Vec3>                          positions;
+    std::vector<Vec2>                          uvs;
+    std::vector<unsigned int>                  faceCorners;
+    std::unordered_map<uint64_t, unsigned int> vertexIndexes;      // (position, uv + 1) to vertex
+    int                                        materialIndex = -1;
+
+    char const* const textEnd    = text + textLength;
+    char const*       lineStart  = text;
+    int               lineNumber = 0;
+
+    auto const fail = [&lineNumber, out_error](char const* reason)
+    {
+        if (out_error != nullptr)
+        {
+            *out_error = Stringf("line %d: %s", lineNumber, reason);
+        }
+
+        return false;
+    };
+
+    while (lineStart < textEnd)
+    {
+        char const* lineEnd = lineStart;
+
+        while (lineEnd < textEnd && *lineEnd != '\n')
+        {
+            ++lineEnd;
+        }
+
+        ++lineNumber;
+
+        char const* cursor = lineStart;
+        lineStart          = lineEnd < textEnd ? lineEnd + 1 : textEnd;
+
+        SkipBlanks(cursor, lineEnd);
+
+        if (lineEnd - cursor >= 2 && cursor[0] == 'v' && IsBlank(cursor[1]))
+        {
+            Vec3 position;
+            cursor += 1;
+
+            if (!ParseFloat(cursor, lineEnd, position.x) || !ParseFloat(cursor, lineEnd, position.y) || !ParseFloat(cursor, lineEnd, position.z))
+            {
+                return fail("malformed v record");
+            }
+
+            positions.push_back(position);
+        }
+        else if (lineEnd - cursor >= 3 && cursor[0] == 'v' && cursor[1] == 't' && IsBlank(cursor[2]))
+        {
+            Vec2 uv;
+            cursor += 2;
+
+            if (!ParseFloat(cursor, lineEnd, uv.x) || !ParseFloat(cursor, lineEnd, uv.y))
+            {
+                return fail("malformed vt record");
+            }
+
+            uvs.push_back(uv);
+        }
+        else if (lineEnd - cursor >= 2 && cursor[0] == 'f' && IsBlank(cursor[1]))
+        {
+            cursor += 1;
+            faceCorners.clear();
+
+            for (SkipBlanks(cursor, lineEnd); cursor < lineEnd; SkipBlanks(cursor, lineEnd))
+            {
+                int      objPositionIndex = 0;
+                int      objUVIndex       = 0;
+                uint32_t positionIndex    = 0;
+                uint32_t uvIndex          = UINT32_MAX;
+
+                if (!ParseInt(cursor, lineEnd, objPositionIndex) || !ResolveIndex(objPositionIndex, positions.size(), positionIndex))
+                {
+                    return fail("bad position index in f record");
+                }
+
+                if (cursor < lineEnd && *cursor == '/')
+                {
+                    ++cursor;
+
+                    if (cursor < lineEnd && *cursor != '/')
+                    {
+                        if (!ParseInt(cursor, lineEnd, objUVIndex) || !ResolveIndex(objUVIndex, uvs.size(), uvIndex))
+                        {
+                            return fail("bad uv index in f record");
+                        }
+                    }
+
+                    // The normal index is checked for syntax only
+                    if (cursor < lineEnd && *cursor == '/')
+                    {
+                        int objNormalIndex = 0;
+                        ++cursor;
+
+                        if (!ParseInt(cursor, lineEnd, objNormalIndex))
+                        {
+                            return fail("bad normal index in f record");
+                        }
+                    }
+                }
+
+                if (cursor < lineEnd && !IsBlank(*cursor))
+                {
+                    return fail("malformed f record");
+                }
+
+                uint64_t const key    = (static_cast<uint64_t>(positionIndex) << 32) | static_cast<uint32_t>(uvIndex + 1);
+                auto const     result = vertexIndexes.emplace(key, static_cast<unsigned int>(out_mesh.m_vertexes.size()));
+
+                if (result.second)
+                {
+                    Vec2 const uv = uvIndex == UINT32_MAX ? Vec2() : uvs[uvIndex];
+                    out_mesh.m_vertexes.emplace_back(positions[positionIndex], Rgba8::WHITE, uv);
+                }
+
+                faceCorners.push_back(result.first->second);
+            }
+
+            if (faceCorners.size() < 3)
+            {
+                return fail("f record with fewer than three corners");
+            }
+
+            if (out_mesh.m_submeshes.empty() || out_mesh.m_submeshes.back().m_materialIndex != materialIndex)
+            {
+                sSubmesh submesh;
+                submesh.m_firstIndex    = static_cast<unsigned int>(out_mesh.m_indexes.size());
+                submesh.m_materialIndex = materialIndex;
+                out_mesh.m_submeshes.push_back(submesh);
+            }
+
+            out_mesh.m_submeshes.back().m_indexCount += static_cast<unsigned int>(faceCorners.size() - 2) * 3;
+
+            for (size_t corner = 1; corner + 1 < faceCorners.size(); ++corner)
+            {
+                out_mesh.m_indexes.push_back(faceCorners[0]);
+                out_mesh.m_indexes.push_back(faceCorners[corner]);
+                out_mesh.m_indexes.push_back(faceCorners[corner + 1]);
+            }
+        }
+        else if (IsUseMaterialRecord(cursor, lineEnd))
+        {
+            String name;
+
+            if (!ParseMaterialName(cursor, lineEnd, name))
+            {
+                return fail("usemtl record with no name");
+            }
+
+            materialIndex = FindOrAddMaterial(out_mesh.m_materialNames, name);
+        }
+    }
+
+    out_mesh.m_localBoundingSphere = ComputeLocalBoundingSphere(out_mesh.m_vertexes);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+static size_t constexpr OBJ_CHUNK_BYTES    = 256 * 1024;
+static int constexpr    VERTEX_SHARD_BITS  = 6;
+static int constexpr    VERTEX_SHARD_COUNT = 1 << VERTEX_SHARD_BITS;
+static int constexpr    NO_UV_INDEX        = INT32_MIN;        // ParseInt never gives it
+
+//----------------------------------------------------------------------------------------------------
+static float const s_powersOf10[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f };       // All exact in a float
+
+//----------------------------------------------------------------------------------------------------
+// Sixteen bytes at a time where SSE2 is available.
+//
+static char const* FindLineEnd(char const* cursor, char const* textEnd)
+{
+#if defined(GAME_SIMD_SSE)
+    __m128i const newline = _mm_set1_epi8('\n');
+
+    for (; textEnd - cursor >= 16; cursor += 16)
+    {
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(cursor)), newline)) != 0)
+        {
+            break;
+        }
+    }
+#endif
+
+    while (cursor < textEnd && *cursor != '\n')
+    {
+        ++cursor;
+    }
+
+    return cursor;
+}
+
+//----------------------------------------------------------------------------------------------------
+// A plain decimal of up to 9 digits whose digits fit a float exactly, as "%f" writes them, is one
+// correctly rounded float division, which is the value strtof returns. Anything else (exponents,
+// more digits, inf, hex) goes to ParseFloat, so the result never differs from it.
+//
+static bool ParseFloatFast(char const*& cursor, char const* lineEnd, float& out_value)
+{
+    SkipBlanks(cursor, lineEnd);
+
+    char const* scan       = cursor;
+    bool const  isNegative = scan < lineEnd && *scan == '-';
+    scan += scan < lineEnd && (*scan == '-' || *scan == '+') ? 1 : 0;
+
+    uint32_t mantissa       = 0;
+    int      digitCount     = 0;
+    int      fractionDigits = 0;
+
+    for (; scan < lineEnd && *scan >= '0' && *scan <= '9' && digitCount < 9; ++scan, ++digitCount)
+    {
+        mantissa = mantissa * 10 + static_cast<uint32_t>(*scan - '0');
+    }
+
+    if (scan < lineEnd && *scan == '.')
+    {
+        for (++scan; scan < lineEnd && *scan >= '0' && *scan <= '9' && digitCount < 9; ++scan, ++digitCount, ++fractionDigits)
+        {
+            mantissa = mantissa * 10 + static_cast<uint32_t>(*scan - '0');
+        }
+    }
+
+    bool const isPlain = digitCount > 0 && (scan == lineEnd || IsBlank(*scan)) && mantissa <= (1u << 24);
+
+    if (!isPlain)
+    {
+        return ParseFloat(cursor, lineEnd, out_value);
+    }
+
+    float const magnitude = static_cast<float>(mantissa) / s_powersOf10[fractionDigits];
+    out_value             = isNegative ? -magnitude : magnitude;
+    cursor                = scan;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+struct sObjCorner
+{
+    int m_objPositionIndex = 0;
+    int m_objUVIndex       = NO_UV_INDEX;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Counts are of the records before the face in its own chunk, for resolving negative indexes.
+//
+struct sObjFace
+{
+    uint32_t m_firstCorner    = 0;      // Into its chunk's m_corners
+    uint32_t m_cornerCount    = 0;
+    uint32_t m_positionCount  = 0;
+    uint32_t m_uvCount        = 0;
+    int      m_lineNumber     = 0;      // In its chunk
+    int      m_materialSwitch = -1;     // The latest usemtl in its chunk; -1 keeps the previous chunk's
+};
+
+//----------------------------------------------------------------------------------------------------
+// One line-aligned piece of the text: its records as parsed, then what the merge works out for it.
+//
+struct sObjChunk
+{
+    char const*             m_begin            = nullptr;
+    char const*             m_end              = nullptr;
+    std::vector<Vec3>       m_positions;
+    std::vector<Vec2>       m_uvs;
+    std::vector<sObjCorner> m_corners;
+    std::vector<sObjFace>   m_faces;                        // A face that failed is kept as far as it parsed
+    std::vector<String>     m_materialSwitches;             // usemtl names in order
+    int                     m_lineCount        = 0;
+    int                     m_errorLine        = 0;         // 0 when every line parsed
+    char const*             m_errorReason      = nullptr;
+
+    uint32_t                m_positionBase     = 0;
+    uint32_t                m_uvBase           = 0;
+    uint32_t                m_cornerBase       = 0;
+    int                     m_lineBase         = 0;
+    int                     m_startMaterial    = -1;
+    std::vector<int>        m_switchMaterials;              // m_materialSwitches as material indexes
+    int                     m_rangeErrorLine   = 0;
+    char const*             m_rangeErrorReason = nullptr;
+    uint32_t                m_indexCount       = 0;
+    uint32_t                m_indexBase        = 0;
+    uint32_t                m_newVertexCount   = 0;
+    uint32_t                m_vertexBase       = 0;
+    std::vector<uint32_t>   m_shardStarts;                  // Where its corners go in each shard's list
+    std::vector<sSubmesh>   m_submeshes;
+};
+
+//----------------------------------------------------------------------------------------------------
+// ParseObjMesh's record syntax, keeping indexes as written: they are checked against the whole file
+// in the merge. A failing f record keeps the corners parsed before the failure, since an index out
+// of range among them comes first in ParseObjMesh.
+//
+static void ParseObjChunk(sObjChunk& chunk)
+{
+    char const*       lineStart  = chunk.m_begin;
+    char const* const textEnd    = chunk.m_end;
+    int               lineNumber = 0;
+
+    auto const fail = [&chunk, &lineNumber](char const* reason)
+    {
+        chunk.m_errorLine   = lineNumber;
+        chunk.m_errorReason = reason;
+        chunk.m_lineCount   = lineNumber;
+    };
+
+    while (lineStart < textEnd)
+    {
+        char const* const lineEnd = FindLineEnd(lineStart, textEnd);
+        ++lineNumber;
+
+        char const* cursor = lineStart;
+        lineStart          = lineEnd < textEnd ? lineEnd + 1 : textEnd;
+
+        SkipBlanks(cursor, lineEnd);
+
+        if (lineEnd - cursor >= 2 && cursor[0] == 'v' && IsBlank(cursor[1]))
+        {
+            Vec3 position;
+            cursor += 1;
+
+            if (!ParseFloatFast(cursor, lineEnd, position.x) || !ParseFloatFast(cursor, lineEnd, position.y) || !ParseFloatFast(cursor, lineEnd, position.z))
+            {
+                return fail("malformed v record");
+            }
+
+            chunk.m_positions.push_back(position);
+        }
+        else if (lineEnd - cursor >= 3 && cursor[0] == 'v' && cursor[1] == 't' && IsBlank(cursor[2]))
+        {
+            Vec2 uv;
+            cursor += 2;
+
+            if (!ParseFloatFast(cursor, lineEnd, uv.x) || !ParseFloatFast(cursor, lineEnd, uv.y))
+            {
+                return fail("malformed vt record");
+            }
+
+            chunk.m_uvs.push_back(uv);
+        }
+        else if (lineEnd - cursor >= 2 && cursor[0] == 'f' && IsBlank(cursor[1]))
+        {
+            sObjFace face;
+            face.m_firstCorner    = static_cast<uint32_t>(chunk.m_corners.size());
+            face.m_positionCount  = static_cast<uint32_t>(chunk.m_positions.size());
+            face.m_uvCount        = static_cast<uint32_t>(chunk.m_uvs.size());
+            face.m_lineNumber     = lineNumber;
+            face.m_materialSwitch = static_cast<int>(chunk.m_materialSwitches.size()) - 1;
+
+            char const* reason = nullptr;
+            cursor += 1;
+
+            for (SkipBlanks(cursor, lineEnd); cursor < lineEnd && reason == nullptr; SkipBlanks(cursor, lineEnd))
+            {
+                sObjCorner corner;
+
+                if (!ParseInt(cursor, lineEnd, corner.m_objPositionIndex))
+                {
+                    reason = "bad position index in f record";
+                    break;
+                }
+
+                if (cursor < lineEnd && *cursor == '/')
+                {
+                    ++cursor;
+
+                    if (cursor < lineEnd && *cursor != '/' && !ParseInt(cursor, lineEnd, corner.m_objUVIndex))
+                    {
+                        corner.m_objUVIndex = NO_UV_INDEX;
+                        reason              = "bad uv index in f record";
+                    }
+
+                    int objNormalIndex = 0;
+
+                    if (reason == nullptr && cursor < lineEnd && *cursor == '/' && !ParseInt(++cursor, lineEnd, objNormalIndex))
+                    {
+                        reason = "bad normal index in f record";
+                    }
+                }
+
+                if (reason == nullptr && cursor < lineEnd && !IsBlank(*cursor))
+                {
+                    reason = "malformed f record";
+                }
+
+                chunk.m_corners.push_back(corner);
+            }
+
+            face.m_cornerCount = static_cast<uint32_t>(chunk.m_corners.size()) - face.m_firstCorner;
+            chunk.m_faces.push_back(face);
+
+            if (reason == nullptr && face.m_cornerCount < 3)
+            {
+                reason = "f record with fewer than three corners";
+            }
+
+            if (reason != nullptr)
+            {
+                return fail(reason);
+            }
+        }
+        else if (IsUseMaterialRecord(cursor, lineEnd))
+        {
+            String name;
+
+            if (!ParseMaterialName(cursor, lineEnd, name))
+            {
+                return fail("usemtl record with no name");
+            }
+
+            chunk.m_materialSwitches.push_back(name);
+        }
+    }
+
+    chunk.m_lineCount = lineNumber;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Turns the chunk's corners into ParseObjMesh's (position, uv + 1) keys, in order, stopping at the
+// first index out of range.
+//
+static void ResolveObjChunk(sObjChunk& chunk, uint64_t* cornerKeys)
+{
+    for (sObjFace const& face : chunk.m_faces)
+    {
+        for (uint32_t corner = face.m_firstCorner; corner < face.m_firstCorner + face.m_cornerCount; ++corner)
+        {
+            sObjCorner const& objCorner     = chunk.m_corners[corner];
+            uint32_t          positionIndex = 0;
+            uint32_t          uvIndex       = UINT32_MAX;
+
+            if (!ResolveIndex(objCorner.m_objPositionIndex, chunk.m_positionBase + face.m_positionCount, positionIndex))
+            {
+                chunk.m_rangeErrorLine   = face.m_lineNumber;
+                chunk.m_rangeErrorReason = "bad position index in f record";
+                return;
+            }
+
+            if (objCorner.m_objUVIndex != NO_UV_INDEX && !ResolveIndex(objCorner.m_objUVIndex, chunk.m_uvBase + face.m_uvCount, uvIndex))
+            {
+                chunk.m_rangeErrorLine   = face.m_lineNumber;
+                chunk.m_rangeErrorReason = "bad uv index in f record";
+                return;
+            }
+
+            cornerKeys[chunk.m_cornerBase + corner] = (static_cast<uint64_t>(positionIndex) << 32) | static_cast<uint32_t>(uvIndex + 1);
+        }
+
+        chunk.m_indexCount += face.m_cornerCount >= 3 ? (face.m_cornerCount - 2) * 3 : 0;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+static int GetVertexShard(uint64_t const key)
+{
+    return static_cast<int>((key * 0x9E3779B97F4A7C15ull) >> (64 - VERTEX_SHARD_BITS));
+}
+
+//----------------------------------------------------------------------------------------------------
+// Every step but the bookkeeping between them runs per chunk or per shard, and none depends on how
+// the chunks or shards land on threads.
+//
+bool ParseObjMeshParallel(JobSystem* jobSystem, char const* text, size_t const textLength, sMeshData& out_mesh, String* out_error)
+{
+    out_mesh.m_vertexes.clear();
+    out_mesh.m_indexes.clear();
+    out_mesh.m_submeshes.clear();
+    out_mesh.m_materialNames.clear();
+
+    std::vector<sObjChunk> chunks;
+    char const* const      textEnd = text + textLength;
+
+    for (char const* chunkBegin = text; chunkBegin < textEnd; chunkBegin = chunks.back().m_end)
+    {
+        char const* const chunkEnd = static_cast<size_t>(textEnd - chunkBegin) > OBJ_CHUNK_BYTES ? FindLineEnd(chunkBegin + OBJ_CHUNK_BYTES, textEnd) : textEnd;
+
+        chunks.emplace_back();
+        chunks.back().m_begin = chunkBegin;
+        chunks.back().m_end   = chunkEnd < textEnd ? chunkEnd + 1 : textEnd;
+    }
+
+    ParallelFor(jobSystem, static_cast<int>(chunks.size()), 1, [&chunks](int const begin, int const end)
+    {
+        PROFILE_SCOPE("ObjMeshParser::ParseChunks");
+
+        for (int chunkIndex = begin; chunkIndex < end; ++chunkIndex)
+        {
+            ParseObjChunk(chunks[chunkIndex]);
+        }
+    });
+
+    // Bases in file order; nothing after the first chunk that failed to parse matters
+    int      chunkCount    = static_cast<int>(chunks.size());
+    uint32_t positionCount = 0;
+    uint32_t uvCount       = 0;
+    uint32_t cornerCount   = 0;
+    int      lineCount     = 0;
+    int      materialIndex = -1;
+
+    for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+    {
+        sObjChunk& chunk      = chunks[chunkIndex];
+        chunk.m_positionBase  = positionCount;
+        chunk.m_uvBase        = uvCount;
+        chunk.m_cornerBase    = cornerCount;
+        chunk.m_lineBase      = lineCount;
+        chunk.m_startMaterial = materialIndex;
+
+        for (String const& name : chunk.m_materialSwitches)
+        {
+            materialIndex = FindOrAddMaterial(out_mesh.m_materialNames, name);
+            chunk.m_switchMaterials.push_back(materialIndex);
+        }
+
+        positionCount += static_cast<uint32_t>(chunk.m_positions.size());
+        uvCount       += static_cast<uint32_t>(chunk.m_uvs.size());
+        cornerCount   += static_cast<uint32_t>(chunk.m_corners.size());
+        lineCount     += chunk.m_lineCount;
+
+        if (chunk.m_errorLine != 0)
+        {
+            chunkCount = chunkIndex + 1;
+            break;
+        }
+    }
+
+    std::vector<uint64_t> cornerKeys(cornerCount);
+
+    ParallelFor(jobSystem, chunkCount, 1, [&chunks, &cornerKeys](int const begin, int const end)
+    {
+        PROFILE_SCOPE("ObjMeshParser::ResolveChunks");
+
+        for (int chunkIndex = begin; chunkIndex < end; ++chunkIndex)
+        {
+            ResolveObjChunk(chunks[chunkIndex], cornerKeys.data());
+        }
+    });
+
+    // The first failure in the file: within a chunk, a bad index comes no later than a syntax error
+    for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+    {
+        sObjChunk const&  chunk     = chunks[chunkIndex];
+        int const         errorLine = chunk.m_rangeErrorLine != 0 ? chunk.m_rangeErrorLine : chunk.m_errorLine;
+        char const* const reason    = chunk.m_rangeErrorLine != 0 ? chunk.m_rangeErrorReason : chunk.m_errorReason;
+
+        if (errorLine != 0)
+        {
+            if (out_error != nullptr)
+            {
+                *out_error = Stringf("line %d: %s", chunk.m_lineBase + errorLine, reason);
+            }
+
+            return false;
+        }
+    }
+
+    // Shard each chunk's corners by key, so each shard's list holds its corners in file order
+    std::vector<uint32_t> shardStarts(VERTEX_SHARD_COUNT + 1, 0);
+
+    ParallelFor(jobSystem, chunkCount, 1, [&chunks, &cornerKeys](int const begin, int const end)
+    {
+        PROFILE_SCOPE("ObjMeshParser::CountShardCorners");
+
+        for (int chunkIndex = begin; chunkIndex < end; ++chunkIndex)
+        {
+            sObjChunk& chunk = chunks[chunkIndex];
+            chunk.m_shardStarts.assign(VERTEX_SHARD_COUNT, 0);      // Counts for now; starts once every chunk has counted
+
+            for (uint32_t corner = 0; corner < chunk.m_corners.size(); ++corner)
+            {
+                ++chunk.m_shardStarts[GetVertexShard(cornerKeys[chunk.m_cornerBase + corner])];
+            }
+        }
+    });
+
+    uint32_t shardCornerCount = 0;
+
+    for (int shard = 0; shard < VERTEX_SHARD_COUNT; ++shard)
+    {
+        for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+        {
+            uint32_t&      shardStart  = chunks[chunkIndex].m_shardStarts[shard];
+            uint32_t const count       = shardStart;
+            shardStart                 = shardCornerCount;
+            shardCornerCount          += count;
+        }
+
+        shardStarts[shard + 1] = shardCornerCount;
+    }
+
+    std::vector<uint32_t> shardCorners(cornerCount);
+    std::vector<uint32_t> firstCorners(cornerCount);        // The first corner in the file with the same key
+
+    ParallelFor(jobSystem, chunkCount, 1, [&chunks, &cornerKeys, &shardCorners](int const begin, int const end)
+    {
+        PROFILE_SCOPE("ObjMeshParser::FillShards");
+
+        for (int chunkIndex = begin; chunkIndex < end; ++chunkIndex)
+        {
+            sObjChunk const&      chunk        = chunks[chunkIndex];
+            std::vector<uint32_t> shardCursors = chunk.m_shardStarts;
+
+            for (uint32_t corner = chunk.m_cornerBase; corner < chunk.m_cornerBase + chunk.m_corners.size(); ++corner)
+            {
+                shardCorners[shardCursors[GetVertexShard(cornerKeys[corner])]++] = corner;
+            }
+        }
+    });
+
+    ParallelFor(jobSystem, VERTEX_SHARD_COUNT, 1, [&shardStarts, &shardCorners, &cornerKeys, &firstCorners](int const begin, int const end)
+    {
+        PROFILE_SCOPE("ObjMeshParser::FindFirstCorners");
+
+        std::unordered_map<uint64_t, uint32_t> firstCornersByKey;
+
+        for (int shard = begin; shard < end; ++shard)
+        {
+            firstCornersByKey.clear();
+            firstCornersByKey.reserve(shardStarts[shard + 1] - shardStarts[shard]);
+
+            for (uint32_t listIndex = shardStarts[shard]; listIndex < shardStarts[shard + 1]; ++listIndex)
+            {
+                uint32_t const corner = shardCorners[listIndex];
+                firstCorners[corner]  = firstCornersByKey.emplace(cornerKeys[corner], corner).first->second;
+            }
+        }
+    });
+
+    // Vertexes are numbered by first corner, as ParseObjMesh numbers them
+    ParallelFor(jobSystem, chunkCount, 1, [&chunks, &firstCorners](int const begin, int const end)
+    {
+        PROFILE_SCOPE("ObjMeshParser::CountNewVertexes");
+
+        for (int chunkIndex = begin; chunkIndex < end; ++chunkIndex)
+        {
+            sObjChunk& chunk = chunks[chunkIndex];
+
+            for (uint32_t corner = chunk.m_cornerBase; corner < chunk.m_cornerBase + chunk.m_corners.size(); ++corner)
+            {
+                chunk.m_newVertexCount += firstCorners[corner] == corner ? 1 : 0;
+            }
+        }
+    });
+
+    uint32_t vertexCount = 0;
+    uint32_t indexCount  = 0;
+
+    for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+    {
+        chunks[chunkIndex].m_vertexBase  = vertexCount;
+        chunks[chunkIndex].m_indexBase   = indexCount;
+        vertexCount                     += chunks[chunkIndex].m_newVertexCount;
+        indexCount                      += chunks[chunkIndex].m_indexCount;
+    }
+
+    std::vector<Vec3> positions(positionCount);
+    std::vector<Vec2> uvs(uvCount);
+
+    ParallelFor(jobSystem, chunkCount, 1, [&chunks, &positions, &uvs](int const begin, int const end)
+    {
+        PROFILE_SCOPE("ObjMeshParser::GatherAttributes");
+
+        for (int chunkIndex = begin; chunkIndex < end; ++chunkIndex)
+        {
+            sObjChunk const& chunk = chunks[chunkIndex];
+            std::copy(chunk.m_positions.begin(), chunk.m_positions.end(), positions.begin() + chunk.m_positionBase);
+            std::copy(chunk.m_uvs.begin(), chunk.m_uvs.end(), uvs.begin() + chunk.m_uvBase);
+        }
+    });
+
+    std::vector<uint32_t> cornerVertexes(cornerCount);
+    out_mesh.m_vertexes.resize(vertexCount);
+    out_mesh.m_indexes.resize(indexCount);
+
+    ParallelFor(jobSystem, chunkCount, 1, [&chunks, &firstCorners, &cornerKeys, &cornerVertexes, &positions, &uvs, &out_mesh](int const begin, int const end)
+    {
+        PROFILE_SCOPE("ObjMeshParser::WriteVertexes");
+
+        for (int chunkIndex = begin; chunkIndex < end; ++chunkIndex)
+        {
+            sObjChunk const& chunk       = chunks[chunkIndex];
+            uint32_t         vertexIndex = chunk.m_vertexBase;
+
+            for (uint32_t corner = chunk.m_cornerBase; corner < chunk.m_cornerBase + chunk.m_corners.size(); ++corner)
+            {
+                if (firstCorners[corner] == corner)
+                {
+                    uint32_t const positionIndex = static_cast<uint32_t>(cornerKeys[corner] >> 32);
+                    uint32_t const uvIndex       = static_cast<uint32_t>(cornerKeys[corner]) - 1;
+                    Vec2 const     uv            = uvIndex == UINT32_MAX ? Vec2() : uvs[uvIndex];
+
+                    out_mesh.m_vertexes[vertexIndex] = Vertex_PCU(positions[positionIndex], Rgba8::WHITE, uv);
+                    cornerVertexes[corner]           = vertexIndex++;
+                }
+            }
+        }
+    });
+
+    // Only now is every first corner numbered, whichever chunk it is in
+    ParallelFor(jobSystem, chunkCount, 1, [&chunks, &firstCorners, &cornerVertexes, &out_mesh](int const begin, int const end)
+    {
+        PROFILE_SCOPE("ObjMeshParser::WriteIndexes");
+
+        for (int chunkIndex = begin; chunkIndex < end; ++chunkIndex)
+        {
+            sObjChunk& chunk = chunks[chunkIndex];
+            uint32_t   index = chunk.m_indexBase;
+
+            for (sObjFace const& face : chunk.m_faces)
+            {
+                uint32_t const firstCorner   = chunk.m_cornerBase + face.m_firstCorner;
+                int const      materialIndex = face.m_materialSwitch < 0 ? chunk.m_startMaterial : chunk.m_switchMaterials[face.m_materialSwitch];
+
+                if (chunk.m_submeshes.empty() || chunk.m_submeshes.back().m_materialIndex != materialIndex)
+                {
+                    sSubmesh submesh;
+                    submesh.m_firstIndex    = index;
+                    submesh.m_materialIndex = materialIndex;
+                    chunk.m_submeshes.push_back(submesh);
+                }
+
+                for (uint32_t corner = 1; corner + 1 < face.m_cornerCount; ++corner)
+                {
+                    out_mesh.m_indexes[index++] = cornerVertexes[firstCorners[firstCorner]];
+                    out_mesh.m_indexes[index++] = cornerVertexes[firstCorners[firstCorner + corner]];
+                    out_mesh.m_indexes[index++] = cornerVertexes[firstCorners[firstCorner + corner + 1]];
+                }
+
+                chunk.m_submeshes.back().m_indexCount += (face.m_cornerCount - 2) * 3;
+            }
+        }
+    });
+
+    for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+    {
+        for (sSubmesh const& submesh : chunks[chunkIndex].m_submeshes)
+        {
+            if (!out_mesh.m_submeshes.empty() && out_mesh.m_submeshes.back().m_materialIndex == submesh.m_materialIndex)
+            {
+                out_mesh.m_submeshes.back().m_indexCount += submesh.m_indexCount;
+            }
+            else
+            {
+                out_mesh.m_submeshes.push_back(submesh);
+            }
+        }
+    }
+
+    out_mesh.m_localBoundingSphere = ComputeLocalBoundingSphere(out_mesh.m_vertexes);
+    return true;
+}
@@ -0,0 +1,33 @@
+//----------------------------------------------------------------------------------------------------
+// ObjMeshParser.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+
+#include "Engine/Core/StringUtils.hpp"
+#include "Game/Subsystem/Resource/MeshData.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class JobSystem;
+
+//----------------------------------------------------------------------------------------------------
+// Parses Wavefront OBJ text into an indexed mesh. Reads v, vt and f records; face corners may be
+// v, v/vt, v//vn or v/vt/vn with 1-based or negative (relative) indexes, and polygons are fanned
+// into triangles. Each distinct position/uv pair becomes one vertex. usemtl starts a new submesh
+// for the faces that follow. Normals and groups are skipped, since Vertex_PCU has nowhere to put
+// them, and vertexes are white.
+// The text does not need to be null-terminated. Returns false on a malformed record or an index
+// out of range, with the line and reason in out_error when given.
+//
+bool ParseObjMesh(char const* text, size_t textLength, sMeshData& out_mesh, String* out_error = nullptr);
+
+//----------------------------------------------------------------------------------------------------
+// The same parse spread over `jobSystem`'s threads, or run on the caller alone when it is null. The
+// text is cut into line-aligned chunks whose records are parsed in parallel, then merged in file
+// order: indexes are resolved against the counts before each chunk, and vertexes are deduplicated
+// in shards that each see their corners in file order. The mesh, and the error on failure, are
+// byte for byte what ParseObjMesh gives, at any thread count.
+//
+bool ParseObjMeshParallel(JobSystem* jobSystem, char const* text, size_t textLength, sMeshData& out_mesh, String* out_error = nullptr);
@@ -0,0 +1,106 @@
+//----------------------------------------------------------------------------------------------------
+// TextureCache.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Resource/TextureCache.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+#include "Engine/Core/Time.hpp"
+#include "Game/Subsystem/Profile/Profiler.hpp"
+#include "Game/Subsystem/Resource/CookedTexture.hpp"
+#include "Game/Subsystem/Resource/MappedFile.hpp"
+
+//----------------------------------------------------------------------------------------------------
+TextureCache::TextureCache(sTextureCacheConfig const& config)
+    : m_config(config)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+// A miss cooks into a temporary file and renames it into place, so a crash mid-write never leaves a
+// truncated file under a valid key. Hits and cooks are timed apart, so a startup can report what a
+// cold cache cost it.
+//
+bool TextureCache::Load(char const* imageFilePath, CookedTexture& out_texture, String* out_error)
+{
+    PROFILE_SCOPE("TextureCache::Load");
+
+    double const startSeconds = GetCurrentTimeSeconds();
+
+    auto const fail = [this, &out_texture, out_error](char const* reason)
+    {
+        out_texture.Unload();
+        ++m_statistics.m_failedCount;
+
+        if (out_error != nullptr && reason != nullptr)
+        {
+            *out_error = reason;
+        }
+
+        return false;
+    };
+
+    MappedFile sourceFile;
+
+    if (!sourceFile.Open(imageFilePath))
+    {
+        return fail("could not map the image");
+    }
+
+    uint64_t const sourceHash     = HashTextureSource(sourceFile.GetData(), sourceFile.GetSize());
+    String const   cookedFilePath = GetCookedFilePath(sourceHash);
+
+    if (out_texture.Load(cookedFilePath.c_str()) && out_texture.GetSourceHash() == sourceHash && out_texture.GetSourceSize() == sourceFile.GetSize())
+    {
+        ++m_statistics.m_hitCount;
+        m_statistics.m_hitSeconds += GetCurrentTimeSeconds() - startSeconds;
+        return true;
+    }
+
+    // Unmapped before it is replaced, which Windows requires
+    out_texture.Unload();
+
+    std::error_code directoryError;
+    std::filesystem::create_directories(m_config.m_directory, directoryError);
+
+    String const temporaryFilePath = cookedFilePath + ".tmp";
+
+    if (!CookTexture(sourceFile.GetData(), sourceFile.GetSize(), temporaryFilePath.c_str(), out_error))
+    {
+        remove(temporaryFilePath.c_str());
+        return fail(nullptr);
+    }
+
+    remove(cookedFilePath.c_str());
+
+    if (rename(temporaryFilePath.c_str(), cookedFilePath.c_str()) != 0)
+    {
+        remove(temporaryFilePath.c_str());
+        return fail("could not move the cooked texture into the cache");
+    }
+
+    if (!out_texture.Load(cookedFilePath.c_str(), out_error))
+    {
+        return fail(nullptr);
+    }
+
+    ++m_statistics.m_cookedCount;
+    m_statistics.m_cookedSeconds += GetCurrentTimeSeconds() - startSeconds;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+String TextureCache::GetCookedFilePath(uint64_t const sourceHash) const
+{
+    return Stringf("%s/%016llx%s", m_config.m_directory.c_str(), static_cast<unsigned long long>(sourceHash), COOKED_TEXTURE_EXTENSION);
+}
+
+//----------------------------------------------------------------------------------------------------
+sTextureCacheStatistics const& TextureCache::GetStatistics() const
+{
+    return m_statistics;
+}
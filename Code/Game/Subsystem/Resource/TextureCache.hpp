@@ -0,0 +1,52 @@
+//----------------------------------------------------------------------------------------------------
+// TextureCache.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+#include "Engine/Core/StringUtils.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class CookedTexture;
+
+//----------------------------------------------------------------------------------------------------
+struct sTextureCacheConfig
+{
+    String m_directory = "Data/Cache/Textures";     // Created on the first cook
+};
+
+//----------------------------------------------------------------------------------------------------
+// Counted since construction.
+//
+struct sTextureCacheStatistics
+{
+    int    m_hitCount      = 0;
+    int    m_cookedCount   = 0;         // Misses: no cooked file yet, or a stale or corrupt one replaced
+    int    m_failedCount   = 0;
+    double m_hitSeconds    = 0.0;       // Spent in Loads that hit: a warm start
+    double m_cookedSeconds = 0.0;       // Spent in Loads that cooked: what a cold start adds
+};
+
+//----------------------------------------------------------------------------------------------------
+// Cooked textures on disk, keyed by a hash of the source image's bytes rather than its path or
+// timestamp: an edited image is recooked the next time it loads, and copies of one image share a
+// file. A hit costs hashing the source and mapping the cooked file; a miss decodes the image, builds
+// its mip chain and writes it once. Load from one thread at a time.
+//
+class TextureCache
+{
+public:
+    explicit TextureCache(sTextureCacheConfig const& config = sTextureCacheConfig());
+
+    // Maps the cooked form of `imageFilePath` into `out_texture`, cooking it first on a miss.
+    bool Load(char const* imageFilePath, CookedTexture& out_texture, String* out_error = nullptr);
+
+    String                         GetCookedFilePath(uint64_t sourceHash) const;
+    sTextureCacheStatistics const& GetStatistics() const;
+
+private:
+    sTextureCacheConfig     m_config;
+    sTextureCacheStatistics m_statistics;
+};
@@ -194,6 +194,45 @@ SamplerState		s_diffuseSampler	: register(s0);			// Sampler is bound in sampler
 SamplerState		s_normalSampler		: register(s1);			// Sampler is bound in sampler constant slot #1 (s1)
 SamplerState		s_specGlossEmitSampler : register(s2); 		// Sampler is bound in sampler constant slot #2 (s2)
 
+//----------------------------------------------------------------------------------------------------
+// Clustered lighting (define CLUSTERED_LIGHTING when compiling)
+//
+// Point and spot lights come from LightClusterGrid instead of c_lightArray, so there is no MAX_LIGHTS
+//	limit on them; c_lightArray then only supplies directional lights.
+// The view frustum is split into c_tileCountX x c_tileCountY screen tiles and c_sliceCount depth
+//	slices; t_clusterRecords holds (firstIndex, lightCount) per cluster into t_clusterLightIndexes,
+//	whose entries index t_clusterLights. Matches sLightClusterConstants / sLightClusterRecord in C++.
+//----------------------------------------------------------------------------------------------------
+#if defined(CLUSTERED_LIGHTING)
+cbuffer ClusterConstants : register(b8)
+{
+	float	c_viewportWidth;
+	float	c_viewportHeight;
+	float	c_logDepthScale;			// slice = log(renderDepth) * c_logDepthScale + c_logDepthBias
+	float	c_logDepthBias;
+	uint	c_tileCountX;
+	uint	c_tileCountY;
+	uint	c_sliceCount;
+	uint	EMPTY_PADDING_B8;
+};
+
+StructuredBuffer<Light>	t_clusterLights			: register(t8);
+StructuredBuffer<uint2>	t_clusterRecords		: register(t9);
+StructuredBuffer<uint>	t_clusterLightIndexes	: register(t10);
+
+//----------------------------------------------------------------------------------------------------
+// In the Pixel Shader SV_Position.xy is the pixel position (origin top-left) and SV_Position.w is
+//	the clip w, which is render-space depth for our perspective projection.
+uint GetClusterIndex( float4 pixelPosition )
+{
+	uint tileX = min( (uint)(pixelPosition.x * c_tileCountX / c_viewportWidth), c_tileCountX - 1 );
+	uint tileY = min( (uint)((1.0 - pixelPosition.y / c_viewportHeight) * c_tileCountY), c_tileCountY - 1 );
+	uint slice = (uint)clamp( log( pixelPosition.w ) * c_logDepthScale + c_logDepthBias, 0.0, (float)(c_sliceCount - 1) );
+
+	return (slice * c_tileCountY + tileY) * c_tileCountX + tileX;
+}
+#endif
+
 //----------------------------------------------------------------------------------------------------
 // VERTEX SHADER (VS)
 //
@@ -530,6 +569,10 @@ float4 PixelMain( VertexOutPixelIn input ) : SV_Target0
 	{
 		Light light = c_lightArray[i];
 
+#if defined(CLUSTERED_LIGHTING)
+		if (light.lightType != 0) continue; // Point and spot lights come from the cluster below
+#endif
+
 		if(light.lightType == 0)
 		{
 			if (light.color.a > 0.0)
@@ -594,6 +637,24 @@ float4 PixelMain( VertexOutPixelIn input ) : SV_Target0
 		}
 	}
 
+#if defined(CLUSTERED_LIGHTING)
+	uint2 clusterRecord = t_clusterRecords[ GetClusterIndex( input.v_position ) ];
+
+	for (uint clusterLight = 0; clusterLight < clusterRecord.y; clusterLight++)
+	{
+		Light light = t_clusterLights[ t_clusterLightIndexes[ clusterRecord.x + clusterLight ] ];
+
+		if (light.lightType == 1) // Point light
+		{
+			CalculatePointLight( light, input.v_worldPos, finalNormal, viewDirection, diffuseColor.rgb, specularStrength, specularPower, diffuseLighting, specularLighting );
+		}
+		else if (light.lightType == 2) // Spot light; binned at its real position, so not animated like the ones above
+		{
+			CalculateSpotLight( light, input.v_worldPos, finalNormal, viewDirection, diffuseColor.rgb, specularStrength, specularPower, diffuseLighting, specularLighting );
+		}
+	}
+#endif
+
 	// Add emissive contribution
 	float3 emissiveLighting = diffuseColor.rgb * emissiveStrength;
 